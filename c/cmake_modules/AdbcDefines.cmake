@@ -111,3 +111,13 @@ if(ADBC_BUILD_TESTS)
   endif()
   set(ADBC_TEST_LINK_LIBS GTest::gtest_main GTest::gtest GTest::gmock)
 endif()
+
+# Common benchmarking setup
+add_custom_target(all-benchmarks)
+if(ADBC_BUILD_BENCHMARKS)
+  find_package(benchmark REQUIRED)
+  set(ADBC_BENCHMARK_LINK_LIBS benchmark::benchmark_main benchmark::benchmark)
+  # Build and run every benchmark, writing one JSON file per executable
+  set(ADBC_BENCHMARK_OUTPUT_DIR "${CMAKE_BINARY_DIR}/benchmark-results")
+  add_custom_target(adbc_benchmarks)
+endif()
@@ -399,8 +399,8 @@ endfunction()
 #
 # Add a new micro benchmark, with or without an executable that should be built.
 # If benchmarks are enabled then they will be run along side unit tests with ctest.
-# 'make benchmark' and 'make unittest' to build/run only benchmark or unittests,
-# respectively.
+# 'make adbc_benchmarks' builds and runs all benchmarks, writing JSON results to
+# ADBC_BENCHMARK_OUTPUT_DIR.
 #
 # REL_BENCHMARK_NAME is the name of the benchmark app. It may be a single component
 # (e.g. monotime-benchmark) or contain additional components (e.g.
@@ -455,7 +455,7 @@ function(ADD_BENCHMARK REL_BENCHMARK_NAME)
   # Make sure the executable name contains only hyphens, not underscores
   string(REPLACE "_" "-" BENCHMARK_NAME ${BENCHMARK_NAME})
 
-  if(EXISTS ${CMAKE_CURRENT_SOURCE_DIR}/${REL_BENCHMARK_NAME}.cc)
+  if(ARG_SOURCES OR EXISTS ${CMAKE_CURRENT_SOURCE_DIR}/${REL_BENCHMARK_NAME}.cc)
     # This benchmark has a corresponding .cc file, set it up as an executable.
     set(BENCHMARK_PATH "${EXECUTABLE_OUTPUT_PATH}/${BENCHMARK_NAME}")
     add_executable(${BENCHMARK_NAME} ${SOURCES})
@@ -466,12 +466,22 @@ function(ADD_BENCHMARK REL_BENCHMARK_NAME)
     else()
       target_link_libraries(${BENCHMARK_NAME} PRIVATE ${ADBC_BENCHMARK_LINK_LIBS})
     endif()
-    add_dependencies(benchmark ${BENCHMARK_NAME})
-    set(NO_COLOR "--color_print=false")
+    adbc_configure_target(${BENCHMARK_NAME})
+    set(NO_COLOR "--benchmark_color=false")
 
     if(ARG_EXTRA_LINK_LIBS)
       target_link_libraries(${BENCHMARK_NAME} PRIVATE ${ARG_EXTRA_LINK_LIBS})
     endif()
+
+    add_custom_target(${BENCHMARK_NAME}-json
+                      COMMAND ${CMAKE_COMMAND} -E make_directory
+                              "${ADBC_BENCHMARK_OUTPUT_DIR}"
+                      COMMAND ${BENCHMARK_NAME}
+                              "--benchmark_out=${ADBC_BENCHMARK_OUTPUT_DIR}/${BENCHMARK_NAME}.json"
+                              --benchmark_out_format=json
+                      DEPENDS ${BENCHMARK_NAME}
+                      USES_TERMINAL)
+    add_dependencies(adbc_benchmarks ${BENCHMARK_NAME}-json)
   else()
     # No executable, just invoke the benchmark (probably a script) directly.
     set(BENCHMARK_PATH ${CMAKE_CURRENT_SOURCE_DIR}/${REL_BENCHMARK_NAME})
@@ -511,12 +521,7 @@ function(ADD_BENCHMARK REL_BENCHMARK_NAME)
     target_compile_definitions(${BENCHMARK_NAME} PRIVATE ADBC_BUILD_DETAILED_BENCHMARKS)
   endif()
 
-  add_test(${BENCHMARK_NAME}
-           ${BUILD_SUPPORT_DIR}/run-test.sh
-           ${CMAKE_BINARY_DIR}
-           benchmark
-           ${BENCHMARK_PATH}
-           ${NO_COLOR})
+  add_test(${BENCHMARK_NAME} ${BENCHMARK_PATH} ${NO_COLOR})
   set_property(TEST ${BENCHMARK_NAME}
                APPEND
                PROPERTY LABELS ${ARG_LABELS})
@@ -45,6 +45,23 @@ extern "C" {
 /// The type is char*.
 #define ADBC_INGEST_OPTION_TEMPORARY "adbc.ingest.temporary"
 
+/// \brief Re-chunk result sets to approximately this many rows per batch.
+///
+/// Smaller batches produced by the driver are concatenated and larger
+/// batches are sliced. 0 (the default) leaves the driver's batching as-is.
+///
+/// The type is int64_t (or char* containing a base-10 integer).
+#define ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS "adbc.statement.target_batch_rows"
+
+/// \brief Re-chunk result sets to approximately this many bytes per batch.
+///
+/// May be combined with ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS, in which
+/// case whichever limit is reached first applies. 0 (the default) means no
+/// limit.
+///
+/// The type is int64_t (or char* containing a base-10 integer).
+#define ADBC_STATEMENT_OPTION_TARGET_BATCH_BYTES "adbc.statement.target_batch_bytes"
+
 #ifdef __cplusplus
 }
 #endif
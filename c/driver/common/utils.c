@@ -23,6 +23,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 #include <adbc.h>
 
 static size_t kErrorBufferSize = 1024;
@@ -292,6 +296,574 @@ AdbcStatusCode BatchToArrayStream(struct ArrowArray* values, struct ArrowSchema*
   return ADBC_STATUS_OK;
 }
 
+// Slices of one input batch may be released from different threads
+#if defined(_MSC_VER)
+#define ADBC_ATOMIC_ADD(PTR, N) (_InterlockedExchangeAdd64((PTR), (N)) + (N))
+#else
+#define ADBC_ATOMIC_ADD(PTR, N) __atomic_add_fetch((PTR), (N), __ATOMIC_ACQ_REL)
+#endif
+
+/// A reference-counted batch that zero-copy slices point into.
+struct SharedArray {
+  struct ArrowArray array;
+  int64_t refcount;
+};
+
+static void SharedArrayUnref(struct SharedArray* shared) {
+  if (ADBC_ATOMIC_ADD(&shared->refcount, -1) == 0) {
+    shared->array.release(&shared->array);
+    free(shared);
+  }
+}
+
+static void SlicedChildRelease(struct ArrowArray* array) {
+  SharedArrayUnref((struct SharedArray*)array->private_data);
+  array->release = NULL;
+}
+
+static void SlicedArrayRelease(struct ArrowArray* array) {
+  for (int64_t i = 0; i < array->n_children; i++) {
+    if (array->children[i]->release) array->children[i]->release(array->children[i]);
+  }
+  // The child structs are allocated in the same block as the pointers
+  free(array->children);
+  SharedArrayUnref((struct SharedArray*)array->private_data);
+  array->release = NULL;
+}
+
+static const void* kSlicedArrayBuffers[1] = {NULL};
+
+/// Slice rows [offset, offset + length) of a struct array (with no
+/// top-level nulls) by adjusting the offsets of its children.
+static ArrowErrorCode SliceSharedArray(struct SharedArray* shared,
+                                       struct ArrowArrayView* view, int64_t offset,
+                                       int64_t length, struct ArrowArray* out) {
+  const struct ArrowArray* source = &shared->array;
+  const int64_t n_children = source->n_children;
+
+  struct ArrowArray** children = (struct ArrowArray**)malloc(
+      n_children * (sizeof(struct ArrowArray*) + sizeof(struct ArrowArray)) + 1);
+  if (children == NULL) return ENOMEM;
+  struct ArrowArray* child_structs = (struct ArrowArray*)(children + n_children);
+
+  for (int64_t i = 0; i < n_children; i++) {
+    struct ArrowArray* child = &child_structs[i];
+    struct ArrowArrayView* child_view = view->children[i];
+    memcpy(child, source->children[i], sizeof(*child));
+    child->offset = source->children[i]->offset + source->offset + offset;
+    child->length = length;
+
+    const uint8_t* validity = child_view->buffer_views[0].data.as_uint8;
+    if (child_view->storage_type == NANOARROW_TYPE_NA) {
+      child->null_count = length;
+    } else if (source->children[i]->null_count == 0 || validity == NULL ||
+               child_view->layout.buffer_type[0] != NANOARROW_BUFFER_TYPE_VALIDITY) {
+      child->null_count = 0;
+    } else {
+      child->null_count = length - ArrowBitCountSet(validity, child->offset, length);
+    }
+
+    child->private_data = shared;
+    child->release = &SlicedChildRelease;
+    children[i] = child;
+  }
+
+  ADBC_ATOMIC_ADD(&shared->refcount, n_children + 1);
+
+  out->length = length;
+  out->null_count = 0;
+  out->offset = 0;
+  out->n_buffers = 1;
+  out->n_children = n_children;
+  out->buffers = kSlicedArrayBuffers;
+  out->children = children;
+  out->dictionary = NULL;
+  out->private_data = shared;
+  out->release = &SlicedArrayRelease;
+  return NANOARROW_OK;
+}
+
+/// Append (by copying) rows [offset, offset + length) of src to dst, which
+/// must be in the appending state.
+static ArrowErrorCode AppendArrayViewRange(struct ArrowArray* dst,
+                                           struct ArrowArrayView* src, int64_t offset,
+                                           int64_t length) {
+  if (length == 0) return NANOARROW_OK;
+  if (src->dictionary != NULL) return ENOTSUP;
+
+  const int64_t start = src->offset + offset;
+  switch (src->storage_type) {
+    case NANOARROW_TYPE_NA:
+      dst->length += length;
+      dst->null_count += length;
+      return NANOARROW_OK;
+    case NANOARROW_TYPE_SPARSE_UNION:
+    case NANOARROW_TYPE_DENSE_UNION:
+      return ENOTSUP;
+    default:
+      break;
+  }
+
+  // Validity: only materialize a bitmap once we see a null
+  const uint8_t* validity = src->buffer_views[0].data.as_uint8;
+  int64_t null_count = 0;
+  if (validity != NULL && src->null_count != 0) {
+    null_count = length - ArrowBitCountSet(validity, start, length);
+  }
+
+  struct ArrowBitmap* bitmap = ArrowArrayValidityBitmap(dst);
+  if (null_count > 0 && bitmap->buffer.data == NULL) {
+    NANOARROW_RETURN_NOT_OK(ArrowBitmapReserve(bitmap, dst->length + length));
+    if (dst->length > 0) ArrowBitmapAppendUnsafe(bitmap, 1, dst->length);
+  }
+  if (bitmap->buffer.data != NULL) {
+    NANOARROW_RETURN_NOT_OK(ArrowBitmapReserve(bitmap, length));
+    if (null_count == 0) {
+      ArrowBitmapAppendUnsafe(bitmap, 1, length);
+    } else {
+      for (int64_t i = 0; i < length; i++) {
+        ArrowBitmapAppendUnsafe(bitmap, ArrowBitGet(validity, start + i), 1);
+      }
+    }
+  }
+
+  switch (src->storage_type) {
+    case NANOARROW_TYPE_BOOL: {
+      struct ArrowBuffer* data = ArrowArrayBuffer(dst, 1);
+      const int64_t bytes_required = (dst->length + length + 7) / 8;
+      if (bytes_required > data->size_bytes) {
+        NANOARROW_RETURN_NOT_OK(
+            ArrowBufferAppendFill(data, 0, bytes_required - data->size_bytes));
+      }
+      const uint8_t* values = src->buffer_views[1].data.as_uint8;
+      for (int64_t i = 0; i < length; i++) {
+        ArrowBitSetTo(data->data, dst->length + i, ArrowBitGet(values, start + i));
+      }
+      break;
+    }
+    case NANOARROW_TYPE_STRING:
+    case NANOARROW_TYPE_BINARY: {
+      const int32_t* offsets = src->buffer_views[1].data.as_int32;
+      struct ArrowBuffer* dst_offsets = ArrowArrayBuffer(dst, 1);
+      const int32_t base = ((const int32_t*)dst_offsets->data)[dst->length];
+      const int32_t first = offsets[start];
+      if ((int64_t)base + (offsets[start + length] - first) > INT32_MAX) {
+        return EOVERFLOW;
+      }
+      NANOARROW_RETURN_NOT_OK(ArrowBufferReserve(dst_offsets, length * sizeof(int32_t)));
+      for (int64_t i = 1; i <= length; i++) {
+        const int32_t value = base + (offsets[start + i] - first);
+        ArrowBufferAppendUnsafe(dst_offsets, &value, sizeof(value));
+      }
+      NANOARROW_RETURN_NOT_OK(
+          ArrowBufferAppend(ArrowArrayBuffer(dst, 2),
+                            src->buffer_views[2].data.as_uint8 + first,
+                            offsets[start + length] - first));
+      break;
+    }
+    case NANOARROW_TYPE_LARGE_STRING:
+    case NANOARROW_TYPE_LARGE_BINARY: {
+      const int64_t* offsets = src->buffer_views[1].data.as_int64;
+      struct ArrowBuffer* dst_offsets = ArrowArrayBuffer(dst, 1);
+      const int64_t base = ((const int64_t*)dst_offsets->data)[dst->length];
+      const int64_t first = offsets[start];
+      NANOARROW_RETURN_NOT_OK(ArrowBufferReserve(dst_offsets, length * sizeof(int64_t)));
+      for (int64_t i = 1; i <= length; i++) {
+        const int64_t value = base + (offsets[start + i] - first);
+        ArrowBufferAppendUnsafe(dst_offsets, &value, sizeof(value));
+      }
+      NANOARROW_RETURN_NOT_OK(
+          ArrowBufferAppend(ArrowArrayBuffer(dst, 2),
+                            src->buffer_views[2].data.as_uint8 + first,
+                            offsets[start + length] - first));
+      break;
+    }
+    case NANOARROW_TYPE_LIST:
+    case NANOARROW_TYPE_MAP: {
+      const int32_t* offsets = src->buffer_views[1].data.as_int32;
+      struct ArrowBuffer* dst_offsets = ArrowArrayBuffer(dst, 1);
+      const int32_t base = ((const int32_t*)dst_offsets->data)[dst->length];
+      const int32_t first = offsets[start];
+      if ((int64_t)base + (offsets[start + length] - first) > INT32_MAX) {
+        return EOVERFLOW;
+      }
+      NANOARROW_RETURN_NOT_OK(ArrowBufferReserve(dst_offsets, length * sizeof(int32_t)));
+      for (int64_t i = 1; i <= length; i++) {
+        const int32_t value = base + (offsets[start + i] - first);
+        ArrowBufferAppendUnsafe(dst_offsets, &value, sizeof(value));
+      }
+      NANOARROW_RETURN_NOT_OK(AppendArrayViewRange(
+          dst->children[0], src->children[0], first, offsets[start + length] - first));
+      break;
+    }
+    case NANOARROW_TYPE_LARGE_LIST: {
+      const int64_t* offsets = src->buffer_views[1].data.as_int64;
+      struct ArrowBuffer* dst_offsets = ArrowArrayBuffer(dst, 1);
+      const int64_t base = ((const int64_t*)dst_offsets->data)[dst->length];
+      const int64_t first = offsets[start];
+      NANOARROW_RETURN_NOT_OK(ArrowBufferReserve(dst_offsets, length * sizeof(int64_t)));
+      for (int64_t i = 1; i <= length; i++) {
+        const int64_t value = base + (offsets[start + i] - first);
+        ArrowBufferAppendUnsafe(dst_offsets, &value, sizeof(value));
+      }
+      NANOARROW_RETURN_NOT_OK(AppendArrayViewRange(
+          dst->children[0], src->children[0], first, offsets[start + length] - first));
+      break;
+    }
+    case NANOARROW_TYPE_FIXED_SIZE_LIST: {
+      const int64_t size = src->layout.child_size_elements;
+      NANOARROW_RETURN_NOT_OK(AppendArrayViewRange(dst->children[0], src->children[0],
+                                                   start * size, length * size));
+      break;
+    }
+    case NANOARROW_TYPE_STRUCT:
+      for (int64_t i = 0; i < src->n_children; i++) {
+        NANOARROW_RETURN_NOT_OK(
+            AppendArrayViewRange(dst->children[i], src->children[i], start, length));
+      }
+      break;
+    default: {
+      // Fixed-width types
+      const int64_t element_size_bits = src->layout.element_size_bits[1];
+      if (src->layout.buffer_type[1] != NANOARROW_BUFFER_TYPE_DATA ||
+          element_size_bits == 0 || element_size_bits % 8 != 0) {
+        return ENOTSUP;
+      }
+      const int64_t width = element_size_bits / 8;
+      NANOARROW_RETURN_NOT_OK(ArrowBufferAppend(
+          ArrowArrayBuffer(dst, 1), src->buffer_views[1].data.as_uint8 + start * width,
+          length * width));
+      break;
+    }
+  }
+
+  dst->length += length;
+  dst->null_count += null_count;
+  return NANOARROW_OK;
+}
+
+/// The size of all buffers referenced by an array (not accounting for offsets).
+static int64_t ArrayViewSizeBytes(const struct ArrowArrayView* view) {
+  int64_t size = 0;
+  for (int i = 0; i < 3; i++) {
+    size += view->buffer_views[i].size_bytes;
+  }
+  for (int64_t i = 0; i < view->n_children; i++) {
+    size += ArrayViewSizeBytes(view->children[i]);
+  }
+  if (view->dictionary != NULL) size += ArrayViewSizeBytes(view->dictionary);
+  return size;
+}
+
+struct RechunkStream {
+  struct ArrowArrayStream input;
+  struct ArrowSchema schema;
+  int64_t target_rows;
+  int64_t target_bytes;
+  // Whether batches of this schema can be sliced without copying
+  char can_slice;
+  char finished;
+
+  // The input batch currently being consumed
+  struct SharedArray* current;
+  struct ArrowArrayView current_view;
+  int64_t current_offset;
+  int64_t current_target_rows;
+
+  // Rows accumulated (by copying) but not yet returned
+  struct ArrowArray pending;
+
+  struct ArrowError error;
+};
+
+static const char* RechunkStreamGetLastError(struct ArrowArrayStream* stream) {
+  if (!stream || !stream->private_data) return NULL;
+  struct RechunkStream* impl = (struct RechunkStream*)stream->private_data;
+  return impl->error.message;
+}
+
+static int RechunkStreamGetSchema(struct ArrowArrayStream* stream,
+                                  struct ArrowSchema* schema) {
+  if (!stream || !stream->private_data) return EINVAL;
+  struct RechunkStream* impl = (struct RechunkStream*)stream->private_data;
+  return ArrowSchemaDeepCopy(&impl->schema, schema);
+}
+
+/// Fetch the next non-empty input batch, or mark the stream finished.
+static int RechunkStreamFetch(struct RechunkStream* impl) {
+  if (impl->current) {
+    SharedArrayUnref(impl->current);
+    impl->current = NULL;
+  }
+
+  while (1) {
+    struct ArrowArray batch;
+    int status = impl->input.get_next(&impl->input, &batch);
+    if (status != 0) {
+      const char* message = impl->input.get_last_error(&impl->input);
+      ArrowErrorSet(&impl->error, "Failed to read input batch: (%d) %s", status,
+                    message ? message : strerror(status));
+      return status;
+    } else if (batch.release == NULL) {
+      impl->finished = 1;
+      return 0;
+    } else if (batch.length == 0) {
+      batch.release(&batch);
+      continue;
+    }
+
+    status = ArrowArrayViewSetArray(&impl->current_view, &batch, &impl->error);
+    if (status != 0) {
+      batch.release(&batch);
+      return status;
+    }
+
+    impl->current = (struct SharedArray*)malloc(sizeof(struct SharedArray));
+    if (impl->current == NULL) {
+      batch.release(&batch);
+      return ENOMEM;
+    }
+    ArrowArrayMove(&batch, &impl->current->array);
+    impl->current->refcount = 1;
+    impl->current_offset = 0;
+
+    int64_t rows = impl->target_rows > 0 ? impl->target_rows : INT64_MAX;
+    if (impl->target_bytes > 0) {
+      int64_t bytes_per_row =
+          ArrayViewSizeBytes(&impl->current_view) / impl->current->array.length;
+      if (bytes_per_row < 1) bytes_per_row = 1;
+      int64_t byte_rows = impl->target_bytes / bytes_per_row;
+      if (byte_rows < 1) byte_rows = 1;
+      if (byte_rows < rows) rows = byte_rows;
+    }
+    impl->current_target_rows = rows;
+    return 0;
+  }
+}
+
+static int RechunkStreamFinishPending(struct RechunkStream* impl,
+                                      struct ArrowArray* out) {
+  int status = ArrowArrayFinishBuildingDefault(&impl->pending, &impl->error);
+  if (status != 0) return status;
+  ArrowArrayMove(&impl->pending, out);
+  return 0;
+}
+
+static int RechunkStreamGetNext(struct ArrowArrayStream* stream,
+                                struct ArrowArray* out) {
+  if (!stream || !stream->private_data) return EINVAL;
+  struct RechunkStream* impl = (struct RechunkStream*)stream->private_data;
+  impl->error.message[0] = '\0';
+
+  while (1) {
+    if (!impl->finished &&
+        (!impl->current || impl->current_offset == impl->current->array.length)) {
+      int status = RechunkStreamFetch(impl);
+      if (status != 0) return status;
+    }
+
+    const int64_t pending_rows = impl->pending.release ? impl->pending.length : 0;
+    if (impl->finished) {
+      if (pending_rows > 0) return RechunkStreamFinishPending(impl, out);
+      if (impl->pending.release) impl->pending.release(&impl->pending);
+      out->release = NULL;
+      return 0;
+    }
+
+    const int64_t target = impl->current_target_rows;
+    const int64_t remaining = impl->current->array.length - impl->current_offset;
+
+    if (pending_rows == 0 && remaining >= target && impl->can_slice &&
+        impl->current->array.null_count == 0) {
+      if (impl->current_offset == 0 && remaining == target) {
+        // Batch is exactly the right size: pass it through
+        ArrowArrayMove(&impl->current->array, out);
+        free(impl->current);
+        impl->current = NULL;
+        return 0;
+      }
+
+      int status = SliceSharedArray(impl->current, &impl->current_view,
+                                    impl->current_offset, target, out);
+      if (status != 0) {
+        ArrowErrorSet(&impl->error, "Failed to slice batch");
+        return status;
+      }
+      impl->current_offset += target;
+      return 0;
+    }
+
+    if (!impl->pending.release) {
+      int status = ArrowArrayInitFromSchema(&impl->pending, &impl->schema, &impl->error);
+      if (status != 0) return status;
+      status = ArrowArrayStartAppending(&impl->pending);
+      if (status != 0) {
+        ArrowErrorSet(&impl->error, "Failed to start appending to output batch");
+        return status;
+      }
+    }
+
+    int64_t n = target - pending_rows;
+    if (n > remaining) n = remaining;
+    int status = AppendArrayViewRange(&impl->pending, &impl->current_view,
+                                      impl->current_offset, n);
+    if (status != 0) {
+      ArrowErrorSet(&impl->error, "Failed to concatenate batches: (%d) %s", status,
+                    strerror(status));
+      return status;
+    }
+    impl->current_offset += n;
+
+    if (impl->pending.length >= target) return RechunkStreamFinishPending(impl, out);
+  }
+}
+
+static void RechunkStreamRelease(struct ArrowArrayStream* stream) {
+  if (!stream || !stream->private_data) return;
+  struct RechunkStream* impl = (struct RechunkStream*)stream->private_data;
+  if (impl->current) SharedArrayUnref(impl->current);
+  if (impl->pending.release) impl->pending.release(&impl->pending);
+  ArrowArrayViewReset(&impl->current_view);
+  if (impl->schema.release) impl->schema.release(&impl->schema);
+  if (impl->input.release) impl->input.release(&impl->input);
+  free(impl);
+
+  memset(stream, 0, sizeof(*stream));
+}
+
+AdbcStatusCode RechunkArrayStream(struct ArrowArrayStream* input, int64_t target_rows,
+                                  int64_t target_bytes, struct ArrowArrayStream* out,
+                                  struct AdbcError* error) {
+  if (!input->release) {
+    SetError(error, "ArrowArrayStream is not initialized");
+    return ADBC_STATUS_INTERNAL;
+  } else if (target_rows < 0 || target_bytes < 0) {
+    SetError(error, "Target batch size must be non-negative");
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+
+  if (target_rows == 0 && target_bytes == 0) {
+    memcpy(out, input, sizeof(*out));
+    memset(input, 0, sizeof(*input));
+    return ADBC_STATUS_OK;
+  }
+
+  struct RechunkStream* impl = (struct RechunkStream*)calloc(1, sizeof(*impl));
+  if (impl == NULL) {
+    SetError(error, "Failed to allocate stream");
+    return ADBC_STATUS_INTERNAL;
+  }
+  memcpy(&impl->input, input, sizeof(*input));
+  memset(input, 0, sizeof(*input));
+  impl->target_rows = target_rows;
+  impl->target_bytes = target_bytes;
+
+  int status = impl->input.get_schema(&impl->input, &impl->schema);
+  if (status != 0) {
+    const char* message = impl->input.get_last_error(&impl->input);
+    SetError(error, "Failed to get schema of stream: (%d) %s", status,
+             message ? message : strerror(status));
+    impl->input.release(&impl->input);
+    free(impl);
+    return ADBC_STATUS_INTERNAL;
+  }
+
+  struct ArrowError na_error = {0};
+  status = ArrowArrayViewInitFromSchema(&impl->current_view, &impl->schema, &na_error);
+  if (status != 0) {
+    SetError(error, "Cannot re-chunk stream: %s", na_error.message);
+    impl->schema.release(&impl->schema);
+    impl->input.release(&impl->input);
+    free(impl);
+    return ADBC_STATUS_NOT_IMPLEMENTED;
+  }
+  impl->can_slice = impl->current_view.storage_type == NANOARROW_TYPE_STRUCT &&
+                    impl->schema.dictionary == NULL;
+
+  out->private_data = impl;
+  out->get_last_error = RechunkStreamGetLastError;
+  out->get_next = RechunkStreamGetNext;
+  out->get_schema = RechunkStreamGetSchema;
+  out->release = RechunkStreamRelease;
+  return ADBC_STATUS_OK;
+}
+
+struct AdbcArenaBlock {
+  struct AdbcArenaBlock* next;
+  size_t capacity;
+  size_t size;
+};
+
+#define ADBC_ARENA_ALIGN(x) (((x) + 15) & ~(size_t)15)
+
+static const size_t kArenaDefaultBlockSize = 4096;
+
+static uint8_t* ArenaBlockData(struct AdbcArenaBlock* block) {
+  return (uint8_t*)block + ADBC_ARENA_ALIGN(sizeof(struct AdbcArenaBlock));
+}
+
+static size_t ArenaAllocationSize(size_t size) {
+  return ADBC_ARENA_ALIGN(size > 0 ? size : 1);
+}
+
+static struct AdbcArenaBlock* ArenaNewBlock(size_t capacity) {
+  struct AdbcArenaBlock* block = (struct AdbcArenaBlock*)malloc(
+      ADBC_ARENA_ALIGN(sizeof(struct AdbcArenaBlock)) + capacity);
+  if (block == NULL) return NULL;
+  block->next = NULL;
+  block->capacity = capacity;
+  block->size = 0;
+  return block;
+}
+
+void AdbcArenaInit(struct AdbcArena* arena, size_t block_size) {
+  arena->head = NULL;
+  arena->block_size =
+      block_size == 0 ? kArenaDefaultBlockSize : ADBC_ARENA_ALIGN(block_size);
+}
+
+void* AdbcArenaAlloc(struct AdbcArena* arena, size_t size) {
+  size = ArenaAllocationSize(size);
+  struct AdbcArenaBlock* head = arena->head;
+
+  if (head != NULL && head->capacity - head->size >= size) {
+    uint8_t* out = ArenaBlockData(head) + head->size;
+    head->size += size;
+    memset(out, 0, size);
+    return out;
+  }
+
+  struct AdbcArenaBlock* block =
+      ArenaNewBlock(size > arena->block_size ? size : arena->block_size);
+  if (block == NULL) return NULL;
+  block->size = size;
+
+  if (head != NULL && size > arena->block_size / 4) {
+    // Large allocation: give it its own block, but keep filling the
+    // current one so that we don't waste its remaining space
+    block->next = head->next;
+    head->next = block;
+  } else {
+    block->next = head;
+    arena->head = block;
+  }
+
+  memset(ArenaBlockData(block), 0, size);
+  return ArenaBlockData(block);
+}
+
+void AdbcArenaReset(struct AdbcArena* arena) {
+  struct AdbcArenaBlock* block = arena->head;
+  while (block != NULL) {
+    struct AdbcArenaBlock* next = block->next;
+    free(block);
+    block = next;
+  }
+  arena->head = NULL;
+}
+
+#undef ADBC_ARENA_ALIGN
+
 int StringBuilderInit(struct StringBuilder* builder, size_t initial_size) {
   builder->buffer = (char*)malloc(initial_size);
   if (builder->buffer == NULL) return errno;
@@ -618,6 +1190,61 @@ AdbcStatusCode AdbcInitConnectionObjectsSchema(struct ArrowSchema* schema,
   return ADBC_STATUS_OK;
 }
 
+static uint64_t GetObjectsHash(const char* data, int64_t size_bytes) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (int64_t i = 0; i < size_bytes; i++) {
+    hash ^= (uint8_t)data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static int GetObjectsIndexInit(struct AdbcArena* arena, struct AdbcGetObjectsIndex* index,
+                               int64_t n) {
+  int64_t capacity = 1;
+  while (capacity < 2 * n) capacity *= 2;
+  index->entries = (struct AdbcGetObjectsIndexEntry*)AdbcArenaAlloc(
+      arena, capacity * sizeof(struct AdbcGetObjectsIndexEntry));
+  if (index->entries == NULL) return ENOMEM;
+  index->capacity = capacity;
+  return 0;
+}
+
+static bool GetObjectsNameEquals(struct ArrowStringView name, const char* data,
+                                 int64_t size_bytes) {
+  return name.size_bytes == size_bytes &&
+         (size_bytes == 0 || memcmp(name.data, data, size_bytes) == 0);
+}
+
+static void GetObjectsIndexInsert(struct AdbcGetObjectsIndex* index,
+                                  struct ArrowStringView name, void* value) {
+  int64_t mask = index->capacity - 1;
+  int64_t i = (int64_t)(GetObjectsHash(name.data, name.size_bytes) & mask);
+  while (index->entries[i].value != NULL) {
+    // Keep the first occurrence of a duplicate name
+    if (GetObjectsNameEquals(index->entries[i].name, name.data, name.size_bytes)) return;
+    i = (i + 1) & mask;
+  }
+  index->entries[i].name = name;
+  index->entries[i].value = value;
+}
+
+static void* GetObjectsIndexFind(const struct AdbcGetObjectsIndex* index,
+                                 const char* name) {
+  if (name == NULL || index->capacity == 0) return NULL;
+  int64_t size_bytes = (int64_t)strlen(name);
+  int64_t mask = index->capacity - 1;
+  int64_t i = (int64_t)(GetObjectsHash(name, size_bytes) & mask);
+  while (index->entries[i].value != NULL) {
+    if (GetObjectsNameEquals(index->entries[i].name, name, size_bytes)) {
+      return index->entries[i].value;
+    }
+    i = (i + 1) & mask;
+  }
+  return NULL;
+}
+
 struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_view) {
   struct AdbcGetObjectsData* get_objects_data =
       (struct AdbcGetObjectsData*)calloc(1, sizeof(struct AdbcGetObjectsData));
@@ -679,16 +1306,38 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
   get_objects_data->fk_table_array = constraint_column_usage_items->children[2];
   get_objects_data->fk_column_name_array = constraint_column_usage_items->children[3];
 
-  get_objects_data->catalogs = (struct AdbcGetObjectsCatalog**)calloc(
-      array_view->array->length, sizeof(struct AdbcGetObjectsCatalog*));
-
-  if (get_objects_data->catalogs == NULL) {
+  // Size the arena so that (in the common case) every node lands in one
+  // contiguous block: each node, its slot in the parent's pointer array,
+  // its worst-case share of the parent's hash index, and alignment padding
+  struct AdbcArena* arena = &get_objects_data->arena;
+  const size_t kPadding =
+      sizeof(void*) + 4 * sizeof(struct AdbcGetObjectsIndexEntry) + 32;
+  size_t arena_size =
+      array_view->array->length * (sizeof(struct AdbcGetObjectsCatalog) + kPadding) +
+      catalog_db_schemas_items->length *
+          (sizeof(struct AdbcGetObjectsSchema) + kPadding) +
+      schema_table_items->length * (sizeof(struct AdbcGetObjectsTable) + 2 * kPadding) +
+      table_columns_items->length * (sizeof(struct AdbcGetObjectsColumn) + kPadding) +
+      table_constraints_items->length *
+          (sizeof(struct AdbcGetObjectsConstraint) + 2 * kPadding) +
+      get_objects_data->constraint_column_name_array->length *
+          sizeof(struct ArrowStringView) +
+      constraint_column_usage_items->length *
+          (sizeof(struct AdbcGetObjectsUsage) + kPadding);
+  AdbcArenaInit(arena, arena_size);
+
+  get_objects_data->catalogs = (struct AdbcGetObjectsCatalog**)AdbcArenaAlloc(
+      arena, array_view->array->length * sizeof(struct AdbcGetObjectsCatalog*));
+
+  if (get_objects_data->catalogs == NULL ||
+      GetObjectsIndexInit(arena, &get_objects_data->catalogs_index,
+                          array_view->array->length) != 0) {
     goto error_handler;
   }
 
   for (int64_t catalog_idx = 0; catalog_idx < array_view->array->length; catalog_idx++) {
     struct AdbcGetObjectsCatalog* catalog =
-        (struct AdbcGetObjectsCatalog*)calloc(1, sizeof(struct AdbcGetObjectsCatalog));
+        (struct AdbcGetObjectsCatalog*)AdbcArenaAlloc(arena, sizeof(*catalog));
     if (catalog == NULL) {
       goto error_handler;
     }
@@ -699,6 +1348,8 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
 
     catalog->catalog_name =
         ArrowArrayViewGetStringUnsafe(get_objects_data->catalog_name_array, catalog_idx);
+    GetObjectsIndexInsert(&get_objects_data->catalogs_index, catalog->catalog_name,
+                          catalog);
 
     int64_t db_schema_list_start = ArrowArrayViewListChildOffset(
         get_objects_data->catalog_schemas_array, catalog_idx);
@@ -710,16 +1361,18 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
     if (db_schema_len == 0) {
       catalog->catalog_db_schemas = NULL;
     } else {
-      catalog->catalog_db_schemas = (struct AdbcGetObjectsSchema**)calloc(
-          db_schema_len, sizeof(struct AdbcGetObjectsSchema*));
-      if (catalog->catalog_db_schemas == NULL) {
+      catalog->catalog_db_schemas = (struct AdbcGetObjectsSchema**)AdbcArenaAlloc(
+          arena, db_schema_len * sizeof(struct AdbcGetObjectsSchema*));
+      if (catalog->catalog_db_schemas == NULL ||
+          GetObjectsIndexInit(arena, &catalog->catalog_db_schemas_index,
+                              db_schema_len) != 0) {
         goto error_handler;
       }
 
       for (int64_t db_schema_index = db_schema_list_start;
            db_schema_index < db_schema_list_end; db_schema_index++) {
         struct AdbcGetObjectsSchema* schema =
-            (struct AdbcGetObjectsSchema*)calloc(1, sizeof(struct AdbcGetObjectsSchema));
+            (struct AdbcGetObjectsSchema*)AdbcArenaAlloc(arena, sizeof(*schema));
         if (schema == NULL) {
           goto error_handler;
         }
@@ -729,6 +1382,8 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
 
         schema->db_schema_name = ArrowArrayViewGetStringUnsafe(
             get_objects_data->db_schema_name_array, db_schema_index);
+        GetObjectsIndexInsert(&catalog->catalog_db_schemas_index, schema->db_schema_name,
+                              schema);
         int64_t table_list_start = ArrowArrayViewListChildOffset(
             get_objects_data->db_schema_tables_array, db_schema_index);
         int64_t table_list_end = ArrowArrayViewListChildOffset(
@@ -738,16 +1393,18 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
         if (table_len == 0) {
           schema->db_schema_tables = NULL;
         } else {
-          schema->db_schema_tables = (struct AdbcGetObjectsTable**)calloc(
-              table_len, sizeof(struct AdbcGetObjectsTable*));
-          if (schema->db_schema_tables == NULL) {
+          schema->db_schema_tables = (struct AdbcGetObjectsTable**)AdbcArenaAlloc(
+              arena, table_len * sizeof(struct AdbcGetObjectsTable*));
+          if (schema->db_schema_tables == NULL ||
+              GetObjectsIndexInit(arena, &schema->db_schema_tables_index, table_len) !=
+                  0) {
             goto error_handler;
           }
 
           for (int64_t table_index = table_list_start; table_index < table_list_end;
                table_index++) {
-            struct AdbcGetObjectsTable* table = (struct AdbcGetObjectsTable*)calloc(
-                1, sizeof(struct AdbcGetObjectsTable));
+            struct AdbcGetObjectsTable* table =
+                (struct AdbcGetObjectsTable*)AdbcArenaAlloc(arena, sizeof(*table));
             if (table == NULL) {
               goto error_handler;
             }
@@ -760,6 +1417,8 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
                 get_objects_data->table_name_array, table_index);
             table->table_type = ArrowArrayViewGetStringUnsafe(
                 get_objects_data->table_type_array, table_index);
+            GetObjectsIndexInsert(&schema->db_schema_tables_index, table->table_name,
+                                  table);
 
             int64_t columns_list_start = ArrowArrayViewListChildOffset(
                 get_objects_data->table_columns_array, table_index);
@@ -771,17 +1430,18 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
             if (columns_len == 0) {
               table->table_columns = NULL;
             } else {
-              table->table_columns = (struct AdbcGetObjectsColumn**)calloc(
-                  columns_len, sizeof(struct AdbcGetObjectsColumn*));
-              if (table->table_columns == NULL) {
+              table->table_columns = (struct AdbcGetObjectsColumn**)AdbcArenaAlloc(
+                  arena, columns_len * sizeof(struct AdbcGetObjectsColumn*));
+              if (table->table_columns == NULL ||
+                  GetObjectsIndexInit(arena, &table->table_columns_index, columns_len) !=
+                      0) {
                 goto error_handler;
               }
 
               for (int64_t column_index = columns_list_start;
                    column_index < columns_list_end; column_index++) {
                 struct AdbcGetObjectsColumn* column =
-                    (struct AdbcGetObjectsColumn*)calloc(
-                        1, sizeof(struct AdbcGetObjectsColumn));
+                    (struct AdbcGetObjectsColumn*)AdbcArenaAlloc(arena, sizeof(*column));
                 if (column == NULL) {
                   goto error_handler;
                 }
@@ -790,6 +1450,8 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
 
                 column->column_name = ArrowArrayViewGetStringUnsafe(
                     get_objects_data->column_name_array, column_index);
+                GetObjectsIndexInsert(&table->table_columns_index, column->column_name,
+                                      column);
                 column->ordinal_position = ArrowArrayViewGetIntUnsafe(
                     get_objects_data->column_position_array, column_index);
                 column->remarks = ArrowArrayViewGetStringUnsafe(
@@ -837,17 +1499,20 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
             if (constraints_len == 0) {
               table->table_constraints = NULL;
             } else {
-              table->table_constraints = (struct AdbcGetObjectsConstraint**)calloc(
-                  constraints_len, sizeof(struct AdbcGetObjectsConstraint*));
-              if (table->table_constraints == NULL) {
+              table->table_constraints =
+                  (struct AdbcGetObjectsConstraint**)AdbcArenaAlloc(
+                      arena, constraints_len * sizeof(struct AdbcGetObjectsConstraint*));
+              if (table->table_constraints == NULL ||
+                  GetObjectsIndexInit(arena, &table->table_constraints_index,
+                                      constraints_len) != 0) {
                 goto error_handler;
               }
 
               for (int64_t constraint_index = constraints_list_start;
                    constraint_index < constraints_list_end; constraint_index++) {
                 struct AdbcGetObjectsConstraint* constraint =
-                    (struct AdbcGetObjectsConstraint*)calloc(
-                        1, sizeof(struct AdbcGetObjectsConstraint));
+                    (struct AdbcGetObjectsConstraint*)AdbcArenaAlloc(
+                        arena, sizeof(*constraint));
                 if (constraint == NULL) {
                   goto error_handler;
                 }
@@ -859,6 +1524,8 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
 
                 constraint->constraint_name = ArrowArrayViewGetStringUnsafe(
                     get_objects_data->constraint_name_array, constraint_index);
+                GetObjectsIndexInsert(&table->table_constraints_index,
+                                      constraint->constraint_name, constraint);
                 constraint->constraint_type = ArrowArrayViewGetStringUnsafe(
                     get_objects_data->constraint_type_array, constraint_index);
                 int64_t constraint_column_names_start = ArrowArrayViewListChildOffset(
@@ -872,8 +1539,10 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
                 if (constraint_column_names_len == 0) {
                   constraint->constraint_column_names = NULL;
                 } else {
-                  constraint->constraint_column_names = (struct ArrowStringView*)calloc(
-                      constraint_column_names_len, sizeof(struct ArrowStringView));
+                  constraint->constraint_column_names =
+                      (struct ArrowStringView*)AdbcArenaAlloc(
+                          arena,
+                          constraint_column_names_len * sizeof(struct ArrowStringView));
                   if (constraint->constraint_column_names == NULL) {
                     goto error_handler;
                   }
@@ -903,9 +1572,9 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
                   constraint->constraint_column_usages = NULL;
                 } else {
                   constraint->constraint_column_usages =
-                      (struct AdbcGetObjectsUsage**)calloc(
-                          constraint_column_usages_len,
-                          sizeof(struct AdbcGetObjectsUsage*));
+                      (struct AdbcGetObjectsUsage**)AdbcArenaAlloc(
+                          arena, constraint_column_usages_len *
+                                     sizeof(struct AdbcGetObjectsUsage*));
                   if (constraint->constraint_column_usages == NULL) {
                     goto error_handler;
                   }
@@ -915,8 +1584,8 @@ struct AdbcGetObjectsData* AdbcGetObjectsDataInit(struct ArrowArrayView* array_v
                        constraint_column_usage_index < constraint_column_usages_end;
                        constraint_column_usage_index++) {
                     struct AdbcGetObjectsUsage* usage =
-                        (struct AdbcGetObjectsUsage*)calloc(
-                            1, sizeof(struct AdbcGetObjectsUsage));
+                        (struct AdbcGetObjectsUsage*)AdbcArenaAlloc(arena,
+                                                                     sizeof(*usage));
                     if (usage == NULL) {
                       goto error_handler;
                     }
@@ -955,65 +1624,14 @@ error_handler:
 }
 
 void AdbcGetObjectsDataDelete(struct AdbcGetObjectsData* get_objects_data) {
-  for (int64_t catalog_index = 0; catalog_index < get_objects_data->n_catalogs;
-       catalog_index++) {
-    struct AdbcGetObjectsCatalog* catalog = get_objects_data->catalogs[catalog_index];
-    for (int64_t db_schema_index = 0; db_schema_index < catalog->n_db_schemas;
-         db_schema_index++) {
-      struct AdbcGetObjectsSchema* schema = catalog->catalog_db_schemas[db_schema_index];
-      for (int64_t table_index = 0; table_index < schema->n_db_schema_tables;
-           table_index++) {
-        struct AdbcGetObjectsTable* table = schema->db_schema_tables[table_index];
-        for (int64_t column_index = 0; column_index < table->n_table_columns;
-             column_index++) {
-          free(table->table_columns[column_index]);
-        }
-
-        free(table->table_columns);
-
-        for (int64_t constraint_index = 0; constraint_index < table->n_table_constraints;
-             constraint_index++) {
-          struct AdbcGetObjectsConstraint* constraint =
-              table->table_constraints[constraint_index];
-          free(constraint->constraint_column_names);
-          for (int64_t usage_index = 0; usage_index < constraint->n_column_usages;
-               usage_index++) {
-            free(constraint->constraint_column_usages[usage_index]);
-          }
-
-          free(constraint->constraint_column_usages);
-          free(table->table_constraints[constraint_index]);
-        }
-
-        free(table->table_constraints);
-        free(table);
-      }
-
-      free(schema->db_schema_tables);
-      free(schema);
-    }
-
-    free(catalog->catalog_db_schemas);
-    free(catalog);
-  }
-
-  free(get_objects_data->catalogs);
+  AdbcArenaReset(&get_objects_data->arena);
   free(get_objects_data);
 }
 
 struct AdbcGetObjectsCatalog* AdbcGetObjectsDataGetCatalogByName(
     struct AdbcGetObjectsData* get_objects_data, const char* const catalog_name) {
-  if (catalog_name != NULL) {
-    for (int64_t i = 0; i < get_objects_data->n_catalogs; i++) {
-      struct AdbcGetObjectsCatalog* catalog = get_objects_data->catalogs[i];
-      struct ArrowStringView name = catalog->catalog_name;
-      if (!strncmp(name.data, catalog_name, name.size_bytes)) {
-        return catalog;
-      }
-    }
-  }
-
-  return NULL;
+  return (struct AdbcGetObjectsCatalog*)GetObjectsIndexFind(
+      &get_objects_data->catalogs_index, catalog_name);
 }
 
 struct AdbcGetObjectsSchema* AdbcGetObjectsDataGetSchemaByName(
@@ -1023,13 +1641,8 @@ struct AdbcGetObjectsSchema* AdbcGetObjectsDataGetSchemaByName(
     struct AdbcGetObjectsCatalog* catalog =
         AdbcGetObjectsDataGetCatalogByName(get_objects_data, catalog_name);
     if (catalog != NULL) {
-      for (int64_t i = 0; i < catalog->n_db_schemas; i++) {
-        struct AdbcGetObjectsSchema* schema = catalog->catalog_db_schemas[i];
-        struct ArrowStringView name = schema->db_schema_name;
-        if (!strncmp(name.data, schema_name, name.size_bytes)) {
-          return schema;
-        }
-      }
+      return (struct AdbcGetObjectsSchema*)GetObjectsIndexFind(
+          &catalog->catalog_db_schemas_index, schema_name);
     }
   }
 
@@ -1043,13 +1656,8 @@ struct AdbcGetObjectsTable* AdbcGetObjectsDataGetTableByName(
     struct AdbcGetObjectsSchema* schema =
         AdbcGetObjectsDataGetSchemaByName(get_objects_data, catalog_name, schema_name);
     if (schema != NULL) {
-      for (int64_t i = 0; i < schema->n_db_schema_tables; i++) {
-        struct AdbcGetObjectsTable* table = schema->db_schema_tables[i];
-        struct ArrowStringView name = table->table_name;
-        if (!strncmp(name.data, table_name, name.size_bytes)) {
-          return table;
-        }
-      }
+      return (struct AdbcGetObjectsTable*)GetObjectsIndexFind(
+          &schema->db_schema_tables_index, table_name);
     }
   }
 
@@ -1064,13 +1672,8 @@ struct AdbcGetObjectsColumn* AdbcGetObjectsDataGetColumnByName(
     struct AdbcGetObjectsTable* table = AdbcGetObjectsDataGetTableByName(
         get_objects_data, catalog_name, schema_name, table_name);
     if (table != NULL) {
-      for (int64_t i = 0; i < table->n_table_columns; i++) {
-        struct AdbcGetObjectsColumn* column = table->table_columns[i];
-        struct ArrowStringView name = column->column_name;
-        if (!strncmp(name.data, column_name, name.size_bytes)) {
-          return column;
-        }
-      }
+      return (struct AdbcGetObjectsColumn*)GetObjectsIndexFind(
+          &table->table_columns_index, column_name);
     }
   }
 
@@ -1085,13 +1688,8 @@ struct AdbcGetObjectsConstraint* AdbcGetObjectsDataGetConstraintByName(
     struct AdbcGetObjectsTable* table = AdbcGetObjectsDataGetTableByName(
         get_objects_data, catalog_name, schema_name, table_name);
     if (table != NULL) {
-      for (int64_t i = 0; i < table->n_table_constraints; i++) {
-        struct AdbcGetObjectsConstraint* constraint = table->table_constraints[i];
-        struct ArrowStringView name = constraint->constraint_name;
-        if (!strncmp(name.data, constraint_name, name.size_bytes)) {
-          return constraint;
-        }
-      }
+      return (struct AdbcGetObjectsConstraint*)GetObjectsIndexFind(
+          &table->table_constraints_index, constraint_name);
     }
   }
 
@@ -52,6 +52,23 @@ void AppendErrorDetail(struct AdbcError* error, const char* key, const uint8_t*
 int CommonErrorGetDetailCount(const struct AdbcError* error);
 struct AdbcErrorDetail CommonErrorGetDetail(const struct AdbcError* error, int index);
 
+/// \brief A bump allocator for many small allocations with a shared lifetime.
+///
+/// Allocations are carved out of large blocks and are only freed all at
+/// once by AdbcArenaReset.
+struct AdbcArenaBlock;
+struct AdbcArena {
+  struct AdbcArenaBlock* head;
+  size_t block_size;
+};
+
+/// Initialize an empty arena. A block_size of 0 uses a default.
+void AdbcArenaInit(struct AdbcArena* arena, size_t block_size);
+/// Allocate zeroed memory from the arena. Returns NULL on error.
+void* AdbcArenaAlloc(struct AdbcArena* arena, size_t size);
+/// Free all memory owned by the arena. The arena may be reused afterwards.
+void AdbcArenaReset(struct AdbcArena* arena);
+
 struct StringBuilder {
   char* buffer;
   // Not including null terminator
@@ -71,6 +88,17 @@ AdbcStatusCode BatchToArrayStream(struct ArrowArray* values, struct ArrowSchema*
                                   struct ArrowArrayStream* stream,
                                   struct AdbcError* error);
 
+/// Re-chunk a stream so that each batch has approximately a target size.
+///
+/// Batches smaller than the target are concatenated (which copies) and
+/// batches larger than the target are sliced (which does not copy, unless
+/// the batch has top-level nulls). A target of 0 means no limit; if both
+/// targets are 0, the input is moved to the output unchanged. Takes
+/// ownership of input.
+AdbcStatusCode RechunkArrayStream(struct ArrowArrayStream* input, int64_t target_rows,
+                                  int64_t target_bytes, struct ArrowArrayStream* out,
+                                  struct AdbcError* error);
+
 /// Check an NanoArrow status code.
 #define CHECK_NA(CODE, EXPR, ERROR)                                                 \
   do {                                                                              \
@@ -138,6 +166,17 @@ AdbcStatusCode AdbcInitConnectionObjectsSchema(struct ArrowSchema* schema,
                                                struct AdbcError* error);
 /// @}
 
+/// \brief A hash index from name to node, used for the *ByName lookups.
+struct AdbcGetObjectsIndexEntry {
+  struct ArrowStringView name;
+  void* value;
+};
+struct AdbcGetObjectsIndex {
+  // Open addressing with linear probing; capacity is a power of two
+  struct AdbcGetObjectsIndexEntry* entries;
+  int64_t capacity;
+};
+
 struct AdbcGetObjectsUsage {
   struct ArrowStringView fk_catalog;
   struct ArrowStringView fk_db_schema;
@@ -183,23 +222,28 @@ struct AdbcGetObjectsTable {
   int n_table_columns;
   struct AdbcGetObjectsConstraint** table_constraints;
   int n_table_constraints;
+  struct AdbcGetObjectsIndex table_columns_index;
+  struct AdbcGetObjectsIndex table_constraints_index;
 };
 
 struct AdbcGetObjectsSchema {
   struct ArrowStringView db_schema_name;
   struct AdbcGetObjectsTable** db_schema_tables;
   int n_db_schema_tables;
+  struct AdbcGetObjectsIndex db_schema_tables_index;
 };
 
 struct AdbcGetObjectsCatalog {
   struct ArrowStringView catalog_name;
   struct AdbcGetObjectsSchema** catalog_db_schemas;
   int n_db_schemas;
+  struct AdbcGetObjectsIndex catalog_db_schemas_index;
 };
 
 struct AdbcGetObjectsData {
   struct AdbcGetObjectsCatalog** catalogs;
   int n_catalogs;
+  struct AdbcGetObjectsIndex catalogs_index;
   struct ArrowArrayView* catalog_name_array;
   struct ArrowArrayView* catalog_schemas_array;
   struct ArrowArrayView* db_schema_name_array;
@@ -236,6 +280,8 @@ struct AdbcGetObjectsData {
   struct ArrowArrayView* fk_db_schema_array;
   struct ArrowArrayView* fk_table_array;
   struct ArrowArrayView* fk_column_name_array;
+  // Owns all of the catalog/schema/table/column/constraint/usage nodes
+  struct AdbcArena arena;
 };
 
 // does not copy any data from array
@@ -245,6 +291,7 @@ void AdbcGetObjectsDataDelete(struct AdbcGetObjectsData* get_objects_data);
 
 // returns NULL on error
 // for now all arguments are required
+// lookups are exact matches, in constant time
 struct AdbcGetObjectsCatalog* AdbcGetObjectsDataGetCatalogByName(
     struct AdbcGetObjectsData* get_objects_data, const char* const catalog_name);
 struct AdbcGetObjectsSchema* AdbcGetObjectsDataGetSchemaByName(
@@ -0,0 +1,175 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <nanoarrow/nanoarrow.hpp>
+
+#include "utils.h"
+
+namespace {
+
+#define CHECK_OK(EXPR)                       \
+  do {                                       \
+    if ((EXPR) != 0) {                       \
+      state.SkipWithError("Failed: " #EXPR); \
+      return;                                \
+    }                                        \
+  } while (0)
+
+/// Build a GetObjects result with one catalog and one schema containing
+/// n_tables tables of n_columns columns each.
+void MakeCatalog(benchmark::State& state, int64_t n_tables, int64_t n_columns,
+                 struct ArrowSchema* schema, struct ArrowArray* array) {
+  struct AdbcError error = ADBC_ERROR_INIT;
+  CHECK_OK(AdbcInitConnectionObjectsSchema(schema, &error));
+  CHECK_OK(ArrowArrayInitFromSchema(array, schema, nullptr));
+  CHECK_OK(ArrowArrayStartAppending(array));
+
+  struct ArrowArray* db_schemas = array->children[1];
+  struct ArrowArray* db_schema_item = db_schemas->children[0];
+  struct ArrowArray* db_schema_tables = db_schema_item->children[1];
+  struct ArrowArray* table_item = db_schema_tables->children[0];
+  struct ArrowArray* table_columns = table_item->children[2];
+  struct ArrowArray* column_item = table_columns->children[0];
+  struct ArrowArray* table_constraints = table_item->children[3];
+
+  CHECK_OK(ArrowArrayAppendString(array->children[0], ArrowCharView("main")));
+  CHECK_OK(ArrowArrayAppendString(db_schema_item->children[0], ArrowCharView("public")));
+  for (int64_t i = 0; i < n_tables; i++) {
+    std::string table_name = "table" + std::to_string(i);
+    CHECK_OK(ArrowArrayAppendString(table_item->children[0],
+                                    ArrowCharView(table_name.c_str())));
+    CHECK_OK(ArrowArrayAppendString(table_item->children[1], ArrowCharView("TABLE")));
+    for (int64_t j = 0; j < n_columns; j++) {
+      std::string column_name = "column" + std::to_string(j);
+      CHECK_OK(ArrowArrayAppendString(column_item->children[0],
+                                      ArrowCharView(column_name.c_str())));
+      CHECK_OK(ArrowArrayAppendInt(column_item->children[1], j + 1));
+      for (int64_t k = 2; k < column_item->n_children; k++) {
+        CHECK_OK(ArrowArrayAppendNull(column_item->children[k], 1));
+      }
+      CHECK_OK(ArrowArrayFinishElement(column_item));
+    }
+    CHECK_OK(ArrowArrayFinishElement(table_columns));
+    CHECK_OK(ArrowArrayFinishElement(table_constraints));
+    CHECK_OK(ArrowArrayFinishElement(table_item));
+  }
+  CHECK_OK(ArrowArrayFinishElement(db_schema_tables));
+  CHECK_OK(ArrowArrayFinishElement(db_schema_item));
+  CHECK_OK(ArrowArrayFinishElement(db_schemas));
+  CHECK_OK(ArrowArrayFinishElement(array));
+  CHECK_OK(ArrowArrayFinishBuildingDefault(array, nullptr));
+}
+
+constexpr int64_t kNumTables = 10000;
+constexpr int64_t kNumColumns = 10;
+
+void BM_GetObjectsDataInit(benchmark::State& state) {
+  nanoarrow::UniqueSchema schema;
+  nanoarrow::UniqueArray array;
+  nanoarrow::UniqueArrayView view;
+  MakeCatalog(state, kNumTables, kNumColumns, schema.get(), array.get());
+  if (state.error_occurred()) return;
+  CHECK_OK(ArrowArrayViewInitFromSchema(view.get(), schema.get(), nullptr));
+  CHECK_OK(ArrowArrayViewSetArray(view.get(), array.get(), nullptr));
+
+  for (auto _ : state) {
+    struct AdbcGetObjectsData* data = AdbcGetObjectsDataInit(view.get());
+    if (data == nullptr) {
+      state.SkipWithError("AdbcGetObjectsDataInit failed");
+      return;
+    }
+    AdbcGetObjectsDataDelete(data);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumTables * kNumColumns);
+}
+BENCHMARK(BM_GetObjectsDataInit)->Unit(benchmark::kMillisecond);
+
+/// Look up every column of every table, as a metadata sync would.
+void BM_GetObjectsDataLookup(benchmark::State& state) {
+  nanoarrow::UniqueSchema schema;
+  nanoarrow::UniqueArray array;
+  nanoarrow::UniqueArrayView view;
+  MakeCatalog(state, kNumTables, kNumColumns, schema.get(), array.get());
+  if (state.error_occurred()) return;
+  CHECK_OK(ArrowArrayViewInitFromSchema(view.get(), schema.get(), nullptr));
+  CHECK_OK(ArrowArrayViewSetArray(view.get(), array.get(), nullptr));
+
+  struct AdbcGetObjectsData* data = AdbcGetObjectsDataInit(view.get());
+  if (data == nullptr) {
+    state.SkipWithError("AdbcGetObjectsDataInit failed");
+    return;
+  }
+
+  std::vector<std::string> table_names;
+  std::vector<std::string> column_names;
+  for (int64_t i = 0; i < kNumTables; i++) {
+    table_names.push_back("table" + std::to_string(i));
+  }
+  for (int64_t j = 0; j < kNumColumns; j++) {
+    column_names.push_back("column" + std::to_string(j));
+  }
+
+  for (auto _ : state) {
+    for (const auto& table_name : table_names) {
+      for (const auto& column_name : column_names) {
+        struct AdbcGetObjectsColumn* column = AdbcGetObjectsDataGetColumnByName(
+            data, "main", "public", table_name.c_str(), column_name.c_str());
+        benchmark::DoNotOptimize(column);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumTables * kNumColumns);
+  AdbcGetObjectsDataDelete(data);
+}
+BENCHMARK(BM_GetObjectsDataLookup)->Unit(benchmark::kMillisecond);
+
+void BM_InitConnectionObjectsSchema(benchmark::State& state) {
+  struct AdbcError error = ADBC_ERROR_INIT;
+  for (auto _ : state) {
+    nanoarrow::UniqueSchema schema;
+    CHECK_OK(AdbcInitConnectionObjectsSchema(schema.get(), &error));
+    benchmark::DoNotOptimize(schema->release);
+  }
+}
+BENCHMARK(BM_InitConnectionObjectsSchema);
+
+void BM_GetInfoBuilder(benchmark::State& state) {
+  struct AdbcError error = ADBC_ERROR_INIT;
+  const uint32_t info_codes[] = {ADBC_INFO_VENDOR_NAME, ADBC_INFO_VENDOR_VERSION,
+                                 ADBC_INFO_DRIVER_NAME, ADBC_INFO_DRIVER_VERSION,
+                                 ADBC_INFO_DRIVER_ARROW_VERSION};
+  const size_t n_info_codes = sizeof(info_codes) / sizeof(info_codes[0]);
+  for (auto _ : state) {
+    nanoarrow::UniqueSchema schema;
+    nanoarrow::UniqueArray array;
+    CHECK_OK(AdbcInitConnectionGetInfoSchema(info_codes, n_info_codes, schema.get(),
+                                             array.get(), &error));
+    for (size_t i = 0; i < n_info_codes; i++) {
+      CHECK_OK(AdbcConnectionGetInfoAppendString(array.get(), info_codes[i], "value",
+                                                 &error));
+      CHECK_OK(ArrowArrayFinishElement(array.get()));
+    }
+    CHECK_OK(ArrowArrayFinishBuildingDefault(array.get(), nullptr));
+  }
+}
+BENCHMARK(BM_GetInfoBuilder);
+
+}  // namespace
@@ -16,12 +16,14 @@
 // under the License.
 
 #include <cstring>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <nanoarrow/nanoarrow.hpp>
 
 #include "utils.h"
 
@@ -79,6 +81,33 @@ TEST(TestStringBuilder, TestMultipleAppends) {
   StringBuilderReset(&str);
 }
 
+TEST(TestArena, TestAlloc) {
+  struct AdbcArena arena;
+  AdbcArenaInit(&arena, /*block_size=*/256);
+
+  std::vector<uint8_t*> ptrs;
+  for (size_t i = 1; i < 64; i++) {
+    auto* ptr = reinterpret_cast<uint8_t*>(AdbcArenaAlloc(&arena, i));
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(ptr) % 16);
+    for (size_t j = 0; j < i; j++) ASSERT_EQ(0, ptr[j]);
+    std::memset(ptr, static_cast<int>(i), i);
+    ptrs.push_back(ptr);
+  }
+
+  // Allocations larger than the block size still work
+  auto* big = reinterpret_cast<uint8_t*>(AdbcArenaAlloc(&arena, 4096));
+  ASSERT_NE(nullptr, big);
+  std::memset(big, 0xFF, 4096);
+
+  for (size_t i = 1; i < 64; i++) {
+    for (size_t j = 0; j < i; j++) ASSERT_EQ(i, ptrs[i - 1][j]);
+  }
+
+  AdbcArenaReset(&arena);
+  EXPECT_EQ(nullptr, arena.head);
+}
+
 TEST(ErrorDetails, Adbc100) {
   struct AdbcError error;
   std::memset(&error, 0, ADBC_ERROR_1_1_0_SIZE);
@@ -167,3 +196,313 @@ TEST(ErrorDetails, RoundTripValues) {
 
   error.release(&error);
 }
+
+class RechunkTest : public ::testing::Test {
+ public:
+  void TearDown() override {
+    if (error.release) error.release(&error);
+  }
+
+  /// Make a batch of (int32, string) where every third value is null.
+  void MakeBatch(int32_t start, int32_t length, struct ArrowArray* out) {
+    nanoarrow::UniqueSchema schema;
+    MakeSchema(schema.get());
+    ASSERT_EQ(0, ArrowArrayInitFromSchema(out, schema.get(), nullptr));
+    ASSERT_EQ(0, ArrowArrayStartAppending(out));
+    for (int32_t i = start; i < start + length; i++) {
+      if (i % 3 == 0) {
+        ASSERT_EQ(0, ArrowArrayAppendNull(out->children[0], 1));
+      } else {
+        ASSERT_EQ(0, ArrowArrayAppendInt(out->children[0], i));
+      }
+      std::string value = "s" + std::to_string(i);
+      ASSERT_EQ(0,
+                ArrowArrayAppendString(out->children[1], ArrowCharView(value.c_str())));
+      ASSERT_EQ(0, ArrowArrayFinishElement(out));
+    }
+    ASSERT_EQ(0, ArrowArrayFinishBuildingDefault(out, nullptr));
+  }
+
+  void MakeSchema(struct ArrowSchema* schema) {
+    ArrowSchemaInit(schema);
+    ASSERT_EQ(0, ArrowSchemaSetTypeStruct(schema, 2));
+    ASSERT_EQ(0, ArrowSchemaSetType(schema->children[0], NANOARROW_TYPE_INT32));
+    ASSERT_EQ(0, ArrowSchemaSetName(schema->children[0], "ints"));
+    ASSERT_EQ(0, ArrowSchemaSetType(schema->children[1], NANOARROW_TYPE_STRING));
+    ASSERT_EQ(0, ArrowSchemaSetName(schema->children[1], "strs"));
+  }
+
+  /// Make a stream of batches with the given lengths.
+  void MakeStream(const std::vector<int32_t>& lengths, struct ArrowArrayStream* out) {
+    nanoarrow::UniqueSchema schema;
+    MakeSchema(schema.get());
+    std::vector<nanoarrow::UniqueArray> batches;
+    int32_t start = 0;
+    for (int32_t length : lengths) {
+      nanoarrow::UniqueArray batch;
+      ASSERT_NO_FATAL_FAILURE(MakeBatch(start, length, batch.get()));
+      batches.push_back(std::move(batch));
+      start += length;
+    }
+    nanoarrow::VectorArrayStream::MakeUnique(schema.get(), std::move(batches)).move(out);
+  }
+
+  /// Read the stream, checking the values and returning the batch sizes.
+  void ReadStream(struct ArrowArrayStream* stream, std::vector<int64_t>* lengths) {
+    nanoarrow::UniqueSchema schema;
+    ASSERT_EQ(0, stream->get_schema(stream, schema.get()));
+    nanoarrow::UniqueArrayView view;
+    ASSERT_EQ(0, ArrowArrayViewInitFromSchema(view.get(), schema.get(), nullptr));
+
+    int64_t row = 0;
+    while (true) {
+      nanoarrow::UniqueArray batch;
+      ASSERT_EQ(0, stream->get_next(stream, batch.get()))
+          << stream->get_last_error(stream);
+      if (!batch->release) break;
+      ASSERT_EQ(0, ArrowArrayViewSetArray(view.get(), batch.get(), nullptr));
+      lengths->push_back(batch->length);
+
+      for (int64_t i = 0; i < batch->length; i++, row++) {
+        if (row % 3 == 0) {
+          ASSERT_TRUE(ArrowArrayViewIsNull(view->children[0], i));
+        } else {
+          ASSERT_FALSE(ArrowArrayViewIsNull(view->children[0], i));
+          ASSERT_EQ(row, ArrowArrayViewGetIntUnsafe(view->children[0], i));
+        }
+        struct ArrowStringView value =
+            ArrowArrayViewGetStringUnsafe(view->children[1], i);
+        ASSERT_EQ("s" + std::to_string(row), std::string(value.data, value.size_bytes));
+      }
+    }
+  }
+
+ protected:
+  struct AdbcError error = ADBC_ERROR_INIT;
+};
+
+TEST_F(RechunkTest, Concatenate) {
+  nanoarrow::UniqueArrayStream input;
+  nanoarrow::UniqueArrayStream output;
+  ASSERT_NO_FATAL_FAILURE(MakeStream({3, 3, 0, 3, 3, 3, 1}, input.get()));
+  ASSERT_EQ(ADBC_STATUS_OK, RechunkArrayStream(input.get(), /*target_rows=*/8,
+                                               /*target_bytes=*/0, output.get(), &error));
+  ASSERT_EQ(nullptr, input->release);
+
+  std::vector<int64_t> lengths;
+  ASSERT_NO_FATAL_FAILURE(ReadStream(output.get(), &lengths));
+  ASSERT_THAT(lengths, ::testing::ElementsAre(8, 8));
+}
+
+TEST_F(RechunkTest, Slice) {
+  nanoarrow::UniqueArrayStream input;
+  nanoarrow::UniqueArrayStream output;
+  ASSERT_NO_FATAL_FAILURE(MakeStream({20, 4, 2}, input.get()));
+  ASSERT_EQ(ADBC_STATUS_OK, RechunkArrayStream(input.get(), /*target_rows=*/8,
+                                               /*target_bytes=*/0, output.get(), &error));
+
+  std::vector<int64_t> lengths;
+  ASSERT_NO_FATAL_FAILURE(ReadStream(output.get(), &lengths));
+  ASSERT_THAT(lengths, ::testing::ElementsAre(8, 8, 8, 2));
+}
+
+TEST_F(RechunkTest, SliceOutlivesStream) {
+  nanoarrow::UniqueArrayStream input;
+  nanoarrow::UniqueArrayStream output;
+  ASSERT_NO_FATAL_FAILURE(MakeStream({10}, input.get()));
+  ASSERT_EQ(ADBC_STATUS_OK, RechunkArrayStream(input.get(), /*target_rows=*/5,
+                                               /*target_bytes=*/0, output.get(), &error));
+
+  nanoarrow::UniqueArray first;
+  nanoarrow::UniqueArray second;
+  ASSERT_EQ(0, output->get_next(output.get(), first.get()));
+  ASSERT_EQ(0, output->get_next(output.get(), second.get()));
+  output.reset();
+
+  // Slices share the input batch's buffers
+  ASSERT_EQ(0, first->children[0]->offset);
+  ASSERT_EQ(5, second->children[0]->offset);
+  ASSERT_EQ(first->children[1]->buffers[2], second->children[1]->buffers[2]);
+  ASSERT_EQ(2, first->children[0]->null_count);
+  ASSERT_EQ(2, second->children[0]->null_count);
+
+  // Moving a child out must keep it valid after the parent is released
+  struct ArrowArray child = *second->children[1];
+  second->children[1]->release = nullptr;
+  first.reset();
+  second.reset();
+  nanoarrow::UniqueArray owned_child(&child);
+  ASSERT_EQ(5, owned_child->offset);
+}
+
+TEST_F(RechunkTest, TargetBytes) {
+  nanoarrow::UniqueArrayStream input;
+  nanoarrow::UniqueArrayStream output;
+  ASSERT_NO_FATAL_FAILURE(MakeStream({1, 1, 1, 1, 100}, input.get()));
+  ASSERT_EQ(ADBC_STATUS_OK,
+            RechunkArrayStream(input.get(), /*target_rows=*/0, /*target_bytes=*/256,
+                               output.get(), &error));
+
+  std::vector<int64_t> lengths;
+  ASSERT_NO_FATAL_FAILURE(ReadStream(output.get(), &lengths));
+  ASSERT_GT(lengths.size(), 2);
+  int64_t total = 0;
+  for (int64_t length : lengths) total += length;
+  ASSERT_EQ(104, total);
+}
+
+TEST_F(RechunkTest, Passthrough) {
+  nanoarrow::UniqueArrayStream input;
+  nanoarrow::UniqueArrayStream output;
+  ASSERT_NO_FATAL_FAILURE(MakeStream({3, 5}, input.get()));
+  void* private_data = input->private_data;
+  ASSERT_EQ(ADBC_STATUS_OK, RechunkArrayStream(input.get(), /*target_rows=*/0,
+                                               /*target_bytes=*/0, output.get(), &error));
+  ASSERT_EQ(private_data, output->private_data);
+
+  std::vector<int64_t> lengths;
+  ASSERT_NO_FATAL_FAILURE(ReadStream(output.get(), &lengths));
+  ASSERT_THAT(lengths, ::testing::ElementsAre(3, 5));
+}
+
+class GetObjectsDataTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_EQ(ADBC_STATUS_OK, AdbcInitConnectionObjectsSchema(schema.get(), &error));
+    ASSERT_EQ(0, ArrowArrayInitFromSchema(array.get(), schema.get(), nullptr));
+    ASSERT_EQ(0, ArrowArrayStartAppending(array.get()));
+  }
+
+  /// Append a catalog with a single schema, each table having the given
+  /// number of columns and a primary key constraint on the first column.
+  void AppendCatalog(const std::string& catalog, const std::string& db_schema,
+                     const std::vector<std::pair<std::string, int>>& tables) {
+    struct ArrowArray* db_schemas = array->children[1];
+    struct ArrowArray* db_schema_item = db_schemas->children[0];
+    struct ArrowArray* db_schema_tables = db_schema_item->children[1];
+    struct ArrowArray* table_item = db_schema_tables->children[0];
+    struct ArrowArray* table_columns = table_item->children[2];
+    struct ArrowArray* column_item = table_columns->children[0];
+    struct ArrowArray* table_constraints = table_item->children[3];
+    struct ArrowArray* constraint_item = table_constraints->children[0];
+
+    ASSERT_EQ(0,
+              ArrowArrayAppendString(array->children[0], ArrowCharView(catalog.c_str())));
+    ASSERT_EQ(0, ArrowArrayAppendString(db_schema_item->children[0],
+                                        ArrowCharView(db_schema.c_str())));
+    for (const auto& table : tables) {
+      ASSERT_EQ(0, ArrowArrayAppendString(table_item->children[0],
+                                          ArrowCharView(table.first.c_str())));
+      ASSERT_EQ(0,
+                ArrowArrayAppendString(table_item->children[1], ArrowCharView("TABLE")));
+      for (int i = 0; i < table.second; i++) {
+        std::string name = "col" + std::to_string(i);
+        ASSERT_EQ(0, ArrowArrayAppendString(column_item->children[0],
+                                            ArrowCharView(name.c_str())));
+        ASSERT_EQ(0, ArrowArrayAppendInt(column_item->children[1], i + 1));
+        for (int64_t j = 2; j < column_item->n_children; j++) {
+          ASSERT_EQ(0, ArrowArrayAppendNull(column_item->children[j], 1));
+        }
+        ASSERT_EQ(0, ArrowArrayFinishElement(column_item));
+      }
+      ASSERT_EQ(0, ArrowArrayFinishElement(table_columns));
+
+      ASSERT_EQ(0,
+                ArrowArrayAppendString(constraint_item->children[0], ArrowCharView("pk")));
+      ASSERT_EQ(0, ArrowArrayAppendString(constraint_item->children[1],
+                                          ArrowCharView("PRIMARY KEY")));
+      ASSERT_EQ(0, ArrowArrayAppendString(constraint_item->children[2]->children[0],
+                                          ArrowCharView("col0")));
+      ASSERT_EQ(0, ArrowArrayFinishElement(constraint_item->children[2]));
+      ASSERT_EQ(0, ArrowArrayFinishElement(constraint_item->children[3]));
+      ASSERT_EQ(0, ArrowArrayFinishElement(constraint_item));
+      ASSERT_EQ(0, ArrowArrayFinishElement(table_constraints));
+
+      ASSERT_EQ(0, ArrowArrayFinishElement(table_item));
+    }
+    ASSERT_EQ(0, ArrowArrayFinishElement(db_schema_tables));
+    ASSERT_EQ(0, ArrowArrayFinishElement(db_schema_item));
+    ASSERT_EQ(0, ArrowArrayFinishElement(db_schemas));
+    ASSERT_EQ(0, ArrowArrayFinishElement(array.get()));
+  }
+
+  void Finish() {
+    ASSERT_EQ(0, ArrowArrayFinishBuildingDefault(array.get(), nullptr));
+    ASSERT_EQ(0, ArrowArrayViewInitFromSchema(view.get(), schema.get(), nullptr));
+    ASSERT_EQ(0, ArrowArrayViewSetArray(view.get(), array.get(), nullptr));
+  }
+
+ protected:
+  struct AdbcError error = ADBC_ERROR_INIT;
+  nanoarrow::UniqueSchema schema;
+  nanoarrow::UniqueArray array;
+  nanoarrow::UniqueArrayView view;
+};
+
+TEST_F(GetObjectsDataTest, Lookup) {
+  ASSERT_NO_FATAL_FAILURE(AppendCatalog("main", "public", {{"foo", 3}, {"bar", 1}}));
+  ASSERT_NO_FATAL_FAILURE(AppendCatalog("other", "private", {{"baz", 2}}));
+  ASSERT_NO_FATAL_FAILURE(Finish());
+
+  struct AdbcGetObjectsData* data = AdbcGetObjectsDataInit(view.get());
+  ASSERT_NE(nullptr, data);
+  ASSERT_EQ(2, data->n_catalogs);
+
+  EXPECT_NE(nullptr, AdbcGetObjectsDataGetCatalogByName(data, "other"));
+  EXPECT_EQ(nullptr, AdbcGetObjectsDataGetCatalogByName(data, "missing"));
+  EXPECT_NE(nullptr, AdbcGetObjectsDataGetSchemaByName(data, "main", "public"));
+  EXPECT_EQ(nullptr, AdbcGetObjectsDataGetSchemaByName(data, "main", "private"));
+
+  struct AdbcGetObjectsTable* table =
+      AdbcGetObjectsDataGetTableByName(data, "main", "public", "foo");
+  ASSERT_NE(nullptr, table);
+  EXPECT_EQ(3, table->n_table_columns);
+  EXPECT_EQ(1, table->n_table_constraints);
+  EXPECT_EQ(nullptr, AdbcGetObjectsDataGetTableByName(data, "main", "public", "baz"));
+
+  struct AdbcGetObjectsColumn* column =
+      AdbcGetObjectsDataGetColumnByName(data, "main", "public", "foo", "col2");
+  ASSERT_NE(nullptr, column);
+  EXPECT_EQ(3, column->ordinal_position);
+
+  struct AdbcGetObjectsConstraint* constraint =
+      AdbcGetObjectsDataGetConstraintByName(data, "other", "private", "baz", "pk");
+  ASSERT_NE(nullptr, constraint);
+  ASSERT_EQ(1, constraint->n_column_names);
+  EXPECT_EQ("col0", std::string(constraint->constraint_column_names[0].data,
+                                constraint->constraint_column_names[0].size_bytes));
+
+  AdbcGetObjectsDataDelete(data);
+}
+
+TEST_F(GetObjectsDataTest, LookupExactMatch) {
+  std::vector<std::pair<std::string, int>> tables;
+  for (int i = 0; i < 100; i++) {
+    tables.emplace_back("t" + std::to_string(i), 1);
+  }
+  tables.emplace_back("t1", 5);
+  ASSERT_NO_FATAL_FAILURE(AppendCatalog("main", "public", tables));
+  ASSERT_NO_FATAL_FAILURE(Finish());
+
+  struct AdbcGetObjectsData* data = AdbcGetObjectsDataInit(view.get());
+  ASSERT_NE(nullptr, data);
+
+  for (int i = 0; i < 100; i++) {
+    std::string name = "t" + std::to_string(i);
+    struct AdbcGetObjectsTable* table =
+        AdbcGetObjectsDataGetTableByName(data, "main", "public", name.c_str());
+    ASSERT_NE(nullptr, table) << name;
+    EXPECT_EQ(name, std::string(table->table_name.data, table->table_name.size_bytes));
+    // The first of the duplicate names wins
+    EXPECT_EQ(1, table->n_table_columns);
+  }
+
+  // Names are not prefix-matched
+  EXPECT_EQ(nullptr, AdbcGetObjectsDataGetCatalogByName(data, "mai"));
+  EXPECT_EQ(nullptr, AdbcGetObjectsDataGetCatalogByName(data, "main2"));
+  EXPECT_EQ(nullptr, AdbcGetObjectsDataGetTableByName(data, "main", "public", "t"));
+  EXPECT_EQ(nullptr, AdbcGetObjectsDataGetTableByName(data, "main", "public", "t100"));
+  EXPECT_EQ(nullptr, AdbcGetObjectsDataGetTableByName(data, "main", "public", nullptr));
+
+  AdbcGetObjectsDataDelete(data);
+}
@@ -18,9 +18,10 @@
 #include "connection.h"
 
 #include <cassert>
+#include <chrono>
 #include <cinttypes>
-#include <cmath>
 #include <cstring>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -35,6 +36,7 @@
 #include "database.h"
 #include "error.h"
 #include "result_helper.h"
+#include "statistics.h"
 
 namespace adbcpq {
 namespace {
@@ -107,6 +109,31 @@ class PqGetObjectsHelper {
   }
 
  private:
+  struct TableRow {
+    std::string name;
+    std::string type;
+  };
+
+  struct ColumnRow {
+    std::string name;
+    int64_t position;
+    bool has_remarks;
+    std::string remarks;
+  };
+
+  struct ConstraintRow {
+    std::string name;
+    std::string type;
+    std::vector<std::string> column_names;
+    // Only set for foreign keys
+    std::string fk_db_schema;
+    std::string fk_table;
+    std::vector<std::string> fk_column_names;
+  };
+
+  // (schema name, table name)
+  using TableKey = std::pair<std::string, std::string>;
+
   AdbcStatusCode InitArrowArray() {
     RAISE_ADBC(AdbcInitConnectionObjectsSchema(schema_, error_));
 
@@ -120,37 +147,24 @@ class PqGetObjectsHelper {
   AdbcStatusCode AppendSchemas(std::string db_name) {
     // postgres only allows you to list schemas for the currently connected db
     if (!strcmp(db_name.c_str(), PQdb(conn_))) {
-      struct StringBuilder query;
-      std::memset(&query, 0, sizeof(query));
-      if (StringBuilderInit(&query, /*initial_size*/ 256)) {
-        return ADBC_STATUS_INTERNAL;
-      }
-
-      const char* stmt =
-          "SELECT nspname FROM pg_catalog.pg_namespace WHERE "
-          "nspname !~ '^pg_' AND nspname <> 'information_schema'";
-
-      if (StringBuilderAppend(&query, "%s", stmt)) {
-        StringBuilderReset(&query);
-        return ADBC_STATUS_INTERNAL;
-      }
-
       std::vector<std::string> params;
-      if (db_schema_ != NULL) {
-        if (StringBuilderAppend(&query, "%s", " AND nspname = $1")) {
-          StringBuilderReset(&query);
-          return ADBC_STATUS_INTERNAL;
-        }
-        params.push_back(db_schema_);
-      }
-
-      auto result_helper =
-          PqResultHelper{conn_, std::string(query.buffer), params, error_};
-      StringBuilderReset(&query);
+      std::string query = "SELECT nsp.nspname FROM pg_catalog.pg_namespace AS nsp WHERE ";
+      AppendSchemaFilter(&query, &params);
 
+      auto result_helper = PqResultHelper{conn_, std::move(query), params, error_};
       RAISE_ADBC(result_helper.Prepare());
       RAISE_ADBC(result_helper.Execute());
 
+      // Fetch each deeper level with a single query over all matching schemas
+      // rather than one query per schema and per table
+      if (depth_ != ADBC_OBJECT_DEPTH_DB_SCHEMAS) {
+        RAISE_ADBC(FetchTables());
+        if (depth_ != ADBC_OBJECT_DEPTH_TABLES) {
+          RAISE_ADBC(FetchColumns());
+          RAISE_ADBC(FetchConstraints());
+        }
+      }
+
       for (PqResultRow row : result_helper) {
         const char* schema_name = row[0].data;
         CHECK_NA(INTERNAL,
@@ -209,35 +223,26 @@ class PqGetObjectsHelper {
     return ADBC_STATUS_OK;
   }
 
-  AdbcStatusCode AppendTables(std::string schema_name) {
-    struct StringBuilder query;
-    std::memset(&query, 0, sizeof(query));
-    if (StringBuilderInit(&query, /*initial_size*/ 512)) {
-      return ADBC_STATUS_INTERNAL;
+  // Append the conditions on pg_namespace (aliased nsp) for the schemas to list
+  void AppendSchemaFilter(std::string* query, std::vector<std::string>* params) {
+    *query += "nsp.nspname !~ '^pg_' AND nsp.nspname <> 'information_schema'";
+    if (db_schema_ != nullptr) {
+      params->push_back(db_schema_);
+      *query += " AND nsp.nspname = $" + std::to_string(params->size());
     }
+  }
 
-    std::vector<std::string> params = {schema_name};
-    const char* stmt =
-        "SELECT c.relname, CASE c.relkind WHEN 'r' THEN 'table' WHEN 'v' THEN 'view' "
-        "WHEN 'm' THEN 'materialized view' WHEN 't' THEN 'TOAST table' "
-        "WHEN 'f' THEN 'foreign table' WHEN 'p' THEN 'partitioned table' END "
-        "AS reltype FROM pg_catalog.pg_class c "
-        "LEFT JOIN pg_catalog.pg_namespace n ON n.oid = c.relnamespace "
-        "WHERE c.relkind IN ('r','v','m','t','f','p') "
-        "AND pg_catalog.pg_table_is_visible(c.oid) AND n.nspname = $1";
-
-    if (StringBuilderAppend(&query, "%s", stmt)) {
-      StringBuilderReset(&query);
-      return ADBC_STATUS_INTERNAL;
-    }
+  // Append the conditions on pg_class (aliased cls) and pg_namespace (aliased
+  // nsp) for the tables to list
+  void AppendTableFilter(std::string* query, std::vector<std::string>* params) {
+    *query +=
+        "cls.relkind IN ('r','v','m','t','f','p') "
+        "AND pg_catalog.pg_table_is_visible(cls.oid) AND ";
+    AppendSchemaFilter(query, params);
 
     if (table_name_ != nullptr) {
-      if (StringBuilderAppend(&query, "%s", " AND c.relname LIKE $2")) {
-        StringBuilderReset(&query);
-        return ADBC_STATUS_INTERNAL;
-      }
-
-      params.push_back(std::string(table_name_));
+      params->push_back(table_name_);
+      *query += " AND cls.relname LIKE $" + std::to_string(params->size());
     }
 
     if (table_types_ != nullptr) {
@@ -265,117 +270,67 @@ class PqGetObjectsHelper {
         }
         oss << ")";
 
-        if (StringBuilderAppend(&query, "%s%s", " AND c.relkind IN ",
-                                oss.str().c_str())) {
-          StringBuilderReset(&query);
-          return ADBC_STATUS_INTERNAL;
-        }
+        *query += " AND cls.relkind IN " + oss.str();
       } else {
         // no matching table type means no records should come back
-        if (StringBuilderAppend(&query, "%s", " AND false")) {
-          StringBuilderReset(&query);
-          return ADBC_STATUS_INTERNAL;
-        }
+        *query += " AND false";
       }
     }
+  }
 
-    auto result_helper = PqResultHelper{conn_, query.buffer, params, error_};
-    StringBuilderReset(&query);
+  AdbcStatusCode FetchTables() {
+    std::vector<std::string> params;
+    std::string query =
+        "SELECT nsp.nspname, cls.relname, CASE cls.relkind WHEN 'r' THEN 'table' "
+        "WHEN 'v' THEN 'view' WHEN 'm' THEN 'materialized view' "
+        "WHEN 't' THEN 'TOAST table' WHEN 'f' THEN 'foreign table' "
+        "WHEN 'p' THEN 'partitioned table' END AS reltype "
+        "FROM pg_catalog.pg_class AS cls "
+        "INNER JOIN pg_catalog.pg_namespace AS nsp ON nsp.oid = cls.relnamespace "
+        "WHERE ";
+    AppendTableFilter(&query, &params);
 
+    auto result_helper = PqResultHelper{conn_, std::move(query), params, error_};
     RAISE_ADBC(result_helper.Prepare());
     RAISE_ADBC(result_helper.Execute());
-    for (PqResultRow row : result_helper) {
-      const char* table_name = row[0].data;
-      const char* table_type = row[1].data;
 
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(table_name_col_, ArrowCharView(table_name)),
-               error_);
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(table_type_col_, ArrowCharView(table_type)),
-               error_);
-      if (depth_ == ADBC_OBJECT_DEPTH_TABLES) {
-        CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_columns_col_, 1), error_);
-        CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_constraints_col_, 1), error_);
-      } else {
-        auto table_name_s = std::string(table_name);
-        RAISE_ADBC(AppendColumns(schema_name, table_name_s));
-        RAISE_ADBC(AppendConstraints(schema_name, table_name_s));
-      }
-      CHECK_NA(INTERNAL, ArrowArrayFinishElement(schema_table_items_), error_);
+    tables_.clear();
+    for (PqResultRow row : result_helper) {
+      tables_[row[0].data].push_back(TableRow{row[1].data, row[2].data});
     }
-
-    CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_tables_col_), error_);
     return ADBC_STATUS_OK;
   }
 
-  AdbcStatusCode AppendColumns(std::string schema_name, std::string table_name) {
-    struct StringBuilder query;
-    std::memset(&query, 0, sizeof(query));
-    if (StringBuilderInit(&query, /*initial_size*/ 512)) {
-      return ADBC_STATUS_INTERNAL;
-    }
-
-    std::vector<std::string> params = {schema_name, table_name};
-    const char* stmt =
-        "SELECT attr.attname, attr.attnum, "
+  AdbcStatusCode FetchColumns() {
+    std::vector<std::string> params;
+    std::string query =
+        "SELECT nsp.nspname, cls.relname, attr.attname, attr.attnum, "
         "pg_catalog.col_description(cls.oid, attr.attnum) "
         "FROM pg_catalog.pg_attribute AS attr "
         "INNER JOIN pg_catalog.pg_class AS cls ON attr.attrelid = cls.oid "
         "INNER JOIN pg_catalog.pg_namespace AS nsp ON nsp.oid = cls.relnamespace "
-        "WHERE attr.attnum > 0 AND NOT attr.attisdropped "
-        "AND nsp.nspname LIKE $1 AND cls.relname LIKE $2";
-
-    if (StringBuilderAppend(&query, "%s", stmt)) {
-      StringBuilderReset(&query);
-      return ADBC_STATUS_INTERNAL;
-    }
+        "WHERE attr.attnum > 0 AND NOT attr.attisdropped AND ";
+    AppendTableFilter(&query, &params);
 
     if (column_name_ != NULL) {
-      if (StringBuilderAppend(&query, "%s", " AND attr.attname LIKE $3")) {
-        StringBuilderReset(&query);
-        return ADBC_STATUS_INTERNAL;
-      }
-
-      params.push_back(std::string(column_name_));
+      params.push_back(column_name_);
+      query += " AND attr.attname LIKE $" + std::to_string(params.size());
     }
+    query += " ORDER BY cls.oid, attr.attnum";
 
-    auto result_helper = PqResultHelper{conn_, query.buffer, params, error_};
-    StringBuilderReset(&query);
-
+    auto result_helper = PqResultHelper{conn_, std::move(query), params, error_};
     RAISE_ADBC(result_helper.Prepare());
     RAISE_ADBC(result_helper.Execute());
 
+    columns_.clear();
     for (PqResultRow row : result_helper) {
-      const char* column_name = row[0].data;
-      const char* position = row[1].data;
-
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(column_name_col_, ArrowCharView(column_name)),
-               error_);
-      int ival = atol(position);
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendInt(column_position_col_, static_cast<int64_t>(ival)),
-               error_);
-      if (row[2].is_null) {
-        CHECK_NA(INTERNAL, ArrowArrayAppendNull(column_remarks_col_, 1), error_);
-      } else {
-        const char* remarks = row[2].data;
-        CHECK_NA(INTERNAL,
-                 ArrowArrayAppendString(column_remarks_col_, ArrowCharView(remarks)),
-                 error_);
-      }
-
-      // no xdbc_ values for now
-      for (auto i = 3; i < 19; i++) {
-        CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_columns_items_->children[i], 1),
-                 error_);
-      }
-
-      CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_columns_items_), error_);
+      ColumnRow column;
+      column.name = row[2].data;
+      column.position = std::atol(row[3].data);
+      column.has_remarks = !row[4].is_null;
+      if (column.has_remarks) column.remarks = row[4].data;
+      columns_[TableKey(row[0].data, row[1].data)].push_back(std::move(column));
     }
-
-    CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_columns_col_), error_);
     return ADBC_STATUS_OK;
   }
 
@@ -397,17 +352,22 @@ class PqGetObjectsHelper {
     return elements;
   }
 
-  AdbcStatusCode AppendConstraints(std::string schema_name, std::string table_name) {
-    struct StringBuilder query;
-    std::memset(&query, 0, sizeof(query));
-    if (StringBuilderInit(&query, /*initial_size*/ 4096)) {
-      return ADBC_STATUS_INTERNAL;
-    }
-
-    std::vector<std::string> params = {schema_name, table_name};
-    const char* stmt =
-        "WITH fk_unnest AS ( "
+  AdbcStatusCode FetchConstraints() {
+    std::vector<std::string> params;
+    std::string query =
+        "WITH tbl AS ( "
+        "    SELECT cls.oid, nsp.nspname, cls.relname "
+        "    FROM pg_catalog.pg_class AS cls "
+        "    INNER JOIN pg_catalog.pg_namespace AS nsp ON nsp.oid = cls.relnamespace "
+        "    WHERE ";
+    AppendTableFilter(&query, &params);
+    query +=
+        " "
+        "), "
+        "fk_unnest AS ( "
         "    SELECT "
+        "        tbl.nspname, "
+        "        tbl.relname, "
         "        con.conname, "
         "        'FOREIGN KEY' AS contype, "
         "        conrelid, "
@@ -415,13 +375,13 @@ class PqGetObjectsHelper {
         "        confrelid, "
         "        UNNEST(con.confkey) AS confkey "
         "    FROM pg_catalog.pg_constraint AS con "
-        "    INNER JOIN pg_catalog.pg_class AS cls ON cls.oid = conrelid "
-        "    INNER JOIN pg_catalog.pg_namespace AS nsp ON nsp.oid = cls.relnamespace "
-        "    WHERE con.contype = 'f' AND nsp.nspname LIKE $1 "
-        "    AND cls.relname LIKE $2 "
+        "    INNER JOIN tbl ON tbl.oid = con.conrelid "
+        "    WHERE con.contype = 'f' "
         "), "
         "fk_names AS ( "
         "    SELECT "
+        "        fk_unnest.nspname, "
+        "        fk_unnest.relname, "
         "        fk_unnest.conname, "
         "        fk_unnest.contype, "
         "        fk_unnest.conkey, "
@@ -431,7 +391,6 @@ class PqGetObjectsHelper {
         "        fcls.relname AS ftable, "
         "        fattr.attname AS fattname "
         "    FROM fk_unnest "
-        "    INNER JOIN pg_catalog.pg_class AS cls ON cls.oid = fk_unnest.conrelid "
         "    INNER JOIN pg_catalog.pg_class AS fcls ON fcls.oid = fk_unnest.confrelid "
         "    INNER JOIN pg_catalog.pg_namespace AS fnsp ON fnsp.oid = fcls.relnamespace"
         "    INNER JOIN pg_catalog.pg_attribute AS attr ON attr.attnum = "
@@ -443,6 +402,8 @@ class PqGetObjectsHelper {
         "), "
         "fkeys AS ( "
         "    SELECT "
+        "        nspname, "
+        "        relname, "
         "        conname, "
         "        contype, "
         "        ARRAY_AGG(attname ORDER BY conkey) AS colnames, "
@@ -451,69 +412,128 @@ class PqGetObjectsHelper {
         "        ARRAY_AGG(fattname ORDER BY confkey) AS fcolnames "
         "    FROM fk_names "
         "    GROUP BY "
+        "        nspname, "
+        "        relname, "
         "        conname, "
         "        contype, "
         "        fschema, "
         "        ftable "
         "), "
         "other_constraints AS ( "
-        "    SELECT con.conname, CASE con.contype WHEN 'c' THEN 'CHECK' WHEN 'u' THEN  "
+        "    SELECT tbl.nspname, tbl.relname, con.conname, "
+        "    CASE con.contype WHEN 'c' THEN 'CHECK' WHEN 'u' THEN  "
         "    'UNIQUE' WHEN 'p' THEN 'PRIMARY KEY' END AS contype, "
         "    ARRAY_AGG(attr.attname) AS colnames "
         "    FROM pg_catalog.pg_constraint AS con  "
         "    CROSS JOIN UNNEST(conkey) AS conkeys  "
-        "    INNER JOIN pg_catalog.pg_class AS cls ON cls.oid = con.conrelid  "
-        "    INNER JOIN pg_catalog.pg_namespace AS nsp ON nsp.oid = cls.relnamespace  "
+        "    INNER JOIN tbl ON tbl.oid = con.conrelid  "
         "    INNER JOIN pg_catalog.pg_attribute AS attr ON attr.attnum = conkeys  "
-        "    AND cls.oid = attr.attrelid  "
-        "    WHERE con.contype IN ('c', 'u', 'p') AND nsp.nspname LIKE $1 "
-        "    AND cls.relname LIKE $2 "
-        "    GROUP BY conname, contype "
+        "    AND tbl.oid = attr.attrelid  "
+        "    WHERE con.contype IN ('c', 'u', 'p') "
+        "    GROUP BY tbl.nspname, tbl.relname, con.conname, con.contype "
         ") "
         "SELECT "
-        "    conname, contype, colnames, fschema, ftable, fcolnames "
+        "    nspname, relname, conname, contype, colnames, fschema, ftable, fcolnames "
         "FROM fkeys "
         "UNION ALL "
         "SELECT "
-        "    conname, contype, colnames, NULL, NULL, NULL "
+        "    nspname, relname, conname, contype, colnames, NULL, NULL, NULL "
         "FROM other_constraints";
 
-    if (StringBuilderAppend(&query, "%s", stmt)) {
-      StringBuilderReset(&query);
-      return ADBC_STATUS_INTERNAL;
-    }
-
     if (column_name_ != NULL) {
-      if (StringBuilderAppend(&query, "%s", " WHERE conname LIKE $3")) {
-        StringBuilderReset(&query);
-        return ADBC_STATUS_INTERNAL;
-      }
-
-      params.push_back(std::string(column_name_));
+      params.push_back(column_name_);
+      query += " WHERE conname LIKE $" + std::to_string(params.size());
     }
 
-    auto result_helper = PqResultHelper{conn_, query.buffer, params, error_};
-    StringBuilderReset(&query);
-
+    auto result_helper = PqResultHelper{conn_, std::move(query), params, error_};
     RAISE_ADBC(result_helper.Prepare());
     RAISE_ADBC(result_helper.Execute());
 
+    constraints_.clear();
     for (PqResultRow row : result_helper) {
-      const char* constraint_name = row[0].data;
-      const char* constraint_type = row[1].data;
+      ConstraintRow constraint;
+      constraint.name = row[2].data;
+      constraint.type = row[3].data;
+      constraint.column_names = PqTextArrayToVector(std::string(row[4].data));
+      if (constraint.type == "FOREIGN KEY") {
+        assert(!row[5].is_null);
+        assert(!row[6].is_null);
+        assert(!row[7].is_null);
+        constraint.fk_db_schema = row[5].data;
+        constraint.fk_table = row[6].data;
+        constraint.fk_column_names = PqTextArrayToVector(std::string(row[7].data));
+      }
+      constraints_[TableKey(row[0].data, row[1].data)].push_back(std::move(constraint));
+    }
+    return ADBC_STATUS_OK;
+  }
 
-      CHECK_NA(
-          INTERNAL,
-          ArrowArrayAppendString(constraint_name_col_, ArrowCharView(constraint_name)),
-          error_);
+  AdbcStatusCode AppendTables(const std::string& schema_name) {
+    for (const TableRow& table : tables_[schema_name]) {
+      CHECK_NA(INTERNAL,
+               ArrowArrayAppendString(table_name_col_, ArrowCharView(table.name.c_str())),
+               error_);
+      CHECK_NA(INTERNAL,
+               ArrowArrayAppendString(table_type_col_, ArrowCharView(table.type.c_str())),
+               error_);
+      if (depth_ == ADBC_OBJECT_DEPTH_TABLES) {
+        CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_columns_col_, 1), error_);
+        CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_constraints_col_, 1), error_);
+      } else {
+        const TableKey key(schema_name, table.name);
+        RAISE_ADBC(AppendColumns(key));
+        RAISE_ADBC(AppendConstraints(key));
+      }
+      CHECK_NA(INTERNAL, ArrowArrayFinishElement(schema_table_items_), error_);
+    }
 
+    CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_tables_col_), error_);
+    return ADBC_STATUS_OK;
+  }
+
+  AdbcStatusCode AppendColumns(const TableKey& key) {
+    for (const ColumnRow& column : columns_[key]) {
       CHECK_NA(
           INTERNAL,
-          ArrowArrayAppendString(constraint_type_col_, ArrowCharView(constraint_type)),
+          ArrowArrayAppendString(column_name_col_, ArrowCharView(column.name.c_str())),
           error_);
+      CHECK_NA(INTERNAL, ArrowArrayAppendInt(column_position_col_, column.position),
+               error_);
+      if (!column.has_remarks) {
+        CHECK_NA(INTERNAL, ArrowArrayAppendNull(column_remarks_col_, 1), error_);
+      } else {
+        CHECK_NA(INTERNAL,
+                 ArrowArrayAppendString(column_remarks_col_,
+                                        ArrowCharView(column.remarks.c_str())),
+                 error_);
+      }
+
+      // no xdbc_ values for now
+      for (auto i = 3; i < 19; i++) {
+        CHECK_NA(INTERNAL, ArrowArrayAppendNull(table_columns_items_->children[i], 1),
+                 error_);
+      }
 
-      auto constraint_column_names = PqTextArrayToVector(std::string(row[2].data));
-      for (const auto& constraint_column_name : constraint_column_names) {
+      CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_columns_items_), error_);
+    }
+
+    CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_columns_col_), error_);
+    return ADBC_STATUS_OK;
+  }
+
+  AdbcStatusCode AppendConstraints(const TableKey& key) {
+    for (const ConstraintRow& constraint : constraints_[key]) {
+      CHECK_NA(INTERNAL,
+               ArrowArrayAppendString(constraint_name_col_,
+                                      ArrowCharView(constraint.name.c_str())),
+               error_);
+
+      CHECK_NA(INTERNAL,
+               ArrowArrayAppendString(constraint_type_col_,
+                                      ArrowCharView(constraint.type.c_str())),
+               error_);
+
+      for (const auto& constraint_column_name : constraint.column_names) {
         CHECK_NA(INTERNAL,
                  ArrowArrayAppendString(constraint_column_name_col_,
                                         ArrowCharView(constraint_column_name.c_str())),
@@ -521,34 +541,25 @@ class PqGetObjectsHelper {
       }
       CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_names_col_), error_);
 
-      if (!strcmp(constraint_type, "FOREIGN KEY")) {
-        assert(!row[3].is_null);
-        assert(!row[4].is_null);
-        assert(!row[5].is_null);
+      for (const auto& constraint_fcolumn_name : constraint.fk_column_names) {
+        CHECK_NA(INTERNAL,
+                 ArrowArrayAppendString(fk_catalog_col_, ArrowCharView(PQdb(conn_))),
+                 error_);
+        CHECK_NA(INTERNAL,
+                 ArrowArrayAppendString(fk_db_schema_col_,
+                                        ArrowCharView(constraint.fk_db_schema.c_str())),
+                 error_);
+        CHECK_NA(INTERNAL,
+                 ArrowArrayAppendString(fk_table_col_,
+                                        ArrowCharView(constraint.fk_table.c_str())),
+                 error_);
+        CHECK_NA(INTERNAL,
+                 ArrowArrayAppendString(fk_column_name_col_,
+                                        ArrowCharView(constraint_fcolumn_name.c_str())),
+                 error_);
 
-        const char* constraint_ftable_schema = row[3].data;
-        const char* constraint_ftable_name = row[4].data;
-        auto constraint_fcolumn_names = PqTextArrayToVector(std::string(row[5].data));
-        for (const auto& constraint_fcolumn_name : constraint_fcolumn_names) {
-          CHECK_NA(INTERNAL,
-                   ArrowArrayAppendString(fk_catalog_col_, ArrowCharView(PQdb(conn_))),
-                   error_);
-          CHECK_NA(INTERNAL,
-                   ArrowArrayAppendString(fk_db_schema_col_,
-                                          ArrowCharView(constraint_ftable_schema)),
-                   error_);
-          CHECK_NA(INTERNAL,
-                   ArrowArrayAppendString(fk_table_col_,
-                                          ArrowCharView(constraint_ftable_name)),
-                   error_);
-          CHECK_NA(INTERNAL,
-                   ArrowArrayAppendString(fk_column_name_col_,
-                                          ArrowCharView(constraint_fcolumn_name.c_str())),
-                   error_);
-
-          CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_usage_items_),
-                   error_);
-        }
+        CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_usage_items_),
+                 error_);
       }
       CHECK_NA(INTERNAL, ArrowArrayFinishElement(constraint_column_usages_col_), error_);
       CHECK_NA(INTERNAL, ArrowArrayFinishElement(table_constraints_items_), error_);
@@ -576,6 +587,10 @@ class PqGetObjectsHelper {
   struct ArrowArray* array_;
   struct AdbcError* error_;
   struct ArrowError na_error_;
+  // The rows below the schema level, keyed by their parent
+  std::unordered_map<std::string, std::vector<TableRow>> tables_;
+  std::map<TableKey, std::vector<ColumnRow>> columns_;
+  std::map<TableKey, std::vector<ConstraintRow>> constraints_;
   struct ArrowArray* catalog_name_col_;
   struct ArrowArray* catalog_db_schemas_col_;
   struct ArrowArray* catalog_db_schemas_items_;
@@ -765,6 +780,9 @@ AdbcStatusCode PostgresConnection::GetOption(const char* option, char* value,
     output = (*it)[0].data;
   } else if (std::strcmp(option, ADBC_CONNECTION_OPTION_AUTOCOMMIT) == 0) {
     output = autocommit_ ? ADBC_OPTION_VALUE_ENABLED : ADBC_OPTION_VALUE_DISABLED;
+  } else if (std::strcmp(option, ADBC_POSTGRESQL_OPTION_STATISTICS_ROW_COUNT_ONLY) == 0) {
+    output = statistics_row_count_only_ ? ADBC_OPTION_VALUE_ENABLED
+                                        : ADBC_OPTION_VALUE_DISABLED;
   } else {
     return ADBC_STATUS_NOT_FOUND;
   }
@@ -789,271 +807,158 @@ AdbcStatusCode PostgresConnection::GetOptionDouble(const char* option, double* v
   return ADBC_STATUS_NOT_FOUND;
 }
 
-AdbcStatusCode PostgresConnectionGetStatisticsImpl(PGconn* conn, const char* db_schema,
-                                                   const char* table_name,
-                                                   struct ArrowSchema* schema,
-                                                   struct ArrowArray* array,
-                                                   struct AdbcError* error) {
-  // Set up schema
-  auto uschema = nanoarrow::UniqueSchema();
-  {
-    ArrowSchemaInit(uschema.get());
-    CHECK_NA(INTERNAL, ArrowSchemaSetTypeStruct(uschema.get(), /*num_columns=*/2), error);
-    CHECK_NA(INTERNAL, ArrowSchemaSetType(uschema->children[0], NANOARROW_TYPE_STRING),
-             error);
-    CHECK_NA(INTERNAL, ArrowSchemaSetName(uschema->children[0], "catalog_name"), error);
-    CHECK_NA(INTERNAL, ArrowSchemaSetType(uschema->children[1], NANOARROW_TYPE_LIST),
-             error);
-    CHECK_NA(INTERNAL, ArrowSchemaSetName(uschema->children[1], "catalog_db_schemas"),
-             error);
-    CHECK_NA(INTERNAL, ArrowSchemaSetTypeStruct(uschema->children[1]->children[0], 2),
-             error);
-    uschema->children[1]->flags &= ~ARROW_FLAG_NULLABLE;
-
-    struct ArrowSchema* db_schema_schema = uschema->children[1]->children[0];
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetType(db_schema_schema->children[0], NANOARROW_TYPE_STRING),
-             error);
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetName(db_schema_schema->children[0], "db_schema_name"), error);
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetType(db_schema_schema->children[1], NANOARROW_TYPE_LIST),
-             error);
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetName(db_schema_schema->children[1], "db_schema_statistics"),
-             error);
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetTypeStruct(db_schema_schema->children[1]->children[0], 5),
-             error);
-    db_schema_schema->children[1]->flags &= ~ARROW_FLAG_NULLABLE;
-
-    struct ArrowSchema* statistics_schema = db_schema_schema->children[1]->children[0];
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetType(statistics_schema->children[0], NANOARROW_TYPE_STRING),
-             error);
-    CHECK_NA(INTERNAL, ArrowSchemaSetName(statistics_schema->children[0], "table_name"),
-             error);
-    statistics_schema->children[0]->flags &= ~ARROW_FLAG_NULLABLE;
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetType(statistics_schema->children[1], NANOARROW_TYPE_STRING),
-             error);
-    CHECK_NA(INTERNAL, ArrowSchemaSetName(statistics_schema->children[1], "column_name"),
-             error);
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetType(statistics_schema->children[2], NANOARROW_TYPE_INT16),
-             error);
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetName(statistics_schema->children[2], "statistic_key"), error);
-    statistics_schema->children[2]->flags &= ~ARROW_FLAG_NULLABLE;
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetTypeUnion(statistics_schema->children[3],
-                                     NANOARROW_TYPE_DENSE_UNION, 4),
-             error);
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetName(statistics_schema->children[3], "statistic_value"),
-             error);
-    statistics_schema->children[3]->flags &= ~ARROW_FLAG_NULLABLE;
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetType(statistics_schema->children[4], NANOARROW_TYPE_BOOL),
-             error);
-    CHECK_NA(
-        INTERNAL,
-        ArrowSchemaSetName(statistics_schema->children[4], "statistic_is_approximate"),
-        error);
-    statistics_schema->children[4]->flags &= ~ARROW_FLAG_NULLABLE;
-
-    struct ArrowSchema* value_schema = statistics_schema->children[3];
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetType(value_schema->children[0], NANOARROW_TYPE_INT64), error);
-    CHECK_NA(INTERNAL, ArrowSchemaSetName(value_schema->children[0], "int64"), error);
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetType(value_schema->children[1], NANOARROW_TYPE_UINT64), error);
-    CHECK_NA(INTERNAL, ArrowSchemaSetName(value_schema->children[1], "uint64"), error);
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetType(value_schema->children[2], NANOARROW_TYPE_DOUBLE), error);
-    CHECK_NA(INTERNAL, ArrowSchemaSetName(value_schema->children[2], "float64"), error);
-    CHECK_NA(INTERNAL,
-             ArrowSchemaSetType(value_schema->children[3], NANOARROW_TYPE_BINARY), error);
-    CHECK_NA(INTERNAL, ArrowSchemaSetName(value_schema->children[3], "binary"), error);
+namespace {
+// Identifies the analyze/vacuum state of the tables in a schema, which is
+// what determines the contents of pg_stats and pg_class.reltuples
+AdbcStatusCode QueryStatisticsVersion(PGconn* conn, const char* db_schema,
+                                      std::string* out, struct AdbcError* error) {
+  PqResultHelper result_helper{
+      conn,
+      "SELECT COUNT(*), MAX(GREATEST(last_analyze, last_autoanalyze, last_vacuum, "
+      "last_autovacuum)) FROM pg_catalog.pg_stat_user_tables WHERE schemaname = $1",
+      {db_schema},
+      error};
+  RAISE_ADBC(result_helper.Prepare());
+  RAISE_ADBC(result_helper.Execute());
+  auto it = result_helper.begin();
+  if (it == result_helper.end()) {
+    SetError(error, "[libpq] PostgreSQL returned no rows for statistics version");
+    return ADBC_STATUS_INTERNAL;
   }
+  PqResultRow row = *it;
+  *out = std::string(row[0].data) + "/" + (row[1].is_null ? "" : row[1].data);
+  return ADBC_STATUS_OK;
+}
 
-  // Set up builders
-  struct ArrowError na_error = {0};
-  CHECK_NA_DETAIL(INTERNAL, ArrowArrayInitFromSchema(array, uschema.get(), &na_error),
-                  &na_error, error);
-  CHECK_NA(INTERNAL, ArrowArrayStartAppending(array), error);
-
-  struct ArrowArray* catalog_name_col = array->children[0];
-  struct ArrowArray* catalog_db_schemas_col = array->children[1];
-  struct ArrowArray* catalog_db_schemas_items = catalog_db_schemas_col->children[0];
-  struct ArrowArray* db_schema_name_col = catalog_db_schemas_items->children[0];
-  struct ArrowArray* db_schema_statistics_col = catalog_db_schemas_items->children[1];
-  struct ArrowArray* db_schema_statistics_items = db_schema_statistics_col->children[0];
-  struct ArrowArray* statistics_table_name_col = db_schema_statistics_items->children[0];
-  struct ArrowArray* statistics_column_name_col = db_schema_statistics_items->children[1];
-  struct ArrowArray* statistics_key_col = db_schema_statistics_items->children[2];
-  struct ArrowArray* statistics_value_col = db_schema_statistics_items->children[3];
-  struct ArrowArray* statistics_is_approximate_col =
-      db_schema_statistics_items->children[4];
-  // struct ArrowArray* value_int64_col = statistics_value_col->children[0];
-  // struct ArrowArray* value_uint64_col = statistics_value_col->children[1];
-  struct ArrowArray* value_float64_col = statistics_value_col->children[2];
-  // struct ArrowArray* value_binary_col = statistics_value_col->children[3];
-
-  // Query (could probably be massively improved)
-  std::string query = R"(
+AdbcStatusCode ReadStatistics(PGconn* conn, const char* db_schema,
+                              const char* table_name, bool row_count_only,
+                              PostgresSchemaStatistics* out, struct AdbcError* error) {
+  std::string query;
+  if (row_count_only) {
+    query =
+        "SELECT cls.relname, cls.reltuples FROM pg_catalog.pg_class AS cls "
+        "INNER JOIN pg_catalog.pg_namespace AS nsp ON nsp.oid = cls.relnamespace "
+        "WHERE nsp.nspname = $1 AND cls.relkind IN ('r', 'm', 'f', 'p') "
+        "AND cls.reltuples >= 0";
+  } else {
+    query = R"(
     WITH
       class AS (
         SELECT nspname, relname, reltuples
         FROM pg_namespace
         INNER JOIN pg_class ON pg_class.relnamespace = pg_namespace.oid
       )
-    SELECT tablename, attname, null_frac, avg_width, n_distinct, reltuples
+    SELECT tablename, reltuples, attname, null_frac, avg_width, n_distinct
     FROM pg_stats
     INNER JOIN class ON pg_stats.schemaname = class.nspname AND pg_stats.tablename = class.relname
-    WHERE pg_stats.schemaname = $1 AND tablename LIKE $2
-    ORDER BY tablename
-)";
-
-  CHECK_NA(INTERNAL, ArrowArrayAppendString(catalog_name_col, ArrowCharView(PQdb(conn))),
-           error);
-  CHECK_NA(INTERNAL, ArrowArrayAppendString(db_schema_name_col, ArrowCharView(db_schema)),
-           error);
-
-  constexpr int8_t kStatsVariantFloat64 = 2;
+    WHERE pg_stats.schemaname = $1)";
+  }
 
-  std::string prev_table;
+  // Avoid a LIKE scan for the common case of a single table
+  std::vector<std::string> params = {db_schema};
+  std::string literal_name;
+  if (table_name != nullptr) {
+    const char* table_column = row_count_only ? "cls.relname" : "tablename";
+    if (SqlLikeToLiteral(table_name, &literal_name)) {
+      query += std::string(" AND ") + table_column + " = $2";
+      params.push_back(literal_name);
+    } else {
+      query += std::string(" AND ") + table_column + " LIKE $2";
+      params.push_back(table_name);
+    }
+  }
+  query += " ORDER BY 1";
 
-  {
-    PqResultHelper result_helper{
-        conn, query, {db_schema, table_name ? table_name : "%"}, error};
-    RAISE_ADBC(result_helper.Prepare());
-    RAISE_ADBC(result_helper.Execute());
+  PqResultHelper result_helper{conn, std::move(query), std::move(params), error};
+  RAISE_ADBC(result_helper.Prepare());
+  RAISE_ADBC(result_helper.Execute());
 
-    for (PqResultRow row : result_helper) {
-      auto reltuples = row[5].ParseDouble();
+  out->has_columns = !row_count_only;
+  PostgresTableStatistics* table = nullptr;
+  for (PqResultRow row : result_helper) {
+    if (table == nullptr || table->table_name != row[0].data) {
+      auto reltuples = row[1].ParseDouble();
       if (!reltuples.first) {
-        SetError(error, "[libpq] Invalid double value in reltuples: '%s'", row[5].data);
+        SetError(error, "[libpq] Invalid double value in reltuples: '%s'", row[1].data);
         return ADBC_STATUS_INTERNAL;
       }
+      table = out->AddTable(std::string(row[0].data, row[0].len));
+      table->reltuples = reltuples.second;
+    }
+    if (row_count_only) continue;
 
-      if (std::strcmp(prev_table.c_str(), row[0].data) != 0) {
-        CHECK_NA(INTERNAL,
-                 ArrowArrayAppendString(statistics_table_name_col,
-                                        ArrowStringView{row[0].data, row[0].len}),
-                 error);
-        CHECK_NA(INTERNAL, ArrowArrayAppendNull(statistics_column_name_col, 1), error);
-        CHECK_NA(INTERNAL,
-                 ArrowArrayAppendInt(statistics_key_col, ADBC_STATISTIC_ROW_COUNT_KEY),
-                 error);
-        CHECK_NA(INTERNAL, ArrowArrayAppendDouble(value_float64_col, reltuples.second),
-                 error);
-        CHECK_NA(INTERNAL,
-                 ArrowArrayFinishUnionElement(statistics_value_col, kStatsVariantFloat64),
-                 error);
-        CHECK_NA(INTERNAL, ArrowArrayAppendInt(statistics_is_approximate_col, 1), error);
-        CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_statistics_items), error);
-        prev_table = std::string(row[0].data, row[0].len);
-      }
-
-      auto null_frac = row[2].ParseDouble();
-      if (!null_frac.first) {
-        SetError(error, "[libpq] Invalid double value in null_frac: '%s'", row[2].data);
-        return ADBC_STATUS_INTERNAL;
-      }
+    PostgresTableStatistics::Column column;
+    column.name = std::string(row[2].data, row[2].len);
 
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(statistics_table_name_col,
-                                      ArrowStringView{row[0].data, row[0].len}),
-               error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(statistics_column_name_col,
-                                      ArrowStringView{row[1].data, row[1].len}),
-               error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendInt(statistics_key_col, ADBC_STATISTIC_NULL_COUNT_KEY),
-               error);
-      CHECK_NA(
-          INTERNAL,
-          ArrowArrayAppendDouble(value_float64_col, null_frac.second * reltuples.second),
-          error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayFinishUnionElement(statistics_value_col, kStatsVariantFloat64),
-               error);
-      CHECK_NA(INTERNAL, ArrowArrayAppendInt(statistics_is_approximate_col, 1), error);
-      CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_statistics_items), error);
-
-      auto average_byte_width = row[3].ParseDouble();
-      if (!average_byte_width.first) {
-        SetError(error, "[libpq] Invalid double value in avg_width: '%s'", row[3].data);
-        return ADBC_STATUS_INTERNAL;
-      }
+    auto null_frac = row[3].ParseDouble();
+    if (!null_frac.first) {
+      SetError(error, "[libpq] Invalid double value in null_frac: '%s'", row[3].data);
+      return ADBC_STATUS_INTERNAL;
+    }
+    column.null_frac = null_frac.second;
 
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(statistics_table_name_col,
-                                      ArrowStringView{row[0].data, row[0].len}),
-               error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(statistics_column_name_col,
-                                      ArrowStringView{row[1].data, row[1].len}),
-               error);
-      CHECK_NA(
-          INTERNAL,
-          ArrowArrayAppendInt(statistics_key_col, ADBC_STATISTIC_AVERAGE_BYTE_WIDTH_KEY),
-          error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendDouble(value_float64_col, average_byte_width.second),
-               error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayFinishUnionElement(statistics_value_col, kStatsVariantFloat64),
-               error);
-      CHECK_NA(INTERNAL, ArrowArrayAppendInt(statistics_is_approximate_col, 1), error);
-      CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_statistics_items), error);
-
-      auto n_distinct = row[4].ParseDouble();
-      if (!n_distinct.first) {
-        SetError(error, "[libpq] Invalid double value in avg_width: '%s'", row[4].data);
-        return ADBC_STATUS_INTERNAL;
-      }
+    auto average_byte_width = row[4].ParseDouble();
+    if (!average_byte_width.first) {
+      SetError(error, "[libpq] Invalid double value in avg_width: '%s'", row[4].data);
+      return ADBC_STATUS_INTERNAL;
+    }
+    column.avg_width = average_byte_width.second;
 
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(statistics_table_name_col,
-                                      ArrowStringView{row[0].data, row[0].len}),
-               error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendString(statistics_column_name_col,
-                                      ArrowStringView{row[1].data, row[1].len}),
-               error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayAppendInt(statistics_key_col, ADBC_STATISTIC_DISTINCT_COUNT_KEY),
-               error);
-      // > If greater than zero, the estimated number of distinct values in
-      // > the column. If less than zero, the negative of the number of
-      // > distinct values divided by the number of rows.
-      // https://www.postgresql.org/docs/current/view-pg-stats.html
-      CHECK_NA(
-          INTERNAL,
-          ArrowArrayAppendDouble(value_float64_col,
-                                 n_distinct.second > 0
-                                     ? n_distinct.second
-                                     : (std::fabs(n_distinct.second) * reltuples.second)),
-          error);
-      CHECK_NA(INTERNAL,
-               ArrowArrayFinishUnionElement(statistics_value_col, kStatsVariantFloat64),
-               error);
-      CHECK_NA(INTERNAL, ArrowArrayAppendInt(statistics_is_approximate_col, 1), error);
-      CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_statistics_items), error);
+    auto n_distinct = row[5].ParseDouble();
+    if (!n_distinct.first) {
+      SetError(error, "[libpq] Invalid double value in n_distinct: '%s'", row[5].data);
+      return ADBC_STATUS_INTERNAL;
     }
+    column.n_distinct = n_distinct.second;
+
+    table->columns.push_back(std::move(column));
   }
+  return ADBC_STATUS_OK;
+}
+}  // namespace
 
-  CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_statistics_col), error);
-  CHECK_NA(INTERNAL, ArrowArrayFinishElement(catalog_db_schemas_items), error);
-  CHECK_NA(INTERNAL, ArrowArrayFinishElement(catalog_db_schemas_col), error);
-  CHECK_NA(INTERNAL, ArrowArrayFinishElement(array), error);
+AdbcStatusCode PostgresConnection::GetSchemaStatistics(
+    const char* db_schema, const char* table_name,
+    std::shared_ptr<const PostgresSchemaStatistics>* out, struct AdbcError* error) {
+  const double ttl = database_->statistics_cache_ttl();
+  if (ttl <= 0) {
+    auto statistics = std::make_shared<PostgresSchemaStatistics>();
+    RAISE_ADBC(ReadStatistics(conn_, db_schema, table_name, statistics_row_count_only_,
+                              statistics.get(), error));
+    *out = std::move(statistics);
+    return ADBC_STATUS_OK;
+  }
 
-  CHECK_NA_DETAIL(INTERNAL, ArrowArrayFinishBuildingDefault(array, &na_error), &na_error,
-                  error);
-  uschema.move(schema);
+  // Cached statistics are used as-is until the TTL expires, then revalidated
+  // with one query; an entry with column statistics can also serve row counts
+  PostgresStatisticsCache* cache = database_->statistics_cache();
+  const auto now = PostgresStatisticsCache::Clock::now();
+  PostgresStatisticsCache::Entry entry;
+  if (cache->Get(db_schema, &entry) &&
+      (entry.statistics->has_columns || statistics_row_count_only_)) {
+    if (std::chrono::duration<double>(now - entry.validated_at).count() < ttl) {
+      *out = entry.statistics;
+      return ADBC_STATUS_OK;
+    }
+
+    std::string version;
+    RAISE_ADBC(QueryStatisticsVersion(conn_, db_schema, &version, error));
+    if (version == entry.statistics->version) {
+      entry.validated_at = now;
+      cache->Put(db_schema, entry);
+      *out = entry.statistics;
+      return ADBC_STATUS_OK;
+    }
+  }
+
+  // Read the version first, so that an ANALYZE running concurrently with the
+  // read below invalidates the entry rather than leaving it stale
+  auto statistics = std::make_shared<PostgresSchemaStatistics>();
+  RAISE_ADBC(QueryStatisticsVersion(conn_, db_schema, &statistics->version, error));
+  RAISE_ADBC(ReadStatistics(conn_, db_schema, /*table_name=*/nullptr,
+                            statistics_row_count_only_, statistics.get(), error));
+  cache->Put(db_schema, {statistics, now});
+  *out = std::move(statistics);
   return ADBC_STATUS_OK;
 }
 
@@ -1079,8 +984,11 @@ AdbcStatusCode PostgresConnection::GetStatistics(const char* catalog,
   struct ArrowArray array;
   std::memset(&array, 0, sizeof(array));
 
-  AdbcStatusCode status = PostgresConnectionGetStatisticsImpl(
-      conn_, db_schema, table_name, &schema, &array, error);
+  std::shared_ptr<const PostgresSchemaStatistics> statistics;
+  RAISE_ADBC(GetSchemaStatistics(db_schema, table_name, &statistics, error));
+  AdbcStatusCode status =
+      MakeStatisticsArray(PQdb(conn_), db_schema, *statistics, table_name,
+                          statistics_row_count_only_, &schema, &array, error);
   if (status != ADBC_STATUS_OK) {
     if (schema.release) schema.release(&schema);
     if (array.release) array.release(&array);
@@ -1353,6 +1261,16 @@ AdbcStatusCode PostgresConnection::SetOption(const char* key, const char* value,
     RAISE_ADBC(result_helper.Prepare());
     RAISE_ADBC(result_helper.Execute());
     return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_STATISTICS_ROW_COUNT_ONLY) == 0) {
+    if (std::strcmp(value, ADBC_OPTION_VALUE_ENABLED) == 0) {
+      statistics_row_count_only_ = true;
+    } else if (std::strcmp(value, ADBC_OPTION_VALUE_DISABLED) == 0) {
+      statistics_row_count_only_ = false;
+    } else {
+      SetError(error, "%s%s%s%s", "[libpq] Invalid value for option ", key, ": ", value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    return ADBC_STATUS_OK;
   }
   SetError(error, "%s%s", "[libpq] Unknown option ", key);
   return ADBC_STATUS_NOT_IMPLEMENTED;
@@ -25,12 +25,23 @@
 
 #include "postgres_type.h"
 
+/// \brief Whether AdbcConnectionGetStatistics returns only table row counts
+///   (from pg_class.reltuples) instead of also reading column statistics
+///   from pg_stats.
+#define ADBC_POSTGRESQL_OPTION_STATISTICS_ROW_COUNT_ONLY \
+  "adbc.postgresql.statistics_row_count_only"
+
 namespace adbcpq {
 class PostgresDatabase;
+struct PostgresSchemaStatistics;
 class PostgresConnection {
  public:
   PostgresConnection()
-      : database_(nullptr), conn_(nullptr), cancel_(nullptr), autocommit_(true) {}
+      : database_(nullptr),
+        conn_(nullptr),
+        cancel_(nullptr),
+        autocommit_(true),
+        statistics_row_count_only_(false) {}
 
   AdbcStatusCode Cancel(struct AdbcError* error);
   AdbcStatusCode Commit(struct AdbcError* error);
@@ -73,6 +84,7 @@ class PostgresConnection {
     return type_resolver_;
   }
   bool autocommit() const { return autocommit_; }
+  const std::shared_ptr<PostgresDatabase>& database() const { return database_; }
 
  private:
   AdbcStatusCode PostgresConnectionGetInfoImpl(const uint32_t* info_codes,
@@ -80,10 +92,14 @@ class PostgresConnection {
                                                struct ArrowSchema* schema,
                                                struct ArrowArray* array,
                                                struct AdbcError* error);
+  AdbcStatusCode GetSchemaStatistics(const char* db_schema, const char* table_name,
+                                     std::shared_ptr<const PostgresSchemaStatistics>* out,
+                                     struct AdbcError* error);
   std::shared_ptr<PostgresDatabase> database_;
   std::shared_ptr<PostgresTypeResolver> type_resolver_;
   PGconn* conn_;
   PGcancel* cancel_;
   bool autocommit_;
+  bool statistics_row_count_only_;
 };
 }  // namespace adbcpq
@@ -17,9 +17,12 @@
 
 #include "database.h"
 
+#include <cerrno>
 #include <cinttypes>
+#include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -28,17 +31,34 @@
 #include <nanoarrow/nanoarrow.h>
 
 #include "common/utils.h"
+#include "type_cache.h"
 
 namespace adbcpq {
 
-PostgresDatabase::PostgresDatabase() : open_connections_(0) {
+PostgresDatabase::PostgresDatabase()
+    : open_connections_(0), lazy_type_resolver_(false), statistics_cache_ttl_(0) {
   type_resolver_ = std::make_shared<PostgresTypeResolver>();
 }
 PostgresDatabase::~PostgresDatabase() = default;
 
 AdbcStatusCode PostgresDatabase::GetOption(const char* option, char* value,
                                            size_t* length, struct AdbcError* error) {
-  return ADBC_STATUS_NOT_FOUND;
+  std::string result;
+  if (std::strcmp(option, ADBC_POSTGRESQL_OPTION_TYPE_RESOLVER) == 0) {
+    result = lazy_type_resolver_ ? "lazy" : "eager";
+  } else if (std::strcmp(option, ADBC_POSTGRESQL_OPTION_TYPE_CACHE_PATH) == 0) {
+    result = type_cache_path_;
+  } else if (std::strcmp(option, ADBC_POSTGRESQL_OPTION_STATISTICS_CACHE_TTL) == 0) {
+    result = std::to_string(statistics_cache_ttl_);
+  } else {
+    return ADBC_STATUS_NOT_FOUND;
+  }
+
+  if (result.size() + 1 <= *length) {
+    std::memcpy(value, result.data(), result.size() + 1);
+  }
+  *length = result.size() + 1;
+  return ADBC_STATUS_OK;
 }
 AdbcStatusCode PostgresDatabase::GetOptionBytes(const char* option, uint8_t* value,
                                                 size_t* length, struct AdbcError* error) {
@@ -50,6 +70,10 @@ AdbcStatusCode PostgresDatabase::GetOptionInt(const char* option, int64_t* value
 }
 AdbcStatusCode PostgresDatabase::GetOptionDouble(const char* option, double* value,
                                                  struct AdbcError* error) {
+  if (std::strcmp(option, ADBC_POSTGRESQL_OPTION_STATISTICS_CACHE_TTL) == 0) {
+    *value = statistics_cache_ttl_;
+    return ADBC_STATUS_OK;
+  }
   return ADBC_STATUS_NOT_FOUND;
 }
 
@@ -71,6 +95,28 @@ AdbcStatusCode PostgresDatabase::SetOption(const char* key, const char* value,
                                            struct AdbcError* error) {
   if (strcmp(key, "uri") == 0) {
     uri_ = value;
+  } else if (strcmp(key, ADBC_POSTGRESQL_OPTION_TYPE_RESOLVER) == 0) {
+    if (strcmp(value, "eager") == 0) {
+      lazy_type_resolver_ = false;
+    } else if (strcmp(value, "lazy") == 0) {
+      lazy_type_resolver_ = true;
+    } else {
+      SetError(error, "%s%s%s%s", "[libpq] Invalid value '", value,
+               "' for database option ", key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+  } else if (strcmp(key, ADBC_POSTGRESQL_OPTION_TYPE_CACHE_PATH) == 0) {
+    type_cache_path_ = value;
+  } else if (strcmp(key, ADBC_POSTGRESQL_OPTION_STATISTICS_CACHE_TTL) == 0) {
+    char* end = nullptr;
+    errno = 0;
+    double ttl = std::strtod(value, &end);
+    if (errno != 0 || end == value || *end != '\0') {
+      SetError(error, "%s%s%s%s", "[libpq] Invalid value '", value,
+               "' for database option ", key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    return SetOptionDouble(key, ttl, error);
   } else {
     SetError(error, "%s%s", "[libpq] Unknown database option ", key);
     return ADBC_STATUS_NOT_IMPLEMENTED;
@@ -86,12 +132,25 @@ AdbcStatusCode PostgresDatabase::SetOptionBytes(const char* key, const uint8_t*
 
 AdbcStatusCode PostgresDatabase::SetOptionDouble(const char* key, double value,
                                                  struct AdbcError* error) {
+  if (strcmp(key, ADBC_POSTGRESQL_OPTION_STATISTICS_CACHE_TTL) == 0) {
+    if (!(value >= 0)) {
+      SetError(error, "%s%f%s%s", "[libpq] Invalid value '", value,
+               "' for database option ", key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    statistics_cache_ttl_ = value;
+    statistics_cache_.Clear();
+    return ADBC_STATUS_OK;
+  }
   SetError(error, "%s%s", "[libpq] Unknown option ", key);
   return ADBC_STATUS_NOT_IMPLEMENTED;
 }
 
 AdbcStatusCode PostgresDatabase::SetOptionInt(const char* key, int64_t value,
                                               struct AdbcError* error) {
+  if (strcmp(key, ADBC_POSTGRESQL_OPTION_STATISTICS_CACHE_TTL) == 0) {
+    return SetOptionDouble(key, static_cast<double>(value), error);
+  }
   SetError(error, "%s%s", "[libpq] Unknown option ", key);
   return ADBC_STATUS_NOT_IMPLEMENTED;
 }
@@ -124,11 +183,130 @@ AdbcStatusCode PostgresDatabase::Disconnect(PGconn** conn, struct AdbcError* err
 }
 
 // Helpers for building the type resolver from queries
-static inline int32_t InsertPgAttributeResult(
-    PGresult* result, const std::shared_ptr<PostgresTypeResolver>& resolver);
+static inline void AppendPgAttributeResult(PGresult* result,
+                                           std::vector<PostgresClassRow>* out);
+
+static inline void AppendPgTypeResult(PGresult* result,
+                                      std::vector<PostgresTypeRow>* out);
+
+namespace {
+/// Looks up single types and relations for a lazily-populated type resolver.
+/// A dedicated connection is opened on the first miss and kept for the
+/// lifetime of the resolver (it is reopened if it goes bad), so that a
+/// query touching many unknown types does not pay for a connection each.
+class PostgresTypeLoader : public PostgresTypeResolver::Loader {
+ public:
+  explicit PostgresTypeLoader(std::string uri) : uri_(std::move(uri)) {}
+
+  ~PostgresTypeLoader() override {
+    if (conn_ != nullptr) PQfinish(conn_);
+  }
+
+  ArrowErrorCode LoadType(uint32_t oid, PostgresTypeResolver* resolver,
+                          ArrowError* error) override {
+    static const char* kTypeQuery = R"(
+SELECT
+    oid,
+    typname,
+    typreceive,
+    typbasetype,
+    typarray,
+    typrelid,
+    typelem
+FROM
+    pg_catalog.pg_type
+WHERE
+    oid = $1
+)";
+
+    NANOARROW_RETURN_NOT_OK(Acquire(error));
+    PGresult* result = nullptr;
+    int status = Query(kTypeQuery, oid, &result, error);
+    if (status == NANOARROW_OK) {
+      std::vector<PostgresTypeRow> rows;
+      AppendPgTypeResult(result, &rows);
+      if (rows.size() == 1) {
+        status = rows[0].Insert(resolver, error);
+      } else {
+        ArrowErrorSet(error, "Postgres type with oid %ld not found",
+                      static_cast<long>(oid));  // NOLINT(runtime/int)
+        status = ENOENT;
+      }
+    }
+    PQclear(result);
+    return status;
+  }
+
+  ArrowErrorCode LoadClass(uint32_t oid, PostgresTypeResolver* resolver,
+                           ArrowError* error) override {
+    static const char* kColumnsQuery = R"(
+SELECT
+    attrelid,
+    attname,
+    atttypid
+FROM
+    pg_catalog.pg_attribute
+WHERE
+    attrelid = $1 AND attnum > 0 AND NOT attisdropped
+ORDER BY
+    attnum
+)";
+
+    NANOARROW_RETURN_NOT_OK(Acquire(error));
+    PGresult* result = nullptr;
+    int status = Query(kColumnsQuery, oid, &result, error);
+    if (status == NANOARROW_OK) {
+      std::vector<PostgresClassRow> rows;
+      AppendPgAttributeResult(result, &rows);
+      if (rows.empty()) {
+        ArrowErrorSet(error, "Class definition with oid %ld not found",
+                      static_cast<long>(oid));  // NOLINT(runtime/int)
+        status = ENOENT;
+      }
+      for (const auto& cls : rows) {
+        resolver->InsertClass(cls.oid, cls.columns);
+      }
+    }
+    PQclear(result);
+    return status;
+  }
+
+ private:
+  std::string uri_;
+  PGconn* conn_ = nullptr;
+
+  ArrowErrorCode Acquire(ArrowError* error) {
+    if (conn_ != nullptr && PQstatus(conn_) == CONNECTION_OK) return NANOARROW_OK;
+
+    if (conn_ != nullptr) PQfinish(conn_);
+    conn_ = PQconnectdb(uri_.c_str());
+    if (PQstatus(conn_) != CONNECTION_OK) {
+      ArrowErrorSet(error, "[libpq] Failed to connect to load types: %s",
+                    PQerrorMessage(conn_));
+      PQfinish(conn_);
+      conn_ = nullptr;
+      return EIO;
+    }
+    return NANOARROW_OK;
+  }
 
-static inline int32_t InsertPgTypeResult(
-    PGresult* result, const std::shared_ptr<PostgresTypeResolver>& resolver);
+  ArrowErrorCode Query(const char* query, uint32_t oid, PGresult** result,
+                       ArrowError* error) {
+    const std::string param = std::to_string(oid);
+    const char* param_values[] = {param.c_str()};
+    *result = PQexecParams(conn_, query, /*nParams=*/1, /*paramTypes=*/nullptr,
+                           param_values, /*paramLengths=*/nullptr,
+                           /*paramFormats=*/nullptr, /*resultFormat=*/0);
+    if (PQresultStatus(*result) != PGRES_TUPLES_OK) {
+      ArrowErrorSet(error, "[libpq] Failed to load type information for oid %ld: %s",
+                    static_cast<long>(oid),  // NOLINT(runtime/int)
+                    PQerrorMessage(conn_));
+      return EIO;
+    }
+    return NANOARROW_OK;
+  }
+};
+}  // namespace
 
 AdbcStatusCode PostgresDatabase::RebuildTypeResolver(struct AdbcError* error) {
   PGconn* conn = nullptr;
@@ -137,6 +315,55 @@ AdbcStatusCode PostgresDatabase::RebuildTypeResolver(struct AdbcError* error) {
     return final_status;
   }
 
+  PostgresTypeCatalog catalog;
+  final_status = ReadTypeCatalog(conn, &catalog, error);
+
+  // Disconnect since PostgreSQL connections can be heavy.
+  {
+    AdbcStatusCode status = Disconnect(&conn, error);
+    if (status != ADBC_STATUS_OK) final_status = status;
+  }
+
+  if (final_status == ADBC_STATUS_OK) {
+    // Create a new type resolver (this instance's type_resolver_ member
+    // will be updated at the end if this succeeds).
+    auto resolver = std::make_shared<PostgresTypeResolver>();
+    catalog.Populate(resolver.get());
+
+    // Only install the loader after populating so that the attempts above
+    // don't turn into one query per out-of-order type
+    if (lazy_type_resolver_) {
+      resolver->SetLoader(std::make_shared<PostgresTypeLoader>(uri_));
+    }
+    type_resolver_ = std::move(resolver);
+  }
+
+  return final_status;
+}
+
+AdbcStatusCode PostgresDatabase::ReadTypeCatalog(PGconn* conn,
+                                                 PostgresTypeCatalog* catalog,
+                                                 struct AdbcError* error) {
+  // Identify the server and the state of its catalog with one query that
+  // doesn't transfer any rows. The count and latest xmin of pg_type catch
+  // dropped, new, and altered types; that is all a lazy snapshot (base types
+  // only) depends on. An eager snapshot also holds table columns, so it adds
+  // pg_class, whose rows are updated when columns are added (relnatts) or
+  // the table is rewritten. pg_attribute itself is not scanned: it is the
+  // largest catalog, and scanning it could cost as much as the load that the
+  // cache is meant to skip.
+  const std::string kVersionQuery = R"(
+SELECT
+    current_database(),
+    inet_server_addr(),
+    inet_server_port(),
+    current_setting('server_version_num'),
+    (SELECT count(*) || '/' || max(xmin::text::bigint) FROM pg_catalog.pg_type)
+)";
+  const std::string kClassVersionQuery = R"(,
+    (SELECT count(*) || '/' || max(xmin::text::bigint) FROM pg_catalog.pg_class)
+)";
+
   // We need a few queries to build the resolver. The current strategy might
   // fail for some recursive definitions (e.g., arrays of records of arrays).
   // First, one on the pg_attribute table to resolve column names/oids for
@@ -152,9 +379,8 @@ ORDER BY
     attrelid, attnum
 )";
 
-  // Second, a query of the pg_type table. This query may need a few attempts to handle
-  // recursive definitions (e.g., record types with array column). This currently won't
-  // handle range types because those rows don't have child OID information. Arrays types
+  // Second, a query of the pg_type table. This currently won't handle range
+  // types because those rows don't have child OID information. Arrays types
   // are inserted after a successful insert of the element type.
   const std::string kTypeQuery = R"(
 SELECT
@@ -172,61 +398,90 @@ ORDER BY
     oid
 )";
 
-  // Create a new type resolver (this instance's type_resolver_ member
-  // will be updated at the end if this succeeds).
-  auto resolver = std::make_shared<PostgresTypeResolver>();
-
-  // Insert record type definitions (this includes table schemas)
-  PGresult* result = PQexec(conn, kColumnsQuery.c_str());
-  ExecStatusType pq_status = PQresultStatus(result);
-  if (pq_status == PGRES_TUPLES_OK) {
-    InsertPgAttributeResult(result, resolver);
-  } else {
-    SetError(error, "%s%s",
-             "[libpq] Failed to build type mapping table: ", PQerrorMessage(conn));
-    final_status = ADBC_STATUS_IO;
-  }
-
-  PQclear(result);
+  // In lazy mode, skip pg_attribute entirely and only preload types that are
+  // not the row type of a relation (on a large catalog, these are the vast
+  // majority of pg_type). Everything else is loaded on first use.
+  const std::string kBaseTypeQuery = R"(
+SELECT
+    oid,
+    typname,
+    typreceive,
+    typbasetype,
+    typarray,
+    typrelid
+FROM
+    pg_catalog.pg_type
+WHERE
+    (typreceive != 0 OR typname = 'aclitem') AND typtype != 'r' AND typreceive::TEXT != 'array_recv' AND typrelid = 0
+ORDER BY
+    oid
+)";
 
-  // Attempt filling the resolver a few times to handle recursive definitions.
-  int32_t max_attempts = 3;
-  for (int32_t i = 0; i < max_attempts; i++) {
-    result = PQexec(conn, kTypeQuery.c_str());
-    ExecStatusType pq_status = PQresultStatus(result);
-    if (pq_status == PGRES_TUPLES_OK) {
-      InsertPgTypeResult(result, resolver);
-    } else {
+  if (!type_cache_path_.empty()) {
+    const std::string version_query =
+        lazy_type_resolver_ ? kVersionQuery : kVersionQuery + kClassVersionQuery;
+    PGresult* result = PQexec(conn, version_query.c_str());
+    if (PQresultStatus(result) != PGRES_TUPLES_OK) {
       SetError(error, "%s%s",
-               "[libpq] Failed to build type mapping table: ", PQerrorMessage(conn));
-      final_status = ADBC_STATUS_IO;
+               "[libpq] Failed to check type cache version: ", PQerrorMessage(conn));
+      PQclear(result);
+      return ADBC_STATUS_IO;
     }
 
+    // The mode is part of the version since a lazy snapshot is incomplete
+    std::string version = lazy_type_resolver_ ? "lazy" : "eager";
+    for (int i = 0; i < PQnfields(result); i++) {
+      version += "|";
+      version += PQgetvalue(result, 0, i);
+    }
     PQclear(result);
-    if (final_status != ADBC_STATUS_OK) {
-      break;
+
+    if (catalog->Read(type_cache_path_, error) == ADBC_STATUS_OK &&
+        catalog->version == version) {
+      return ADBC_STATUS_OK;
     }
+    *catalog = PostgresTypeCatalog();
+    catalog->version = std::move(version);
   }
 
-  // Disconnect since PostgreSQL connections can be heavy.
-  {
-    AdbcStatusCode status = Disconnect(&conn, error);
-    if (status != ADBC_STATUS_OK) final_status = status;
+  // Insert record type definitions (this includes table schemas)
+  if (!lazy_type_resolver_) {
+    PGresult* result = PQexec(conn, kColumnsQuery.c_str());
+    if (PQresultStatus(result) != PGRES_TUPLES_OK) {
+      SetError(error, "%s%s",
+               "[libpq] Failed to build type mapping table: ", PQerrorMessage(conn));
+      PQclear(result);
+      return ADBC_STATUS_IO;
+    }
+    AppendPgAttributeResult(result, &catalog->classes);
+    PQclear(result);
   }
 
-  if (final_status == ADBC_STATUS_OK) {
-    type_resolver_ = std::move(resolver);
+  PGresult* result =
+      PQexec(conn, (lazy_type_resolver_ ? kBaseTypeQuery : kTypeQuery).c_str());
+  if (PQresultStatus(result) != PGRES_TUPLES_OK) {
+    SetError(error, "%s%s",
+             "[libpq] Failed to build type mapping table: ", PQerrorMessage(conn));
+    PQclear(result);
+    return ADBC_STATUS_IO;
   }
+  AppendPgTypeResult(result, &catalog->types);
+  PQclear(result);
 
-  return final_status;
+  if (!type_cache_path_.empty()) {
+    // The cache is only an optimization, so failing to write it is not an
+    // error (e.g., a read-only filesystem in a serverless worker)
+    struct AdbcError write_error = ADBC_ERROR_INIT;
+    catalog->Write(type_cache_path_, &write_error);
+    if (write_error.release) write_error.release(&write_error);
+  }
+  return ADBC_STATUS_OK;
 }
 
-static inline int32_t InsertPgAttributeResult(
-    PGresult* result, const std::shared_ptr<PostgresTypeResolver>& resolver) {
+static inline void AppendPgAttributeResult(PGresult* result,
+                                           std::vector<PostgresClassRow>* out) {
   int num_rows = PQntuples(result);
-  std::vector<std::pair<std::string, uint32_t>> columns;
-  uint32_t current_type_oid = 0;
-  int32_t n_added = 0;
+  PostgresClassRow cls;
 
   for (int row = 0; row < num_rows; row++) {
     const uint32_t type_oid = static_cast<uint32_t>(
@@ -235,68 +490,45 @@ static inline int32_t InsertPgAttributeResult(
     const uint32_t col_oid = static_cast<uint32_t>(
         std::strtol(PQgetvalue(result, row, 2), /*str_end=*/nullptr, /*base=*/10));
 
-    if (type_oid != current_type_oid && !columns.empty()) {
-      resolver->InsertClass(current_type_oid, columns);
-      columns.clear();
-      current_type_oid = type_oid;
-      n_added++;
+    if (type_oid != cls.oid && !cls.columns.empty()) {
+      out->push_back(std::move(cls));
+      cls = PostgresClassRow();
     }
 
-    columns.push_back({col_name, col_oid});
+    cls.oid = type_oid;
+    cls.columns.push_back({col_name, col_oid});
   }
 
-  if (!columns.empty()) {
-    resolver->InsertClass(current_type_oid, columns);
-    n_added++;
+  if (!cls.columns.empty()) {
+    out->push_back(std::move(cls));
   }
-
-  return n_added;
 }
 
-static inline int32_t InsertPgTypeResult(
-    PGresult* result, const std::shared_ptr<PostgresTypeResolver>& resolver) {
+// Append rows of (oid, typname, typreceive, typbasetype, typarray, typrelid,
+// [typelem])
+static inline void AppendPgTypeResult(PGresult* result,
+                                      std::vector<PostgresTypeRow>* out) {
   int num_rows = PQntuples(result);
-  PostgresTypeResolver::Item item;
-  int32_t n_added = 0;
+  out->reserve(out->size() + num_rows);
 
   for (int row = 0; row < num_rows; row++) {
-    const uint32_t oid = static_cast<uint32_t>(
+    PostgresTypeRow type;
+    type.oid = static_cast<uint32_t>(
         std::strtol(PQgetvalue(result, row, 0), /*str_end=*/nullptr, /*base=*/10));
-    const char* typname = PQgetvalue(result, row, 1);
-    const char* typreceive = PQgetvalue(result, row, 2);
-    const uint32_t typbasetype = static_cast<uint32_t>(
+    type.typname = PQgetvalue(result, row, 1);
+    type.typreceive = PQgetvalue(result, row, 2);
+    type.typbasetype = static_cast<uint32_t>(
         std::strtol(PQgetvalue(result, row, 3), /*str_end=*/nullptr, /*base=*/10));
-    const uint32_t typarray = static_cast<uint32_t>(
+    type.typarray = static_cast<uint32_t>(
         std::strtol(PQgetvalue(result, row, 4), /*str_end=*/nullptr, /*base=*/10));
-    const uint32_t typrelid = static_cast<uint32_t>(
+    type.typrelid = static_cast<uint32_t>(
         std::strtol(PQgetvalue(result, row, 5), /*str_end=*/nullptr, /*base=*/10));
-
-    // Special case the aclitem because it shows up in a bunch of internal tables
-    if (strcmp(typname, "aclitem") == 0) {
-      typreceive = "aclitem_recv";
-    }
-
-    item.oid = oid;
-    item.typname = typname;
-    item.typreceive = typreceive;
-    item.class_oid = typrelid;
-    item.base_oid = typbasetype;
-
-    int result = resolver->Insert(item, nullptr);
-
-    // If there's an array type and the insert succeeded, add that now too
-    if (result == NANOARROW_OK && typarray != 0) {
-      std::string array_typname = "_" + std::string(typname);
-      item.oid = typarray;
-      item.typname = array_typname.c_str();
-      item.typreceive = "array_recv";
-      item.child_oid = oid;
-
-      resolver->Insert(item, nullptr);
+    if (PQnfields(result) > 6) {
+      type.typelem = static_cast<uint32_t>(
+          std::strtol(PQgetvalue(result, row, 6), /*str_end=*/nullptr, /*base=*/10));
     }
+    out->push_back(std::move(type));
   }
-
-  return n_added;
 }
 
 }  // namespace adbcpq
@@ -25,8 +25,28 @@
 #include <libpq-fe.h>
 
 #include "postgres_type.h"
+#include "statistics.h"
+
+/// \brief How the database discovers PostgreSQL types: "eager" (the default)
+///   loads every type and relation definition when the database is
+///   initialized; "lazy" loads only base types up front and looks up
+///   composite and other types the first time a result references them.
+#define ADBC_POSTGRESQL_OPTION_TYPE_RESOLVER "adbc.postgresql.type_resolver"
+
+/// \brief A file in which to cache the type information read at
+///   initialization. The cache is validated against the server with a single
+///   query and rewritten whenever the server's catalog has changed.
+#define ADBC_POSTGRESQL_OPTION_TYPE_CACHE_PATH "adbc.postgresql.type_cache_path"
+
+/// \brief How long (in seconds) statistics returned by
+///   AdbcConnectionGetStatistics are cached and shared by all connections
+///   before being revalidated against pg_stat_user_tables. 0 (the default)
+///   disables the cache.
+#define ADBC_POSTGRESQL_OPTION_STATISTICS_CACHE_TTL "adbc.postgresql.statistics_cache_ttl"
 
 namespace adbcpq {
+struct PostgresTypeCatalog;
+
 class PostgresDatabase {
  public:
   PostgresDatabase();
@@ -60,10 +80,20 @@ class PostgresDatabase {
 
   AdbcStatusCode RebuildTypeResolver(struct AdbcError* error);
 
+  double statistics_cache_ttl() const { return statistics_cache_ttl_; }
+  PostgresStatisticsCache* statistics_cache() { return &statistics_cache_; }
+
  private:
   int32_t open_connections_;
   std::string uri_;
+  bool lazy_type_resolver_;
+  std::string type_cache_path_;
   std::shared_ptr<PostgresTypeResolver> type_resolver_;
+  double statistics_cache_ttl_;
+  PostgresStatisticsCache statistics_cache_;
+
+  AdbcStatusCode ReadTypeCatalog(PGconn* conn, PostgresTypeCatalog* catalog,
+                                 struct AdbcError* error);
 };
 }  // namespace adbcpq
 
@@ -212,12 +212,36 @@ class PostgresCopyFieldReader {
     return NANOARROW_OK;
   }
 
+  // Record the size of a finished (but not yet moved) array so that Reserve()
+  // can size the buffers of the next one
+  virtual void ObserveArray(const ArrowArray* array) {
+    if (data_ != nullptr && array->length > 0) {
+      data_bytes_per_value_ = static_cast<double>(data_->size_bytes) / array->length;
+    }
+  }
+
+  // Reserve space for n_values more values after InitArray(), so that reading
+  // a batch about as large as the last one does not reallocate. The validity
+  // bitmap is left alone since it is only allocated once a null is seen.
+  virtual ArrowErrorCode Reserve(int64_t n_values) {
+    if (offsets_ != nullptr) {
+      NANOARROW_RETURN_NOT_OK(
+          ArrowBufferReserve(offsets_, n_values * static_cast<int64_t>(sizeof(int32_t))));
+    }
+    if (data_ != nullptr) {
+      NANOARROW_RETURN_NOT_OK(ArrowBufferReserve(
+          data_, static_cast<int64_t>(n_values * data_bytes_per_value_) + 1));
+    }
+    return NANOARROW_OK;
+  }
+
  protected:
   PostgresType pg_type_;
   ArrowSchemaView schema_view_;
   ArrowBitmap* validity_;
   ArrowBuffer* offsets_;
   ArrowBuffer* data_;
+  double data_bytes_per_value_ = 0;
   std::vector<std::unique_ptr<PostgresCopyFieldReader>> children_;
 
   ArrowErrorCode AppendValid(ArrowArray* array) {
@@ -336,8 +360,32 @@ class PostgresCopyIntervalFieldReader : public PostgresCopyFieldReader {
 // decimal point. Both of those values can be zero or negative. A "sign" component
 // encodes the positive or negativeness of the value and is also used to encode special
 // values (inf, -inf, and nan).
+// Reader for NUMERIC values. By default these are converted to their decimal
+// string representation. If the output type is decimal128/decimal256, the
+// base-10000 digits are instead accumulated directly into the unscaled integer
+// value at the output scale.
 class PostgresCopyNumericFieldReader : public PostgresCopyFieldReader {
  public:
+  explicit PostgresCopyNumericFieldReader(bool special_as_null = false)
+      : special_as_null_(special_as_null), decimal_limbs_(0), decimal_scale_(0) {}
+
+  ArrowErrorCode InitSchema(ArrowSchema* schema) override {
+    NANOARROW_RETURN_NOT_OK(PostgresCopyFieldReader::InitSchema(schema));
+    switch (schema_view_.type) {
+      case NANOARROW_TYPE_DECIMAL128:
+        decimal_limbs_ = 4;
+        break;
+      case NANOARROW_TYPE_DECIMAL256:
+        decimal_limbs_ = 8;
+        break;
+      default:
+        decimal_limbs_ = 0;
+        break;
+    }
+    decimal_scale_ = schema_view_.decimal_scale;
+    return NANOARROW_OK;
+  }
+
   ArrowErrorCode Read(ArrowBufferView* data, int32_t field_size_bytes, ArrowArray* array,
                       ArrowError* error) override {
     // -1 for NULL
@@ -369,6 +417,10 @@ class PostgresCopyNumericFieldReader : public PostgresCopyFieldReader {
       return EINVAL;
     }
 
+    if (decimal_limbs_ > 0) {
+      return ReadDecimal(data, ndigits, weight, sign, array, error);
+    }
+
     digits_.clear();
     for (int16_t i = 0; i < ndigits; i++) {
       digits_.push_back(ReadUnsafe<int16_t>(data));
@@ -478,6 +530,125 @@ class PostgresCopyNumericFieldReader : public PostgresCopyFieldReader {
 
  private:
   std::vector<int16_t> digits_;
+  bool special_as_null_;
+  // The number of 32-bit words in the output decimal (0 for string output)
+  int decimal_limbs_;
+  int32_t decimal_scale_;
+
+  ArrowErrorCode ReadDecimal(ArrowBufferView* data, int16_t ndigits, int16_t weight,
+                             uint16_t sign, ArrowArray* array, ArrowError* error) {
+    switch (sign) {
+      case kNumericPos:
+      case kNumericNeg:
+        break;
+      case kNumericNAN:
+      case kNumericPinf:
+      case kNumericNinf:
+        if (special_as_null_) {
+          data->data.as_uint8 += ndigits * sizeof(int16_t);
+          data->size_bytes -= ndigits * sizeof(int16_t);
+          return ArrowArrayAppendNull(array, 1);
+        }
+        ArrowErrorSet(error, "Can't convert Postgres numeric %s to a decimal",
+                      sign == kNumericNAN    ? "NaN"
+                      : sign == kNumericPinf ? "Infinity"
+                                             : "-Infinity");
+        return EINVAL;
+      default:
+        ArrowErrorSet(error,
+                      "Unexpected value for sign read from Postgres numeric field: %d",
+                      static_cast<int>(sign));
+        return EINVAL;
+    }
+
+    // Postgres digits that lie entirely past the output scale are dropped
+    // (truncated) without being accumulated. Postgres has already rounded
+    // values of a column with a declared scale, so these are only zeroes.
+    int16_t n_used = 0;
+    while (n_used < ndigits &&
+           kDecDigits * (weight - n_used) + kDecDigits - 1 + decimal_scale_ >= 0) {
+      n_used++;
+    }
+
+    // Little-endian 32-bit words of the unsigned magnitude. The used digits form
+    // an integer N such that value = N * 10^(4 * (weight - n_used + 1)). The
+    // last used digit may still be padded with up to 3 zeroes past the scale,
+    // so accumulate with an extra word for N to overflow into before rescaling.
+    uint32_t limbs[9] = {0};
+    const int n_limbs = decimal_limbs_ + 1;
+    bool overflow = false;
+    for (int16_t i = 0; i < ndigits; i++) {
+      const int16_t digit = ReadUnsafe<int16_t>(data);
+      if (i < n_used) {
+        overflow |= MulAdd(limbs, n_limbs, kNBase, static_cast<uint32_t>(digit));
+      }
+    }
+
+    if (n_used > 0) {
+      // Rescale to the output scale
+      int32_t exponent = kDecDigits * (weight - n_used + 1) + decimal_scale_;
+      while (exponent > 0 && !overflow) {
+        const int32_t step = std::min<int32_t>(exponent, 9);
+        overflow |= MulAdd(limbs, n_limbs, kPow10[step], 0);
+        exponent -= step;
+      }
+      while (exponent < 0) {
+        const int32_t step = std::min<int32_t>(-exponent, 9);
+        DivSmall(limbs, n_limbs, kPow10[step]);
+        exponent += step;
+      }
+    }
+
+    // The magnitude must fit in the output and also leave room for the sign bit
+    if (overflow || limbs[decimal_limbs_] != 0 ||
+        (limbs[decimal_limbs_ - 1] & 0x80000000) != 0) {
+      ArrowErrorSet(error, "Postgres numeric value does not fit in decimal%d",
+                    decimal_limbs_ * 32);
+      return EINVAL;
+    }
+
+    if (sign == kNumericNeg) {
+      // Two's complement
+      uint64_t carry = 1;
+      for (int i = 0; i < decimal_limbs_; i++) {
+        carry += static_cast<uint32_t>(~limbs[i]);
+        limbs[i] = static_cast<uint32_t>(carry);
+        carry >>= 32;
+      }
+    }
+
+    // Arrow decimals are native-endian integers
+    if (!_ArrowIsLittleEndian()) {
+      std::reverse(limbs, limbs + decimal_limbs_);
+    }
+
+    NANOARROW_RETURN_NOT_OK(ArrowBufferAppend(data_, limbs, decimal_limbs_ * 4));
+    return AppendValid(array);
+  }
+
+  // limbs = limbs * mul + add; returns true on overflow
+  static bool MulAdd(uint32_t* limbs, int n_limbs, uint32_t mul, uint32_t add) {
+    uint64_t carry = add;
+    for (int i = 0; i < n_limbs; i++) {
+      carry += static_cast<uint64_t>(limbs[i]) * mul;
+      limbs[i] = static_cast<uint32_t>(carry);
+      carry >>= 32;
+    }
+    return carry != 0;
+  }
+
+  // limbs = limbs / div (truncating)
+  static void DivSmall(uint32_t* limbs, int n_limbs, uint32_t div) {
+    uint64_t remainder = 0;
+    for (int i = n_limbs - 1; i >= 0; i--) {
+      remainder = (remainder << 32) | limbs[i];
+      limbs[i] = static_cast<uint32_t>(remainder / div);
+      remainder %= div;
+    }
+  }
+
+  static constexpr uint32_t kPow10[] = {1,      10,      100,      1000,      10000,
+                                        100000, 1000000, 10000000, 100000000, 1000000000};
 
   // Number of decimal digits per Postgres digit
   static const int kDecDigits = 4;
@@ -510,14 +681,18 @@ class PostgresCopyBinaryFieldReader : public PostgresCopyFieldReader {
       return EINVAL;
     }
 
-    NANOARROW_RETURN_NOT_OK(ArrowBufferAppend(data_, data->data.data, field_size_bytes));
+    // Buffers are usually reserved up front (see Reserve()), so these checks
+    // rarely grow anything
+    NANOARROW_RETURN_NOT_OK(ArrowBufferReserve(data_, field_size_bytes));
+    NANOARROW_RETURN_NOT_OK(ArrowBufferReserve(offsets_, sizeof(int32_t)));
+
+    const int32_t* offsets = reinterpret_cast<const int32_t*>(offsets_->data);
+    const int32_t next_offset = offsets[array->length] + field_size_bytes;
+    ArrowBufferAppendUnsafe(data_, data->data.data, field_size_bytes);
+    ArrowBufferAppendUnsafe(offsets_, &next_offset, sizeof(int32_t));
     data->data.as_uint8 += field_size_bytes;
     data->size_bytes -= field_size_bytes;
 
-    int32_t* offsets = reinterpret_cast<int32_t*>(offsets_->data);
-    NANOARROW_RETURN_NOT_OK(
-        ArrowBufferAppendInt32(offsets_, offsets[array->length] + field_size_bytes));
-
     return AppendValid(array);
   }
 };
@@ -541,6 +716,19 @@ class PostgresCopyArrayFieldReader : public PostgresCopyFieldReader {
     return NANOARROW_OK;
   }
 
+  void ObserveArray(const ArrowArray* array) override {
+    PostgresCopyFieldReader::ObserveArray(array);
+    if (array->length > 0) {
+      items_per_value_ = static_cast<double>(array->children[0]->length) / array->length;
+    }
+    child_->ObserveArray(array->children[0]);
+  }
+
+  ArrowErrorCode Reserve(int64_t n_values) override {
+    NANOARROW_RETURN_NOT_OK(PostgresCopyFieldReader::Reserve(n_values));
+    return child_->Reserve(static_cast<int64_t>(n_values * items_per_value_));
+  }
+
   ArrowErrorCode Read(ArrowBufferView* data, int32_t field_size_bytes, ArrowArray* array,
                       ArrowError* error) override {
     if (field_size_bytes <= 0) {
@@ -608,6 +796,7 @@ class PostgresCopyArrayFieldReader : public PostgresCopyFieldReader {
 
  private:
   std::unique_ptr<PostgresCopyFieldReader> child_;
+  double items_per_value_ = 0;
 };
 
 class PostgresCopyRecordFieldReader : public PostgresCopyFieldReader {
@@ -636,6 +825,19 @@ class PostgresCopyRecordFieldReader : public PostgresCopyFieldReader {
     return NANOARROW_OK;
   }
 
+  void ObserveArray(const ArrowArray* array) override {
+    for (int64_t i = 0; i < array->n_children; i++) {
+      children_[i]->ObserveArray(array->children[i]);
+    }
+  }
+
+  ArrowErrorCode Reserve(int64_t n_values) override {
+    for (const auto& child : children_) {
+      NANOARROW_RETURN_NOT_OK(child->Reserve(n_values));
+    }
+    return NANOARROW_OK;
+  }
+
   ArrowErrorCode Read(ArrowBufferView* data, int32_t field_size_bytes, ArrowArray* array,
                       ArrowError* error) override {
     if (field_size_bytes < 0) {
@@ -725,6 +927,19 @@ class PostgresCopyFieldTupleReader : public PostgresCopyFieldReader {
     return NANOARROW_OK;
   }
 
+  void ObserveArray(const ArrowArray* array) override {
+    for (int64_t i = 0; i < array->n_children; i++) {
+      children_[i]->ObserveArray(array->children[i]);
+    }
+  }
+
+  ArrowErrorCode Reserve(int64_t n_values) override {
+    for (const auto& child : children_) {
+      NANOARROW_RETURN_NOT_OK(child->Reserve(n_values));
+    }
+    return NANOARROW_OK;
+  }
+
   ArrowErrorCode Read(ArrowBufferView* data, int32_t field_size_bytes, ArrowArray* array,
                       ArrowError* error) override {
     int16_t n_fields;
@@ -781,10 +996,20 @@ static inline ArrowErrorCode ErrorCantConvert(ArrowError* error,
   return EINVAL;
 }
 
-static inline ArrowErrorCode MakeCopyFieldReader(const PostgresType& pg_type,
-                                                 ArrowSchema* schema,
-                                                 PostgresCopyFieldReader** out,
-                                                 ArrowError* error) {
+// Options that affect how the COPY reader converts individual fields
+struct PostgresCopyReaderOptions {
+  // Convert top-level NUMERIC columns with a declared precision and scale to
+  // decimal128 (precision <= 38) or decimal256 (precision <= 76) instead of
+  // their string representation
+  bool numeric_as_decimal = false;
+  // When converting NUMERIC to decimal, return NaN and +/-Infinity as null
+  // instead of failing the read
+  bool numeric_special_as_null = false;
+};
+
+static inline ArrowErrorCode MakeCopyFieldReader(
+    const PostgresType& pg_type, ArrowSchema* schema, PostgresCopyFieldReader** out,
+    ArrowError* error, const PostgresCopyReaderOptions& options = {}) {
   ArrowSchemaView schema_view;
   NANOARROW_RETURN_NOT_OK(ArrowSchemaViewInit(&schema_view, schema, nullptr));
 
@@ -867,6 +1092,16 @@ static inline ArrowErrorCode MakeCopyFieldReader(const PostgresType& pg_type,
       *out = new PostgresCopyBinaryFieldReader();
       return NANOARROW_OK;
 
+    case NANOARROW_TYPE_DECIMAL128:
+    case NANOARROW_TYPE_DECIMAL256:
+      switch (pg_type.type_id()) {
+        case PostgresTypeId::kNumeric:
+          *out = new PostgresCopyNumericFieldReader(options.numeric_special_as_null);
+          return NANOARROW_OK;
+        default:
+          return ErrorCantConvert(error, pg_type, schema_view);
+      }
+
     case NANOARROW_TYPE_LIST:
       switch (pg_type.type_id()) {
         case PostgresTypeId::kArray: {
@@ -883,7 +1118,7 @@ static inline ArrowErrorCode MakeCopyFieldReader(const PostgresType& pg_type,
 
           PostgresCopyFieldReader* child_reader;
           NANOARROW_RETURN_NOT_OK(MakeCopyFieldReader(
-              pg_type.child(0), schema->children[0], &child_reader, error));
+              pg_type.child(0), schema->children[0], &child_reader, error, options));
           array_reader->InitChild(std::unique_ptr<PostgresCopyFieldReader>(child_reader));
 
           *out = array_reader.release();
@@ -912,7 +1147,7 @@ static inline ArrowErrorCode MakeCopyFieldReader(const PostgresType& pg_type,
           for (int64_t i = 0; i < pg_type.n_children(); i++) {
             PostgresCopyFieldReader* child_reader;
             NANOARROW_RETURN_NOT_OK(MakeCopyFieldReader(
-                pg_type.child(i), schema->children[i], &child_reader, error));
+                pg_type.child(i), schema->children[i], &child_reader, error, options));
             record_reader->AppendChild(
                 std::unique_ptr<PostgresCopyFieldReader>(child_reader));
           }
@@ -974,6 +1209,7 @@ class PostgresCopyStreamReader {
     pg_type_ = std::move(pg_type);
     root_reader_.Init(pg_type_);
     array_size_approx_bytes_ = 0;
+    last_batch_rows_ = 0;
     return NANOARROW_OK;
   }
 
@@ -1002,10 +1238,20 @@ class PostgresCopyStreamReader {
     return NANOARROW_OK;
   }
 
+  void SetOptions(const PostgresCopyReaderOptions& options) { options_ = options; }
+
   ArrowErrorCode InferOutputSchema(ArrowError* error) {
     schema_.reset();
     ArrowSchemaInit(schema_.get());
     NANOARROW_RETURN_NOT_OK(root_reader_.InputType().SetSchema(schema_.get()));
+
+    if (options_.numeric_as_decimal) {
+      const PostgresType& root_type = root_reader_.InputType();
+      for (int64_t i = 0; i < root_type.n_children(); i++) {
+        NANOARROW_RETURN_NOT_OK(
+            SetNumericDecimalSchema(root_type.child(i), schema_->children[i]));
+      }
+    }
     return NANOARROW_OK;
   }
 
@@ -1019,8 +1265,8 @@ class PostgresCopyStreamReader {
     for (int64_t i = 0; i < root_type.n_children(); i++) {
       const PostgresType& child_type = root_type.child(i);
       PostgresCopyFieldReader* child_reader;
-      NANOARROW_RETURN_NOT_OK(
-          MakeCopyFieldReader(child_type, schema_->children[i], &child_reader, error));
+      NANOARROW_RETURN_NOT_OK(MakeCopyFieldReader(child_type, schema_->children[i],
+                                                  &child_reader, error, options_));
       root_reader_.AppendChild(std::unique_ptr<PostgresCopyFieldReader>(child_reader));
     }
 
@@ -1074,6 +1320,12 @@ class PostgresCopyStreamReader {
       NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(array_.get()));
       NANOARROW_RETURN_NOT_OK(root_reader_.InitArray(array_.get()));
       array_size_approx_bytes_ = 0;
+
+      // Batches are cut at a size hint, so the next one will most likely
+      // have as many rows (and bytes per row) as the last
+      if (last_batch_rows_ > 0) {
+        NANOARROW_RETURN_NOT_OK(root_reader_.Reserve(last_batch_rows_));
+      }
     }
 
     const uint8_t* start = data->data.as_uint8;
@@ -1091,6 +1343,9 @@ class PostgresCopyStreamReader {
       return EINVAL;
     }
 
+    root_reader_.ObserveArray(array_.get());
+    last_batch_rows_ = array_->length;
+
     NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(array_.get(), error));
     ArrowArrayMove(array_.get(), out);
     return NANOARROW_OK;
@@ -1104,6 +1359,30 @@ class PostgresCopyStreamReader {
   nanoarrow::UniqueSchema schema_;
   nanoarrow::UniqueArray array_;
   int64_t array_size_approx_bytes_;
+  int64_t last_batch_rows_ = 0;
+  PostgresCopyReaderOptions options_;
+
+  // Use a decimal type for a NUMERIC column whose precision and scale are
+  // known from its type modifier and fit in decimal256. Unconstrained
+  // NUMERIC columns can hold any scale and are left as strings.
+  static ArrowErrorCode SetNumericDecimalSchema(const PostgresType& pg_type,
+                                                ArrowSchema* schema) {
+    // The type modifier is ((precision << 16) | scale) + VARHDRSZ, with the
+    // scale stored as an 11-bit two's complement integer
+    const int32_t typmod = pg_type.typmod();
+    if (pg_type.type_id() != PostgresTypeId::kNumeric || typmod < 4) {
+      return NANOARROW_OK;
+    }
+    const int32_t precision = ((typmod - 4) >> 16) & 0xffff;
+    const int32_t scale = ((((typmod - 4) & 0x7ff) ^ 1024) - 1024);
+    if (precision < 1 || precision > 76 || scale < 0 || scale > precision) {
+      return NANOARROW_OK;
+    }
+
+    const ArrowType decimal_type =
+        precision <= 38 ? NANOARROW_TYPE_DECIMAL128 : NANOARROW_TYPE_DECIMAL256;
+    return ArrowSchemaSetTypeDecimal(schema, decimal_type, precision, scale);
+  }
 };
 
 class PostgresCopyFieldWriter {
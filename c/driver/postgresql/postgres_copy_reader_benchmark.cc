@@ -0,0 +1,178 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <nanoarrow/nanoarrow.hpp>
+
+#include "postgres_copy_reader.h"
+#include "postgres_util.h"
+
+namespace adbcpq {
+namespace {
+
+#define CHECK_OK(EXPR)                       \
+  do {                                       \
+    if ((EXPR) != 0) {                       \
+      state.SkipWithError("Failed: " #EXPR); \
+      return;                                \
+    }                                        \
+  } while (0)
+
+template <typename T>
+void AppendNetwork(std::vector<uint8_t>* out, T value) {
+  uint8_t bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  out->insert(out->end(), bytes, bytes + sizeof(T));
+}
+
+/// Build the COPY (FORMAT binary) output of a (BIGINT, DOUBLE PRECISION, TEXT)
+/// table, where every 10th TEXT value is NULL.
+std::vector<uint8_t> MakeCopyData(int64_t n_rows) {
+  std::vector<uint8_t> out(kPgCopyBinarySignature,
+                           kPgCopyBinarySignature + sizeof(kPgCopyBinarySignature));
+  AppendNetwork(&out, ToNetworkInt32(0));  // flags
+  AppendNetwork(&out, ToNetworkInt32(0));  // extension length
+
+  for (int64_t i = 0; i < n_rows; i++) {
+    AppendNetwork(&out, ToNetworkInt16(3));
+
+    AppendNetwork(&out, ToNetworkInt32(8));
+    AppendNetwork(&out, ToNetworkInt64(i));
+
+    AppendNetwork(&out, ToNetworkInt32(8));
+    AppendNetwork(&out, ToNetworkFloat8(static_cast<double>(i) / 2));
+
+    if (i % 10 == 0) {
+      AppendNetwork(&out, ToNetworkInt32(-1));
+    } else {
+      std::string value = "row number " + std::to_string(i);
+      AppendNetwork(&out, ToNetworkInt32(static_cast<int32_t>(value.size())));
+      out.insert(out.end(), value.begin(), value.end());
+    }
+  }
+
+  AppendNetwork(&out, ToNetworkInt16(-1));
+  return out;
+}
+
+void BM_CopyDecode(benchmark::State& state) {
+  const int64_t n_rows = state.range(0);
+  std::vector<uint8_t> copy_data = MakeCopyData(n_rows);
+
+  PostgresType input_type(PostgresTypeId::kRecord);
+  input_type.AppendChild("ints", PostgresType(PostgresTypeId::kInt8));
+  input_type.AppendChild("doubles", PostgresType(PostgresTypeId::kFloat8));
+  input_type.AppendChild("strings", PostgresType(PostgresTypeId::kText));
+
+  for (auto _ : state) {
+    PostgresCopyStreamReader reader;
+    CHECK_OK(reader.Init(input_type));
+    CHECK_OK(reader.InferOutputSchema(nullptr));
+    CHECK_OK(reader.InitFieldReaders(nullptr));
+
+    ArrowBufferView data;
+    data.data.as_uint8 = copy_data.data();
+    data.size_bytes = static_cast<int64_t>(copy_data.size());
+    CHECK_OK(reader.ReadHeader(&data, nullptr));
+
+    int result;
+    do {
+      result = reader.ReadRecord(&data, nullptr);
+    } while (result == NANOARROW_OK);
+    if (result != ENODATA) {
+      state.SkipWithError("ReadRecord failed");
+      return;
+    }
+
+    nanoarrow::UniqueArray array;
+    CHECK_OK(reader.GetArray(array.get(), nullptr));
+    benchmark::DoNotOptimize(array->length);
+  }
+
+  state.SetItemsProcessed(state.iterations() * n_rows);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(copy_data.size()));
+}
+BENCHMARK(BM_CopyDecode)->Arg(1000)->Arg(100000);
+
+void BM_CopyEncode(benchmark::State& state) {
+  const int64_t n_rows = state.range(0);
+
+  nanoarrow::UniqueSchema schema;
+  ArrowSchemaInit(schema.get());
+  CHECK_OK(ArrowSchemaSetTypeStruct(schema.get(), 3));
+  CHECK_OK(ArrowSchemaSetType(schema->children[0], NANOARROW_TYPE_INT64));
+  CHECK_OK(ArrowSchemaSetName(schema->children[0], "ints"));
+  CHECK_OK(ArrowSchemaSetType(schema->children[1], NANOARROW_TYPE_INT32));
+  CHECK_OK(ArrowSchemaSetName(schema->children[1], "smallints"));
+  CHECK_OK(ArrowSchemaSetType(schema->children[2], NANOARROW_TYPE_BOOL));
+  CHECK_OK(ArrowSchemaSetName(schema->children[2], "bools"));
+
+  nanoarrow::UniqueArray array;
+  CHECK_OK(ArrowArrayInitFromSchema(array.get(), schema.get(), nullptr));
+  CHECK_OK(ArrowArrayStartAppending(array.get()));
+  for (int64_t i = 0; i < n_rows; i++) {
+    CHECK_OK(ArrowArrayAppendInt(array->children[0], i));
+    if (i % 10 == 0) {
+      CHECK_OK(ArrowArrayAppendNull(array->children[1], 1));
+    } else {
+      CHECK_OK(ArrowArrayAppendInt(array->children[1], i % 1000));
+    }
+    CHECK_OK(ArrowArrayAppendInt(array->children[2], i % 2));
+    CHECK_OK(ArrowArrayFinishElement(array.get()));
+  }
+  CHECK_OK(ArrowArrayFinishBuildingDefault(array.get(), nullptr));
+
+  // The writer does not grow its output buffer, so reserve the worst case:
+  // field count plus a length and value for each field
+  const int64_t max_bytes = n_rows * (2 + (4 + 8) + (4 + 4) + (4 + 1));
+  int64_t bytes_written = 0;
+
+  for (auto _ : state) {
+    PostgresCopyStreamWriter writer;
+    CHECK_OK(writer.Init(schema.get(), array.get()));
+    CHECK_OK(writer.InitFieldWriters(nullptr));
+
+    struct ArrowBuffer buffer;
+    ArrowBufferInit(&buffer);
+    CHECK_OK(ArrowBufferReserve(&buffer, max_bytes));
+    uint8_t* cursor = buffer.data;
+
+    int result;
+    do {
+      result = writer.WriteRecord(&buffer, nullptr);
+    } while (result == NANOARROW_OK);
+
+    bytes_written = buffer.size_bytes;
+    buffer.data = cursor;
+    ArrowBufferReset(&buffer);
+    if (result != ENODATA) {
+      state.SkipWithError("WriteRecord failed");
+      return;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * n_rows);
+  state.SetBytesProcessed(state.iterations() * bytes_written);
+}
+BENCHMARK(BM_CopyEncode)->Arg(1000)->Arg(100000);
+
+}  // namespace
+}  // namespace adbcpq
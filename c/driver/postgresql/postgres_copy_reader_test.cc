@@ -16,6 +16,7 @@
 // under the License.
 
 #include <optional>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <nanoarrow/nanoarrow.hpp>
@@ -27,8 +28,10 @@ namespace adbcpq {
 
 class PostgresCopyStreamTester {
  public:
-  ArrowErrorCode Init(const PostgresType& root_type, ArrowError* error = nullptr) {
+  ArrowErrorCode Init(const PostgresType& root_type, ArrowError* error = nullptr,
+                      const PostgresCopyReaderOptions& options = {}) {
     NANOARROW_RETURN_NOT_OK(reader_.Init(root_type));
+    reader_.SetOptions(options);
     NANOARROW_RETURN_NOT_OK(reader_.InferOutputSchema(error));
     NANOARROW_RETURN_NOT_OK(reader_.InitFieldReaders(error));
     return NANOARROW_OK;
@@ -563,6 +566,240 @@ TEST(PostgresCopyUtilsTest, PostgresCopyReadNumeric) {
   EXPECT_EQ(std::string(item.data, item.size_bytes), "inf");
 }
 
+// NUMERIC(precision, scale) columns carry (precision << 16 | scale) + 4 as
+// their type modifier
+static PostgresType NumericWithTypmod(int32_t precision, int32_t scale) {
+  const int32_t typmod = ((precision << 16) | scale) + 4;
+  return PostgresType(PostgresTypeId::kNumeric).WithTypmod(typmod);
+}
+
+TEST(PostgresCopyUtilsTest, PostgresCopyReadNumericDecimal) {
+  ArrowBufferView data;
+  data.data.as_uint8 = kTestPgCopyNumeric;
+  data.size_bytes = sizeof(kTestPgCopyNumeric);
+
+  PostgresType input_type(PostgresTypeId::kRecord);
+  input_type.AppendChild("col", NumericWithTypmod(20, 8));
+
+  PostgresCopyReaderOptions options;
+  options.numeric_as_decimal = true;
+  options.numeric_special_as_null = true;
+
+  PostgresCopyStreamTester tester;
+  ASSERT_EQ(tester.Init(input_type, nullptr, options), NANOARROW_OK);
+  ASSERT_EQ(tester.ReadAll(&data), ENODATA);
+  ASSERT_EQ(data.size_bytes, 0);
+
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(tester.GetArray(array.get()), NANOARROW_OK);
+  ASSERT_EQ(array->length, 9);
+
+  nanoarrow::UniqueSchema schema;
+  tester.GetSchema(schema.get());
+  ASSERT_STREQ(schema->children[0]->format, "d:20,8");
+
+  nanoarrow::UniqueArrayView array_view;
+  ASSERT_EQ(ArrowArrayViewInitFromSchema(array_view.get(), schema.get(), nullptr),
+            NANOARROW_OK);
+  ASSERT_EQ(ArrowArrayViewSetArray(array_view.get(), array.get(), nullptr), NANOARROW_OK);
+
+  const int64_t expected[] = {100000000000000, 1234, 100000000, -12345600000,
+                              12345600000};
+  struct ArrowDecimal decimal;
+  ArrowDecimalInit(&decimal, 128, 20, 8);
+  for (int64_t i = 0; i < 5; i++) {
+    ASSERT_FALSE(ArrowArrayViewIsNull(array_view->children[0], i));
+    ArrowArrayViewGetDecimalUnsafe(array_view->children[0], i, &decimal);
+    EXPECT_EQ(ArrowDecimalGetIntUnsafe(&decimal), expected[i]);
+    EXPECT_EQ(ArrowDecimalSign(&decimal), expected[i] < 0 ? -1 : 1);
+  }
+
+  // nan, -inf, inf, NULL
+  for (int64_t i = 5; i < 9; i++) {
+    EXPECT_TRUE(ArrowArrayViewIsNull(array_view->children[0], i));
+  }
+}
+
+TEST(PostgresCopyUtilsTest, PostgresCopyReadNumericDecimal256) {
+  ArrowBufferView data;
+  data.data.as_uint8 = kTestPgCopyNumeric;
+  data.size_bytes = sizeof(kTestPgCopyNumeric);
+
+  PostgresType input_type(PostgresTypeId::kRecord);
+  input_type.AppendChild("col", NumericWithTypmod(50, 3));
+
+  PostgresCopyReaderOptions options;
+  options.numeric_as_decimal = true;
+  options.numeric_special_as_null = true;
+
+  PostgresCopyStreamTester tester;
+  ASSERT_EQ(tester.Init(input_type, nullptr, options), NANOARROW_OK);
+  ASSERT_EQ(tester.ReadAll(&data), ENODATA);
+
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(tester.GetArray(array.get()), NANOARROW_OK);
+  nanoarrow::UniqueSchema schema;
+  tester.GetSchema(schema.get());
+  ASSERT_STREQ(schema->children[0]->format, "d:50,3,256");
+
+  nanoarrow::UniqueArrayView array_view;
+  ASSERT_EQ(ArrowArrayViewInitFromSchema(array_view.get(), schema.get(), nullptr),
+            NANOARROW_OK);
+  ASSERT_EQ(ArrowArrayViewSetArray(array_view.get(), array.get(), nullptr), NANOARROW_OK);
+
+  // 0.00001234 is truncated at scale 3 (Postgres would have rounded it already
+  // for a column declared with this scale)
+  const int64_t expected[] = {1000000000, 0, 1000, -123456, 123456};
+  struct ArrowDecimal decimal;
+  ArrowDecimalInit(&decimal, 256, 50, 3);
+  for (int64_t i = 0; i < 5; i++) {
+    ArrowArrayViewGetDecimalUnsafe(array_view->children[0], i, &decimal);
+    EXPECT_EQ(ArrowDecimalGetIntUnsafe(&decimal), expected[i]);
+    EXPECT_EQ(ArrowDecimalSign(&decimal), expected[i] < 0 ? -1 : 1);
+  }
+}
+
+// COPY (SELECT CAST(col AS NUMERIC(38, 37)) AS col FROM (  VALUES
+// ('9.9999999999999999999999999999999999999'),
+// ('-0.1234567890123456789012345678901234567')) AS drvd(col)) TO STDOUT WITH
+// (FORMAT binary);
+static uint8_t kTestPgCopyNumericMaxPrecision128[] = {
+    0x50, 0x47, 0x43, 0x4f, 0x50, 0x59, 0x0a, 0xff, 0x0d, 0x0a, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x1e, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x25, 0x00, 0x09, 0x27,
+    0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27,
+    0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x23, 0x28, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x1c, 0x00, 0x0a, 0xff, 0xff, 0x40, 0x00, 0x00, 0x25, 0x04, 0xd2, 0x16,
+    0x2e, 0x23, 0x34, 0x0d, 0x80, 0x1e, 0xd2, 0x04, 0xd2, 0x16, 0x2e, 0x23,
+    0x34, 0x0d, 0x80, 0x1b, 0x58, 0xff, 0xff};
+
+// COPY (SELECT CAST(col AS NUMERIC(76, 75)) AS col FROM (  VALUES
+// ('9.' || repeat('9', 75)), ('-0.' || repeat('123456789', 8) || '123'))
+// AS drvd(col)) TO STDOUT WITH (FORMAT binary);
+static uint8_t kTestPgCopyNumericMaxPrecision256[] = {
+    0x50, 0x47, 0x43, 0x4f, 0x50, 0x59, 0x0a, 0xff, 0x0d, 0x0a, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x30, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x00, 0x09, 0x27,
+    0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27,
+    0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27,
+    0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27, 0x0f, 0x27,
+    0x06, 0x00, 0x01, 0x00, 0x00, 0x00, 0x2e, 0x00, 0x13, 0xff, 0xff, 0x40,
+    0x00, 0x00, 0x4b, 0x04, 0xd2, 0x16, 0x2e, 0x23, 0xa3, 0x11, 0xd7, 0x22,
+    0xd0, 0x0d, 0x80, 0x1e, 0xd3, 0x09, 0x29, 0x1a, 0x85, 0x04, 0xd2, 0x16,
+    0x2e, 0x23, 0xa3, 0x11, 0xd7, 0x22, 0xd0, 0x0d, 0x80, 0x1e, 0xd3, 0x09,
+    0x29, 0x1a, 0x85, 0x04, 0xce, 0xff, 0xff};
+
+// Values at the full precision of the output, with a scale that is not a
+// multiple of 4 (so the last Postgres digit is padded with zeroes that
+// temporarily push the value past the precision)
+TEST(PostgresCopyUtilsTest, PostgresCopyReadNumericDecimalMaxPrecision) {
+  struct TestCase {
+    uint8_t* data;
+    size_t size;
+    int32_t precision;
+    int32_t scale;
+    const char* format;
+    // Little-endian 64-bit words of each expected value
+    std::vector<std::vector<uint64_t>> expected;
+  };
+
+  const TestCase test_cases[] = {
+      {kTestPgCopyNumericMaxPrecision128,
+       sizeof(kTestPgCopyNumericMaxPrecision128),
+       38,
+       37,
+       "d:38,37",
+       {{0x098a223fffffffffULL, 0x4b3b4ca85a86c47aULL},
+        {0xd2c571918360b479ULL, 0xff123b1a8199614aULL}}},
+      {kTestPgCopyNumericMaxPrecision256,
+       sizeof(kTestPgCopyNumericMaxPrecision256),
+       76,
+       75,
+       "d:76,75,256",
+       {{0xffffffffffffffffULL, 0x7775a5f171950fffULL, 0x0764b4abe8652979ULL,
+         0x161bcca7119915b5ULL},
+        {0x0a07b70c4eec957dULL, 0x0d7528e702e6cbbeULL, 0x9b0417ceb21d59b9ULL,
+         0xffba203d2f3448b7ULL}}},
+  };
+
+  for (const auto& test_case : test_cases) {
+    SCOPED_TRACE(test_case.format);
+    ArrowBufferView data;
+    data.data.as_uint8 = test_case.data;
+    data.size_bytes = static_cast<int64_t>(test_case.size);
+
+    PostgresType input_type(PostgresTypeId::kRecord);
+    input_type.AppendChild("col",
+                           NumericWithTypmod(test_case.precision, test_case.scale));
+
+    PostgresCopyReaderOptions options;
+    options.numeric_as_decimal = true;
+
+    PostgresCopyStreamTester tester;
+    ASSERT_EQ(tester.Init(input_type, nullptr, options), NANOARROW_OK);
+    ArrowError error;
+    ASSERT_EQ(tester.ReadAll(&data, &error), ENODATA) << error.message;
+
+    nanoarrow::UniqueArray array;
+    ASSERT_EQ(tester.GetArray(array.get()), NANOARROW_OK);
+    ASSERT_EQ(array->length, 2);
+    nanoarrow::UniqueSchema schema;
+    tester.GetSchema(schema.get());
+    ASSERT_STREQ(schema->children[0]->format, test_case.format);
+
+    nanoarrow::UniqueArrayView array_view;
+    ASSERT_EQ(ArrowArrayViewInitFromSchema(array_view.get(), schema.get(), nullptr),
+              NANOARROW_OK);
+    ASSERT_EQ(ArrowArrayViewSetArray(array_view.get(), array.get(), nullptr),
+              NANOARROW_OK);
+
+    const int bitwidth = test_case.precision > 38 ? 256 : 128;
+    struct ArrowDecimal decimal;
+    ArrowDecimalInit(&decimal, bitwidth, test_case.precision, test_case.scale);
+    for (int64_t i = 0; i < 2; i++) {
+      ArrowArrayViewGetDecimalUnsafe(array_view->children[0], i, &decimal);
+      for (int word = 0; word < decimal.n_words; word++) {
+        const int index = _ArrowIsLittleEndian() ? word : decimal.n_words - 1 - word;
+        EXPECT_EQ(decimal.words[index], test_case.expected[i][word])
+            << "value " << i << " word " << word;
+      }
+    }
+  }
+}
+
+TEST(PostgresCopyUtilsTest, PostgresCopyReadNumericDecimalSpecialValues) {
+  ArrowBufferView data;
+  data.data.as_uint8 = kTestPgCopyNumeric;
+  data.size_bytes = sizeof(kTestPgCopyNumeric);
+
+  PostgresType input_type(PostgresTypeId::kRecord);
+  input_type.AppendChild("col", NumericWithTypmod(20, 8));
+
+  PostgresCopyReaderOptions options;
+  options.numeric_as_decimal = true;
+
+  PostgresCopyStreamTester tester;
+  ASSERT_EQ(tester.Init(input_type, nullptr, options), NANOARROW_OK);
+  ArrowError error;
+  ASSERT_EQ(tester.ReadAll(&data, &error), EINVAL);
+  EXPECT_STREQ(error.message, "Can't convert Postgres numeric NaN to a decimal");
+}
+
+TEST(PostgresCopyUtilsTest, PostgresCopyReadNumericDecimalUnconstrained) {
+  // Without a declared precision and scale the column stays a string
+  PostgresType input_type(PostgresTypeId::kRecord);
+  input_type.AppendChild("col", PostgresType(PostgresTypeId::kNumeric));
+
+  PostgresCopyReaderOptions options;
+  options.numeric_as_decimal = true;
+
+  PostgresCopyStreamTester tester;
+  ASSERT_EQ(tester.Init(input_type, nullptr, options), NANOARROW_OK);
+  nanoarrow::UniqueSchema schema;
+  tester.GetSchema(schema.get());
+  ASSERT_STREQ(schema->children[0]->format, "u");
+}
+
 // COPY (SELECT CAST("col" AS TEXT) AS "col" FROM (  VALUES ('abc'), ('1234'),
 // (NULL::text)) AS drvd("col")) TO STDOUT WITH (FORMAT binary);
 static uint8_t kTestPgCopyText[] = {
@@ -610,6 +847,45 @@ TEST(PostgresCopyUtilsTest, PostgresCopyReadText) {
   ASSERT_EQ(std::string(data_buffer + 3, 4), "1234");
 }
 
+TEST(PostgresCopyUtilsTest, PostgresCopyReadTextReserve) {
+  auto col_type = PostgresType(PostgresTypeId::kText);
+  PostgresType input_type(PostgresTypeId::kRecord);
+  input_type.AppendChild("col", col_type);
+
+  PostgresCopyStreamTester tester;
+  ASSERT_EQ(tester.Init(input_type), NANOARROW_OK);
+
+  ArrowBufferView data;
+  data.data.as_uint8 = kTestPgCopyText;
+  data.size_bytes = sizeof(kTestPgCopyText);
+  ASSERT_EQ(tester.ReadAll(&data), ENODATA);
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(tester.GetArray(array.get()), NANOARROW_OK);
+  ASSERT_EQ(array->length, 3);
+
+  // Read a second batch with only the first row ('abc'): its buffers should
+  // have been reserved for three rows and seven bytes of text up front
+  std::vector<uint8_t> one_row(kTestPgCopyText, kTestPgCopyText + 28);
+  one_row.push_back(0xff);
+  one_row.push_back(0xff);
+  data.data.as_uint8 = one_row.data();
+  data.size_bytes = static_cast<int64_t>(one_row.size());
+  ASSERT_EQ(tester.ReadAll(&data), ENODATA);
+  array.reset();
+  ASSERT_EQ(tester.GetArray(array.get()), NANOARROW_OK);
+  ASSERT_EQ(array->length, 1);
+
+  EXPECT_GE(ArrowArrayBuffer(array->children[0], 1)->capacity_bytes,
+            4 * static_cast<int64_t>(sizeof(int32_t)));
+  EXPECT_GE(ArrowArrayBuffer(array->children[0], 2)->capacity_bytes, 7);
+
+  auto offsets = reinterpret_cast<const int32_t*>(array->children[0]->buffers[1]);
+  auto data_buffer = reinterpret_cast<const char*>(array->children[0]->buffers[2]);
+  ASSERT_EQ(offsets[0], 0);
+  ASSERT_EQ(offsets[1], 3);
+  ASSERT_EQ(std::string(data_buffer, 3), "abc");
+}
+
 // COPY (SELECT CAST("col" AS INTEGER ARRAY) AS "col" FROM (  VALUES ('{-123, -1}'), ('{0,
 // 1, 123}'), (NULL)) AS drvd("col")) TO STDOUT WITH (FORMAT binary);
 static uint8_t kTestPgCopyIntegerArray[] = {
@@ -19,8 +19,12 @@
 
 #include <cerrno>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -134,7 +138,8 @@ class PostgresTypeResolver;
 // is defined. It is intentionally copyable.
 class PostgresType {
  public:
-  explicit PostgresType(PostgresTypeId type_id) : oid_(0), type_id_(type_id) {}
+  explicit PostgresType(PostgresTypeId type_id)
+      : oid_(0), type_id_(type_id), typmod_(-1) {}
 
   PostgresType() : PostgresType(PostgresTypeId::kUninitialized) {}
 
@@ -164,6 +169,14 @@ class PostgresType {
     return out;
   }
 
+  // The type modifier of a particular column (e.g., the precision and scale
+  // of a NUMERIC), or -1 if not applicable or unknown
+  PostgresType WithTypmod(int32_t typmod) const {
+    PostgresType out(*this);
+    out.typmod_ = typmod;
+    return out;
+  }
+
   PostgresType Domain(uint32_t oid, const std::string& typname) {
     return WithPgTypeInfo(oid, typname);
   }
@@ -180,6 +193,7 @@ class PostgresType {
   PostgresTypeId type_id() const { return type_id_; }
   const std::string& typname() const { return typname_; }
   const std::string& field_name() const { return field_name_; }
+  int32_t typmod() const { return typmod_; }
   int64_t n_children() const { return static_cast<int64_t>(children_.size()); }
   const PostgresType& child(int64_t i) const { return children_[i]; }
 
@@ -304,6 +318,7 @@ class PostgresType {
  private:
   uint32_t oid_;
   PostgresTypeId type_id_;
+  int32_t typmod_;
   std::string typname_;
   std::string field_name_;
   std::vector<PostgresType> children_;
@@ -327,38 +342,83 @@ class PostgresTypeResolver {
     uint32_t class_oid;
   };
 
+  // A source of type and class definitions that have not been inserted yet.
+  // When a loader is set, a miss in Find() (or when resolving the columns of a
+  // record type) calls the loader, which is expected to Insert() or
+  // InsertClass() the definition into the given resolver, and the lookup is
+  // retried once. Calls into the loader are serialized by the resolver but may
+  // be nested (e.g., loading a record type loads the types of its columns).
+  // A loader returns ENOENT if the definition does not exist; such misses are
+  // remembered and not looked up again, while other errors are retried.
+  class Loader {
+   public:
+    virtual ~Loader() = default;
+    virtual ArrowErrorCode LoadType(uint32_t oid, PostgresTypeResolver* resolver,
+                                    ArrowError* error) = 0;
+    virtual ArrowErrorCode LoadClass(uint32_t oid, PostgresTypeResolver* resolver,
+                                     ArrowError* error) = 0;
+  };
+
   PostgresTypeResolver() : base_(AllBase()) {}
 
+  void SetLoader(std::shared_ptr<Loader> loader) {
+    std::lock_guard<std::recursive_mutex> guard(load_mutex_);
+    loader_ = std::move(loader);
+  }
+
   // Place a resolved copy of a PostgresType with the appropriate oid in type_out
   // if NANOARROW_OK is returned or place a null-terminated error message into error
-  // otherwise.
+  // otherwise. Lookups are thread-safe.
   ArrowErrorCode Find(uint32_t oid, PostgresType* type_out, ArrowError* error) const {
-    auto result = mapping_.find(oid);
-    if (result == mapping_.end()) {
+    if (FindLoaded(oid, type_out)) return NANOARROW_OK;
+
+    {
+      // Types loaded on demand are a cache, so the resolver is still logically
+      // const here
+      std::lock_guard<std::recursive_mutex> guard(load_mutex_);
+      if (loader_ && !FindLoaded(oid, type_out) &&
+          missing_types_.find(oid) == missing_types_.end()) {
+        int status =
+            loader_->LoadType(oid, const_cast<PostgresTypeResolver*>(this), error);
+        if (status == ENOENT || (status == NANOARROW_OK && !FindLoaded(oid, type_out))) {
+          missing_types_.insert(oid);
+        }
+        if (status != NANOARROW_OK) return status == ENOENT ? EINVAL : status;
+      }
+    }
+
+    if (!FindLoaded(oid, type_out)) {
       ArrowErrorSet(error, "Postgres type with oid %ld not found",
                     static_cast<long>(oid));  // NOLINT(runtime/int)
       return EINVAL;
     }
-
-    *type_out = (*result).second;
     return NANOARROW_OK;
   }
 
   ArrowErrorCode FindArray(uint32_t child_oid, PostgresType* type_out,
                            ArrowError* error) const {
-    auto array_oid_lookup = array_mapping_.find(child_oid);
-    if (array_oid_lookup == array_mapping_.end()) {
+    uint32_t array_oid = 0;
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      auto array_oid_lookup = array_mapping_.find(child_oid);
+      if (array_oid_lookup != array_mapping_.end()) {
+        array_oid = array_oid_lookup->second;
+      }
+    }
+
+    if (array_oid == 0) {
       ArrowErrorSet(error, "Postgres array type with child oid %ld not found",
                     static_cast<long>(child_oid));  // NOLINT(runtime/int)
       return EINVAL;
     }
 
-    return Find(array_oid_lookup->second, type_out, error);
+    return Find(array_oid, type_out, error);
   }
 
   // Resolve the oid for a given type_id. Returns 0 if the oid cannot be
   // resolved.
   uint32_t GetOID(PostgresTypeId type_id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     auto result = reverse_mapping_.find(static_cast<int32_t>(type_id));
     if (result == reverse_mapping_.end()) {
       return 0;
@@ -391,6 +451,7 @@ class PostgresTypeResolver {
       case PostgresTypeId::kArray: {
         PostgresType child;
         NANOARROW_RETURN_NOT_OK(Find(item.child_oid, &child, error));
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         mapping_.insert({item.oid, child.Array(item.oid, item.typname)});
         reverse_mapping_.insert({static_cast<int32_t>(base.type_id()), item.oid});
         array_mapping_.insert({child.oid(), item.oid});
@@ -408,6 +469,7 @@ class PostgresTypeResolver {
           out.AppendChild(child_item.first, child);
         }
 
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         mapping_.insert({item.oid, out.WithPgTypeInfo(item.oid, item.typname)});
         reverse_mapping_.insert({static_cast<int32_t>(base.type_id()), item.oid});
         break;
@@ -416,6 +478,7 @@ class PostgresTypeResolver {
       case PostgresTypeId::kDomain: {
         PostgresType base_type;
         NANOARROW_RETURN_NOT_OK(Find(item.base_oid, &base_type, error));
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         mapping_.insert({item.oid, base_type.Domain(item.oid, item.typname)});
         reverse_mapping_.insert({static_cast<int32_t>(base.type_id()), item.oid});
         break;
@@ -424,15 +487,18 @@ class PostgresTypeResolver {
       case PostgresTypeId::kRange: {
         PostgresType base_type;
         NANOARROW_RETURN_NOT_OK(Find(item.base_oid, &base_type, error));
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         mapping_.insert({item.oid, base_type.Range(item.oid, item.typname)});
         reverse_mapping_.insert({static_cast<int32_t>(base.type_id()), item.oid});
         break;
       }
 
-      default:
+      default: {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         mapping_.insert({item.oid, type});
         reverse_mapping_.insert({static_cast<int32_t>(base.type_id()), item.oid});
         break;
+      }
     }
 
     return NANOARROW_OK;
@@ -445,10 +511,20 @@ class PostgresTypeResolver {
   // respectively).
   void InsertClass(uint32_t oid,
                    const std::vector<std::pair<std::string, uint32_t>>& cls) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     classes_.insert({oid, cls});
   }
 
  private:
+  // Guards the lookup tables below (base_ is never modified after construction)
+  mutable std::shared_mutex mutex_;
+  // Serializes calls into the loader; recursive because loading one type may
+  // require loading others
+  mutable std::recursive_mutex load_mutex_;
+  std::shared_ptr<Loader> loader_;
+  // Definitions the loader reported as nonexistent (guarded by load_mutex_)
+  mutable std::unordered_set<uint32_t> missing_types_;
+  std::unordered_set<uint32_t> missing_classes_;
   std::unordered_map<uint32_t, PostgresType> mapping_;
   // We can't use PostgresTypeId as an unordered map key because there is no
   // built-in hasher for an enum on gcc 4.8 (i.e., R 3.6 on Windows).
@@ -457,17 +533,45 @@ class PostgresTypeResolver {
   std::unordered_map<uint32_t, std::vector<std::pair<std::string, uint32_t>>> classes_;
   std::unordered_map<std::string, PostgresType> base_;
 
+  bool FindLoaded(uint32_t oid, PostgresType* type_out) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto result = mapping_.find(oid);
+    if (result == mapping_.end()) return false;
+    *type_out = result->second;
+    return true;
+  }
+
+  bool FindLoadedClass(uint32_t oid,
+                       std::vector<std::pair<std::string, uint32_t>>* out) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto result = classes_.find(oid);
+    if (result == classes_.end()) return false;
+    *out = result->second;
+    return true;
+  }
+
   ArrowErrorCode ResolveClass(uint32_t oid,
                               std::vector<std::pair<std::string, uint32_t>>* out,
                               ArrowError* error) {
-    auto result = classes_.find(oid);
-    if (result == classes_.end()) {
+    if (FindLoadedClass(oid, out)) return NANOARROW_OK;
+
+    {
+      std::lock_guard<std::recursive_mutex> guard(load_mutex_);
+      if (loader_ && !FindLoadedClass(oid, out) &&
+          missing_classes_.find(oid) == missing_classes_.end()) {
+        int status = loader_->LoadClass(oid, this, error);
+        if (status == ENOENT || (status == NANOARROW_OK && !FindLoadedClass(oid, out))) {
+          missing_classes_.insert(oid);
+        }
+        if (status != NANOARROW_OK) return status == ENOENT ? EINVAL : status;
+      }
+    }
+
+    if (!FindLoadedClass(oid, out)) {
       ArrowErrorSet(error, "Class definition with oid %ld not found",
                     static_cast<long>(oid));  // NOLINT(runtime/int)
       return EINVAL;
     }
-
-    *out = result->second;
     return NANOARROW_OK;
   }
 
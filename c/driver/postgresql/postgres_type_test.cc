@@ -15,12 +15,17 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <thread>
 #include <utility>
 
 #include <gtest/gtest.h>
 #include <nanoarrow/nanoarrow.hpp>
 
 #include "postgres_type.h"
+#include "type_cache.h"
 
 namespace adbcpq {
 
@@ -395,4 +400,203 @@ TEST(PostgresTypeTest, PostgresTypeResolveRecord) {
   EXPECT_EQ(type.child(1).type_id(), PostgresTypeId::kText);
 }
 
+// Serves a record type (oid 100) whose class (oid 101) has an int4 and an
+// int4[] column, where the array type (oid 102) is also only known here.
+class MockTypeLoader : public PostgresTypeResolver::Loader {
+ public:
+  ArrowErrorCode LoadType(uint32_t oid, PostgresTypeResolver* resolver,
+                          ArrowError* error) override {
+    n_type_loads++;
+    PostgresTypeResolver::Item item;
+    item.oid = oid;
+    switch (oid) {
+      case 100:
+        item.typname = "lazyrecord";
+        item.typreceive = "record_recv";
+        item.class_oid = 101;
+        break;
+      case 102:
+        item.typname = "_int4";
+        item.typreceive = "array_recv";
+        item.child_oid = resolver->GetOID(PostgresTypeId::kInt4);
+        break;
+      case 103:
+        ArrowErrorSet(error, "connection lost");
+        return EIO;
+      default:
+        ArrowErrorSet(error, "no such type %d", static_cast<int>(oid));
+        return ENOENT;
+    }
+    return resolver->Insert(item, error);
+  }
+
+  ArrowErrorCode LoadClass(uint32_t oid, PostgresTypeResolver* resolver,
+                           ArrowError* error) override {
+    n_class_loads++;
+    if (oid != 101) return ENOENT;
+    resolver->InsertClass(
+        oid, {{"int4_col", resolver->GetOID(PostgresTypeId::kInt4)}, {"arr_col", 102}});
+    return NANOARROW_OK;
+  }
+
+  std::atomic<int> n_type_loads{0};
+  std::atomic<int> n_class_loads{0};
+};
+
+TEST(PostgresTypeTest, PostgresTypeResolverLoader) {
+  PostgresTypeResolver resolver;
+  PostgresTypeResolver::Item item;
+  item.oid = 23;
+  item.typname = "int4";
+  item.typreceive = "int4recv";
+  ASSERT_EQ(resolver.Insert(item, nullptr), NANOARROW_OK);
+
+  auto loader = std::make_shared<MockTypeLoader>();
+  resolver.SetLoader(loader);
+
+  // Nested load: the record loads its class, which references an array type
+  // that is loaded in turn
+  PostgresType type;
+  ArrowError error;
+  ASSERT_EQ(resolver.Find(100, &type, &error), NANOARROW_OK) << error.message;
+  EXPECT_EQ(type.type_id(), PostgresTypeId::kRecord);
+  ASSERT_EQ(type.n_children(), 2);
+  EXPECT_EQ(type.child(0).type_id(), PostgresTypeId::kInt4);
+  EXPECT_EQ(type.child(1).type_id(), PostgresTypeId::kArray);
+  EXPECT_EQ(type.child(1).child(0).oid(), 23);
+  EXPECT_EQ(loader->n_type_loads, 2);
+  EXPECT_EQ(loader->n_class_loads, 1);
+
+  // Loaded types are cached
+  ASSERT_EQ(resolver.Find(100, &type, &error), NANOARROW_OK);
+  ASSERT_EQ(resolver.Find(102, &type, &error), NANOARROW_OK);
+  EXPECT_EQ(loader->n_type_loads, 2);
+
+  // Loader errors are propagated
+  EXPECT_EQ(resolver.Find(999, &type, &error), EINVAL);
+  EXPECT_STREQ(ArrowErrorMessage(&error), "no such type 999");
+  EXPECT_EQ(loader->n_type_loads, 3);
+
+  // ...and a type that does not exist is not looked up again
+  EXPECT_EQ(resolver.Find(999, &type, &error), EINVAL);
+  EXPECT_STREQ(ArrowErrorMessage(&error), "Postgres type with oid 999 not found");
+  EXPECT_EQ(loader->n_type_loads, 3);
+
+  // ...but other errors are retried
+  EXPECT_EQ(resolver.Find(103, &type, &error), EIO);
+  EXPECT_EQ(resolver.Find(103, &type, &error), EIO);
+  EXPECT_EQ(loader->n_type_loads, 5);
+}
+
+TEST(PostgresTypeTest, PostgresTypeResolverLoaderConcurrent) {
+  PostgresTypeResolver resolver;
+  PostgresTypeResolver::Item item;
+  item.oid = 23;
+  item.typname = "int4";
+  item.typreceive = "int4recv";
+  ASSERT_EQ(resolver.Insert(item, nullptr), NANOARROW_OK);
+
+  auto loader = std::make_shared<MockTypeLoader>();
+  resolver.SetLoader(loader);
+
+  std::atomic<int> n_failed{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < 100; j++) {
+        PostgresType type;
+        if (resolver.Find(100 + 2 * (j % 2), &type, nullptr) != NANOARROW_OK ||
+            resolver.Find(23, &type, nullptr) != NANOARROW_OK) {
+          n_failed++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(n_failed, 0);
+  // Each type is loaded exactly once regardless of contention
+  EXPECT_EQ(loader->n_type_loads, 2);
+  EXPECT_EQ(loader->n_class_loads, 1);
+}
+
+TEST(PostgresTypeTest, PostgresTypeCatalogRoundTrip) {
+  PostgresTypeCatalog catalog;
+  catalog.version = "eager|postgres|5432|160000";
+  catalog.classes.push_back({200, {{"id", 23}, {"tags", 1009}}});
+
+  PostgresTypeRow int4;
+  int4.oid = 23;
+  int4.typname = "int4";
+  int4.typreceive = "int4recv";
+  int4.typarray = 1007;
+  PostgresTypeRow text;
+  text.oid = 25;
+  text.typname = "text";
+  text.typreceive = "textrecv";
+  text.typarray = 1009;
+  // Sorts before the class's column types, so it needs a second attempt
+  PostgresTypeRow record;
+  record.oid = 20;
+  record.typname = "some_table";
+  record.typreceive = "record_recv";
+  record.typrelid = 200;
+  catalog.types = {record, int4, text};
+
+  const std::string path = ::testing::TempDir() + "adbc_pg_type_cache_test.bin";
+  ASSERT_EQ(catalog.Write(path, nullptr), ADBC_STATUS_OK);
+
+  PostgresTypeCatalog read;
+  ASSERT_EQ(read.Read(path, nullptr), ADBC_STATUS_OK);
+  EXPECT_EQ(read.version, catalog.version);
+  ASSERT_EQ(read.classes.size(), 1);
+  EXPECT_EQ(read.classes[0].columns, catalog.classes[0].columns);
+  ASSERT_EQ(read.types.size(), 3);
+
+  PostgresTypeResolver resolver;
+  read.Populate(&resolver);
+  PostgresType type;
+  ASSERT_EQ(resolver.Find(20, &type, nullptr), NANOARROW_OK);
+  ASSERT_EQ(type.n_children(), 2);
+  EXPECT_EQ(type.child(0).field_name(), "id");
+  EXPECT_EQ(type.child(0).type_id(), PostgresTypeId::kInt4);
+  EXPECT_EQ(type.child(1).type_id(), PostgresTypeId::kArray);
+  EXPECT_EQ(type.child(1).child(0).type_id(), PostgresTypeId::kText);
+  ASSERT_EQ(resolver.FindArray(23, &type, nullptr), NANOARROW_OK);
+  EXPECT_EQ(type.oid(), 1007);
+
+  // Truncated or otherwise invalid files are treated as a cache miss
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "ADBCPGTC";
+  }
+  EXPECT_EQ(read.Read(path, nullptr), ADBC_STATUS_NOT_FOUND);
+  EXPECT_TRUE(read.types.empty());
+
+  // As are counts larger than the rest of the file (which must be rejected
+  // before allocating for them)
+  for (uint32_t n_classes : {uint32_t(0xFFFFFFFF), uint32_t(0)}) {
+    {
+      std::ofstream file(path, std::ios::binary | std::ios::trunc);
+      auto write_u32 = [&](uint32_t value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+      };
+      file << "ADBCPGTC";
+      write_u32(1);
+      write_u32(0x01020304);
+      write_u32(1);
+      file << "v";
+      write_u32(n_classes);
+      // n_types
+      write_u32(0xFFFFFFFF);
+    }
+    EXPECT_EQ(read.Read(path, nullptr), ADBC_STATUS_NOT_FOUND);
+    EXPECT_TRUE(read.classes.empty());
+    EXPECT_TRUE(read.types.empty());
+  }
+
+  std::remove(path.c_str());
+  EXPECT_EQ(read.Read(path, nullptr), ADBC_STATUS_NOT_FOUND);
+}
+
 }  // namespace adbcpq
@@ -17,11 +17,14 @@
 
 #include <cerrno>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <limits>
 #include <optional>
 #include <variant>
+#include <vector>
 
 #include <adbc.h>
 #include <gtest/gtest-param-test.h>
@@ -161,6 +164,101 @@ TEST_F(PostgresDatabaseTest, AdbcDriverBackwardsCompatibility) {
   free(driver);
 }
 
+TEST_F(PostgresDatabaseTest, LazyTypeResolver) {
+  ASSERT_THAT(AdbcDatabaseNew(&database, &error), IsOkStatus(&error));
+  ASSERT_THAT(quirks()->SetupDatabase(&database, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database, ADBC_POSTGRESQL_OPTION_TYPE_RESOLVER,
+                                    "sometimes", &error),
+              IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+  ASSERT_THAT(AdbcDatabaseSetOption(&database, ADBC_POSTGRESQL_OPTION_TYPE_RESOLVER,
+                                    "lazy", &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database, &error), IsOkStatus(&error));
+
+  Handle<struct AdbcConnection> connection;
+  ASSERT_THAT(AdbcConnectionNew(&connection.value, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection.value, &database, &error),
+              IsOkStatus(&error));
+
+  // A table created after Init() is unknown until a result references its
+  // row type
+  ASSERT_THAT(quirks()->DropTable(&connection.value, "lazytype", &error),
+              IsOkStatus(&error));
+  {
+    Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(
+                    &statement.value,
+                    "CREATE TABLE lazytype (ints INT4, texts TEXT[]); "
+                    "INSERT INTO lazytype VALUES (1, ARRAY['a', 'b'])",
+                    &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error),
+                IsOkStatus(&error));
+  }
+
+  Handle<struct AdbcStatement> statement;
+  ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value,
+                                       "SELECT lazytype FROM lazytype", &error),
+              IsOkStatus(&error));
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                        &reader.rows_affected, &error),
+              IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  ASSERT_EQ(1, reader.fields.size());
+  ASSERT_EQ(NANOARROW_TYPE_STRUCT, reader.fields[0].type);
+  ASSERT_EQ(2, reader.schema->children[0]->n_children);
+  ASSERT_STREQ("ints", reader.schema->children[0]->children[0]->name);
+  ASSERT_STREQ("texts", reader.schema->children[0]->children[1]->name);
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_EQ(1, reader.array->length);
+
+  ASSERT_THAT(quirks()->DropTable(&connection.value, "lazytype", &error),
+              IsOkStatus(&error));
+}
+
+TEST_F(PostgresDatabaseTest, TypeCache) {
+  const std::string path = ::testing::TempDir() + "adbc_postgresql_type_cache.bin";
+  std::remove(path.c_str());
+
+  // The first database writes the cache; the second reads it
+  for (int i = 0; i < 2; i++) {
+    Handle<struct AdbcDatabase> db;
+    ASSERT_THAT(AdbcDatabaseNew(&db.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(quirks()->SetupDatabase(&db.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcDatabaseSetOption(&db.value, ADBC_POSTGRESQL_OPTION_TYPE_CACHE_PATH,
+                                      path.c_str(), &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcDatabaseInit(&db.value, &error), IsOkStatus(&error));
+    ASSERT_EQ(0, std::ifstream(path).fail());
+
+    Handle<struct AdbcConnection> connection;
+    ASSERT_THAT(AdbcConnectionNew(&connection.value, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcConnectionInit(&connection.value, &db.value, &error),
+                IsOkStatus(&error));
+    Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection.value, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value,
+                                         "SELECT 1::INT4, 'a'::TEXT, ARRAY[1.5]", &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          &reader.rows_affected, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_EQ(NANOARROW_TYPE_INT32, reader.fields[0].type);
+    ASSERT_EQ(NANOARROW_TYPE_STRING, reader.fields[1].type);
+    ASSERT_EQ(NANOARROW_TYPE_LIST, reader.fields[2].type);
+  }
+
+  std::remove(path.c_str());
+}
+
 class PostgresConnectionTest : public ::testing::Test,
                                public adbc_validation::ConnectionTest {
  public:
@@ -543,6 +641,64 @@ TEST_F(PostgresConnectionTest, GetObjectsTableTypesFilter) {
   ASSERT_NE(view, nullptr) << "did not find view adbc_table_types_view_test";
 }
 
+TEST_F(PostgresConnectionTest, GetObjectsUnderscoreTableName) {
+  ASSERT_THAT(AdbcConnectionNew(&connection, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection, &database, &error), IsOkStatus(&error));
+
+  // '_' is a LIKE wildcard, so adbc_like_test also matches adbcxlikextest
+  ASSERT_THAT(quirks()->DropTable(&connection, "adbc_like_test", &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(quirks()->DropTable(&connection, "adbcxlikextest", &error),
+              IsOkStatus(&error));
+
+  for (const char* query : {"CREATE TABLE adbc_like_test (a INT)",
+                            "CREATE TABLE adbcxlikextest (b INT, c INT)"}) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, query, &error),
+                IsOkStatus(&error));
+    int64_t rows_affected = 0;
+    ASSERT_THAT(
+        AdbcStatementExecuteQuery(&statement.value, nullptr, &rows_affected, &error),
+        IsOkStatus(&error));
+  }
+
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(
+      AdbcConnectionGetObjects(&connection, ADBC_OBJECT_DEPTH_ALL, nullptr, nullptr,
+                               nullptr, nullptr, nullptr, &reader.stream.value, &error),
+      IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_NE(nullptr, reader.array->release);
+  ASSERT_GT(reader.array->length, 0);
+
+  auto get_objects_data = adbc_validation::GetObjectsReader{&reader.array_view.value};
+  ASSERT_NE(*get_objects_data, nullptr)
+      << "could not initialize the AdbcGetObjectsData object";
+
+  // Each table has only its own columns
+  struct AdbcGetObjectsTable* table = AdbcGetObjectsDataGetTableByName(
+      *get_objects_data, "postgres", "public", "adbc_like_test");
+  ASSERT_NE(table, nullptr) << "could not find adbc_like_test table";
+  ASSERT_EQ(table->n_table_columns, 1);
+  ASSERT_NE(AdbcGetObjectsDataGetColumnByName(*get_objects_data, "postgres", "public",
+                                              "adbc_like_test", "a"),
+            nullptr);
+  ASSERT_EQ(AdbcGetObjectsDataGetColumnByName(*get_objects_data, "postgres", "public",
+                                              "adbc_like_test", "b"),
+            nullptr);
+
+  table = AdbcGetObjectsDataGetTableByName(*get_objects_data, "postgres", "public",
+                                           "adbcxlikextest");
+  ASSERT_NE(table, nullptr) << "could not find adbcxlikextest table";
+  ASSERT_EQ(table->n_table_columns, 2);
+  ASSERT_EQ(AdbcGetObjectsDataGetColumnByName(*get_objects_data, "postgres", "public",
+                                              "adbcxlikextest", "a"),
+            nullptr);
+}
+
 TEST_F(PostgresConnectionTest, MetadataSetCurrentDbSchema) {
   ASSERT_THAT(AdbcConnectionNew(&connection, &error), IsOkStatus(&error));
   ASSERT_THAT(AdbcConnectionInit(&connection, &database, &error), IsOkStatus(&error));
@@ -773,6 +929,72 @@ TEST_F(PostgresConnectionTest, MetadataGetStatistics) {
                   }));
 }
 
+TEST_F(PostgresConnectionTest, MetadataGetStatisticsCached) {
+  if (!quirks()->supports_statistics()) {
+    GTEST_SKIP();
+  }
+
+  ASSERT_THAT(AdbcDatabaseSetOption(&database, "adbc.postgresql.statistics_cache_ttl",
+                                    "3600", &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionNew(&connection, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection, &database, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionSetOption(&connection,
+                                      "adbc.postgresql.statistics_row_count_only",
+                                      ADBC_OPTION_VALUE_ENABLED, &error),
+              IsOkStatus(&error));
+
+  auto execute = [&](const char* query) {
+    adbc_validation::Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, query, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error),
+                IsOkStatus(&error));
+  };
+  // Get the (only) statistic reported for the table, which must be its row count
+  auto row_count = [&](double* out) {
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(
+        AdbcConnectionGetStatistics(&connection, nullptr, quirks()->db_schema().c_str(),
+                                    "statstable", 1, &reader.stream.value, &error),
+        IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_NE(reader.array->release, nullptr);
+    struct ArrowArrayView* stats =
+        reader.array_view->children[1]->children[0]->children[1]->children[0];
+    ASSERT_EQ(stats->length, 1);
+    ASSERT_EQ(ArrowArrayViewGetIntUnsafe(stats->children[2], 0),
+              ADBC_STATISTIC_ROW_COUNT_KEY);
+    *out = ArrowArrayViewGetDoubleUnsafe(stats->children[3]->children[2], 0);
+  };
+
+  ASSERT_NO_FATAL_FAILURE(execute("DROP TABLE IF EXISTS statstable"));
+  ASSERT_NO_FATAL_FAILURE(execute("CREATE TABLE statstable (ints INT, strs TEXT)"));
+  ASSERT_NO_FATAL_FAILURE(
+      execute("INSERT INTO statstable VALUES (1, 'a'), (NULL, 'bcd'), (-5, NULL)"));
+  ASSERT_NO_FATAL_FAILURE(execute("ANALYZE statstable"));
+
+  double value = 0;
+  ASSERT_NO_FATAL_FAILURE(row_count(&value));
+  ASSERT_EQ(value, 3);
+
+  // Within the TTL, the cached statistics are returned even if they are stale
+  ASSERT_NO_FATAL_FAILURE(execute("INSERT INTO statstable VALUES (2, 'e')"));
+  ASSERT_NO_FATAL_FAILURE(execute("ANALYZE statstable"));
+  ASSERT_NO_FATAL_FAILURE(row_count(&value));
+  ASSERT_EQ(value, 3);
+
+  // Changing the TTL drops the cache
+  ASSERT_THAT(AdbcDatabaseSetOption(&database, "adbc.postgresql.statistics_cache_ttl",
+                                    "0", &error),
+              IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(row_count(&value));
+  ASSERT_EQ(value, 4);
+}
+
 ADBCV_TEST_CONNECTION(PostgresConnectionTest)
 
 class PostgresStatementTest : public ::testing::Test,
@@ -1023,6 +1245,192 @@ TEST_F(PostgresStatementTest, SqlIngestTimestampOverflow) {
   }
 }
 
+// Slice off the first row of every column of a batch (as e.g. slicing a
+// record batch and exporting it does), without touching the buffers
+static void SliceFirstRow(struct ArrowArray* batch) {
+  for (int64_t i = 0; i < batch->n_children; i++) {
+    batch->children[i]->offset++;
+    batch->children[i]->length--;
+    batch->children[i]->null_count = -1;
+  }
+  batch->length--;
+}
+
+TEST_F(PostgresStatementTest, SqlBindSlicedBatch) {
+  ASSERT_THAT(quirks()->DropTable(&connection, "adbc_bind_sliced_test", &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetSqlQuery(
+                  &statement,
+                  "CREATE TABLE adbc_bind_sliced_test (b BOOLEAN, i2 SMALLINT, "
+                  "i4 INTEGER, i8 BIGINT, f4 REAL, f8 DOUBLE PRECISION, d DATE, "
+                  "ts TIMESTAMP, dur INTERVAL, iv INTERVAL)",
+                  &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error),
+              IsOkStatus(&error));
+
+  adbc_validation::Handle<struct ArrowSchema> schema;
+  adbc_validation::Handle<struct ArrowArray> batch;
+
+  const ArrowType types[] = {NANOARROW_TYPE_BOOL,
+                             NANOARROW_TYPE_INT16,
+                             NANOARROW_TYPE_INT32,
+                             NANOARROW_TYPE_INT64,
+                             NANOARROW_TYPE_FLOAT,
+                             NANOARROW_TYPE_DOUBLE,
+                             NANOARROW_TYPE_DATE32,
+                             NANOARROW_TYPE_TIMESTAMP,
+                             NANOARROW_TYPE_DURATION,
+                             NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO};
+  ArrowSchemaInit(&schema.value);
+  ASSERT_THAT(ArrowSchemaSetTypeStruct(&schema.value, 10), adbc_validation::IsOkErrno());
+  for (int64_t i = 0; i < 10; i++) {
+    const std::string name = "$" + std::to_string(i + 1);
+    ASSERT_THAT(ArrowSchemaSetName(schema->children[i], name.c_str()),
+                adbc_validation::IsOkErrno());
+    if (types[i] == NANOARROW_TYPE_TIMESTAMP || types[i] == NANOARROW_TYPE_DURATION) {
+      ASSERT_THAT(ArrowSchemaSetTypeDateTime(schema->children[i], types[i],
+                                             NANOARROW_TIME_UNIT_SECOND, nullptr),
+                  adbc_validation::IsOkErrno());
+    } else {
+      ASSERT_THAT(ArrowSchemaSetType(schema->children[i], types[i]),
+                  adbc_validation::IsOkErrno());
+    }
+  }
+
+  struct ArrowInterval skipped, interval1, interval2;
+  ArrowIntervalInit(&skipped, NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO);
+  ArrowIntervalInit(&interval1, NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO);
+  ArrowIntervalInit(&interval2, NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO);
+  skipped.months = 99;
+  interval1.months = 1;
+  interval1.days = 2;
+  interval1.ns = 3000;
+  interval2.months = -1;
+  interval2.days = -2;
+  interval2.ns = -3000;
+
+  // The first row is sliced away, so its out-of-range values must not be
+  // encoded (or reported)
+  ASSERT_THAT((adbc_validation::MakeBatch<bool, int16_t, int32_t, int64_t, float, double,
+                                          int32_t, int64_t, int64_t, ArrowInterval*>(
+                  &schema.value, &batch.value, static_cast<struct ArrowError*>(nullptr),
+                  {true, false, true}, {-1, 2, -3}, {100, 200, std::nullopt}, {7, 8, 9},
+                  {0.5, 1.5, 2.5}, {0.25, 1.25, 2.25},
+                  {std::numeric_limits<int32_t>::min(), 19000, -100},
+                  {std::numeric_limits<int64_t>::max(), 1600000000, 0},
+                  {std::numeric_limits<int64_t>::min(), 60, -1},
+                  {&skipped, &interval1, &interval2})),
+              adbc_validation::IsOkErrno());
+  SliceFirstRow(&batch.value);
+
+  ASSERT_THAT(AdbcStatementSetSqlQuery(&statement,
+                                       "INSERT INTO adbc_bind_sliced_test VALUES "
+                                       "($1, $2, $3, $4, $5, $6, $7, $8, $9, $10)",
+                                       &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementBind(&statement, &batch.value, &schema.value, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementPrepare(&statement, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error),
+              IsOkStatus(&error));
+
+  ASSERT_THAT(AdbcStatementSetSqlQuery(
+                  &statement, "SELECT * FROM adbc_bind_sliced_test ORDER BY i8", &error),
+              IsOkStatus(&error));
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(AdbcStatementExecuteQuery(&statement, &reader.stream.value,
+                                        &reader.rows_affected, &error),
+              IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_NE(nullptr, reader.array->release);
+  ASSERT_EQ(2, reader.array->length);
+
+  struct ArrowArrayView** columns = reader.array_view->children;
+  ASSERT_NO_FATAL_FAILURE(adbc_validation::CompareArray<bool>(columns[0], {false, true}));
+  ASSERT_NO_FATAL_FAILURE(adbc_validation::CompareArray<int16_t>(columns[1], {2, -3}));
+  ASSERT_NO_FATAL_FAILURE(
+      adbc_validation::CompareArray<int32_t>(columns[2], {200, std::nullopt}));
+  ASSERT_NO_FATAL_FAILURE(adbc_validation::CompareArray<int64_t>(columns[3], {8, 9}));
+  ASSERT_NO_FATAL_FAILURE(adbc_validation::CompareArray<float>(columns[4], {1.5, 2.5}));
+  ASSERT_NO_FATAL_FAILURE(
+      adbc_validation::CompareArray<double>(columns[5], {1.25, 2.25}));
+  ASSERT_NO_FATAL_FAILURE(
+      adbc_validation::CompareArray<int32_t>(columns[6], {19000, -100}));
+  ASSERT_NO_FATAL_FAILURE(
+      adbc_validation::CompareArray<int64_t>(columns[7], {1600000000000000, 0}));
+
+  struct ArrowInterval duration1, duration2;
+  ArrowIntervalInit(&duration1, NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO);
+  ArrowIntervalInit(&duration2, NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO);
+  duration1.ns = 60000000000;
+  duration2.ns = -1000000000;
+  ASSERT_NO_FATAL_FAILURE(
+      adbc_validation::CompareArray<ArrowInterval*>(columns[8],
+                                                    {&duration1, &duration2}));
+  ASSERT_NO_FATAL_FAILURE(
+      adbc_validation::CompareArray<ArrowInterval*>(columns[9],
+                                                    {&interval1, &interval2}));
+
+  ASSERT_NO_FATAL_FAILURE(reader.Next());
+  ASSERT_EQ(nullptr, reader.array->release);
+}
+
+TEST_F(PostgresStatementTest, SqlBindSlicedBatchOutOfRange) {
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error), IsOkStatus(&error));
+
+  for (const ArrowType type :
+       {NANOARROW_TYPE_DATE32, NANOARROW_TYPE_TIMESTAMP, NANOARROW_TYPE_DURATION}) {
+    SCOPED_TRACE(ArrowTypeString(type));
+    adbc_validation::Handle<struct ArrowSchema> schema;
+    adbc_validation::Handle<struct ArrowArray> batch;
+
+    ArrowSchemaInit(&schema.value);
+    ASSERT_THAT(ArrowSchemaSetTypeStruct(&schema.value, 1), adbc_validation::IsOkErrno());
+    ASSERT_THAT(ArrowSchemaSetName(schema->children[0], "$1"),
+                adbc_validation::IsOkErrno());
+    if (type == NANOARROW_TYPE_DATE32) {
+      ASSERT_THAT(ArrowSchemaSetType(schema->children[0], type),
+                  adbc_validation::IsOkErrno());
+      ASSERT_THAT((adbc_validation::MakeBatch<int32_t>(
+                      &schema.value, &batch.value,
+                      static_cast<struct ArrowError*>(nullptr),
+                      {0, 0, std::numeric_limits<int32_t>::min()})),
+                  adbc_validation::IsOkErrno());
+    } else {
+      ASSERT_THAT(ArrowSchemaSetTypeDateTime(schema->children[0], type,
+                                             NANOARROW_TIME_UNIT_SECOND, nullptr),
+                  adbc_validation::IsOkErrno());
+      ASSERT_THAT((adbc_validation::MakeBatch<int64_t>(
+                      &schema.value, &batch.value,
+                      static_cast<struct ArrowError*>(nullptr),
+                      {0, 0, std::numeric_limits<int64_t>::max()})),
+                  adbc_validation::IsOkErrno());
+    }
+    SliceFirstRow(&batch.value);
+
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement, "SELECT $1", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementBind(&statement, &batch.value, &schema.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementPrepare(&statement, &error), IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error),
+                IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+    // Rows are numbered within the (sliced) batch
+    if (type == NANOARROW_TYPE_DATE32) {
+      ASSERT_THAT(error.message, ::testing::HasSubstr("Row #2"));
+      ASSERT_THAT(error.message, ::testing::HasSubstr("exceeds postgres date limits"));
+    } else {
+      ASSERT_THAT(error.message,
+                  ::testing::HasSubstr("Row #2 has value '9223372036854775807' which "
+                                       "exceeds PostgreSQL timestamp limits"));
+    }
+    error.release(&error);
+  }
+}
+
 TEST_F(PostgresStatementTest, SqlReadIntervalOverflow) {
   ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error), IsOkStatus(&error));
 
@@ -1167,6 +1575,386 @@ TEST_F(PostgresStatementTest, BatchSizeHint) {
   }
 }
 
+TEST_F(PostgresStatementTest, NumericConversionDecimal) {
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error), IsOkStatus(&error));
+
+  ASSERT_EQ(AdbcStatementSetOption(&statement, "adbc.postgresql.numeric_conversion",
+                                   "float", nullptr),
+            ADBC_STATUS_INVALID_ARGUMENT);
+  ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.postgresql.numeric_conversion",
+                                     "decimal", &error),
+              IsOkStatus(&error));
+
+  {
+    ASSERT_THAT(AdbcStatementSetSqlQuery(
+                    &statement,
+                    "SELECT CAST(col AS NUMERIC(10, 2)) AS col, "
+                    "CAST(col AS NUMERIC) AS unconstrained "
+                    "FROM (VALUES ('-123.45'), (NULL)) AS drvd(col)",
+                    &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, &reader.stream.value,
+                                          &reader.rows_affected, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_STREQ(reader.schema->children[0]->format, "d:10,2");
+    ASSERT_STREQ(reader.schema->children[1]->format, "u");
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(reader.array->length, 2);
+
+    struct ArrowDecimal decimal;
+    ArrowDecimalInit(&decimal, 128, 10, 2);
+    ArrowArrayViewGetDecimalUnsafe(reader.array_view->children[0], 0, &decimal);
+    ASSERT_EQ(ArrowDecimalGetIntUnsafe(&decimal), -12345);
+    ASSERT_TRUE(ArrowArrayViewIsNull(reader.array_view->children[0], 1));
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(reader.array->release, nullptr);
+  }
+
+  ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.postgresql.numeric_special_values",
+                                     "null", &error),
+              IsOkStatus(&error));
+
+  {
+    ASSERT_THAT(AdbcStatementSetSqlQuery(
+                    &statement, "SELECT CAST('NaN' AS NUMERIC(10, 2)) AS col", &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, &reader.stream.value,
+                                          &reader.rows_affected, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(reader.array->length, 1);
+    ASSERT_TRUE(ArrowArrayViewIsNull(reader.array_view->children[0], 0));
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(reader.array->release, nullptr);
+  }
+}
+
+TEST_F(PostgresStatementTest, ResultTransport) {
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error), IsOkStatus(&error));
+
+  ASSERT_EQ(AdbcStatementSetOption(&statement, "adbc.postgresql.result_transport",
+                                   "portal", nullptr),
+            ADBC_STATUS_INVALID_ARGUMENT);
+  ASSERT_EQ(AdbcStatementSetOption(&statement, "adbc.postgresql.cursor_fetch_rows", "0",
+                                   nullptr),
+            ADBC_STATUS_INVALID_ARGUMENT);
+  // Fetch fewer rows per round trip than the query returns
+  ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.postgresql.cursor_fetch_rows",
+                                     "2", &error),
+              IsOkStatus(&error));
+
+  for (const char* transport : {"copy", "cursor", "single_row"}) {
+    SCOPED_TRACE(transport);
+    ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.postgresql.result_transport",
+                                       transport, &error),
+                IsOkStatus(&error));
+
+    ASSERT_THAT(AdbcStatementSetSqlQuery(
+                    &statement,
+                    "SELECT i AS ints, CAST(i AS TEXT) AS strs "
+                    "FROM generate_series(1, 5) AS i "
+                    "UNION ALL SELECT NULL, NULL",
+                    &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, &reader.stream.value,
+                                          &reader.rows_affected, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_EQ(reader.fields.size(), 2);
+    ASSERT_EQ(reader.fields[0].type, NANOARROW_TYPE_INT32);
+    ASSERT_EQ(reader.fields[1].type, NANOARROW_TYPE_STRING);
+
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_NE(reader.array->release, nullptr);
+    ASSERT_EQ(reader.array->length, 6);
+    for (int64_t i = 0; i < 5; i++) {
+      ASSERT_EQ(ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], i), i + 1);
+      struct ArrowStringView value =
+          ArrowArrayViewGetStringUnsafe(reader.array_view->children[1], i);
+      ASSERT_EQ(std::string(value.data, value.size_bytes), std::to_string(i + 1));
+    }
+    ASSERT_TRUE(ArrowArrayViewIsNull(reader.array_view->children[0], 5));
+    ASSERT_TRUE(ArrowArrayViewIsNull(reader.array_view->children[1], 5));
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(reader.array->release, nullptr);
+  }
+
+  // A stream released early must leave the connection usable
+  for (const char* transport : {"cursor", "single_row"}) {
+    SCOPED_TRACE(transport);
+    ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.postgresql.result_transport",
+                                       transport, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcStatementSetOption(&statement, "adbc.postgresql.batch_size_hint_bytes", "1",
+                               &error),
+        IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetSqlQuery(
+                    &statement, "SELECT * FROM generate_series(1, 100000)", &error),
+                IsOkStatus(&error));
+    {
+      adbc_validation::StreamReader reader;
+      ASSERT_THAT(AdbcStatementExecuteQuery(&statement, &reader.stream.value,
+                                            &reader.rows_affected, &error),
+                  IsOkStatus(&error));
+      ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+      ASSERT_EQ(reader.array->length, 1);
+    }
+
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement, "SELECT 1", &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, &reader.stream.value,
+                                          &reader.rows_affected, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(reader.array->length, 1);
+  }
+}
+
+TEST_F(PostgresStatementTest, SqlIngestParallel) {
+  ASSERT_THAT(quirks()->DropTable(&connection, "bulk_ingest", &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error), IsOkStatus(&error));
+
+  ASSERT_EQ(AdbcStatementSetOption(&statement, "adbc.postgresql.ingest_connections", "0",
+                                   nullptr),
+            ADBC_STATUS_INVALID_ARGUMENT);
+  ASSERT_EQ(AdbcStatementSetOption(&statement, "adbc.postgresql.ingest_commit", "eager",
+                                   nullptr),
+            ADBC_STATUS_INVALID_ARGUMENT);
+
+  // Enough rows that every connection gets at least one task
+  constexpr int64_t kRows = 5000;
+  std::vector<std::optional<int64_t>> values;
+  for (int64_t i = 0; i < kRows; i++) {
+    values.push_back(i);
+  }
+
+  // Each commit mode, loading the target directly and through a staging table
+  const std::vector<std::pair<const char*, const char*>> configs = {
+      {"deferred", ADBC_OPTION_VALUE_DISABLED},
+      {"two_phase", ADBC_OPTION_VALUE_DISABLED},
+      {"deferred", ADBC_OPTION_VALUE_ENABLED},
+      {"two_phase", ADBC_OPTION_VALUE_ENABLED},
+  };
+  for (const auto& config : configs) {
+    const char* commit = config.first;
+    SCOPED_TRACE(std::string(commit) + " staging=" + config.second);
+    adbc_validation::Handle<struct ArrowSchema> schema;
+    adbc_validation::Handle<struct ArrowArray> batch;
+
+    ArrowSchemaInit(&schema.value);
+    ASSERT_THAT(ArrowSchemaSetTypeStruct(&schema.value, 1), adbc_validation::IsOkErrno());
+    ASSERT_THAT(ArrowSchemaSetType(schema->children[0], NANOARROW_TYPE_INT64),
+                adbc_validation::IsOkErrno());
+    ASSERT_THAT(ArrowSchemaSetName(schema->children[0], "ints"),
+                adbc_validation::IsOkErrno());
+    ASSERT_THAT((adbc_validation::MakeBatch<int64_t>(
+                    &schema.value, &batch.value, static_cast<struct ArrowError*>(nullptr),
+                    values)),
+                adbc_validation::IsOkErrno());
+
+    ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_TARGET_TABLE,
+                                       "bulk_ingest", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_MODE,
+                                       ADBC_INGEST_OPTION_MODE_REPLACE, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.postgresql.ingest_connections",
+                                       "3", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.postgresql.ingest_commit",
+                                       commit, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.postgresql.ingest_staging",
+                                       config.second, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementBind(&statement, &batch.value, &schema.value, &error),
+                IsOkStatus(&error));
+
+    int64_t rows_affected = 0;
+    auto status = AdbcStatementExecuteQuery(&statement, nullptr, &rows_affected, &error);
+    if (std::string(commit) == "two_phase" && status != ADBC_STATUS_OK &&
+        std::strstr(error.message, "prepared transactions") != nullptr) {
+      // The server was started with max_prepared_transactions = 0
+      error.release(&error);
+      continue;
+    }
+    ASSERT_THAT(status, IsOkStatus(&error));
+    ASSERT_EQ(rows_affected, kRows);
+
+    ASSERT_THAT(AdbcStatementSetSqlQuery(&statement, "SELECT COUNT(*) FROM bulk_ingest",
+                                         &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, &reader.stream.value,
+                                          &reader.rows_affected, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(reader.array->length, 1);
+    ASSERT_EQ(ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], 0), kRows);
+  }
+
+  // Temporary tables are only visible to the statement's own connection
+  {
+    adbc_validation::Handle<struct ArrowSchema> schema;
+    adbc_validation::Handle<struct ArrowArray> batch;
+
+    ArrowSchemaInit(&schema.value);
+    ASSERT_THAT(ArrowSchemaSetTypeStruct(&schema.value, 1), adbc_validation::IsOkErrno());
+    ASSERT_THAT(ArrowSchemaSetType(schema->children[0], NANOARROW_TYPE_INT64),
+                adbc_validation::IsOkErrno());
+    ASSERT_THAT(ArrowSchemaSetName(schema->children[0], "ints"),
+                adbc_validation::IsOkErrno());
+    ASSERT_THAT((adbc_validation::MakeBatch<int64_t>(
+                    &schema.value, &batch.value, static_cast<struct ArrowError*>(nullptr),
+                    {1, 2, 3})),
+                adbc_validation::IsOkErrno());
+
+    ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_TARGET_TABLE,
+                                       "bulk_ingest", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_TEMPORARY,
+                                       ADBC_OPTION_VALUE_ENABLED, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementBind(&statement, &batch.value, &schema.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error),
+                IsStatus(ADBC_STATUS_INVALID_STATE, &error));
+  }
+}
+
+TEST_F(PostgresStatementTest, SqlIngestStaged) {
+  ASSERT_THAT(quirks()->DropTable(&connection, "bulk_ingest", &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error), IsOkStatus(&error));
+
+  ASSERT_EQ(AdbcStatementSetOption(&statement, "adbc.postgresql.ingest_staging", "maybe",
+                                   nullptr),
+            ADBC_STATUS_INVALID_ARGUMENT);
+
+  // Each mode's expected row count afterwards
+  const std::vector<std::pair<const char*, int64_t>> modes = {
+      {ADBC_INGEST_OPTION_MODE_CREATE, 4},
+      {ADBC_INGEST_OPTION_MODE_APPEND, 8},
+      {ADBC_INGEST_OPTION_MODE_CREATE_APPEND, 12},
+      {ADBC_INGEST_OPTION_MODE_REPLACE, 4},
+  };
+  for (const auto& mode : modes) {
+    SCOPED_TRACE(mode.first);
+    adbc_validation::Handle<struct ArrowSchema> schema;
+    adbc_validation::Handle<struct ArrowArray> batch;
+
+    ArrowSchemaInit(&schema.value);
+    ASSERT_THAT(ArrowSchemaSetTypeStruct(&schema.value, 2), adbc_validation::IsOkErrno());
+    ASSERT_THAT(ArrowSchemaSetType(schema->children[0], NANOARROW_TYPE_INT64),
+                adbc_validation::IsOkErrno());
+    ASSERT_THAT(ArrowSchemaSetName(schema->children[0], "ints"),
+                adbc_validation::IsOkErrno());
+    ASSERT_THAT(ArrowSchemaSetType(schema->children[1], NANOARROW_TYPE_STRING),
+                adbc_validation::IsOkErrno());
+    ASSERT_THAT(ArrowSchemaSetName(schema->children[1], "strs"),
+                adbc_validation::IsOkErrno());
+    ASSERT_THAT((adbc_validation::MakeBatch<int64_t, std::string>(
+                    &schema.value, &batch.value, static_cast<struct ArrowError*>(nullptr),
+                    {-1, 0, 1, std::nullopt}, {"a", std::nullopt, "", "d"})),
+                adbc_validation::IsOkErrno());
+
+    ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_TARGET_TABLE,
+                                       "bulk_ingest", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(
+        AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_MODE, mode.first, &error),
+        IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement, "adbc.postgresql.ingest_staging",
+                                       ADBC_OPTION_VALUE_ENABLED, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementBind(&statement, &batch.value, &schema.value, &error),
+                IsOkStatus(&error));
+
+    int64_t rows_affected = 0;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, &rows_affected, &error),
+                IsOkStatus(&error));
+    ASSERT_EQ(rows_affected, 4);
+
+    ASSERT_THAT(AdbcStatementSetSqlQuery(
+                    &statement,
+                    "SELECT COUNT(*), COUNT(ints), COUNT(strs), "
+                    "(SELECT COUNT(*) FROM pg_class WHERE relname LIKE 'adbc_staging_%') "
+                    "FROM bulk_ingest",
+                    &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, &reader.stream.value,
+                                          &reader.rows_affected, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(reader.array->length, 1);
+    ASSERT_EQ(ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], 0), mode.second);
+    ASSERT_EQ(ArrowArrayViewGetIntUnsafe(reader.array_view->children[1], 0),
+              mode.second / 4 * 3);
+    ASSERT_EQ(ArrowArrayViewGetIntUnsafe(reader.array_view->children[2], 0),
+              mode.second / 4 * 3);
+    // The staging table is gone
+    ASSERT_EQ(ArrowArrayViewGetIntUnsafe(reader.array_view->children[3], 0), 0);
+  }
+
+  // Creating an existing table fails before anything is loaded
+  {
+    adbc_validation::Handle<struct ArrowSchema> schema;
+    adbc_validation::Handle<struct ArrowArray> batch;
+
+    ArrowSchemaInit(&schema.value);
+    ASSERT_THAT(ArrowSchemaSetTypeStruct(&schema.value, 1), adbc_validation::IsOkErrno());
+    ASSERT_THAT(ArrowSchemaSetType(schema->children[0], NANOARROW_TYPE_INT64),
+                adbc_validation::IsOkErrno());
+    ASSERT_THAT(ArrowSchemaSetName(schema->children[0], "ints"),
+                adbc_validation::IsOkErrno());
+    ASSERT_THAT((adbc_validation::MakeBatch<int64_t>(
+                    &schema.value, &batch.value, static_cast<struct ArrowError*>(nullptr),
+                    {1, 2, 3})),
+                adbc_validation::IsOkErrno());
+
+    ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_TARGET_TABLE,
+                                       "bulk_ingest", &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_MODE,
+                                       ADBC_INGEST_OPTION_MODE_CREATE, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementBind(&statement, &batch.value, &schema.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error),
+                IsStatus(ADBC_STATUS_ALREADY_EXISTS, &error));
+    ASSERT_EQ("42P07", std::string_view(error.sqlstate, 5));
+    error.release(&error);
+
+    ASSERT_THAT(AdbcStatementSetSqlQuery(
+                    &statement,
+                    "SELECT (SELECT COUNT(*) FROM bulk_ingest), "
+                    "(SELECT COUNT(*) FROM pg_class WHERE relname LIKE 'adbc_staging_%')",
+                    &error),
+                IsOkStatus(&error));
+    adbc_validation::StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement, &reader.stream.value,
+                                          &reader.rows_affected, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    ASSERT_EQ(ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], 0), 4);
+    ASSERT_EQ(ArrowArrayViewGetIntUnsafe(reader.array_view->children[1], 0), 0);
+  }
+}
+
 // Test that an ADBC 1.0.0-sized error still works
 TEST_F(PostgresStatementTest, AdbcErrorBackwardsCompatibility) {
   // XXX: sketchy cast
@@ -1228,6 +2016,18 @@ TEST_F(PostgresStatementTest, Cancel) {
   ASSERT_NE(0, AdbcErrorGetDetailCount(detail));
 }
 
+class PostgresThroughputTest : public ::testing::Test,
+                               public adbc_validation::ThroughputTest {
+ public:
+  const adbc_validation::DriverQuirks* quirks() const override { return &quirks_; }
+  void SetUp() override { ASSERT_NO_FATAL_FAILURE(SetUpTest()); }
+  void TearDown() override { ASSERT_NO_FATAL_FAILURE(TearDownTest()); }
+
+ protected:
+  PostgresQuirks quirks_;
+};
+ADBCV_TEST_THROUGHPUT(PostgresThroughputTest)
+
 struct TypeTestCase {
   std::string name;
   std::string sql_type;
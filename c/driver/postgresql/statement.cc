@@ -17,13 +17,23 @@
 
 #include "statement.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cerrno>
 #include <cinttypes>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -34,6 +44,7 @@
 #include "common/options.h"
 #include "common/utils.h"
 #include "connection.h"
+#include "database.h"
 #include "error.h"
 #include "postgres_copy_reader.h"
 #include "postgres_type.h"
@@ -46,6 +57,24 @@ namespace {
 /// The flag indicating to PostgreSQL that we want binary-format values.
 constexpr int kPgBinaryFormat = 1;
 
+/// The end of a COPY binary stream (a field count of -1). The cursor and
+/// single-row transports hand this to the copy reader after the last row.
+constexpr uint8_t kPgCopyTrailer[] = {0xff, 0xff};
+
+/// Used to give each cursor on a connection a unique name
+std::atomic<int64_t> next_cursor_id{0};
+
+/// A random 128-bit hex string, for names of server-side objects that must
+/// not collide with (or be guessable by) anything else on the server.
+std::string RandomHexString() {
+  std::random_device random;
+  char out[33];
+  for (int i = 0; i < 4; i++) {
+    std::snprintf(out + 8 * i, 9, "%08x", static_cast<unsigned int>(random()));
+  }
+  return out;
+}
+
 /// One-value ArrowArrayStream used to unify the implementations of Bind
 struct OneValueStream {
   struct ArrowSchema schema;
@@ -94,13 +123,144 @@ AdbcStatusCode ResolvePostgresType(const PostgresTypeResolver& type_resolver,
       return ADBC_STATUS_NOT_IMPLEMENTED;
     }
 
-    root_type.AppendChild(PQfname(result, i), pg_type);
+    root_type.AppendChild(PQfname(result, i), pg_type.WithTypmod(PQfmod(result, i)));
   }
 
   *out = root_type;
   return ADBC_STATUS_OK;
 }
 
+/// Encodes rows [begin, end) of a fixed-width bind parameter column into the
+/// binary format PostgreSQL expects, writing row begin + i at out + i * stride.
+/// Null slots are encoded too (their contents are never sent). Returns the
+/// index of the first row whose value PostgreSQL cannot represent, or -1.
+using ParamEncoder = int64_t (*)(struct ArrowArrayView* values,
+                                 const struct ArrowSchemaView& field, int64_t begin,
+                                 int64_t end, char* out, size_t stride);
+
+int64_t EncodeBoolParam(struct ArrowArrayView* values,
+                        const struct ArrowSchemaView& field, int64_t begin,
+                        int64_t end, char* out, size_t stride) {
+  const uint8_t* bits = values->buffer_views[1].data.as_uint8;
+  for (int64_t row = begin; row < end; row++, out += stride) {
+    *out = static_cast<char>(ArrowBitGet(bits, values->offset + row));
+  }
+  return -1;
+}
+
+template <typename T, typename Arg, typename Encoded, Encoded (*ToNetwork)(Arg)>
+int64_t EncodeNumericParam(struct ArrowArrayView* values,
+                           const struct ArrowSchemaView& field, int64_t begin,
+                           int64_t end, char* out, size_t stride) {
+  const T* data = reinterpret_cast<const T*>(values->buffer_views[1].data.data);
+  data += values->offset;
+  for (int64_t row = begin; row < end; row++, out += stride) {
+    const Encoded value = ToNetwork(static_cast<Arg>(data[row]));
+    std::memcpy(out, &value, sizeof(Encoded));
+  }
+  return -1;
+}
+
+int64_t EncodeDateParam(struct ArrowArrayView* values,
+                        const struct ArrowSchemaView& field, int64_t begin,
+                        int64_t end, char* out, size_t stride) {
+  // 2000-01-01
+  constexpr int32_t kPostgresDateEpoch = 10957;
+  const int32_t* data = values->buffer_views[1].data.as_int32 + values->offset;
+  for (int64_t row = begin; row < end; row++, out += stride) {
+    if (data[row] < INT32_MIN + kPostgresDateEpoch) {
+      if (!ArrowArrayViewIsNull(values, row)) return row;
+      continue;
+    }
+    const uint32_t value = ToNetworkInt32(data[row] - kPostgresDateEpoch);
+    std::memcpy(out, &value, sizeof(int32_t));
+  }
+  return -1;
+}
+
+/// Convert a timestamp or duration to microseconds, returning false on overflow.
+bool ToPostgresMicros(int64_t value, enum ArrowTimeUnit unit, int64_t* out) {
+  switch (unit) {
+    case NANOARROW_TIME_UNIT_SECOND:
+      if (value > kMaxSafeSecondsToMicros || value < kMinSafeSecondsToMicros) {
+        return false;
+      }
+      value *= 1000000;
+      break;
+    case NANOARROW_TIME_UNIT_MILLI:
+      if (value > kMaxSafeMillisToMicros || value < kMinSafeMillisToMicros) {
+        return false;
+      }
+      value *= 1000;
+      break;
+    case NANOARROW_TIME_UNIT_MICRO:
+      break;
+    case NANOARROW_TIME_UNIT_NANO:
+      value /= 1000;
+      break;
+  }
+  *out = value;
+  return true;
+}
+
+int64_t EncodeTimestampParam(struct ArrowArrayView* values,
+                             const struct ArrowSchemaView& field, int64_t begin,
+                             int64_t end, char* out, size_t stride) {
+  // 2000-01-01 00:00:00.000000 in microseconds
+  constexpr int64_t kPostgresTimestampEpoch = 946684800000000;
+  const int64_t* data = values->buffer_views[1].data.as_int64 + values->offset;
+  for (int64_t row = begin; row < end; row++, out += stride) {
+    int64_t micros;
+    if (!ToPostgresMicros(data[row], field.time_unit, &micros)) {
+      if (!ArrowArrayViewIsNull(values, row)) return row;
+      continue;
+    }
+    const uint64_t value = ToNetworkInt64(micros - kPostgresTimestampEpoch);
+    std::memcpy(out, &value, sizeof(int64_t));
+  }
+  return -1;
+}
+
+int64_t EncodeDurationParam(struct ArrowArrayView* values,
+                            const struct ArrowSchemaView& field, int64_t begin,
+                            int64_t end, char* out, size_t stride) {
+  const int64_t* data = values->buffer_views[1].data.as_int64 + values->offset;
+  for (int64_t row = begin; row < end; row++, out += stride) {
+    int64_t micros;
+    if (!ToPostgresMicros(data[row], field.time_unit, &micros)) {
+      if (!ArrowArrayViewIsNull(values, row)) return row;
+      continue;
+    }
+    // postgres stores an interval as a 64 bit offset in microsecond
+    // resolution alongside a 32 bit day and 32 bit month
+    // for now we just send 0 for the day / month values
+    const uint64_t value = ToNetworkInt64(micros);
+    std::memcpy(out, &value, sizeof(int64_t));
+    std::memset(out + sizeof(int64_t), 0, sizeof(int64_t));
+  }
+  return -1;
+}
+
+int64_t EncodeIntervalParam(struct ArrowArrayView* values,
+                            const struct ArrowSchemaView& field, int64_t begin,
+                            int64_t end, char* out, size_t stride) {
+  struct ArrowInterval interval;
+  ArrowIntervalInit(&interval, NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO);
+  for (int64_t row = begin; row < end; row++, out += stride) {
+    // Unlike the other getters, this does not add the offset
+    ArrowArrayViewGetIntervalUnsafe(values, values->offset + row, &interval);
+
+    const uint32_t months = ToNetworkInt32(interval.months);
+    const uint32_t days = ToNetworkInt32(interval.days);
+    const uint64_t ms = ToNetworkInt64(interval.ns / 1000);
+
+    std::memcpy(out, &ms, sizeof(uint64_t));
+    std::memcpy(out + sizeof(uint64_t), &days, sizeof(uint32_t));
+    std::memcpy(out + sizeof(uint64_t) + sizeof(uint32_t), &months, sizeof(uint32_t));
+  }
+  return -1;
+}
+
 /// Helper to manage bind parameters with a prepared statement
 struct BindStream {
   Handle<struct ArrowArrayStream> bind;
@@ -114,15 +274,20 @@ struct BindStream {
   std::vector<int> param_lengths;
   std::vector<int> param_formats;
   std::vector<size_t> param_values_offsets;
+  // Encoders for fixed-width columns (nullptr for variable-length columns,
+  // which are sent straight from the bound array)
+  std::vector<ParamEncoder> param_encoders;
+  // The encoded fixed-width values of the current batch, one row after another
   std::vector<char> param_values_buffer;
-  // XXX: this assumes fixed-length fields only - will need more
-  // consideration to deal with variable-length fields
+  size_t param_row_bytes = 0;
 
   bool has_tz_field = false;
   std::string tz_setting;
 
   struct ArrowError na_error;
 
+  BindStream() { std::memset(&na_error, 0, sizeof(na_error)); }
+
   explicit BindStream(struct ArrowArrayStream&& bind) {
     this->bind.value = std::move(bind);
     std::memset(&na_error, 0, sizeof(na_error));
@@ -131,6 +296,21 @@ struct BindStream {
   template <typename Callback>
   AdbcStatusCode Begin(Callback&& callback, struct AdbcError* error) {
     CHECK_NA(INTERNAL, bind->get_schema(&bind.value, &bind_schema.value), error);
+    RAISE_ADBC(InitSchemaViews(error));
+    return std::move(callback)();
+  }
+
+  // Set up to execute batches read elsewhere (see ParallelIngest)
+  AdbcStatusCode BeginWithSchema(const struct ArrowSchema& schema,
+                                 struct AdbcError* error) {
+    CHECK_NA(INTERNAL,
+             ArrowSchemaDeepCopy(const_cast<struct ArrowSchema*>(&schema),
+                                 &bind_schema.value),
+             error);
+    return InitSchemaViews(error);
+  }
+
+  AdbcStatusCode InitSchemaViews(struct AdbcError* error) {
     CHECK_NA(
         INTERNAL,
         ArrowSchemaViewInit(&bind_schema_view, &bind_schema.value, /*error*/ nullptr),
@@ -148,8 +328,7 @@ struct BindStream {
                                    /*error*/ nullptr),
                error);
     }
-
-    return std::move(callback)();
+    return ADBC_STATUS_OK;
   }
 
   AdbcStatusCode SetParamTypes(const PostgresTypeResolver& type_resolver,
@@ -159,6 +338,7 @@ struct BindStream {
     param_lengths.resize(bind_schema->n_children);
     param_formats.resize(bind_schema->n_children, kPgBinaryFormat);
     param_values_offsets.reserve(bind_schema->n_children);
+    param_encoders.resize(bind_schema->n_children, nullptr);
 
     for (size_t i = 0; i < bind_schema_fields.size(); i++) {
       PostgresTypeId type_id;
@@ -166,27 +346,43 @@ struct BindStream {
         case ArrowType::NANOARROW_TYPE_BOOL:
           type_id = PostgresTypeId::kBool;
           param_lengths[i] = 1;
+          param_encoders[i] = &EncodeBoolParam;
           break;
         case ArrowType::NANOARROW_TYPE_INT8:
+          type_id = PostgresTypeId::kInt2;
+          param_lengths[i] = 2;
+          param_encoders[i] =
+              &EncodeNumericParam<int8_t, int16_t, uint16_t, ToNetworkInt16>;
+          break;
         case ArrowType::NANOARROW_TYPE_INT16:
           type_id = PostgresTypeId::kInt2;
           param_lengths[i] = 2;
+          param_encoders[i] =
+              &EncodeNumericParam<int16_t, int16_t, uint16_t, ToNetworkInt16>;
           break;
         case ArrowType::NANOARROW_TYPE_INT32:
           type_id = PostgresTypeId::kInt4;
           param_lengths[i] = 4;
+          param_encoders[i] =
+              &EncodeNumericParam<int32_t, int32_t, uint32_t, ToNetworkInt32>;
           break;
         case ArrowType::NANOARROW_TYPE_INT64:
           type_id = PostgresTypeId::kInt8;
           param_lengths[i] = 8;
+          param_encoders[i] =
+              &EncodeNumericParam<int64_t, int64_t, uint64_t, ToNetworkInt64>;
           break;
         case ArrowType::NANOARROW_TYPE_FLOAT:
           type_id = PostgresTypeId::kFloat4;
           param_lengths[i] = 4;
+          param_encoders[i] =
+              &EncodeNumericParam<float, float, uint32_t, ToNetworkFloat4>;
           break;
         case ArrowType::NANOARROW_TYPE_DOUBLE:
           type_id = PostgresTypeId::kFloat8;
           param_lengths[i] = 8;
+          param_encoders[i] =
+              &EncodeNumericParam<double, double, uint64_t, ToNetworkFloat8>;
           break;
         case ArrowType::NANOARROW_TYPE_STRING:
         case ArrowType::NANOARROW_TYPE_LARGE_STRING:
@@ -200,15 +396,22 @@ struct BindStream {
         case ArrowType::NANOARROW_TYPE_DATE32:
           type_id = PostgresTypeId::kDate;
           param_lengths[i] = 4;
+          param_encoders[i] = &EncodeDateParam;
           break;
         case ArrowType::NANOARROW_TYPE_TIMESTAMP:
           type_id = PostgresTypeId::kTimestamp;
           param_lengths[i] = 8;
+          param_encoders[i] = &EncodeTimestampParam;
           break;
         case ArrowType::NANOARROW_TYPE_DURATION:
+          type_id = PostgresTypeId::kInterval;
+          param_lengths[i] = 16;
+          param_encoders[i] = &EncodeDurationParam;
+          break;
         case ArrowType::NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO:
           type_id = PostgresTypeId::kInterval;
           param_lengths[i] = 16;
+          param_encoders[i] = &EncodeIntervalParam;
           break;
         default:
           SetError(error, "%s%" PRIu64 "%s%s%s%s", "[libpq] Field #",
@@ -228,12 +431,11 @@ struct BindStream {
       }
     }
 
-    size_t param_values_length = 0;
+    param_row_bytes = 0;
     for (int length : param_lengths) {
-      param_values_offsets.push_back(param_values_length);
-      param_values_length += length;
+      param_values_offsets.push_back(param_row_bytes);
+      param_row_bytes += length;
     }
-    param_values_buffer.resize(param_values_length);
     return ADBC_STATUS_OK;
   }
 
@@ -297,9 +499,81 @@ struct BindStream {
     return ADBC_STATUS_OK;
   }
 
+  AdbcStatusCode SetOutOfRangeError(int64_t col, int64_t row,
+                                    struct ArrowArrayView* values,
+                                    struct AdbcError* error) {
+    if (bind_schema_fields[col].type == ArrowType::NANOARROW_TYPE_DATE32) {
+      SetError(error, "[libpq] Field #%" PRId64 "%s%s%s%" PRId64 "%s", col + 1, "('",
+               bind_schema->children[col]->name, "') Row #", row + 1,
+               "has value which exceeds postgres date limits");
+    } else {
+      SetError(error,
+               "[libpq] Field #%" PRId64 " ('%s') Row #%" PRId64 " has value '%" PRIi64
+               "' which exceeds PostgreSQL timestamp limits",
+               col + 1, bind_schema->children[col]->name, row + 1,
+               ArrowArrayViewGetIntUnsafe(values, row));
+    }
+    return ADBC_STATUS_INVALID_ARGUMENT;
+  }
+
+  // Encode the fixed-width columns of rows [begin, end) into
+  // param_values_buffer, so that sending a row only has to point at its values
+  AdbcStatusCode EncodeRows(struct ArrowArrayView* array_view, int64_t begin,
+                            int64_t end, struct AdbcError* error) {
+    param_values_buffer.resize((end - begin) * param_row_bytes);
+    for (int64_t col = 0; col < array_view->n_children; col++) {
+      if (param_encoders[col] == nullptr) continue;
+      const int64_t bad_row = param_encoders[col](
+          array_view->children[col], bind_schema_fields[col], begin, end,
+          param_values_buffer.data() + param_values_offsets[col], param_row_bytes);
+      if (bad_row >= 0) {
+        return SetOutOfRangeError(col, bad_row, array_view->children[col], error);
+      }
+    }
+    return ADBC_STATUS_OK;
+  }
+
+  // Insert rows [begin, end) of a batch, one PQexecPrepared per row
+  AdbcStatusCode ExecuteRows(PGconn* conn, struct ArrowArrayView* array_view,
+                             int64_t begin, int64_t end, struct AdbcError* error) {
+    RAISE_ADBC(EncodeRows(array_view, begin, end, error));
+
+    for (int64_t row = begin; row < end; row++) {
+      char* row_values = param_values_buffer.data() + (row - begin) * param_row_bytes;
+      for (int64_t col = 0; col < array_view->n_children; col++) {
+        struct ArrowArrayView* values = array_view->children[col];
+        if (ArrowArrayViewIsNull(values, row)) {
+          param_values[col] = nullptr;
+        } else if (param_encoders[col] != nullptr) {
+          param_values[col] = row_values + param_values_offsets[col];
+        } else {
+          const ArrowBufferView view = ArrowArrayViewGetBytesUnsafe(values, row);
+          // TODO: overflow check?
+          param_lengths[col] = static_cast<int>(view.size_bytes);
+          param_values[col] = const_cast<char*>(view.data.as_char);
+        }
+      }
+
+      PGresult* result = PQexecPrepared(
+          conn, /*stmtName=*/"", /*nParams=*/bind_schema->n_children, param_values.data(),
+          param_lengths.data(), param_formats.data(), /*resultFormat=*/0 /*text*/);
+
+      ExecStatusType pg_status = PQresultStatus(result);
+      if (pg_status != PGRES_COMMAND_OK) {
+        AdbcStatusCode code = SetError(
+            error, result, "[libpq] Failed to execute prepared statement: %s %s",
+            PQresStatus(pg_status), PQerrorMessage(conn));
+        PQclear(result);
+        return code;
+      }
+
+      PQclear(result);
+    }
+    return ADBC_STATUS_OK;
+  }
+
   AdbcStatusCode Execute(PGconn* conn, int64_t* rows_affected, struct AdbcError* error) {
     if (rows_affected) *rows_affected = 0;
-    PGresult* result = nullptr;
 
     while (true) {
       Handle<struct ArrowArray> array;
@@ -322,180 +596,7 @@ struct BindStream {
       CHECK_NA(INTERNAL, ArrowArrayViewSetArray(&array_view.value, &array.value, nullptr),
                error);
 
-      for (int64_t row = 0; row < array->length; row++) {
-        for (int64_t col = 0; col < array_view->n_children; col++) {
-          if (ArrowArrayViewIsNull(array_view->children[col], row)) {
-            param_values[col] = nullptr;
-            continue;
-          } else {
-            param_values[col] = param_values_buffer.data() + param_values_offsets[col];
-          }
-          switch (bind_schema_fields[col].type) {
-            case ArrowType::NANOARROW_TYPE_BOOL: {
-              const int8_t val = ArrowBitGet(
-                  array_view->children[col]->buffer_views[1].data.as_uint8, row);
-              std::memcpy(param_values[col], &val, sizeof(int8_t));
-              break;
-            }
-
-            case ArrowType::NANOARROW_TYPE_INT8: {
-              const int16_t val =
-                  array_view->children[col]->buffer_views[1].data.as_int8[row];
-              const uint16_t value = ToNetworkInt16(val);
-              std::memcpy(param_values[col], &value, sizeof(int16_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_INT16: {
-              const uint16_t value = ToNetworkInt16(
-                  array_view->children[col]->buffer_views[1].data.as_int16[row]);
-              std::memcpy(param_values[col], &value, sizeof(int16_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_INT32: {
-              const uint32_t value = ToNetworkInt32(
-                  array_view->children[col]->buffer_views[1].data.as_int32[row]);
-              std::memcpy(param_values[col], &value, sizeof(int32_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_INT64: {
-              const int64_t value = ToNetworkInt64(
-                  array_view->children[col]->buffer_views[1].data.as_int64[row]);
-              std::memcpy(param_values[col], &value, sizeof(int64_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_FLOAT: {
-              const uint32_t value = ToNetworkFloat4(
-                  array_view->children[col]->buffer_views[1].data.as_float[row]);
-              std::memcpy(param_values[col], &value, sizeof(uint32_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_DOUBLE: {
-              const uint64_t value = ToNetworkFloat8(
-                  array_view->children[col]->buffer_views[1].data.as_double[row]);
-              std::memcpy(param_values[col], &value, sizeof(uint64_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_STRING:
-            case ArrowType::NANOARROW_TYPE_LARGE_STRING:
-            case ArrowType::NANOARROW_TYPE_BINARY: {
-              const ArrowBufferView view =
-                  ArrowArrayViewGetBytesUnsafe(array_view->children[col], row);
-              // TODO: overflow check?
-              param_lengths[col] = static_cast<int>(view.size_bytes);
-              param_values[col] = const_cast<char*>(view.data.as_char);
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_DATE32: {
-              // 2000-01-01
-              constexpr int32_t kPostgresDateEpoch = 10957;
-              const int32_t raw_value =
-                  array_view->children[col]->buffer_views[1].data.as_int32[row];
-              if (raw_value < INT32_MIN + kPostgresDateEpoch) {
-                SetError(error, "[libpq] Field #%" PRId64 "%s%s%s%" PRId64 "%s", col + 1,
-                         "('", bind_schema->children[col]->name, "') Row #", row + 1,
-                         "has value which exceeds postgres date limits");
-                return ADBC_STATUS_INVALID_ARGUMENT;
-              }
-
-              const uint32_t value = ToNetworkInt32(raw_value - kPostgresDateEpoch);
-              std::memcpy(param_values[col], &value, sizeof(int32_t));
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_DURATION:
-            case ArrowType::NANOARROW_TYPE_TIMESTAMP: {
-              int64_t val = array_view->children[col]->buffer_views[1].data.as_int64[row];
-
-              // 2000-01-01 00:00:00.000000 in microseconds
-              constexpr int64_t kPostgresTimestampEpoch = 946684800000000;
-              bool overflow_safe = true;
-
-              auto unit = bind_schema_fields[col].time_unit;
-
-              switch (unit) {
-                case NANOARROW_TIME_UNIT_SECOND:
-                  if ((overflow_safe = val <= kMaxSafeSecondsToMicros &&
-                                       val >= kMinSafeSecondsToMicros)) {
-                    val *= 1000000;
-                  }
-
-                  break;
-                case NANOARROW_TIME_UNIT_MILLI:
-                  if ((overflow_safe = val <= kMaxSafeMillisToMicros &&
-                                       val >= kMinSafeMillisToMicros)) {
-                    val *= 1000;
-                  }
-                  break;
-                case NANOARROW_TIME_UNIT_MICRO:
-                  break;
-                case NANOARROW_TIME_UNIT_NANO:
-                  val /= 1000;
-                  break;
-              }
-
-              if (!overflow_safe) {
-                SetError(error,
-                         "[libpq] Field #%" PRId64 " ('%s') Row #%" PRId64
-                         " has value '%" PRIi64
-                         "' which exceeds PostgreSQL timestamp limits",
-                         col + 1, bind_schema->children[col]->name, row + 1,
-                         array_view->children[col]->buffer_views[1].data.as_int64[row]);
-                return ADBC_STATUS_INVALID_ARGUMENT;
-              }
-
-              if (bind_schema_fields[col].type == ArrowType::NANOARROW_TYPE_TIMESTAMP) {
-                const uint64_t value = ToNetworkInt64(val - kPostgresTimestampEpoch);
-                std::memcpy(param_values[col], &value, sizeof(int64_t));
-              } else if (bind_schema_fields[col].type ==
-                         ArrowType::NANOARROW_TYPE_DURATION) {
-                // postgres stores an interval as a 64 bit offset in microsecond
-                // resolution alongside a 32 bit day and 32 bit month
-                // for now we just send 0 for the day / month values
-                const uint64_t value = ToNetworkInt64(val);
-                std::memcpy(param_values[col], &value, sizeof(int64_t));
-                std::memset(param_values[col] + sizeof(int64_t), 0, sizeof(int64_t));
-              }
-              break;
-            }
-            case ArrowType::NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO: {
-              struct ArrowInterval interval;
-              ArrowIntervalInit(&interval, NANOARROW_TYPE_INTERVAL_MONTH_DAY_NANO);
-              ArrowArrayViewGetIntervalUnsafe(array_view->children[col], row, &interval);
-
-              const uint32_t months = ToNetworkInt32(interval.months);
-              const uint32_t days = ToNetworkInt32(interval.days);
-              const uint64_t ms = ToNetworkInt64(interval.ns / 1000);
-
-              std::memcpy(param_values[col], &ms, sizeof(uint64_t));
-              std::memcpy(param_values[col] + sizeof(uint64_t), &days, sizeof(uint32_t));
-              std::memcpy(param_values[col] + sizeof(uint64_t) + sizeof(uint32_t),
-                          &months, sizeof(uint32_t));
-              break;
-            }
-            default:
-              SetError(error, "%s%" PRId64 "%s%s%s%s", "[libpq] Field #", col + 1, " ('",
-                       bind_schema->children[col]->name,
-                       "') has unsupported type for ingestion ",
-                       ArrowTypeString(bind_schema_fields[col].type));
-              return ADBC_STATUS_NOT_IMPLEMENTED;
-          }
-        }
-
-        result = PQexecPrepared(conn, /*stmtName=*/"",
-                                /*nParams=*/bind_schema->n_children, param_values.data(),
-                                param_lengths.data(), param_formats.data(),
-                                /*resultFormat=*/0 /*text*/);
-
-        ExecStatusType pg_status = PQresultStatus(result);
-        if (pg_status != PGRES_COMMAND_OK) {
-          AdbcStatusCode code = SetError(
-              error, result, "[libpq] Failed to execute prepared statement: %s %s",
-              PQresStatus(pg_status), PQerrorMessage(conn));
-          PQclear(result);
-          return code;
-        }
-
-        PQclear(result);
-      }
+      RAISE_ADBC(ExecuteRows(conn, &array_view.value, 0, array->length, error));
       if (rows_affected) *rows_affected += array->length;
 
       if (has_tz_field) {
@@ -523,6 +624,458 @@ struct BindStream {
     }
     return ADBC_STATUS_OK;
   }
+
+  // Start COPY ... FROM STDIN (FORMAT binary) on conn. The data is then sent
+  // with CopyRows() and the COPY is finished with EndCopy().
+  AdbcStatusCode BeginCopy(PGconn* conn, const std::string& copy_query,
+                           struct AdbcError* error) {
+    PGresult* result = PQexec(conn, copy_query.c_str());
+    if (PQresultStatus(result) != PGRES_COPY_IN) {
+      AdbcStatusCode code =
+          SetError(error, result, "[libpq] Failed to begin COPY: %s\nQuery was: %s",
+                   PQerrorMessage(conn), copy_query.c_str());
+      PQclear(result);
+      return code;
+    }
+    PQclear(result);
+
+    copy_buffer.clear();
+    AppendCopyBytes(kPgCopyBinarySignature, sizeof(kPgCopyBinarySignature));
+    const uint32_t flags = 0;
+    const uint32_t extension_bytes = 0;
+    AppendCopyBytes(&flags, sizeof(flags));
+    AppendCopyBytes(&extension_bytes, sizeof(extension_bytes));
+    return ADBC_STATUS_OK;
+  }
+
+  // Send rows [begin, end) of a batch in the COPY binary format, whose field
+  // values are encoded the same way as binary parameters. Data is buffered
+  // and sent in chunks of about kCopyChunkBytes (values at least that large
+  // are sent without being copied into the buffer).
+  AdbcStatusCode CopyRows(PGconn* conn, struct ArrowArrayView* array_view,
+                          int64_t begin, int64_t end, struct AdbcError* error) {
+    // Encode the fixed-width values a group of rows at a time, so the
+    // encoded values of a large batch are not all held at once
+    const int64_t group_rows = std::max<int64_t>(
+        1, kCopyChunkBytes / std::max<size_t>(param_row_bytes, 1));
+
+    const uint16_t n_fields =
+        SwapHostToNetwork(static_cast<uint16_t>(array_view->n_children));
+    const uint32_t null_length = SwapHostToNetwork(static_cast<uint32_t>(-1));
+    for (int64_t group = begin; group < end; group += group_rows) {
+      const int64_t group_end = std::min(end, group + group_rows);
+      RAISE_ADBC(EncodeRows(array_view, group, group_end, error));
+
+      for (int64_t row = group; row < group_end; row++) {
+        const char* row_values =
+            param_values_buffer.data() + (row - group) * param_row_bytes;
+        AppendCopyBytes(&n_fields, sizeof(n_fields));
+        for (int64_t col = 0; col < array_view->n_children; col++) {
+          struct ArrowArrayView* values = array_view->children[col];
+          if (ArrowArrayViewIsNull(values, row)) {
+            AppendCopyBytes(&null_length, sizeof(null_length));
+            continue;
+          }
+
+          const char* data;
+          int64_t size;
+          if (param_encoders[col] != nullptr) {
+            data = row_values + param_values_offsets[col];
+            size = param_lengths[col];
+          } else {
+            const ArrowBufferView view = ArrowArrayViewGetBytesUnsafe(values, row);
+            data = view.data.as_char;
+            size = view.size_bytes;
+          }
+          if (size > std::numeric_limits<int32_t>::max()) {
+            SetError(error,
+                     "[libpq] Field #%" PRId64 " ('%s') Row #%" PRId64
+                     " has value of %" PRId64 " bytes, which exceeds the COPY limit",
+                     col + 1, bind_schema->children[col]->name, row + 1, size);
+            return ADBC_STATUS_INVALID_ARGUMENT;
+          }
+          const uint32_t length = SwapHostToNetwork(static_cast<uint32_t>(size));
+          AppendCopyBytes(&length, sizeof(length));
+          if (static_cast<size_t>(size) >= kCopyChunkBytes) {
+            RAISE_ADBC(FlushCopy(conn, /*min_bytes=*/0, error));
+            RAISE_ADBC(PutCopyData(conn, data, static_cast<size_t>(size), error));
+          } else {
+            AppendCopyBytes(data, static_cast<size_t>(size));
+          }
+        }
+        RAISE_ADBC(FlushCopy(conn, kCopyChunkBytes, error));
+      }
+    }
+    return ADBC_STATUS_OK;
+  }
+
+  // Finish a COPY: if status is OK, send the rest of the data and end the
+  // COPY, otherwise make the server abort it (the error is already set).
+  AdbcStatusCode EndCopy(PGconn* conn, AdbcStatusCode status, struct AdbcError* error) {
+    if (status == ADBC_STATUS_OK) {
+      const uint16_t trailer = SwapHostToNetwork(static_cast<uint16_t>(-1));
+      AppendCopyBytes(&trailer, sizeof(trailer));
+      status = FlushCopy(conn, /*min_bytes=*/0, error);
+      if (status == ADBC_STATUS_OK && PQputCopyEnd(conn, /*errormsg=*/nullptr) != 1) {
+        SetError(error, "[libpq] Failed to send COPY data: %s", PQerrorMessage(conn));
+        status = ADBC_STATUS_IO;
+      }
+    }
+    if (status != ADBC_STATUS_OK) {
+      PQputCopyEnd(conn, "ADBC bulk ingestion failed");
+    }
+    copy_buffer.clear();
+    copy_buffer.shrink_to_fit();
+
+    // Always consume the results so the connection can be used again
+    PGresult* result;
+    while ((result = PQgetResult(conn)) != nullptr) {
+      if (status == ADBC_STATUS_OK && PQresultStatus(result) != PGRES_COMMAND_OK) {
+        status = SetError(error, result, "[libpq] Failed to execute COPY: %s",
+                          PQerrorMessage(conn));
+      }
+      PQclear(result);
+    }
+    return status;
+  }
+
+  // Load the whole stream with COPY ... FROM STDIN (FORMAT binary)
+  AdbcStatusCode ExecuteCopy(PGconn* conn, const std::string& copy_query,
+                             int64_t* rows_affected, struct AdbcError* error) {
+    if (rows_affected) *rows_affected = 0;
+    RAISE_ADBC(BeginCopy(conn, copy_query, error));
+
+    AdbcStatusCode status = ADBC_STATUS_OK;
+    int64_t rows = 0;
+    while (status == ADBC_STATUS_OK) {
+      Handle<struct ArrowArray> array;
+      int res = bind->get_next(&bind.value, &array.value);
+      if (res != 0) {
+        SetError(error,
+                 "[libpq] Failed to read next batch from stream of bind parameters: "
+                 "(%d) %s %s",
+                 res, std::strerror(res), bind->get_last_error(&bind.value));
+        status = ADBC_STATUS_IO;
+        break;
+      }
+      if (!array->release) break;
+
+      Handle<struct ArrowArrayView> array_view;
+      if (ArrowArrayViewInitFromSchema(&array_view.value, &bind_schema.value,
+                                       &na_error) != NANOARROW_OK ||
+          ArrowArrayViewSetArray(&array_view.value, &array.value, &na_error) !=
+              NANOARROW_OK) {
+        SetError(error, "[libpq] Invalid batch of bind parameters: %s", na_error.message);
+        status = ADBC_STATUS_INTERNAL;
+        break;
+      }
+
+      status = CopyRows(conn, &array_view.value, 0, array->length, error);
+      rows += array->length;
+    }
+
+    status = EndCopy(conn, status, error);
+    if (status == ADBC_STATUS_OK && rows_affected) *rows_affected = rows;
+    return status;
+  }
+
+ private:
+  // Data for COPY ... FROM STDIN is sent in chunks of about this size
+  static constexpr size_t kCopyChunkBytes = 1 << 20;
+  // COPY data not yet sent
+  std::vector<char> copy_buffer;
+
+  void AppendCopyBytes(const void* data, size_t size) {
+    const char* bytes = reinterpret_cast<const char*>(data);
+    copy_buffer.insert(copy_buffer.end(), bytes, bytes + size);
+  }
+
+  AdbcStatusCode PutCopyData(PGconn* conn, const char* data, size_t size,
+                             struct AdbcError* error) {
+    // size is at most about kCopyChunkBytes, or one value (whose size is
+    // checked against the COPY limit)
+    if (PQputCopyData(conn, data, static_cast<int>(size)) != 1) {
+      SetError(error, "[libpq] Failed to send COPY data: %s", PQerrorMessage(conn));
+      return ADBC_STATUS_IO;
+    }
+    return ADBC_STATUS_OK;
+  }
+
+  // Send the buffered COPY data if there is at least min_bytes of it
+  AdbcStatusCode FlushCopy(PGconn* conn, size_t min_bytes, struct AdbcError* error) {
+    if (copy_buffer.empty() || copy_buffer.size() < min_bytes) return ADBC_STATUS_OK;
+    RAISE_ADBC(PutCopyData(conn, copy_buffer.data(), copy_buffer.size(), error));
+    copy_buffer.clear();
+    return ADBC_STATUS_OK;
+  }
+};
+
+/// Run a command that returns no rows.
+AdbcStatusCode ExecCommand(PGconn* conn, const std::string& command,
+                           struct AdbcError* error) {
+  PGresult* result = PQexec(conn, command.c_str());
+  if (PQresultStatus(result) != PGRES_COMMAND_OK) {
+    AdbcStatusCode code =
+        SetError(error, result, "[libpq] Failed to execute '%s': %s", command.c_str(),
+                 PQerrorMessage(conn));
+    PQclear(result);
+    return code;
+  }
+  PQclear(result);
+  return ADBC_STATUS_OK;
+}
+
+/// Bulk ingestion over several connections of the same database.
+///
+/// The calling thread reads the bind stream and splits each batch into row
+/// ranges. Each worker thread streams its ranges into a single COPY on its
+/// own connection, inside a single transaction. The transactions are
+/// committed only once every worker has succeeded, and are all rolled back
+/// otherwise.
+class ParallelIngest {
+ public:
+  ParallelIngest(PostgresDatabase* database, BindStream* source, bool two_phase)
+      : database_(database), source_(source), two_phase_(two_phase) {}
+
+  ~ParallelIngest() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      failed_ = true;
+    }
+    task_added_.notify_all();
+    for (auto& worker : workers_) {
+      if (worker->thread.joinable()) worker->thread.join();
+      // Closing the connection rolls back anything not committed
+      if (worker->conn) database_->Disconnect(&worker->conn, nullptr);
+      if (worker->error.release) worker->error.release(&worker->error);
+    }
+  }
+
+  AdbcStatusCode Run(const PostgresTypeResolver& type_resolver,
+                     const std::string& copy_query, int64_t n_connections,
+                     int64_t* rows_affected, struct AdbcError* error) {
+    for (int64_t i = 0; i < n_connections; i++) {
+      workers_.push_back(std::make_unique<Worker>());
+      Worker* worker = workers_.back().get();
+      RAISE_ADBC(database_->Connect(&worker->conn, error));
+      RAISE_ADBC(ExecCommand(worker->conn, "BEGIN", error));
+      RAISE_ADBC(worker->bind.BeginWithSchema(source_->bind_schema.value, error));
+      RAISE_ADBC(worker->bind.SetParamTypes(type_resolver, error));
+      RAISE_ADBC(worker->bind.BeginCopy(worker->conn, copy_query, error));
+    }
+    for (auto& worker : workers_) {
+      worker->thread = std::thread(&ParallelIngest::Work, this, worker.get());
+    }
+
+    AdbcStatusCode status = Distribute(n_connections, error);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    task_added_.notify_all();
+    for (auto& worker : workers_) worker->thread.join();
+    RAISE_ADBC(status);
+
+    int64_t rows = 0;
+    for (auto& worker : workers_) {
+      if (worker->status != ADBC_STATUS_OK) {
+        SetError(error, "%s",
+                 worker->error.message ? worker->error.message
+                                       : "[libpq] Bulk ingestion failed");
+        if (error) std::memcpy(error->sqlstate, worker->error.sqlstate, 5);
+        return worker->status;
+      }
+      rows += worker->rows;
+    }
+
+    RAISE_ADBC(Commit(error));
+    if (rows_affected) *rows_affected = rows;
+    return ADBC_STATUS_OK;
+  }
+
+ private:
+  // Don't split batches into ranges smaller than this
+  static constexpr int64_t kMinTaskRows = 1024;
+
+  struct Batch {
+    Handle<struct ArrowArray> array;
+    Handle<struct ArrowArrayView> array_view;
+  };
+
+  struct Task {
+    std::shared_ptr<Batch> batch;
+    int64_t begin;
+    int64_t end;
+  };
+
+  struct Worker {
+    PGconn* conn = nullptr;
+    BindStream bind;
+    std::thread thread;
+    AdbcStatusCode status = ADBC_STATUS_OK;
+    struct AdbcError error = ADBC_ERROR_INIT;
+    int64_t rows = 0;
+  };
+
+  // Read the bind stream and queue its rows for the workers
+  AdbcStatusCode Distribute(int64_t n_connections, struct AdbcError* error) {
+    BindStream* source = source_;
+    while (true) {
+      auto batch = std::make_shared<Batch>();
+      int res = source->bind->get_next(&source->bind.value, &batch->array.value);
+      if (res != 0) {
+        SetError(error,
+                 "[libpq] Failed to read next batch from stream of bind parameters: "
+                 "(%d) %s %s",
+                 res, std::strerror(res),
+                 source->bind->get_last_error(&source->bind.value));
+        return ADBC_STATUS_IO;
+      }
+      if (!batch->array->release) return ADBC_STATUS_OK;
+
+      CHECK_NA(INTERNAL,
+               ArrowArrayViewInitFromSchema(&batch->array_view.value,
+                                            &source->bind_schema.value, nullptr),
+               error);
+      CHECK_NA(INTERNAL,
+               ArrowArrayViewSetArray(&batch->array_view.value, &batch->array.value,
+                                      nullptr),
+               error);
+
+      const int64_t length = batch->array->length;
+      const int64_t task_rows =
+          std::max(kMinTaskRows, (length + n_connections - 1) / n_connections);
+      for (int64_t begin = 0; begin < length; begin += task_rows) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // Bound the number of batches held in memory
+        task_taken_.wait(lock, [&] {
+          return failed_ || static_cast<int64_t>(tasks_.size()) < 2 * n_connections;
+        });
+        // A worker failed; its error is reported by Run()
+        if (failed_) return ADBC_STATUS_OK;
+        tasks_.push_back({batch, begin, std::min(length, begin + task_rows)});
+        lock.unlock();
+        task_added_.notify_one();
+      }
+    }
+  }
+
+  void Work(Worker* worker) {
+    while (true) {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        task_added_.wait(lock, [&] { return failed_ || closed_ || !tasks_.empty(); });
+        if (failed_ || tasks_.empty()) break;
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task_taken_.notify_one();
+
+      worker->status =
+          worker->bind.CopyRows(worker->conn, &task.batch->array_view.value, task.begin,
+                                task.end, &worker->error);
+      if (worker->status != ADBC_STATUS_OK) {
+        Fail();
+        break;
+      }
+      worker->rows += task.end - task.begin;
+    }
+
+    bool failed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      failed = failed_;
+    }
+    if (failed && worker->status == ADBC_STATUS_OK) {
+      // Another worker failed: abort this COPY too, but leave the error to it
+      worker->bind.EndCopy(worker->conn, ADBC_STATUS_CANCELLED, nullptr);
+      return;
+    }
+    worker->status = worker->bind.EndCopy(worker->conn, worker->status, &worker->error);
+    if (worker->status != ADBC_STATUS_OK) Fail();
+  }
+
+  void Fail() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      failed_ = true;
+    }
+    task_added_.notify_all();
+    task_taken_.notify_all();
+  }
+
+  AdbcStatusCode Commit(struct AdbcError* error) {
+    if (!two_phase_) {
+      // If a COMMIT fails after others succeeded, the ingest is partially
+      // applied; this is the documented guarantee of the default mode
+      for (size_t i = 0; i < workers_.size(); i++) {
+        AdbcStatusCode status = ExecCommand(workers_[i]->conn, "COMMIT", error);
+        if (status != ADBC_STATUS_OK && i > 0) {
+          SetError(error,
+                   "[libpq] Bulk ingestion was partially committed (%" PRIu64
+                   " of %" PRIu64 " connections): %s",
+                   static_cast<uint64_t>(i), static_cast<uint64_t>(workers_.size()),
+                   PQerrorMessage(workers_[i]->conn));
+        }
+        RAISE_ADBC(status);
+      }
+      return ADBC_STATUS_OK;
+    }
+
+    // Prepared transactions outlive their connection and share a namespace
+    // across the server, so their names are random
+    std::vector<std::string> gids;
+    for (size_t i = 0; i < workers_.size(); i++) {
+      gids.push_back("adbc_ingest_" + RandomHexString());
+    }
+
+    for (size_t i = 0; i < workers_.size(); i++) {
+      AdbcStatusCode status =
+          ExecCommand(workers_[i]->conn, "PREPARE TRANSACTION '" + gids[i] + "'", error);
+      if (status != ADBC_STATUS_OK) {
+        for (size_t j = 0; j < i; j++) {
+          ExecCommand(workers_[j]->conn, "ROLLBACK PREPARED '" + gids[j] + "'", nullptr);
+        }
+        return status;
+      }
+    }
+
+    // Once all are prepared, the commits can only fail for reasons (e.g. a
+    // lost connection) that leave the remaining transactions prepared on the
+    // server, from where they can still be committed
+    for (size_t i = 0; i < workers_.size(); i++) {
+      AdbcStatusCode status =
+          ExecCommand(workers_[i]->conn, "COMMIT PREPARED '" + gids[i] + "'", error);
+      if (status != ADBC_STATUS_OK) {
+        std::string pending;
+        for (size_t j = i; j < workers_.size(); j++) {
+          if (j > i) pending += ", ";
+          pending += gids[j];
+        }
+        SetError(error,
+                 "[libpq] Failed to commit prepared transactions of bulk ingestion "
+                 "(still prepared: %s): %s",
+                 pending.c_str(), PQerrorMessage(workers_[i]->conn));
+        return status;
+      }
+    }
+    return ADBC_STATUS_OK;
+  }
+
+  PostgresDatabase* database_;
+  BindStream* source_;
+  bool two_phase_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable task_added_;
+  std::condition_variable task_taken_;
+  std::deque<Task> tasks_;
+  // No more tasks will be added
+  bool closed_ = false;
+  // A worker failed (or Run() returned early), so the others should stop
+  bool failed_ = false;
 };
 }  // namespace
 
@@ -545,9 +1098,7 @@ int TupleReader::GetSchema(struct ArrowSchema* out) {
 
 int TupleReader::InitQueryAndFetchFirst(struct ArrowError* error) {
   // Fetch + parse the header
-  int get_copy_res = PQgetCopyData(conn_, &pgbuf_, /*async=*/0);
-  data_.size_bytes = get_copy_res;
-  data_.data.as_char = pgbuf_;
+  int get_copy_res = FetchNext();
 
   if (get_copy_res == -2) {
     SetError(&error_, "[libpq] Fetch header failed: %s", PQerrorMessage(conn_));
@@ -555,6 +1106,9 @@ int TupleReader::InitQueryAndFetchFirst(struct ArrowError* error) {
     return AdbcStatusCodeToErrno(status_);
   }
 
+  // Only COPY has a header; the other transports start with the first row
+  if (transport_ != ResultTransport::kCopy) return NANOARROW_OK;
+
   int na_res = copy_reader_->ReadHeader(&data_, error);
   if (na_res != NANOARROW_OK) {
     SetError(&error_, "[libpq] ReadHeader failed: %s", error->message);
@@ -579,11 +1133,7 @@ int TupleReader::AppendRowAndFetchNext(struct ArrowError* error) {
   row_id_++;
 
   // Fetch + check
-  PQfreemem(pgbuf_);
-  pgbuf_ = nullptr;
-  int get_copy_res = PQgetCopyData(conn_, &pgbuf_, /*async=*/0);
-  data_.size_bytes = get_copy_res;
-  data_.data.as_char = pgbuf_;
+  int get_copy_res = FetchNext();
 
   if (get_copy_res == -2) {
     SetError(&error_, "[libpq] PQgetCopyData failed at row %" PRId64 ": %s", row_id_,
@@ -625,36 +1175,222 @@ int TupleReader::GetNext(struct ArrowArray* out) {
     return 0;
   }
 
-  struct ArrowError error;
-  error.message[0] = '\0';
-
-  if (row_id_ == -1) {
-    NANOARROW_RETURN_NOT_OK(InitQueryAndFetchFirst(&error));
-    row_id_++;
+  struct ArrowError error;
+  error.message[0] = '\0';
+
+  if (row_id_ == -1) {
+    NANOARROW_RETURN_NOT_OK(InitQueryAndFetchFirst(&error));
+    row_id_++;
+  }
+
+  int na_res;
+  do {
+    na_res = AppendRowAndFetchNext(&error);
+    if (na_res == EOVERFLOW) {
+      // The result would be too big to return if we appended the row. When EOVERFLOW is
+      // returned, the copy reader leaves the output in a valid state. The data is left in
+      // pg_buf_/data_ and will attempt to be appended on the next call to GetNext()
+      return BuildOutput(out, &error);
+    }
+  } while (na_res == NANOARROW_OK);
+
+  if (na_res != ENODATA) {
+    return na_res;
+  }
+
+  is_finished_ = true;
+
+  // Finish the result properly and return the last result. Note that BuildOutput() may
+  // set tmp.release = nullptr if there were zero rows in the copy reader (can
+  // occur in an overflow scenario).
+  struct ArrowArray tmp;
+  NANOARROW_RETURN_NOT_OK(BuildOutput(&tmp, &error));
+
+  na_res = FinishQuery();
+  if (na_res != NANOARROW_OK) {
+    if (tmp.release != nullptr) {
+      tmp.release(&tmp);
+    }
+    return na_res;
+  }
+
+  ArrowArrayMove(&tmp, out);
+  return NANOARROW_OK;
+}
+
+AdbcStatusCode TupleReader::BeginCursor(const std::string& query,
+                                        struct AdbcError* error) {
+  // Cursors only exist inside a transaction. Unless the caller already has
+  // one open, run the query in its own transaction (which, unlike WITH HOLD,
+  // does not materialize the result when the transaction commits).
+  owns_transaction_ = PQtransactionStatus(conn_) == PQTRANS_IDLE;
+  if (owns_transaction_) {
+    PGresult* result = PQexec(conn_, "BEGIN");
+    if (PQresultStatus(result) != PGRES_COMMAND_OK) {
+      AdbcStatusCode code = SetError(error, result, "[libpq] Failed to begin cursor: %s",
+                                     PQerrorMessage(conn_));
+      PQclear(result);
+      owns_transaction_ = false;
+      return code;
+    }
+    PQclear(result);
+  }
+
+  cursor_name_ = "adbc_cursor_" + std::to_string(next_cursor_id++);
+  std::string declare =
+      "DECLARE " + cursor_name_ + " BINARY NO SCROLL CURSOR FOR " + query;
+  PGresult* result =
+      PQexecParams(conn_, declare.c_str(), /*nParams=*/0, /*paramTypes=*/nullptr,
+                   /*paramValues=*/nullptr, /*paramLengths=*/nullptr,
+                   /*paramFormats=*/nullptr, kPgBinaryFormat);
+  if (PQresultStatus(result) != PGRES_COMMAND_OK) {
+    AdbcStatusCode code =
+        SetError(error, result,
+                 "[libpq] Failed to execute query: could not declare cursor: "
+                 "%s\nQuery was: %s",
+                 PQerrorMessage(conn_), declare.c_str());
+    PQclear(result);
+    if (owns_transaction_) {
+      PQclear(PQexec(conn_, "ROLLBACK"));
+      owns_transaction_ = false;
+    }
+    return code;
+  }
+  PQclear(result);
+
+  query_pending_ = true;
+  rows_done_ = false;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode TupleReader::BeginSingleRow(const std::string& query,
+                                           struct AdbcError* error) {
+  if (!PQsendQueryParams(conn_, query.c_str(), /*nParams=*/0, /*paramTypes=*/nullptr,
+                         /*paramValues=*/nullptr, /*paramLengths=*/nullptr,
+                         /*paramFormats=*/nullptr, kPgBinaryFormat)) {
+    SetError(error, "[libpq] Failed to execute query: %s\nQuery was: %s",
+             PQerrorMessage(conn_), query.c_str());
+    return ADBC_STATUS_IO;
+  }
+
+  query_pending_ = true;
+  rows_done_ = false;
+  if (!PQsetSingleRowMode(conn_)) {
+    SetError(error, "[libpq] Failed to enable single-row mode: %s",
+             PQerrorMessage(conn_));
+    AbandonQuery();
+    return ADBC_STATUS_IO;
+  }
+  return ADBC_STATUS_OK;
+}
+
+int TupleReader::FetchNext() {
+  if (transport_ == ResultTransport::kCopy) {
+    if (pgbuf_) {
+      PQfreemem(pgbuf_);
+      pgbuf_ = nullptr;
+    }
+    int get_copy_res = PQgetCopyData(conn_, &pgbuf_, /*async=*/0);
+    data_.size_bytes = get_copy_res;
+    data_.data.as_char = pgbuf_;
+    return get_copy_res;
+  }
+
+  int get_row_res = FetchNextRow();
+  if (get_row_res == -1) {
+    data_.data.as_uint8 = kPgCopyTrailer;
+    data_.size_bytes = sizeof(kPgCopyTrailer);
+  } else {
+    data_.data.as_uint8 = row_buffer_.data();
+    data_.size_bytes = get_row_res;
+  }
+  return get_row_res;
+}
+
+int TupleReader::FetchNextRow() {
+  while (result_ == nullptr || result_row_ >= PQntuples(result_)) {
+    if (rows_done_) return -1;
+
+    PQclear(result_);
+    result_row_ = 0;
+    if (transport_ == ResultTransport::kCursor) {
+      std::string fetch = "FETCH FORWARD " + std::to_string(cursor_fetch_rows_) +
+                          " FROM " + cursor_name_;
+      result_ =
+          PQexecParams(conn_, fetch.c_str(), /*nParams=*/0, /*paramTypes=*/nullptr,
+                       /*paramValues=*/nullptr, /*paramLengths=*/nullptr,
+                       /*paramFormats=*/nullptr, kPgBinaryFormat);
+      if (PQresultStatus(result_) != PGRES_TUPLES_OK) return -2;
+      rows_done_ = PQntuples(result_) == 0;
+    } else {
+      result_ = PQgetResult(conn_);
+      switch (PQresultStatus(result_)) {
+        case PGRES_SINGLE_TUPLE:
+          break;
+        case PGRES_TUPLES_OK:
+          // The final (empty) result of a query in single-row mode
+          rows_done_ = true;
+          break;
+        default:
+          return -2;
+      }
+    }
+  }
+
+  // Re-encode the row as a COPY binary record so that the copy reader can
+  // parse it: a field count, then a length (-1 for NULL) and the binary value
+  // of each field, all in network byte order
+  const int n_fields = PQnfields(result_);
+  row_buffer_.clear();
+  const uint16_t n_fields_net = SwapHostToNetwork(static_cast<uint16_t>(n_fields));
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&n_fields_net);
+  row_buffer_.insert(row_buffer_.end(), bytes, bytes + sizeof(n_fields_net));
+  for (int i = 0; i < n_fields; i++) {
+    const bool is_null = PQgetisnull(result_, result_row_, i);
+    const int32_t length = is_null ? -1 : PQgetlength(result_, result_row_, i);
+    const uint32_t length_net = SwapHostToNetwork(static_cast<uint32_t>(length));
+    bytes = reinterpret_cast<const uint8_t*>(&length_net);
+    row_buffer_.insert(row_buffer_.end(), bytes, bytes + sizeof(length_net));
+    if (!is_null) {
+      bytes = reinterpret_cast<const uint8_t*>(PQgetvalue(result_, result_row_, i));
+      row_buffer_.insert(row_buffer_.end(), bytes, bytes + length);
+    }
   }
 
-  int na_res;
-  do {
-    na_res = AppendRowAndFetchNext(&error);
-    if (na_res == EOVERFLOW) {
-      // The result would be too big to return if we appended the row. When EOVERFLOW is
-      // returned, the copy reader leaves the output in a valid state. The data is left in
-      // pg_buf_/data_ and will attempt to be appended on the next call to GetNext()
-      return BuildOutput(out, &error);
-    }
-  } while (na_res == NANOARROW_OK);
+  result_row_++;
+  return static_cast<int>(row_buffer_.size());
+}
 
-  if (na_res != ENODATA) {
-    return na_res;
+int TupleReader::FinishQuery() {
+  if (transport_ == ResultTransport::kCursor) {
+    query_pending_ = false;
+    std::string close = "CLOSE " + cursor_name_;
+    PQclear(result_);
+    result_ = PQexec(conn_, close.c_str());
+    if (PQresultStatus(result_) == PGRES_COMMAND_OK && owns_transaction_) {
+      PQclear(result_);
+      result_ = PQexec(conn_, "COMMIT");
+    }
+    if (PQresultStatus(result_) != PGRES_COMMAND_OK) {
+      SetError(&error_, result_, "[libpq] Failed to close cursor: %s",
+               PQresultErrorMessage(result_));
+      status_ = ADBC_STATUS_IO;
+      if (owns_transaction_) PQclear(PQexec(conn_, "ROLLBACK"));
+      owns_transaction_ = false;
+      return AdbcStatusCodeToErrno(status_);
+    }
+    owns_transaction_ = false;
+    return NANOARROW_OK;
   }
 
-  is_finished_ = true;
-
-  // Finish the result properly and return the last result. Note that BuildOutput() may
-  // set tmp.release = nullptr if there were zero rows in the copy reader (can
-  // occur in an overflow scenario).
-  struct ArrowArray tmp;
-  NANOARROW_RETURN_NOT_OK(BuildOutput(&tmp, &error));
+  if (transport_ == ResultTransport::kSingleRow) {
+    // The final result was already checked while fetching rows; libpq still
+    // needs to be read until it returns NULL
+    query_pending_ = false;
+    PGresult* result;
+    while ((result = PQgetResult(conn_)) != nullptr) PQclear(result);
+    return NANOARROW_OK;
+  }
 
   PQclear(result_);
   // Check the server-side response
@@ -665,10 +1401,6 @@ int TupleReader::GetNext(struct ArrowArray* out) {
     SetError(&error_, result_, "[libpq] Query failed [%s]: %s", PQresStatus(pq_status),
              PQresultErrorMessage(result_));
 
-    if (tmp.release != nullptr) {
-      tmp.release(&tmp);
-    }
-
     if (sqlstate != nullptr && std::strcmp(sqlstate, "57014") == 0) {
       status_ = ADBC_STATUS_CANCELLED;
     } else {
@@ -676,11 +1408,31 @@ int TupleReader::GetNext(struct ArrowArray* out) {
     }
     return AdbcStatusCodeToErrno(status_);
   }
-
-  ArrowArrayMove(&tmp, out);
   return NANOARROW_OK;
 }
 
+void TupleReader::AbandonQuery() {
+  if (!query_pending_) return;
+  query_pending_ = false;
+
+  if (transport_ == ResultTransport::kCursor) {
+    // Rolling back also closes the cursor
+    std::string close = owns_transaction_ ? "ROLLBACK" : "CLOSE " + cursor_name_;
+    PQclear(PQexec(conn_, close.c_str()));
+    owns_transaction_ = false;
+  } else {
+    // Stop the query instead of reading the remaining rows
+    PGcancel* cancel = PQgetCancel(conn_);
+    if (cancel != nullptr) {
+      char errbuf[256];
+      PQcancel(cancel, errbuf, sizeof(errbuf));
+      PQfreeCancel(cancel);
+    }
+    PGresult* result;
+    while ((result = PQgetResult(conn_)) != nullptr) PQclear(result);
+  }
+}
+
 void TupleReader::Release() {
   if (error_.release) {
     error_.release(&error_);
@@ -702,6 +1454,11 @@ void TupleReader::Release() {
     copy_reader_.reset();
   }
 
+  AbandonQuery();
+  rows_done_ = false;
+  result_row_ = 0;
+  row_buffer_.clear();
+
   is_finished_ = false;
   row_id_ = -1;
 }
@@ -813,93 +1570,58 @@ AdbcStatusCode PostgresStatement::Cancel(struct AdbcError* error) {
   return connection_->Cancel(error);
 }
 
-AdbcStatusCode PostgresStatement::CreateBulkTable(
-    const std::string& current_schema, const struct ArrowSchema& source_schema,
-    const std::vector<struct ArrowSchemaView>& source_schema_fields,
-    std::string* escaped_table, struct AdbcError* error) {
+AdbcStatusCode PostgresStatement::EscapeBulkTarget(const std::string& current_schema,
+                                                   std::string* escaped_schema,
+                                                   std::string* escaped_table,
+                                                   struct AdbcError* error) {
   PGconn* conn = connection_->conn();
 
-  if (!ingest_.db_schema.empty() && ingest_.temporary) {
-    SetError(error, "[libpq] Cannot set both %s and %s",
-             ADBC_INGEST_OPTION_TARGET_DB_SCHEMA, ADBC_INGEST_OPTION_TEMPORARY);
-    return ADBC_STATUS_INVALID_STATE;
-  }
-
-  {
-    if (!ingest_.db_schema.empty()) {
-      char* escaped =
-          PQescapeIdentifier(conn, ingest_.db_schema.c_str(), ingest_.db_schema.size());
-      if (escaped == nullptr) {
-        SetError(error, "[libpq] Failed to escape target schema %s for ingestion: %s",
-                 ingest_.db_schema.c_str(), PQerrorMessage(conn));
-        return ADBC_STATUS_INTERNAL;
-      }
-      *escaped_table += escaped;
-      *escaped_table += " . ";
-      PQfreemem(escaped);
-    } else if (ingest_.temporary) {
-      // OK to be redundant (CREATE TEMPORARY TABLE pg_temp.foo)
-      *escaped_table += "pg_temp . ";
-    } else {
-      // Explicitly specify the current schema to avoid any temporary tables
-      // shadowing this table
-      char* escaped =
-          PQescapeIdentifier(conn, current_schema.c_str(), current_schema.size());
-      *escaped_table += escaped;
-      *escaped_table += " . ";
-      PQfreemem(escaped);
-    }
-
-    if (!ingest_.target.empty()) {
-      char* escaped =
-          PQescapeIdentifier(conn, ingest_.target.c_str(), ingest_.target.size());
-      if (escaped == nullptr) {
-        SetError(error, "[libpq] Failed to escape target table %s for ingestion: %s",
-                 ingest_.target.c_str(), PQerrorMessage(conn));
-        return ADBC_STATUS_INTERNAL;
-      }
-      *escaped_table += escaped;
-      PQfreemem(escaped);
+  if (!ingest_.db_schema.empty()) {
+    char* escaped =
+        PQescapeIdentifier(conn, ingest_.db_schema.c_str(), ingest_.db_schema.size());
+    if (escaped == nullptr) {
+      SetError(error, "[libpq] Failed to escape target schema %s for ingestion: %s",
+               ingest_.db_schema.c_str(), PQerrorMessage(conn));
+      return ADBC_STATUS_INTERNAL;
     }
-  }
-
-  std::string create;
-
-  if (ingest_.temporary) {
-    create = "CREATE TEMPORARY TABLE ";
+    *escaped_schema = escaped;
+    *escaped_schema += " . ";
+    PQfreemem(escaped);
+  } else if (ingest_.temporary) {
+    // OK to be redundant (CREATE TEMPORARY TABLE pg_temp.foo)
+    *escaped_schema = "pg_temp . ";
   } else {
-    create = "CREATE TABLE ";
+    // Explicitly specify the current schema to avoid any temporary tables
+    // shadowing this table
+    char* escaped =
+        PQescapeIdentifier(conn, current_schema.c_str(), current_schema.size());
+    *escaped_schema = escaped;
+    *escaped_schema += " . ";
+    PQfreemem(escaped);
   }
 
-  switch (ingest_.mode) {
-    case IngestMode::kCreate:
-      // Nothing to do
-      break;
-    case IngestMode::kAppend:
-      return ADBC_STATUS_OK;
-    case IngestMode::kReplace: {
-      std::string drop = "DROP TABLE IF EXISTS " + *escaped_table;
-      PGresult* result = PQexecParams(conn, drop.c_str(), /*nParams=*/0,
-                                      /*paramTypes=*/nullptr, /*paramValues=*/nullptr,
-                                      /*paramLengths=*/nullptr, /*paramFormats=*/nullptr,
-                                      /*resultFormat=*/1 /*(binary)*/);
-      if (PQresultStatus(result) != PGRES_COMMAND_OK) {
-        AdbcStatusCode code =
-            SetError(error, result, "[libpq] Failed to drop table: %s\nQuery was: %s",
-                     PQerrorMessage(conn), drop.c_str());
-        PQclear(result);
-        return code;
-      }
-      PQclear(result);
-      break;
+  escaped_table->clear();
+  if (!ingest_.target.empty()) {
+    char* escaped =
+        PQescapeIdentifier(conn, ingest_.target.c_str(), ingest_.target.size());
+    if (escaped == nullptr) {
+      SetError(error, "[libpq] Failed to escape target table %s for ingestion: %s",
+               ingest_.target.c_str(), PQerrorMessage(conn));
+      return ADBC_STATUS_INTERNAL;
     }
-    case IngestMode::kCreateAppend:
-      create += "IF NOT EXISTS ";
-      break;
+    *escaped_table = escaped;
+    PQfreemem(escaped);
   }
-  create += *escaped_table;
-  create += " (";
+  return ADBC_STATUS_OK;
+}
 
+AdbcStatusCode PostgresStatement::BuildBulkTableColumns(
+    const struct ArrowSchema& source_schema,
+    const std::vector<struct ArrowSchemaView>& source_schema_fields,
+    std::string* columns, struct AdbcError* error) {
+  PGconn* conn = connection_->conn();
+  std::string& create = *columns;
+  create = "(";
   for (size_t i = 0; i < source_schema_fields.size(); i++) {
     if (i > 0) create += ", ";
 
@@ -964,6 +1686,66 @@ AdbcStatusCode PostgresStatement::CreateBulkTable(
   }
 
   create += ")";
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode PostgresStatement::CreateBulkTable(
+    const std::string& current_schema, const struct ArrowSchema& source_schema,
+    const std::vector<struct ArrowSchemaView>& source_schema_fields,
+    std::string* escaped_table, struct AdbcError* error) {
+  PGconn* conn = connection_->conn();
+
+  if (!ingest_.db_schema.empty() && ingest_.temporary) {
+    SetError(error, "[libpq] Cannot set both %s and %s",
+             ADBC_INGEST_OPTION_TARGET_DB_SCHEMA, ADBC_INGEST_OPTION_TEMPORARY);
+    return ADBC_STATUS_INVALID_STATE;
+  }
+
+  std::string escaped_schema;
+  std::string escaped_name;
+  RAISE_ADBC(EscapeBulkTarget(current_schema, &escaped_schema, &escaped_name, error));
+  *escaped_table = escaped_schema + escaped_name;
+
+  std::string create;
+
+  if (ingest_.temporary) {
+    create = "CREATE TEMPORARY TABLE ";
+  } else {
+    create = "CREATE TABLE ";
+  }
+
+  switch (ingest_.mode) {
+    case IngestMode::kCreate:
+      // Nothing to do
+      break;
+    case IngestMode::kAppend:
+      return ADBC_STATUS_OK;
+    case IngestMode::kReplace: {
+      std::string drop = "DROP TABLE IF EXISTS " + *escaped_table;
+      PGresult* result = PQexecParams(conn, drop.c_str(), /*nParams=*/0,
+                                      /*paramTypes=*/nullptr, /*paramValues=*/nullptr,
+                                      /*paramLengths=*/nullptr, /*paramFormats=*/nullptr,
+                                      /*resultFormat=*/1 /*(binary)*/);
+      if (PQresultStatus(result) != PGRES_COMMAND_OK) {
+        AdbcStatusCode code =
+            SetError(error, result, "[libpq] Failed to drop table: %s\nQuery was: %s",
+                     PQerrorMessage(conn), drop.c_str());
+        PQclear(result);
+        return code;
+      }
+      PQclear(result);
+      break;
+    }
+    case IngestMode::kCreateAppend:
+      create += "IF NOT EXISTS ";
+      break;
+  }
+  create += *escaped_table;
+  create += " ";
+
+  std::string columns;
+  RAISE_ADBC(BuildBulkTableColumns(source_schema, source_schema_fields, &columns, error));
+  create += columns;
   SetError(error, "%s%s", "[libpq] ", create.c_str());
   PGresult* result = PQexecParams(conn, create.c_str(), /*nParams=*/0,
                                   /*paramTypes=*/nullptr, /*paramValues=*/nullptr,
@@ -1062,8 +1844,12 @@ AdbcStatusCode PostgresStatement::ExecuteQuery(struct ArrowArrayStream* stream,
     }
   }
 
-  // 2. Execute the query with COPY to get binary tuples
-  {
+  // 2. Execute the query with COPY (or the configured alternative) to get binary tuples
+  if (reader_.transport_ == ResultTransport::kCursor) {
+    RAISE_ADBC(reader_.BeginCursor(query_, error));
+  } else if (reader_.transport_ == ResultTransport::kSingleRow) {
+    RAISE_ADBC(reader_.BeginSingleRow(query_, error));
+  } else {
     std::string copy_query = "COPY (" + query_ + ") TO STDOUT (FORMAT binary)";
     reader_.result_ =
         PQexecParams(connection_->conn(), copy_query.c_str(), /*nParams=*/0,
@@ -1080,7 +1866,14 @@ AdbcStatusCode PostgresStatement::ExecuteQuery(struct ArrowArrayStream* stream,
     // Result is read from the connection, not the result, but we won't clear it here
   }
 
-  reader_.ExportTo(stream);
+  if (rechunk_.rows > 0 || rechunk_.bytes > 0) {
+    struct ArrowArrayStream reader_stream;
+    reader_.ExportTo(&reader_stream);
+    RAISE_ADBC(
+        RechunkArrayStream(&reader_stream, rechunk_.rows, rechunk_.bytes, stream, error));
+  } else {
+    reader_.ExportTo(stream);
+  }
   if (rows_affected) *rows_affected = -1;
   return ADBC_STATUS_OK;
 }
@@ -1108,6 +1901,26 @@ AdbcStatusCode PostgresStatement::ExecuteUpdateBulk(int64_t* rows_affected,
     SetError(error, "%s", "[libpq] Must Bind() before Execute() for bulk ingestion");
     return ADBC_STATUS_INVALID_STATE;
   }
+  if (ingest_.staging) {
+    if (ingest_.temporary) {
+      SetError(error, "[libpq] Cannot set both %s and %s",
+               ADBC_POSTGRESQL_OPTION_INGEST_STAGING, ADBC_INGEST_OPTION_TEMPORARY);
+      return ADBC_STATUS_INVALID_STATE;
+    }
+  }
+  if (ingest_.connections > 1) {
+    // Other connections can't see a temporary table, or a table created in
+    // (or data inserted by) an open transaction
+    if (ingest_.temporary) {
+      SetError(error, "[libpq] Cannot use %s > 1 with %s",
+               ADBC_POSTGRESQL_OPTION_INGEST_CONNECTIONS, ADBC_INGEST_OPTION_TEMPORARY);
+      return ADBC_STATUS_INVALID_STATE;
+    } else if (!connection_->autocommit()) {
+      SetError(error, "[libpq] Cannot use %s > 1 with autocommit disabled",
+               ADBC_POSTGRESQL_OPTION_INGEST_CONNECTIONS);
+      return ADBC_STATUS_INVALID_STATE;
+    }
+  }
 
   // Need the current schema to avoid being shadowed by temp tables
   // This is a little unfortunate; we need another DB roundtrip
@@ -1126,6 +1939,77 @@ AdbcStatusCode PostgresStatement::ExecuteUpdateBulk(int64_t* rows_affected,
 
   BindStream bind_stream(std::move(bind_));
   std::memset(&bind_, 0, sizeof(bind_));
+
+  if (ingest_.staging) {
+    PGconn* conn = connection_->conn();
+    std::string escaped_schema;
+    std::string escaped_target;
+    std::string columns;
+    RAISE_ADBC(bind_stream.Begin(
+        [&]() -> AdbcStatusCode {
+          RAISE_ADBC(
+              EscapeBulkTarget(current_schema, &escaped_schema, &escaped_target, error));
+          return BuildBulkTableColumns(bind_stream.bind_schema.value,
+                                       bind_stream.bind_schema_fields, &columns, error);
+        },
+        error));
+    RAISE_ADBC(bind_stream.SetParamTypes(*type_resolver_, error));
+
+    if (ingest_.mode == IngestMode::kCreate) {
+      // Fail before loading anything rather than when renaming into place
+      PqResultHelper result_helper{conn,
+                                   "SELECT to_regclass($1) IS NOT NULL",
+                                   {escaped_schema + escaped_target},
+                                   error};
+      RAISE_ADBC(result_helper.Prepare());
+      RAISE_ADBC(result_helper.Execute());
+      auto it = result_helper.begin();
+      if (it != result_helper.end() && std::strcmp((*it)[0].data, "t") == 0) {
+        SetError(error, "[libpq] Failed to create table: relation %s%s already exists",
+                 escaped_schema.c_str(), escaped_target.c_str());
+        if (error) std::memcpy(error->sqlstate, "42P07", 5);
+        return ADBC_STATUS_ALREADY_EXISTS;
+      }
+    }
+
+    // The staging table must be in the target's schema so that it can be
+    // renamed into place. It gets a random name (and is never created with
+    // IF NOT EXISTS or dropped before it was created here), so that an
+    // existing table can't be mistaken for it.
+    //
+    // A staging table that becomes the target (create and replace) is a
+    // regular table, so COPY writes it to the WAL once. One that is only
+    // copied from (append modes) is unlogged, since only the INSERT into
+    // the target needs to be crash-safe.
+    const bool renamed =
+        ingest_.mode == IngestMode::kCreate || ingest_.mode == IngestMode::kReplace;
+    const std::string staging = escaped_schema + "adbc_staging_" + RandomHexString();
+    const char* create = renamed ? "CREATE TABLE " : "CREATE UNLOGGED TABLE ";
+    RAISE_ADBC(ExecCommand(conn, create + staging + " " + columns, error));
+
+    // With several connections, the staging table was committed above (as
+    // autocommit is required), so the other connections can load it
+    const std::string copy_query = "COPY " + staging + " FROM STDIN (FORMAT binary)";
+    AdbcStatusCode status;
+    if (ingest_.connections > 1) {
+      ParallelIngest parallel(connection_->database().get(), &bind_stream,
+                              ingest_.two_phase);
+      status = parallel.Run(*type_resolver_, copy_query, ingest_.connections,
+                            rows_affected, error);
+    } else {
+      status = bind_stream.ExecuteCopy(conn, copy_query, rows_affected, error);
+    }
+    if (status == ADBC_STATUS_OK) {
+      status = SwapStagingTable(staging, escaped_schema, escaped_target, columns, error);
+    }
+    if (status != ADBC_STATUS_OK) {
+      // Best effort: inside a failed transaction this fails too, but then
+      // rolling back the transaction drops the table
+      ExecCommand(conn, "DROP TABLE " + staging, nullptr);
+    }
+    return status;
+  }
+
   std::string escaped_table;
   RAISE_ADBC(bind_stream.Begin(
       [&]() -> AdbcStatusCode {
@@ -1135,6 +2019,14 @@ AdbcStatusCode PostgresStatement::ExecuteUpdateBulk(int64_t* rows_affected,
       error));
   RAISE_ADBC(bind_stream.SetParamTypes(*type_resolver_, error));
 
+  if (ingest_.connections > 1) {
+    ParallelIngest parallel(connection_->database().get(), &bind_stream,
+                            ingest_.two_phase);
+    return parallel.Run(*type_resolver_,
+                        "COPY " + escaped_table + " FROM STDIN (FORMAT binary)",
+                        ingest_.connections, rows_affected, error);
+  }
+
   std::string insert = "INSERT INTO ";
   insert += escaped_table;
   insert += " VALUES (";
@@ -1151,6 +2043,51 @@ AdbcStatusCode PostgresStatement::ExecuteUpdateBulk(int64_t* rows_affected,
   return ADBC_STATUS_OK;
 }
 
+AdbcStatusCode PostgresStatement::SwapStagingTable(const std::string& staging,
+                                                   const std::string& escaped_schema,
+                                                   const std::string& escaped_target,
+                                                   const std::string& columns,
+                                                   struct AdbcError* error) {
+  PGconn* conn = connection_->conn();
+  const std::string target = escaped_schema + escaped_target;
+  const std::string rename = "ALTER TABLE " + staging + " RENAME TO " + escaped_target;
+  const std::string copy = "INSERT INTO " + target + " SELECT * FROM " + staging;
+
+  std::vector<std::string> commands;
+  switch (ingest_.mode) {
+    case IngestMode::kCreate:
+    case IngestMode::kReplace:
+      if (ingest_.mode == IngestMode::kReplace) {
+        commands.push_back("DROP TABLE IF EXISTS " + target);
+      }
+      commands.push_back(rename);
+      break;
+    case IngestMode::kAppend:
+      commands.push_back(copy);
+      commands.push_back("DROP TABLE " + staging);
+      break;
+    case IngestMode::kCreateAppend:
+      commands.push_back("CREATE TABLE IF NOT EXISTS " + target + " " + columns);
+      commands.push_back(copy);
+      commands.push_back("DROP TABLE " + staging);
+      break;
+  }
+
+  // Readers see either the old or the new contents of the target. Without
+  // autocommit, the commands join the open transaction instead.
+  const bool autocommit = connection_->autocommit();
+  if (autocommit) RAISE_ADBC(ExecCommand(conn, "BEGIN", error));
+  for (const auto& command : commands) {
+    AdbcStatusCode status = ExecCommand(conn, command, error);
+    if (status != ADBC_STATUS_OK) {
+      if (autocommit) ExecCommand(conn, "ROLLBACK", nullptr);
+      return status;
+    }
+  }
+  if (autocommit) RAISE_ADBC(ExecCommand(conn, "COMMIT", error));
+  return ADBC_STATUS_OK;
+}
+
 AdbcStatusCode PostgresStatement::ExecuteUpdateQuery(int64_t* rows_affected,
                                                      struct AdbcError* error) {
   // NOTE: must prepare first (used in ExecuteQuery)
@@ -1193,8 +2130,36 @@ AdbcStatusCode PostgresStatement::GetOption(const char* key, char* value, size_t
         result = ADBC_INGEST_OPTION_MODE_CREATE_APPEND;
         break;
     }
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_INGEST_CONNECTIONS) == 0) {
+    result = std::to_string(ingest_.connections);
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_INGEST_COMMIT) == 0) {
+    result = ingest_.two_phase ? "two_phase" : "deferred";
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_INGEST_STAGING) == 0) {
+    result = ingest_.staging ? ADBC_OPTION_VALUE_ENABLED : ADBC_OPTION_VALUE_DISABLED;
   } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_BATCH_SIZE_HINT_BYTES) == 0) {
     result = std::to_string(reader_.batch_size_hint_bytes_);
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_RESULT_TRANSPORT) == 0) {
+    switch (reader_.transport_) {
+      case ResultTransport::kCopy:
+        result = "copy";
+        break;
+      case ResultTransport::kCursor:
+        result = "cursor";
+        break;
+      case ResultTransport::kSingleRow:
+        result = "single_row";
+        break;
+    }
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_CURSOR_FETCH_ROWS) == 0) {
+    result = std::to_string(reader_.cursor_fetch_rows_);
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_NUMERIC_CONVERSION) == 0) {
+    result = reader_.copy_options_.numeric_as_decimal ? "decimal" : "string";
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_NUMERIC_SPECIAL_VALUES) == 0) {
+    result = reader_.copy_options_.numeric_special_as_null ? "null" : "error";
+  } else if (std::strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS) == 0) {
+    result = std::to_string(rechunk_.rows);
+  } else if (std::strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_BYTES) == 0) {
+    result = std::to_string(rechunk_.bytes);
   } else {
     SetError(error, "[libpq] Unknown statement option '%s'", key);
     return ADBC_STATUS_NOT_FOUND;
@@ -1226,6 +2191,18 @@ AdbcStatusCode PostgresStatement::GetOptionInt(const char* key, int64_t* value,
   if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_BATCH_SIZE_HINT_BYTES) == 0) {
     *value = reader_.batch_size_hint_bytes_;
     return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_CURSOR_FETCH_ROWS) == 0) {
+    *value = reader_.cursor_fetch_rows_;
+    return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_INGEST_CONNECTIONS) == 0) {
+    *value = ingest_.connections;
+    return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS) == 0) {
+    *value = rechunk_.rows;
+    return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_BYTES) == 0) {
+    *value = rechunk_.bytes;
+    return ADBC_STATUS_OK;
   }
   SetError(error, "[libpq] Unknown statement option '%s'", key);
   return ADBC_STATUS_NOT_FOUND;
@@ -1304,6 +2281,33 @@ AdbcStatusCode PostgresStatement::SetOption(const char* key, const char* value,
     }
     ingest_.db_schema.clear();
     prepared_ = false;
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_INGEST_CONNECTIONS) == 0) {
+    char* end = nullptr;
+    errno = 0;
+    int64_t int_value = std::strtoll(value, &end, /*base=*/10);
+    if (errno != 0 || end == value || *end != '\0') {
+      SetError(error, "[libpq] Invalid value '%s' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    return SetOptionInt(key, int_value, error);
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_INGEST_COMMIT) == 0) {
+    if (std::strcmp(value, "deferred") == 0) {
+      ingest_.two_phase = false;
+    } else if (std::strcmp(value, "two_phase") == 0) {
+      ingest_.two_phase = true;
+    } else {
+      SetError(error, "[libpq] Invalid value '%s' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_INGEST_STAGING) == 0) {
+    if (std::strcmp(value, ADBC_OPTION_VALUE_ENABLED) == 0) {
+      ingest_.staging = true;
+    } else if (std::strcmp(value, ADBC_OPTION_VALUE_DISABLED) == 0) {
+      ingest_.staging = false;
+    } else {
+      SetError(error, "[libpq] Invalid value '%s' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
   } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_BATCH_SIZE_HINT_BYTES) == 0) {
     int64_t int_value = std::atol(value);
     if (int_value <= 0) {
@@ -1312,6 +2316,54 @@ AdbcStatusCode PostgresStatement::SetOption(const char* key, const char* value,
     }
 
     this->reader_.batch_size_hint_bytes_ = int_value;
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_RESULT_TRANSPORT) == 0) {
+    if (std::strcmp(value, "copy") == 0) {
+      reader_.transport_ = ResultTransport::kCopy;
+    } else if (std::strcmp(value, "cursor") == 0) {
+      reader_.transport_ = ResultTransport::kCursor;
+    } else if (std::strcmp(value, "single_row") == 0) {
+      reader_.transport_ = ResultTransport::kSingleRow;
+    } else {
+      SetError(error, "[libpq] Invalid value '%s' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_CURSOR_FETCH_ROWS) == 0) {
+    char* end = nullptr;
+    errno = 0;
+    int64_t int_value = std::strtoll(value, &end, /*base=*/10);
+    if (errno != 0 || end == value || *end != '\0') {
+      SetError(error, "[libpq] Invalid value '%s' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    return SetOptionInt(key, int_value, error);
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_NUMERIC_CONVERSION) == 0) {
+    if (std::strcmp(value, "string") == 0) {
+      reader_.copy_options_.numeric_as_decimal = false;
+    } else if (std::strcmp(value, "decimal") == 0) {
+      reader_.copy_options_.numeric_as_decimal = true;
+    } else {
+      SetError(error, "[libpq] Invalid value '%s' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_NUMERIC_SPECIAL_VALUES) == 0) {
+    if (std::strcmp(value, "error") == 0) {
+      reader_.copy_options_.numeric_special_as_null = false;
+    } else if (std::strcmp(value, "null") == 0) {
+      reader_.copy_options_.numeric_special_as_null = true;
+    } else {
+      SetError(error, "[libpq] Invalid value '%s' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+  } else if (std::strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS) == 0 ||
+             std::strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_BYTES) == 0) {
+    char* end = nullptr;
+    errno = 0;
+    int64_t int_value = std::strtoll(value, &end, /*base=*/10);
+    if (errno != 0 || end == value || *end != '\0') {
+      SetError(error, "[libpq] Invalid value '%s' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    return SetOptionInt(key, int_value, error);
   } else {
     SetError(error, "[libpq] Unknown statement option '%s'", key);
     return ADBC_STATUS_NOT_IMPLEMENTED;
@@ -1341,6 +2393,35 @@ AdbcStatusCode PostgresStatement::SetOptionInt(const char* key, int64_t value,
 
     this->reader_.batch_size_hint_bytes_ = value;
     return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_CURSOR_FETCH_ROWS) == 0) {
+    if (value <= 0) {
+      SetError(error, "[libpq] Invalid value '%" PRIi64 "' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+
+    reader_.cursor_fetch_rows_ = value;
+    return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_POSTGRESQL_OPTION_INGEST_CONNECTIONS) == 0) {
+    if (value <= 0) {
+      SetError(error, "[libpq] Invalid value '%" PRIi64 "' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+
+    ingest_.connections = value;
+    return ADBC_STATUS_OK;
+  } else if (std::strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS) == 0 ||
+             std::strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_BYTES) == 0) {
+    if (value < 0) {
+      SetError(error, "[libpq] Invalid value '%" PRIi64 "' for option '%s'", value, key);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (std::strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS) == 0) {
+      rechunk_.rows = value;
+    } else {
+      rechunk_.bytes = value;
+    }
+    return ADBC_STATUS_OK;
   }
   SetError(error, "[libpq] Unknown statement option '%s'", key);
   return ADBC_STATUS_NOT_IMPLEMENTED;
@@ -1381,6 +2462,7 @@ AdbcStatusCode PostgresStatement::SetupReader(struct AdbcError* error) {
   // unsupported types before issuing the COPY query)
   reader_.copy_reader_.reset(new PostgresCopyStreamReader());
   reader_.copy_reader_->Init(root_type);
+  reader_.copy_reader_->SetOptions(reader_.copy_options_);
   struct ArrowError na_error;
   int na_res = reader_.copy_reader_->InferOutputSchema(&na_error);
   if (na_res != NANOARROW_OK) {
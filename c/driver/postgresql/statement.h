@@ -32,11 +32,49 @@
 
 #define ADBC_POSTGRESQL_OPTION_BATCH_SIZE_HINT_BYTES \
   "adbc.postgresql.batch_size_hint_bytes"
+/// \brief How to return NUMERIC columns: "string" (the default) or "decimal"
+///   (decimal128/decimal256 for columns with a declared precision and scale).
+#define ADBC_POSTGRESQL_OPTION_NUMERIC_CONVERSION "adbc.postgresql.numeric_conversion"
+/// \brief What to do with NaN and +/-Infinity when converting NUMERIC to
+///   decimal: "error" (the default) or "null".
+#define ADBC_POSTGRESQL_OPTION_NUMERIC_SPECIAL_VALUES \
+  "adbc.postgresql.numeric_special_values"
+/// \brief How result sets are transferred: "copy" (the default), "cursor", or
+///   "single_row".
+#define ADBC_POSTGRESQL_OPTION_RESULT_TRANSPORT "adbc.postgresql.result_transport"
+/// \brief The number of rows fetched per round trip with the "cursor" transport.
+#define ADBC_POSTGRESQL_OPTION_CURSOR_FETCH_ROWS "adbc.postgresql.cursor_fetch_rows"
+/// \brief The number of connections bulk ingestion loads over (default 1).
+///   With more than one, each connection loads part of the data with COPY in
+///   its own transaction, and the transactions are committed once all succeed.
+#define ADBC_POSTGRESQL_OPTION_INGEST_CONNECTIONS "adbc.postgresql.ingest_connections"
+/// \brief How the transactions of a multi-connection ingest are committed:
+///   "deferred" (the default) or "two_phase" (PREPARE TRANSACTION, which needs
+///   max_prepared_transactions > 0 on the server).
+#define ADBC_POSTGRESQL_OPTION_INGEST_COMMIT "adbc.postgresql.ingest_commit"
+/// \brief Whether bulk ingestion loads into a staging table with COPY first,
+///   then moves the rows into the target in one short transaction (default
+///   false).
+#define ADBC_POSTGRESQL_OPTION_INGEST_STAGING "adbc.postgresql.ingest_staging"
 
 namespace adbcpq {
 class PostgresConnection;
 class PostgresStatement;
 
+/// \brief How the rows of a result set are transferred from the server.
+///
+/// All transports request values in binary format, so they share the field
+/// readers (and therefore the type mapping) of PostgresCopyStreamReader.
+enum class ResultTransport {
+  /// \brief COPY (query) TO STDOUT (FORMAT binary)
+  kCopy,
+  /// \brief DECLARE ... CURSOR and repeated FETCH FORWARD n, for servers or
+  ///   poolers that do not allow COPY
+  kCursor,
+  /// \brief libpq single-row mode, which only needs the extended query protocol
+  kSingleRow,
+};
+
 /// \brief An ArrowArrayStream that reads tuples from a PGresult.
 class TupleReader final {
  public:
@@ -49,7 +87,13 @@ class TupleReader final {
         copy_reader_(nullptr),
         row_id_(-1),
         batch_size_hint_bytes_(16777216),
-        is_finished_(false) {
+        is_finished_(false),
+        transport_(ResultTransport::kCopy),
+        cursor_fetch_rows_(10000),
+        owns_transaction_(false),
+        query_pending_(false),
+        rows_done_(false),
+        result_row_(0) {
     data_.data.as_char = nullptr;
     data_.size_bytes = 0;
   }
@@ -70,6 +114,17 @@ class TupleReader final {
   int AppendRowAndFetchNext(struct ArrowError* error);
   int BuildOutput(struct ArrowArray* out, struct ArrowError* error);
 
+  // Start a query with the cursor or single-row transport
+  AdbcStatusCode BeginCursor(const std::string& query, struct AdbcError* error);
+  AdbcStatusCode BeginSingleRow(const std::string& query, struct AdbcError* error);
+  // Point data_ at the next record; returns the same values as PQgetCopyData()
+  int FetchNext();
+  int FetchNextRow();
+  // Check the final status of the query (and end the cursor transport)
+  int FinishQuery();
+  // Clean up the connection if the stream is released before the end
+  void AbandonQuery();
+
   static int GetSchemaTrampoline(struct ArrowArrayStream* self, struct ArrowSchema* out);
   static int GetNextTrampoline(struct ArrowArrayStream* self, struct ArrowArray* out);
   static const char* GetLastErrorTrampoline(struct ArrowArrayStream* self);
@@ -84,7 +139,22 @@ class TupleReader final {
   std::unique_ptr<PostgresCopyStreamReader> copy_reader_;
   int64_t row_id_;
   int64_t batch_size_hint_bytes_;
+  PostgresCopyReaderOptions copy_options_;
   bool is_finished_;
+
+  ResultTransport transport_;
+  int64_t cursor_fetch_rows_;
+  std::string cursor_name_;
+  // Whether the cursor transport began the transaction it runs in
+  bool owns_transaction_;
+  // Whether a cursor or single-row query still needs to be finished
+  bool query_pending_;
+  // Whether the last row of a cursor or single-row query has been fetched
+  bool rows_done_;
+  // The next row of result_ (cursor and single-row transports)
+  int result_row_;
+  // The current row re-encoded as a COPY binary record
+  std::vector<uint8_t> row_buffer_;
 };
 
 class PostgresStatement {
@@ -129,7 +199,18 @@ class PostgresStatement {
       const std::string& current_schema, const struct ArrowSchema& source_schema,
       const std::vector<struct ArrowSchemaView>& source_schema_fields,
       std::string* escaped_table, struct AdbcError* error);
+  AdbcStatusCode EscapeBulkTarget(const std::string& current_schema,
+                                  std::string* escaped_schema, std::string* escaped_table,
+                                  struct AdbcError* error);
+  AdbcStatusCode BuildBulkTableColumns(
+      const struct ArrowSchema& source_schema,
+      const std::vector<struct ArrowSchemaView>& source_schema_fields,
+      std::string* columns, struct AdbcError* error);
   AdbcStatusCode ExecuteUpdateBulk(int64_t* rows_affected, struct AdbcError* error);
+  AdbcStatusCode SwapStagingTable(const std::string& staging,
+                                  const std::string& escaped_schema,
+                                  const std::string& escaped_target,
+                                  const std::string& columns, struct AdbcError* error);
   AdbcStatusCode ExecuteUpdateQuery(int64_t* rows_affected, struct AdbcError* error);
   AdbcStatusCode ExecutePreparedStatement(struct ArrowArrayStream* stream,
                                           int64_t* rows_affected,
@@ -158,8 +239,17 @@ class PostgresStatement {
     std::string target;
     IngestMode mode = IngestMode::kCreate;
     bool temporary = false;
+    int64_t connections = 1;
+    bool two_phase = false;
+    bool staging = false;
   } ingest_;
 
+  // Result set re-chunking (0 means use the reader's batches as-is)
+  struct {
+    int64_t rows = 0;
+    int64_t bytes = 0;
+  } rechunk_;
+
   TupleReader reader_;
 };
 }  // namespace adbcpq
@@ -0,0 +1,322 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nanoarrow/nanoarrow.hpp>
+
+#include "common/utils.h"
+
+namespace adbcpq {
+
+namespace {
+constexpr char kLikeEscape = '\\';
+
+// The length of the UTF-8 character starting at value[i] (so that '_' matches
+// one character, as in PostgreSQL, rather than one byte)
+size_t Utf8CharLength(std::string_view value, size_t i) {
+  const auto c = static_cast<unsigned char>(value[i]);
+  size_t length = 1;
+  if ((c >> 5) == 0x6) {
+    length = 2;
+  } else if ((c >> 4) == 0xe) {
+    length = 3;
+  } else if ((c >> 3) == 0x1e) {
+    length = 4;
+  }
+  return std::min(length, value.size() - i);
+}
+
+ArrowErrorCode InitStatisticsSchema(struct ArrowSchema* schema) {
+  ArrowSchemaInit(schema);
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeStruct(schema, /*num_columns=*/2));
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema->children[0], NANOARROW_TYPE_STRING));
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(schema->children[0], "catalog_name"));
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema->children[1], NANOARROW_TYPE_LIST));
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(schema->children[1], "catalog_db_schemas"));
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeStruct(schema->children[1]->children[0], 2));
+  schema->children[1]->flags &= ~ARROW_FLAG_NULLABLE;
+
+  struct ArrowSchema* db_schema_schema = schema->children[1]->children[0];
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetType(db_schema_schema->children[0], NANOARROW_TYPE_STRING));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetName(db_schema_schema->children[0], "db_schema_name"));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetType(db_schema_schema->children[1], NANOARROW_TYPE_LIST));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetName(db_schema_schema->children[1], "db_schema_statistics"));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetTypeStruct(db_schema_schema->children[1]->children[0], 5));
+  db_schema_schema->children[1]->flags &= ~ARROW_FLAG_NULLABLE;
+
+  struct ArrowSchema* statistics_schema = db_schema_schema->children[1]->children[0];
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetType(statistics_schema->children[0], NANOARROW_TYPE_STRING));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetName(statistics_schema->children[0], "table_name"));
+  statistics_schema->children[0]->flags &= ~ARROW_FLAG_NULLABLE;
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetType(statistics_schema->children[1], NANOARROW_TYPE_STRING));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetName(statistics_schema->children[1], "column_name"));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetType(statistics_schema->children[2], NANOARROW_TYPE_INT16));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetName(statistics_schema->children[2], "statistic_key"));
+  statistics_schema->children[2]->flags &= ~ARROW_FLAG_NULLABLE;
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeUnion(statistics_schema->children[3],
+                                                  NANOARROW_TYPE_DENSE_UNION, 4));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetName(statistics_schema->children[3], "statistic_value"));
+  statistics_schema->children[3]->flags &= ~ARROW_FLAG_NULLABLE;
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetType(statistics_schema->children[4], NANOARROW_TYPE_BOOL));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetName(statistics_schema->children[4], "statistic_is_approximate"));
+  statistics_schema->children[4]->flags &= ~ARROW_FLAG_NULLABLE;
+
+  struct ArrowSchema* value_schema = statistics_schema->children[3];
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetType(value_schema->children[0], NANOARROW_TYPE_INT64));
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(value_schema->children[0], "int64"));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetType(value_schema->children[1], NANOARROW_TYPE_UINT64));
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(value_schema->children[1], "uint64"));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetType(value_schema->children[2], NANOARROW_TYPE_DOUBLE));
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(value_schema->children[2], "float64"));
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetType(value_schema->children[3], NANOARROW_TYPE_BINARY));
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(value_schema->children[3], "binary"));
+  return NANOARROW_OK;
+}
+
+/// Appends (table, column, key, float64 value, approximate) rows to the
+/// db_schema_statistics list.
+class StatisticsAppender {
+ public:
+  explicit StatisticsAppender(struct ArrowArray* items)
+      : items_(items),
+        table_name_col_(items->children[0]),
+        column_name_col_(items->children[1]),
+        key_col_(items->children[2]),
+        value_col_(items->children[3]),
+        is_approximate_col_(items->children[4]),
+        value_float64_col_(items->children[3]->children[2]) {}
+
+  ArrowErrorCode Append(const std::string& table_name, const std::string* column_name,
+                        int16_t key, double value) {
+    NANOARROW_RETURN_NOT_OK(
+        ArrowArrayAppendString(table_name_col_, ArrowCharView(table_name.c_str())));
+    if (column_name == nullptr) {
+      NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(column_name_col_, 1));
+    } else {
+      NANOARROW_RETURN_NOT_OK(
+          ArrowArrayAppendString(column_name_col_, ArrowCharView(column_name->c_str())));
+    }
+    NANOARROW_RETURN_NOT_OK(ArrowArrayAppendInt(key_col_, key));
+    NANOARROW_RETURN_NOT_OK(ArrowArrayAppendDouble(value_float64_col_, value));
+    NANOARROW_RETURN_NOT_OK(ArrowArrayFinishUnionElement(value_col_, kVariantFloat64));
+    // Everything PostgreSQL keeps is an estimate
+    NANOARROW_RETURN_NOT_OK(ArrowArrayAppendInt(is_approximate_col_, 1));
+    return ArrowArrayFinishElement(items_);
+  }
+
+ private:
+  static constexpr int8_t kVariantFloat64 = 2;
+
+  struct ArrowArray* items_;
+  struct ArrowArray* table_name_col_;
+  struct ArrowArray* column_name_col_;
+  struct ArrowArray* key_col_;
+  struct ArrowArray* value_col_;
+  struct ArrowArray* is_approximate_col_;
+  struct ArrowArray* value_float64_col_;
+};
+
+ArrowErrorCode AppendTableStatistics(const PostgresTableStatistics& table,
+                                     bool has_columns, StatisticsAppender* appender) {
+  const double reltuples = table.reltuples;
+  NANOARROW_RETURN_NOT_OK(appender->Append(table.table_name, nullptr,
+                                           ADBC_STATISTIC_ROW_COUNT_KEY, reltuples));
+  if (!has_columns) return NANOARROW_OK;
+
+  for (const auto& column : table.columns) {
+    NANOARROW_RETURN_NOT_OK(appender->Append(table.table_name, &column.name,
+                                             ADBC_STATISTIC_NULL_COUNT_KEY,
+                                             column.null_frac * reltuples));
+    NANOARROW_RETURN_NOT_OK(appender->Append(table.table_name, &column.name,
+                                             ADBC_STATISTIC_AVERAGE_BYTE_WIDTH_KEY,
+                                             column.avg_width));
+    // > If greater than zero, the estimated number of distinct values in
+    // > the column. If less than zero, the negative of the number of
+    // > distinct values divided by the number of rows.
+    // https://www.postgresql.org/docs/current/view-pg-stats.html
+    NANOARROW_RETURN_NOT_OK(appender->Append(
+        table.table_name, &column.name, ADBC_STATISTIC_DISTINCT_COUNT_KEY,
+        column.n_distinct > 0 ? column.n_distinct
+                              : (std::fabs(column.n_distinct) * reltuples)));
+  }
+  return NANOARROW_OK;
+}
+}  // namespace
+
+PostgresTableStatistics* PostgresSchemaStatistics::AddTable(std::string table_name) {
+  index.insert({table_name, tables.size()});
+  tables.emplace_back();
+  tables.back().table_name = std::move(table_name);
+  return &tables.back();
+}
+
+std::vector<const PostgresTableStatistics*> PostgresSchemaStatistics::Find(
+    const char* table_name) const {
+  std::vector<const PostgresTableStatistics*> out;
+  std::string literal;
+  if (table_name == nullptr) {
+    for (const auto& table : tables) out.push_back(&table);
+  } else if (SqlLikeToLiteral(table_name, &literal)) {
+    auto it = index.find(literal);
+    if (it != index.end()) out.push_back(&tables[it->second]);
+  } else {
+    for (const auto& table : tables) {
+      if (SqlLikeMatch(table_name, table.table_name)) out.push_back(&table);
+    }
+  }
+  return out;
+}
+
+bool SqlLikeMatch(std::string_view pattern, std::string_view value) {
+  // Greedy matching that backtracks to the most recent '%'
+  size_t p = 0;
+  size_t v = 0;
+  size_t star_p = std::string_view::npos;
+  size_t star_v = 0;
+  while (v < value.size()) {
+    if (p < pattern.size()) {
+      const char c = pattern[p];
+      if (c == '%') {
+        star_p = ++p;
+        star_v = v;
+        continue;
+      } else if (c == '_') {
+        p++;
+        v += Utf8CharLength(value, v);
+        continue;
+      } else if (c == kLikeEscape && p + 1 < pattern.size()) {
+        if (pattern[p + 1] == value[v]) {
+          p += 2;
+          v++;
+          continue;
+        }
+      } else if (c == value[v]) {
+        p++;
+        v++;
+        continue;
+      }
+    }
+
+    if (star_p == std::string_view::npos) return false;
+    star_v += Utf8CharLength(value, star_v);
+    v = star_v;
+    p = star_p;
+  }
+
+  while (p < pattern.size() && pattern[p] == '%') p++;
+  return p == pattern.size();
+}
+
+bool SqlLikeToLiteral(std::string_view pattern, std::string* out) {
+  out->clear();
+  for (size_t i = 0; i < pattern.size(); i++) {
+    const char c = pattern[i];
+    if (c == '%' || c == '_') {
+      return false;
+    } else if (c == kLikeEscape && i + 1 < pattern.size()) {
+      i++;
+    }
+    out->push_back(pattern[i]);
+  }
+  return true;
+}
+
+AdbcStatusCode MakeStatisticsArray(const char* catalog, const char* db_schema,
+                                   const PostgresSchemaStatistics& statistics,
+                                   const char* table_name, bool row_count_only,
+                                   struct ArrowSchema* schema, struct ArrowArray* array,
+                                   struct AdbcError* error) {
+  nanoarrow::UniqueSchema uschema;
+  CHECK_NA(INTERNAL, InitStatisticsSchema(uschema.get()), error);
+
+  struct ArrowError na_error = {0};
+  CHECK_NA_DETAIL(INTERNAL, ArrowArrayInitFromSchema(array, uschema.get(), &na_error),
+                  &na_error, error);
+  CHECK_NA(INTERNAL, ArrowArrayStartAppending(array), error);
+
+  struct ArrowArray* catalog_name_col = array->children[0];
+  struct ArrowArray* catalog_db_schemas_col = array->children[1];
+  struct ArrowArray* catalog_db_schemas_items = catalog_db_schemas_col->children[0];
+  struct ArrowArray* db_schema_name_col = catalog_db_schemas_items->children[0];
+  struct ArrowArray* db_schema_statistics_col = catalog_db_schemas_items->children[1];
+
+  CHECK_NA(INTERNAL, ArrowArrayAppendString(catalog_name_col, ArrowCharView(catalog)),
+           error);
+  CHECK_NA(INTERNAL, ArrowArrayAppendString(db_schema_name_col, ArrowCharView(db_schema)),
+           error);
+
+  StatisticsAppender appender(db_schema_statistics_col->children[0]);
+  const bool has_columns = statistics.has_columns && !row_count_only;
+  for (const PostgresTableStatistics* table : statistics.Find(table_name)) {
+    CHECK_NA(INTERNAL, AppendTableStatistics(*table, has_columns, &appender), error);
+  }
+
+  CHECK_NA(INTERNAL, ArrowArrayFinishElement(db_schema_statistics_col), error);
+  CHECK_NA(INTERNAL, ArrowArrayFinishElement(catalog_db_schemas_items), error);
+  CHECK_NA(INTERNAL, ArrowArrayFinishElement(catalog_db_schemas_col), error);
+  CHECK_NA(INTERNAL, ArrowArrayFinishElement(array), error);
+
+  CHECK_NA_DETAIL(INTERNAL, ArrowArrayFinishBuildingDefault(array, &na_error), &na_error,
+                  error);
+  uschema.move(schema);
+  return ADBC_STATUS_OK;
+}
+
+bool PostgresStatisticsCache::Get(const std::string& db_schema, Entry* out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(db_schema);
+  if (it == entries_.end()) return false;
+  *out = it->second;
+  return true;
+}
+
+void PostgresStatisticsCache::Put(const std::string& db_schema, Entry entry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_[db_schema] = std::move(entry);
+}
+
+void PostgresStatisticsCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+}
+
+}  // namespace adbcpq
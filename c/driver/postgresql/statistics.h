@@ -0,0 +1,110 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <adbc.h>
+#include <nanoarrow/nanoarrow.h>
+
+namespace adbcpq {
+
+/// \brief The statistics of one table, from pg_class and (optionally) pg_stats.
+struct PostgresTableStatistics {
+  struct Column {
+    std::string name;
+    double null_frac = 0;
+    double avg_width = 0;
+    double n_distinct = 0;
+  };
+
+  std::string table_name;
+  double reltuples = 0;
+  std::vector<Column> columns;
+};
+
+/// \brief The statistics of the tables in one schema.
+struct PostgresSchemaStatistics {
+  /// \brief An opaque string identifying the analyze/vacuum state of the
+  ///   schema when the statistics were read; see PostgresStatisticsCache.
+  std::string version;
+  /// \brief Whether column statistics were read, or only row counts.
+  bool has_columns = false;
+  std::vector<PostgresTableStatistics> tables;
+  /// \brief Table name to index in tables, for exact-name lookups.
+  std::unordered_map<std::string, size_t> index;
+
+  /// \brief Append a table (and index it by name).
+  PostgresTableStatistics* AddTable(std::string table_name);
+
+  /// \brief Get the tables whose name matches a LIKE pattern (all tables if
+  ///   the pattern is null), in the order they were added.
+  std::vector<const PostgresTableStatistics*> Find(const char* table_name) const;
+};
+
+/// \brief Whether value matches a SQL LIKE pattern (with the default escape
+///   character, backslash).
+bool SqlLikeMatch(std::string_view pattern, std::string_view value);
+
+/// \brief If a LIKE pattern has no wildcards, get the only string it matches.
+bool SqlLikeToLiteral(std::string_view pattern, std::string* out);
+
+/// \brief Build the result of AdbcConnectionGetStatistics for one schema.
+///
+/// Row counts are emitted for every matching table; null count, average
+/// byte width and distinct count for every column if has_columns is set and
+/// row_count_only is not.
+AdbcStatusCode MakeStatisticsArray(const char* catalog, const char* db_schema,
+                                   const PostgresSchemaStatistics& statistics,
+                                   const char* table_name, bool row_count_only,
+                                   struct ArrowSchema* schema, struct ArrowArray* array,
+                                   struct AdbcError* error);
+
+/// \brief Statistics of recently queried schemas, shared by the connections of
+///   a database.
+///
+/// Entries are used as-is for a configurable time after they were read or
+/// last validated. After that, the caller compares the version of the entry
+/// against the server (a single cheap query) and either marks the entry as
+/// validated again or replaces it.
+class PostgresStatisticsCache {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    std::shared_ptr<const PostgresSchemaStatistics> statistics;
+    Clock::time_point validated_at;
+  };
+
+  /// \brief Look up a schema; returns false if it is not cached.
+  bool Get(const std::string& db_schema, Entry* out) const;
+  void Put(const std::string& db_schema, Entry entry);
+  void Clear();
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace adbcpq
@@ -0,0 +1,126 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <nanoarrow/nanoarrow.hpp>
+
+#include "statistics.h"
+
+namespace adbcpq {
+
+TEST(PostgresStatisticsTest, SqlLike) {
+  EXPECT_TRUE(SqlLikeMatch("", ""));
+  EXPECT_TRUE(SqlLikeMatch("%", ""));
+  EXPECT_TRUE(SqlLikeMatch("abc", "abc"));
+  EXPECT_FALSE(SqlLikeMatch("abc", "abcd"));
+  EXPECT_TRUE(SqlLikeMatch("a%c", "abbbc"));
+  EXPECT_TRUE(SqlLikeMatch("%b%", "abc"));
+  EXPECT_FALSE(SqlLikeMatch("%d%", "abc"));
+  EXPECT_TRUE(SqlLikeMatch("a_c", "abc"));
+  EXPECT_FALSE(SqlLikeMatch("a_c", "ac"));
+  // '_' matches one character, not one byte
+  EXPECT_TRUE(SqlLikeMatch("a_c", "a\xc3\xa9" "c"));
+  EXPECT_TRUE(SqlLikeMatch("a\\_c", "a_c"));
+  EXPECT_FALSE(SqlLikeMatch("a\\_c", "abc"));
+  EXPECT_TRUE(SqlLikeMatch("%\\%", "100%"));
+
+  std::string literal;
+  EXPECT_TRUE(SqlLikeToLiteral("my\\_table", &literal));
+  EXPECT_EQ(literal, "my_table");
+  EXPECT_FALSE(SqlLikeToLiteral("my_table", &literal));
+  EXPECT_FALSE(SqlLikeToLiteral("tab%", &literal));
+}
+
+TEST(PostgresStatisticsTest, MakeStatisticsArray) {
+  PostgresSchemaStatistics statistics;
+  statistics.has_columns = true;
+  PostgresTableStatistics* table = statistics.AddTable("foo");
+  table->reltuples = 100;
+  table->columns.push_back({"id", 0.0, 4, -1.0});
+  table->columns.push_back({"name", 0.25, 12.5, 20});
+  statistics.AddTable("foobar")->reltuples = 5;
+  statistics.AddTable("bar")->reltuples = 7;
+
+  auto names = [&](const char* pattern) {
+    std::vector<std::string> out;
+    for (const auto* table : statistics.Find(pattern)) out.push_back(table->table_name);
+    return out;
+  };
+  EXPECT_EQ(names(nullptr), (std::vector<std::string>{"foo", "foobar", "bar"}));
+  EXPECT_EQ(names("foo"), (std::vector<std::string>{"foo"}));
+  EXPECT_EQ(names("foo%"), (std::vector<std::string>{"foo", "foobar"}));
+  EXPECT_TRUE(names("baz").empty());
+
+  nanoarrow::UniqueSchema schema;
+  nanoarrow::UniqueArray array;
+  ASSERT_EQ(MakeStatisticsArray("db", "public", statistics, "foo",
+                                /*row_count_only=*/false, schema.get(), array.get(),
+                                nullptr),
+            ADBC_STATUS_OK);
+
+  nanoarrow::UniqueArrayView view;
+  ASSERT_EQ(ArrowArrayViewInitFromSchema(view.get(), schema.get(), nullptr),
+            NANOARROW_OK);
+  ASSERT_EQ(ArrowArrayViewSetArray(view.get(), array.get(), nullptr), NANOARROW_OK);
+  ASSERT_EQ(view->length, 1);
+  struct ArrowArrayView* statistics_view =
+      view->children[1]->children[0]->children[1]->children[0];
+  // One row count, then three statistics per column
+  ASSERT_EQ(statistics_view->length, 7);
+
+  struct ArrowArrayView* key_view = statistics_view->children[2];
+  struct ArrowArrayView* value_view = statistics_view->children[3]->children[2];
+  EXPECT_EQ(ArrowArrayViewGetIntUnsafe(key_view, 0), ADBC_STATISTIC_ROW_COUNT_KEY);
+  EXPECT_EQ(ArrowArrayViewGetDoubleUnsafe(value_view, 0), 100);
+  // A negative n_distinct is a fraction of the row count
+  EXPECT_EQ(ArrowArrayViewGetIntUnsafe(key_view, 3), ADBC_STATISTIC_DISTINCT_COUNT_KEY);
+  EXPECT_EQ(ArrowArrayViewGetDoubleUnsafe(value_view, 3), 100);
+  EXPECT_EQ(ArrowArrayViewGetIntUnsafe(key_view, 4), ADBC_STATISTIC_NULL_COUNT_KEY);
+  EXPECT_EQ(ArrowArrayViewGetDoubleUnsafe(value_view, 4), 25);
+  EXPECT_EQ(ArrowArrayViewGetDoubleUnsafe(value_view, 6), 20);
+
+  // Column statistics can be left out even if they were read
+  array.reset();
+  schema.reset();
+  ASSERT_EQ(MakeStatisticsArray("db", "public", statistics, nullptr,
+                                /*row_count_only=*/true, schema.get(), array.get(),
+                                nullptr),
+            ADBC_STATUS_OK);
+  EXPECT_EQ(array->children[1]->children[0]->children[1]->children[0]->length, 3);
+}
+
+TEST(PostgresStatisticsTest, Cache) {
+  PostgresStatisticsCache cache;
+  PostgresStatisticsCache::Entry entry;
+  EXPECT_FALSE(cache.Get("public", &entry));
+
+  auto statistics = std::make_shared<PostgresSchemaStatistics>();
+  statistics->version = "1|2024-01-01";
+  cache.Put("public", {statistics, PostgresStatisticsCache::Clock::now()});
+  ASSERT_TRUE(cache.Get("public", &entry));
+  EXPECT_EQ(entry.statistics->version, "1|2024-01-01");
+  EXPECT_FALSE(cache.Get("other", &entry));
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Get("public", &entry));
+}
+
+}  // namespace adbcpq
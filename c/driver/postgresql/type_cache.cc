@@ -0,0 +1,314 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "type_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/utils.h"
+
+namespace adbcpq {
+
+namespace {
+// The file starts with this magic string followed by a format version. All
+// integers are written in host byte order: the cache is a local file, and a
+// file from a host with a different byte order fails the magic check.
+constexpr char kMagic[8] = {'A', 'D', 'B', 'C', 'P', 'G', 'T', 'C'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+class SnapshotWriter {
+ public:
+  void PutU32(uint32_t value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out_.insert(out_.end(), bytes, bytes + sizeof(value));
+  }
+
+  void PutString(const std::string& value) {
+    PutU32(static_cast<uint32_t>(value.size()));
+    out_.insert(out_.end(), value.begin(), value.end());
+  }
+
+  void PutBytes(const char* value, size_t size) {
+    out_.insert(out_.end(), value, value + size);
+  }
+
+  const std::vector<char>& data() const { return out_; }
+
+ private:
+  std::vector<char> out_;
+};
+
+/// Reads from a (possibly memory-mapped) buffer, failing on truncation
+/// instead of reading past the end.
+class SnapshotReader {
+ public:
+  SnapshotReader(const char* data, size_t size) : data_(data), remaining_(size) {}
+
+  bool GetU32(uint32_t* out) {
+    if (remaining_ < sizeof(*out)) return false;
+    std::memcpy(out, data_, sizeof(*out));
+    Advance(sizeof(*out));
+    return true;
+  }
+
+  bool GetString(std::string* out) {
+    uint32_t size;
+    if (!GetU32(&size) || remaining_ < size) return false;
+    out->assign(data_, size);
+    Advance(size);
+    return true;
+  }
+
+  /// Read the number of items that follow, rejecting counts that could not
+  /// fit in the rest of the buffer (so a corrupt count can't cause a huge
+  /// allocation), given the smallest possible encoded size of an item.
+  bool GetCount(uint32_t* out, size_t min_item_size) {
+    return GetU32(out) && *out <= remaining_ / min_item_size;
+  }
+
+  bool GetBytes(char* out, size_t size) {
+    if (remaining_ < size) return false;
+    std::memcpy(out, data_, size);
+    Advance(size);
+    return true;
+  }
+
+  bool done() const { return remaining_ == 0; }
+
+ private:
+  const char* data_;
+  size_t remaining_;
+
+  void Advance(size_t size) {
+    data_ += size;
+    remaining_ -= size;
+  }
+};
+
+bool ParseSnapshot(SnapshotReader* reader, PostgresTypeCatalog* out) {
+  char magic[sizeof(kMagic)];
+  uint32_t format_version;
+  uint32_t byte_order;
+  if (!reader->GetBytes(magic, sizeof(magic)) ||
+      std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !reader->GetU32(&format_version) || format_version != kFormatVersion ||
+      !reader->GetU32(&byte_order) || byte_order != kByteOrderMark) {
+    return false;
+  }
+
+  if (!reader->GetString(&out->version)) return false;
+
+  // The smallest encoding of each item: its fixed-width fields plus the
+  // lengths of its (possibly empty) strings
+  constexpr size_t kMinClassSize = 2 * sizeof(uint32_t);
+  constexpr size_t kMinColumnSize = 2 * sizeof(uint32_t);
+  constexpr size_t kMinTypeSize = 7 * sizeof(uint32_t);
+
+  uint32_t n_classes;
+  if (!reader->GetCount(&n_classes, kMinClassSize)) return false;
+  out->classes.resize(n_classes);
+  for (auto& cls : out->classes) {
+    uint32_t n_columns;
+    if (!reader->GetU32(&cls.oid) || !reader->GetCount(&n_columns, kMinColumnSize)) {
+      return false;
+    }
+    cls.columns.resize(n_columns);
+    for (auto& column : cls.columns) {
+      if (!reader->GetString(&column.first) || !reader->GetU32(&column.second)) {
+        return false;
+      }
+    }
+  }
+
+  uint32_t n_types;
+  if (!reader->GetCount(&n_types, kMinTypeSize)) return false;
+  out->types.resize(n_types);
+  for (auto& type : out->types) {
+    if (!reader->GetU32(&type.oid) || !reader->GetString(&type.typname) ||
+        !reader->GetString(&type.typreceive) || !reader->GetU32(&type.typbasetype) ||
+        !reader->GetU32(&type.typarray) || !reader->GetU32(&type.typrelid) ||
+        !reader->GetU32(&type.typelem)) {
+      return false;
+    }
+  }
+
+  return reader->done();
+}
+}  // namespace
+
+ArrowErrorCode PostgresTypeRow::Insert(PostgresTypeResolver* resolver,
+                                       ArrowError* error) const {
+  PostgresTypeResolver::Item item;
+  item.oid = oid;
+  item.typname = typname.c_str();
+  item.typreceive = typreceive.c_str();
+  item.child_oid = typelem;
+  item.base_oid = typbasetype;
+  item.class_oid = typrelid;
+
+  // Special case the aclitem because it shows up in a bunch of internal tables
+  if (typname == "aclitem") {
+    item.typreceive = "aclitem_recv";
+  }
+
+  // Array types looked up by oid are inserted directly (the element type is
+  // resolved by the insert)
+  if (typreceive == "array_recv") {
+    return resolver->Insert(item, error);
+  }
+
+  int status = resolver->Insert(item, error);
+
+  // If there's an array type and the insert succeeded, add that now too
+  if (status == NANOARROW_OK && typarray != 0) {
+    std::string array_typname = "_" + typname;
+    item.oid = typarray;
+    item.typname = array_typname.c_str();
+    item.typreceive = "array_recv";
+    item.child_oid = oid;
+
+    resolver->Insert(item, nullptr);
+  }
+
+  return status;
+}
+
+void PostgresTypeCatalog::Populate(PostgresTypeResolver* resolver) const {
+  for (const auto& cls : classes) {
+    resolver->InsertClass(cls.oid, cls.columns);
+  }
+
+  // Attempt filling the resolver a few times to handle recursive definitions.
+  constexpr int32_t kMaxAttempts = 3;
+  for (int32_t i = 0; i < kMaxAttempts; i++) {
+    for (const auto& type : types) {
+      type.Insert(resolver, nullptr);
+    }
+  }
+}
+
+AdbcStatusCode PostgresTypeCatalog::Read(const std::string& path,
+                                         struct AdbcError* error) {
+  bool ok = false;
+#if defined(_WIN32)
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) return ADBC_STATUS_NOT_FOUND;
+  std::vector<char> data(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  if (file.read(data.data(), data.size())) {
+    SnapshotReader reader(data.data(), data.size());
+    ok = ParseSnapshot(&reader, this);
+  }
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return ADBC_STATUS_NOT_FOUND;
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      SnapshotReader reader(static_cast<const char*>(data), size);
+      ok = ParseSnapshot(&reader, this);
+      munmap(data, size);
+    }
+  }
+  close(fd);
+#endif
+
+  if (!ok) {
+    *this = PostgresTypeCatalog();
+    return ADBC_STATUS_NOT_FOUND;
+  }
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode PostgresTypeCatalog::Write(const std::string& path,
+                                          struct AdbcError* error) const {
+  SnapshotWriter writer;
+  writer.PutBytes(kMagic, sizeof(kMagic));
+  writer.PutU32(kFormatVersion);
+  writer.PutU32(kByteOrderMark);
+  writer.PutString(version);
+
+  writer.PutU32(static_cast<uint32_t>(classes.size()));
+  for (const auto& cls : classes) {
+    writer.PutU32(cls.oid);
+    writer.PutU32(static_cast<uint32_t>(cls.columns.size()));
+    for (const auto& column : cls.columns) {
+      writer.PutString(column.first);
+      writer.PutU32(column.second);
+    }
+  }
+
+  writer.PutU32(static_cast<uint32_t>(types.size()));
+  for (const auto& type : types) {
+    writer.PutU32(type.oid);
+    writer.PutString(type.typname);
+    writer.PutString(type.typreceive);
+    writer.PutU32(type.typbasetype);
+    writer.PutU32(type.typarray);
+    writer.PutU32(type.typrelid);
+    writer.PutU32(type.typelem);
+  }
+
+  // Write to a temporary file and rename it into place, so that concurrent
+  // processes never observe a partially written snapshot
+#if defined(_WIN32)
+  const std::string tmp_path = path + ".tmp" + std::to_string(_getpid());
+#else
+  const std::string tmp_path = path + ".tmp" + std::to_string(getpid());
+#endif
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    const std::vector<char>& data = writer.data();
+    if (!file || !file.write(data.data(), data.size()) || !file.flush()) {
+      SetError(error, "[libpq] Failed to write type cache '%s'", tmp_path.c_str());
+      file.close();
+      std::remove(tmp_path.c_str());
+      return ADBC_STATUS_IO;
+    }
+  }
+
+#if defined(_WIN32)
+  // rename() does not replace an existing file on Windows
+  std::remove(path.c_str());
+#endif
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    SetError(error, "[libpq] Failed to move type cache into place at '%s'",
+             path.c_str());
+    std::remove(tmp_path.c_str());
+    return ADBC_STATUS_IO;
+  }
+  return ADBC_STATUS_OK;
+}
+
+}  // namespace adbcpq
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <adbc.h>
+#include <nanoarrow/nanoarrow.h>
+
+#include "postgres_type.h"
+
+namespace adbcpq {
+
+/// \brief One row of pg_type, as needed to insert it into a PostgresTypeResolver.
+struct PostgresTypeRow {
+  uint32_t oid = 0;
+  std::string typname;
+  std::string typreceive;
+  uint32_t typbasetype = 0;
+  uint32_t typarray = 0;
+  uint32_t typrelid = 0;
+  /// \brief Only needed for rows that are themselves array types
+  uint32_t typelem = 0;
+
+  /// \brief Insert this type and, if it has one, its array type.
+  ArrowErrorCode Insert(PostgresTypeResolver* resolver, ArrowError* error) const;
+};
+
+/// \brief The columns (name and type oid) of one relation, from pg_attribute.
+struct PostgresClassRow {
+  uint32_t oid = 0;
+  std::vector<std::pair<std::string, uint32_t>> columns;
+};
+
+/// \brief The catalog rows a PostgresTypeResolver is built from.
+///
+/// Keeping the rows (rather than the resolved types) makes the snapshot
+/// trivially serializable: loading a cached snapshot replays the same
+/// inserts that a fresh read of the catalog would.
+struct PostgresTypeCatalog {
+  /// \brief An opaque string identifying the server and the catalog state the
+  ///   rows were read at; a cached snapshot is only used if this matches.
+  std::string version;
+  std::vector<PostgresClassRow> classes;
+  std::vector<PostgresTypeRow> types;
+
+  /// \brief Insert all classes and types into the resolver.
+  ///
+  /// Rows are ordered by oid, which is not necessarily dependency order, so
+  /// types are inserted a few times to resolve e.g. domains of later types.
+  void Populate(PostgresTypeResolver* resolver) const;
+
+  /// \brief Read a snapshot written by Write().
+  ///
+  /// Returns ADBC_STATUS_NOT_FOUND if the file does not exist or is not a
+  /// valid snapshot (so that callers can fall back to the server).
+  AdbcStatusCode Read(const std::string& path, struct AdbcError* error);
+
+  /// \brief Atomically replace the file at path with this snapshot.
+  AdbcStatusCode Write(const std::string& path, struct AdbcError* error) const;
+};
+
+}  // namespace adbcpq
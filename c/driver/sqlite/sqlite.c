@@ -1368,8 +1368,13 @@ AdbcStatusCode SqliteStatementExecuteQuery(struct AdbcStatement* statement,
   // Query
   if (rows_affected) *rows_affected = -1;
   struct AdbcSqliteBinder* binder = stmt->binder.schema.release ? &stmt->binder : NULL;
-  return AdbcSqliteExportReader(stmt->conn, stmt->stmt, binder, stmt->batch_size, out,
-                                error);
+  struct ArrowArrayStream reader;
+  memset(&reader, 0, sizeof(reader));
+  status = AdbcSqliteExportReader(stmt->conn, stmt->stmt, binder, stmt->batch_size,
+                                  &reader, error);
+  if (status != ADBC_STATUS_OK) return status;
+  return RechunkArrayStream(&reader, stmt->target_batch_rows, stmt->target_batch_bytes,
+                            out, error);
 }
 
 AdbcStatusCode SqliteStatementSetSqlQuery(struct AdbcStatement* statement,
@@ -1424,8 +1429,25 @@ AdbcStatusCode SqliteStatementBindStream(struct AdbcStatement* statement,
 AdbcStatusCode SqliteStatementGetOption(struct AdbcStatement* statement, const char* key,
                                         char* value, size_t* length,
                                         struct AdbcError* error) {
-  CHECK_DB_INIT(statement, error);
-  return ADBC_STATUS_NOT_FOUND;
+  CHECK_STMT_INIT(statement, error);
+  struct SqliteStatement* stmt = (struct SqliteStatement*)statement->private_data;
+
+  int64_t int_value = 0;
+  if (strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS) == 0) {
+    int_value = stmt->target_batch_rows;
+  } else if (strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_BYTES) == 0) {
+    int_value = stmt->target_batch_bytes;
+  } else {
+    return ADBC_STATUS_NOT_FOUND;
+  }
+
+  char buffer[32];
+  int written = snprintf(buffer, sizeof(buffer), "%" PRId64, int_value);
+  if ((size_t)written + 1 <= *length) {
+    memcpy(value, buffer, written + 1);
+  }
+  *length = (size_t)written + 1;
+  return ADBC_STATUS_OK;
 }
 
 AdbcStatusCode SqliteStatementGetOptionBytes(struct AdbcStatement* statement,
@@ -1445,7 +1467,16 @@ AdbcStatusCode SqliteStatementGetOptionDouble(struct AdbcStatement* statement,
 AdbcStatusCode SqliteStatementGetOptionInt(struct AdbcStatement* statement,
                                            const char* key, int64_t* value,
                                            struct AdbcError* error) {
-  CHECK_DB_INIT(statement, error);
+  CHECK_STMT_INIT(statement, error);
+  struct SqliteStatement* stmt = (struct SqliteStatement*)statement->private_data;
+
+  if (strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS) == 0) {
+    *value = stmt->target_batch_rows;
+    return ADBC_STATUS_OK;
+  } else if (strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_BYTES) == 0) {
+    *value = stmt->target_batch_bytes;
+    return ADBC_STATUS_OK;
+  }
   return ADBC_STATUS_NOT_FOUND;
 }
 
@@ -1481,6 +1512,10 @@ AdbcStatusCode SqliteStatementGetParameterSchema(struct AdbcStatement* statement
   return ADBC_STATUS_OK;
 }
 
+AdbcStatusCode SqliteStatementSetOptionInt(struct AdbcStatement* statement,
+                                           const char* key, int64_t value,
+                                           struct AdbcError* error);
+
 AdbcStatusCode SqliteStatementSetOption(struct AdbcStatement* statement, const char* key,
                                         const char* value, struct AdbcError* error) {
   CHECK_STMT_INIT(statement, error);
@@ -1556,6 +1591,17 @@ AdbcStatusCode SqliteStatementSetOption(struct AdbcStatement* statement, const c
     }
     stmt->batch_size = (int)batch_size;
     return ADBC_STATUS_OK;
+  } else if (strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS) == 0 ||
+             strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_BYTES) == 0) {
+    char* end = NULL;
+    errno = 0;
+    long long target = strtoll(value, &end, /*base=*/10);  // NOLINT(runtime/int)
+    if (errno != 0 || end == value || *end != '\0') {
+      SetError(error, "[SQLite] Invalid statement option value %s=%s (not an integer)",
+               key, value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    return SqliteStatementSetOptionInt(statement, key, (int64_t)target, error);
   }
   SetError(error, "[SQLite] Unknown statement option %s=%s", key,
            value ? value : "(NULL)");
@@ -1579,7 +1625,26 @@ AdbcStatusCode SqliteStatementSetOptionDouble(struct AdbcStatement* statement,
 AdbcStatusCode SqliteStatementSetOptionInt(struct AdbcStatement* statement,
                                            const char* key, int64_t value,
                                            struct AdbcError* error) {
-  CHECK_DB_INIT(statement, error);
+  CHECK_STMT_INIT(statement, error);
+  struct SqliteStatement* stmt = (struct SqliteStatement*)statement->private_data;
+
+  if (strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS) == 0 ||
+      strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_BYTES) == 0) {
+    if (value < 0) {
+      SetError(error,
+               "[SQLite] Invalid statement option value %s=%" PRId64
+               " (value is negative)",
+               key, value);
+      return ADBC_STATUS_INVALID_ARGUMENT;
+    }
+    if (strcmp(key, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS) == 0) {
+      stmt->target_batch_rows = value;
+    } else {
+      stmt->target_batch_bytes = value;
+    }
+    return ADBC_STATUS_OK;
+  }
+  SetError(error, "[SQLite] Unknown statement option %s=%" PRId64, key, value);
   return ADBC_STATUS_NOT_IMPLEMENTED;
 }
 
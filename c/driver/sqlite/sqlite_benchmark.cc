@@ -0,0 +1,178 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string>
+
+#include <adbc.h>
+#include <benchmark/benchmark.h>
+#include <nanoarrow/nanoarrow.hpp>
+
+namespace {
+
+#define CHECK_OK(EXPR)                                                       \
+  do {                                                                       \
+    if ((EXPR) != 0) {                                                       \
+      state.SkipWithError(error.message ? error.message : "Failed: " #EXPR); \
+      return;                                                                \
+    }                                                                        \
+  } while (0)
+
+/// An in-memory database with one connection, torn down at scope exit.
+class SqliteFixture {
+ public:
+  ~SqliteFixture() {
+    struct AdbcError release_error = ADBC_ERROR_INIT;
+    if (connection.private_data) AdbcConnectionRelease(&connection, &release_error);
+    if (database.private_data) AdbcDatabaseRelease(&database, &release_error);
+    if (release_error.release) release_error.release(&release_error);
+    if (error.release) error.release(&error);
+  }
+
+  AdbcStatusCode Init() {
+    AdbcStatusCode status;
+    if ((status = AdbcDatabaseNew(&database, &error)) != ADBC_STATUS_OK) return status;
+    if ((status = AdbcDatabaseSetOption(&database, "uri", ":memory:", &error)) !=
+        ADBC_STATUS_OK) {
+      return status;
+    }
+    if ((status = AdbcDatabaseInit(&database, &error)) != ADBC_STATUS_OK) return status;
+    if ((status = AdbcConnectionNew(&connection, &error)) != ADBC_STATUS_OK) {
+      return status;
+    }
+    return AdbcConnectionInit(&connection, &database, &error);
+  }
+
+  AdbcStatusCode Execute(const char* query) {
+    struct AdbcStatement statement = {};
+    AdbcStatusCode status = AdbcStatementNew(&connection, &statement, &error);
+    if (status != ADBC_STATUS_OK) return status;
+    status = AdbcStatementSetSqlQuery(&statement, query, &error);
+    if (status == ADBC_STATUS_OK) {
+      status = AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error);
+    }
+    AdbcStatementRelease(&statement, &error);
+    return status;
+  }
+
+  /// Ingest a (int64, double, string) batch of n_rows into the given table.
+  AdbcStatusCode Ingest(const char* table, int64_t n_rows) {
+    nanoarrow::UniqueSchema schema;
+    nanoarrow::UniqueArray array;
+    if (MakeBatch(n_rows, schema.get(), array.get()) != 0) return ADBC_STATUS_INTERNAL;
+
+    struct AdbcStatement statement = {};
+    AdbcStatusCode status = AdbcStatementNew(&connection, &statement, &error);
+    if (status != ADBC_STATUS_OK) return status;
+    status = AdbcStatementSetOption(&statement, ADBC_INGEST_OPTION_TARGET_TABLE, table,
+                                    &error);
+    if (status == ADBC_STATUS_OK) {
+      status = AdbcStatementBind(&statement, array.get(), schema.get(), &error);
+    }
+    if (status == ADBC_STATUS_OK) {
+      status = AdbcStatementExecuteQuery(&statement, nullptr, nullptr, &error);
+    }
+    AdbcStatementRelease(&statement, &error);
+    return status;
+  }
+
+  static ArrowErrorCode MakeBatch(int64_t n_rows, struct ArrowSchema* schema,
+                                  struct ArrowArray* array) {
+    ArrowSchemaInit(schema);
+    NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeStruct(schema, 3));
+    NANOARROW_RETURN_NOT_OK(
+        ArrowSchemaSetType(schema->children[0], NANOARROW_TYPE_INT64));
+    NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(schema->children[0], "ints"));
+    NANOARROW_RETURN_NOT_OK(
+        ArrowSchemaSetType(schema->children[1], NANOARROW_TYPE_DOUBLE));
+    NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(schema->children[1], "doubles"));
+    NANOARROW_RETURN_NOT_OK(
+        ArrowSchemaSetType(schema->children[2], NANOARROW_TYPE_STRING));
+    NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(schema->children[2], "strings"));
+
+    NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(array, schema, nullptr));
+    NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(array));
+    for (int64_t i = 0; i < n_rows; i++) {
+      NANOARROW_RETURN_NOT_OK(ArrowArrayAppendInt(array->children[0], i));
+      NANOARROW_RETURN_NOT_OK(
+          ArrowArrayAppendDouble(array->children[1], static_cast<double>(i) / 2));
+      if (i % 10 == 0) {
+        NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(array->children[2], 1));
+      } else {
+        std::string value = "row number " + std::to_string(i);
+        NANOARROW_RETURN_NOT_OK(
+            ArrowArrayAppendString(array->children[2], ArrowCharView(value.c_str())));
+      }
+      NANOARROW_RETURN_NOT_OK(ArrowArrayFinishElement(array));
+    }
+    return ArrowArrayFinishBuildingDefault(array, nullptr);
+  }
+
+  struct AdbcError error = ADBC_ERROR_INIT;
+  struct AdbcDatabase database = {};
+  struct AdbcConnection connection = {};
+};
+
+void BM_SqliteIngest(benchmark::State& state) {
+  const int64_t n_rows = state.range(0);
+  SqliteFixture fixture;
+  struct AdbcError& error = fixture.error;
+  CHECK_OK(fixture.Init());
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    CHECK_OK(fixture.Execute("DROP TABLE IF EXISTS bench"));
+    state.ResumeTiming();
+    CHECK_OK(fixture.Ingest("bench", n_rows));
+  }
+  state.SetItemsProcessed(state.iterations() * n_rows);
+}
+BENCHMARK(BM_SqliteIngest)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+void BM_SqliteScan(benchmark::State& state) {
+  const int64_t n_rows = state.range(0);
+  SqliteFixture fixture;
+  struct AdbcError& error = fixture.error;
+  CHECK_OK(fixture.Init());
+  CHECK_OK(fixture.Ingest("bench", n_rows));
+
+  for (auto _ : state) {
+    struct AdbcStatement statement = {};
+    CHECK_OK(AdbcStatementNew(&fixture.connection, &statement, &error));
+    CHECK_OK(AdbcStatementSetSqlQuery(&statement, "SELECT * FROM bench", &error));
+
+    nanoarrow::UniqueArrayStream stream;
+    CHECK_OK(AdbcStatementExecuteQuery(&statement, stream.get(), nullptr, &error));
+    int64_t rows_read = 0;
+    while (true) {
+      nanoarrow::UniqueArray batch;
+      CHECK_OK(stream->get_next(stream.get(), batch.get()));
+      if (!batch->release) break;
+      rows_read += batch->length;
+    }
+    stream.reset();
+    CHECK_OK(AdbcStatementRelease(&statement, &error));
+
+    if (rows_read != n_rows) {
+      state.SkipWithError("Unexpected number of rows");
+      return;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n_rows);
+}
+BENCHMARK(BM_SqliteScan)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -28,6 +28,7 @@
 #include <gtest/gtest.h>
 #include <nanoarrow/nanoarrow.h>
 
+#include "common/options.h"
 #include "statement_reader.h"
 #include "validation/adbc_validation.h"
 #include "validation/adbc_validation_util.h"
@@ -305,6 +306,71 @@ TEST_F(SqliteStatementTest, SqlIngestNameEscaping) {
   ASSERT_EQ(3, rows_affected);
 }
 
+TEST_F(SqliteStatementTest, TargetBatchRows) {
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetSqlQuery(
+                  &statement,
+                  "WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c "
+                  "WHERE x < 1000) SELECT x FROM c",
+                  &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(
+      AdbcStatementSetOption(&statement, "adbc.sqlite.query.batch_rows", "64", &error),
+      adbc_validation::IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS,
+                                     "300", &error),
+              adbc_validation::IsOkStatus(&error));
+
+  adbc_validation::StreamReader reader;
+  ASSERT_THAT(AdbcStatementExecuteQuery(&statement, &reader.stream.value,
+                                        &reader.rows_affected, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+
+  std::vector<int64_t> lengths;
+  int64_t expected = 1;
+  while (true) {
+    ASSERT_NO_FATAL_FAILURE(reader.Next());
+    if (!reader.array->release) break;
+    lengths.push_back(reader.array->length);
+    for (int64_t i = 0; i < reader.array->length; i++) {
+      ASSERT_EQ(expected++,
+                ArrowArrayViewGetIntUnsafe(reader.array_view->children[0], i));
+    }
+  }
+  ASSERT_THAT(lengths, ::testing::ElementsAre(300, 300, 300, 100));
+
+  char buffer[32];
+  size_t length = sizeof(buffer);
+  ASSERT_THAT(AdbcStatementGetOption(&statement, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS,
+                                     buffer, &length, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_EQ(4, length);
+  ASSERT_STREQ("300", buffer);
+  length = sizeof(buffer);
+  ASSERT_THAT(AdbcStatementGetOption(&statement, ADBC_STATEMENT_OPTION_TARGET_BATCH_BYTES,
+                                     buffer, &length, &error),
+              adbc_validation::IsOkStatus(&error));
+  ASSERT_STREQ("0", buffer);
+
+  ASSERT_THAT(AdbcStatementSetOption(&statement, ADBC_STATEMENT_OPTION_TARGET_BATCH_ROWS,
+                                     "-1", &error),
+              adbc_validation::IsStatus(ADBC_STATUS_INVALID_ARGUMENT, &error));
+}
+
+class SqliteThroughputTest : public ::testing::Test,
+                             public adbc_validation::ThroughputTest {
+ public:
+  const adbc_validation::DriverQuirks* quirks() const override { return &quirks_; }
+  void SetUp() override { ASSERT_NO_FATAL_FAILURE(SetUpTest()); }
+  void TearDown() override { ASSERT_NO_FATAL_FAILURE(TearDownTest()); }
+
+ protected:
+  SqliteQuirks quirks_;
+};
+ADBCV_TEST_THROUGHPUT(SqliteThroughputTest)
+
 // -- SQLite Specific Tests ------------------------------------------
 
 constexpr size_t kInferRows = 16;
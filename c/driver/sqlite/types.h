@@ -57,4 +57,6 @@ struct SqliteStatement {
 
   // -- Query options ---------------------------------------
   int batch_size;
+  int64_t target_batch_rows;
+  int64_t target_batch_bytes;
 };
@@ -0,0 +1,217 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Measure the cost of forwarding calls through the driver manager, by
+// comparing calls to a no-op driver made directly through its function
+// table against the same calls made through the AdbcXxx entrypoints.
+
+#include <cstring>
+
+#include <adbc.h>
+#include <benchmark/benchmark.h>
+
+#include "adbc_driver_manager.h"
+
+namespace {
+
+int kDummy = 0;
+
+AdbcStatusCode NoopDatabaseNew(struct AdbcDatabase* database, struct AdbcError* error) {
+  database->private_data = &kDummy;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode NoopDatabaseInit(struct AdbcDatabase* database, struct AdbcError* error) {
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode NoopDatabaseRelease(struct AdbcDatabase* database,
+                                   struct AdbcError* error) {
+  database->private_data = nullptr;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode NoopConnectionNew(struct AdbcConnection* connection,
+                                 struct AdbcError* error) {
+  connection->private_data = &kDummy;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode NoopConnectionInit(struct AdbcConnection* connection,
+                                  struct AdbcDatabase* database,
+                                  struct AdbcError* error) {
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode NoopConnectionRelease(struct AdbcConnection* connection,
+                                     struct AdbcError* error) {
+  connection->private_data = nullptr;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode NoopStatementNew(struct AdbcConnection* connection,
+                                struct AdbcStatement* statement,
+                                struct AdbcError* error) {
+  statement->private_data = &kDummy;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode NoopStatementRelease(struct AdbcStatement* statement,
+                                    struct AdbcError* error) {
+  statement->private_data = nullptr;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode NoopStatementExecuteQuery(struct AdbcStatement* statement,
+                                         struct ArrowArrayStream* stream,
+                                         int64_t* rows_affected,
+                                         struct AdbcError* error) {
+  return ADBC_STATUS_NOT_IMPLEMENTED;
+}
+
+AdbcStatusCode NoopStatementSetSqlQuery(struct AdbcStatement* statement,
+                                        const char* query, struct AdbcError* error) {
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode NoopStatementGetOptionInt(struct AdbcStatement* statement,
+                                         const char* key, int64_t* value,
+                                         struct AdbcError* error) {
+  *value = 0;
+  return ADBC_STATUS_OK;
+}
+
+AdbcStatusCode NoopDriverInit(int version, void* raw_driver, struct AdbcError* error) {
+  if (version != ADBC_VERSION_1_1_0) return ADBC_STATUS_NOT_IMPLEMENTED;
+
+  auto* driver = reinterpret_cast<struct AdbcDriver*>(raw_driver);
+  std::memset(driver, 0, ADBC_DRIVER_1_1_0_SIZE);
+  driver->DatabaseNew = &NoopDatabaseNew;
+  driver->DatabaseInit = &NoopDatabaseInit;
+  driver->DatabaseRelease = &NoopDatabaseRelease;
+  driver->ConnectionNew = &NoopConnectionNew;
+  driver->ConnectionInit = &NoopConnectionInit;
+  driver->ConnectionRelease = &NoopConnectionRelease;
+  driver->StatementNew = &NoopStatementNew;
+  driver->StatementRelease = &NoopStatementRelease;
+  driver->StatementExecuteQuery = &NoopStatementExecuteQuery;
+  driver->StatementSetSqlQuery = &NoopStatementSetSqlQuery;
+  driver->StatementGetOptionInt = &NoopStatementGetOptionInt;
+  return ADBC_STATUS_OK;
+}
+
+void BM_DirectSetSqlQuery(benchmark::State& state) {
+  struct AdbcError error = ADBC_ERROR_INIT;
+  struct AdbcDriver driver = {};
+  NoopDriverInit(ADBC_VERSION_1_1_0, &driver, &error);
+  struct AdbcStatement statement = {};
+  driver.StatementNew(nullptr, &statement, &error);
+
+  for (auto _ : state) {
+    AdbcStatusCode status = driver.StatementSetSqlQuery(&statement, "SELECT 1", &error);
+    benchmark::DoNotOptimize(status);
+  }
+  driver.StatementRelease(&statement, &error);
+}
+BENCHMARK(BM_DirectSetSqlQuery);
+
+/// A database, connection, and statement opened through the driver manager.
+struct ManagedStatement {
+  ~ManagedStatement() {
+    if (statement.private_data) AdbcStatementRelease(&statement, &error);
+    if (connection.private_data) AdbcConnectionRelease(&connection, &error);
+    if (database.private_data) AdbcDatabaseRelease(&database, &error);
+    if (error.release) error.release(&error);
+  }
+
+  AdbcStatusCode Init() {
+    AdbcStatusCode status;
+    if ((status = AdbcDatabaseNew(&database, &error)) != ADBC_STATUS_OK) return status;
+    if ((status = AdbcDriverManagerDatabaseSetInitFunc(&database, &NoopDriverInit,
+                                                       &error)) != ADBC_STATUS_OK) {
+      return status;
+    }
+    if ((status = AdbcDatabaseInit(&database, &error)) != ADBC_STATUS_OK) return status;
+    if ((status = AdbcConnectionNew(&connection, &error)) != ADBC_STATUS_OK) {
+      return status;
+    }
+    if ((status = AdbcConnectionInit(&connection, &database, &error)) !=
+        ADBC_STATUS_OK) {
+      return status;
+    }
+    return AdbcStatementNew(&connection, &statement, &error);
+  }
+
+  struct AdbcError error = ADBC_ERROR_INIT;
+  struct AdbcDatabase database = {};
+  struct AdbcConnection connection = {};
+  struct AdbcStatement statement = {};
+};
+
+void BM_DriverManagerSetSqlQuery(benchmark::State& state) {
+  ManagedStatement managed;
+  if (managed.Init() != ADBC_STATUS_OK) {
+    state.SkipWithError(managed.error.message ? managed.error.message
+                                              : "Failed to initialize driver");
+    return;
+  }
+
+  for (auto _ : state) {
+    AdbcStatusCode status =
+        AdbcStatementSetSqlQuery(&managed.statement, "SELECT 1", &managed.error);
+    benchmark::DoNotOptimize(status);
+  }
+}
+BENCHMARK(BM_DriverManagerSetSqlQuery);
+
+void BM_DirectGetOptionInt(benchmark::State& state) {
+  struct AdbcError error = ADBC_ERROR_INIT;
+  struct AdbcDriver driver = {};
+  NoopDriverInit(ADBC_VERSION_1_1_0, &driver, &error);
+  struct AdbcStatement statement = {};
+  driver.StatementNew(nullptr, &statement, &error);
+
+  for (auto _ : state) {
+    int64_t value = 0;
+    AdbcStatusCode status =
+        driver.StatementGetOptionInt(&statement, "key", &value, &error);
+    benchmark::DoNotOptimize(status);
+    benchmark::DoNotOptimize(value);
+  }
+  driver.StatementRelease(&statement, &error);
+}
+BENCHMARK(BM_DirectGetOptionInt);
+
+void BM_DriverManagerGetOptionInt(benchmark::State& state) {
+  ManagedStatement managed;
+  if (managed.Init() != ADBC_STATUS_OK) {
+    state.SkipWithError(managed.error.message ? managed.error.message
+                                              : "Failed to initialize driver");
+    return;
+  }
+
+  for (auto _ : state) {
+    int64_t value = 0;
+    AdbcStatusCode status =
+        AdbcStatementGetOptionInt(&managed.statement, "key", &value, &managed.error);
+    benchmark::DoNotOptimize(status);
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK(BM_DriverManagerGetOptionInt);
+
+}  // namespace
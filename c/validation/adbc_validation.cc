@@ -19,6 +19,10 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <cinttypes>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <limits>
 #include <optional>
@@ -3428,6 +3432,378 @@ void StatementTest::TestResultInvalidation() {
   reader1.MaybeNext();
 }
 
+// ------------------------------------------------------------
+// Tests of throughput
+
+namespace {
+constexpr char kThroughputTable[] = "adbc_throughput";
+
+/// Sum the buffer sizes of an array (and its children) as the number of
+/// bytes it carries.
+int64_t ArrayViewBytes(const struct ArrowArrayView* array_view) {
+  int64_t bytes = 0;
+  for (int i = 0; i < 3; i++) {
+    bytes += array_view->buffer_views[i].size_bytes;
+  }
+  for (int64_t i = 0; i < array_view->n_children; i++) {
+    bytes += ArrayViewBytes(array_view->children[i]);
+  }
+  return bytes;
+}
+
+ArrowErrorCode AppendThroughputValue(struct ArrowArray* array, ArrowType type,
+                                     int64_t i) {
+  if (i % 10 == 0) return ArrowArrayAppendNull(array, 1);
+
+  switch (type) {
+    case NANOARROW_TYPE_BOOL:
+      return ArrowArrayAppendInt(array, i % 2);
+    case NANOARROW_TYPE_INT8:
+      return ArrowArrayAppendInt(array, i % std::numeric_limits<int8_t>::max());
+    case NANOARROW_TYPE_UINT8:
+      return ArrowArrayAppendUInt(array, i % std::numeric_limits<uint8_t>::max());
+    case NANOARROW_TYPE_INT16:
+      return ArrowArrayAppendInt(array, i % std::numeric_limits<int16_t>::max());
+    case NANOARROW_TYPE_UINT16:
+      return ArrowArrayAppendUInt(array, i % std::numeric_limits<uint16_t>::max());
+    case NANOARROW_TYPE_INT32:
+    case NANOARROW_TYPE_UINT32:
+    case NANOARROW_TYPE_INT64:
+    case NANOARROW_TYPE_UINT64:
+      return ArrowArrayAppendInt(array, i);
+    case NANOARROW_TYPE_FLOAT:
+    case NANOARROW_TYPE_DOUBLE:
+      return ArrowArrayAppendDouble(array, static_cast<double>(i) / 4);
+    case NANOARROW_TYPE_STRING:
+    case NANOARROW_TYPE_LARGE_STRING:
+    case NANOARROW_TYPE_BINARY:
+    case NANOARROW_TYPE_LARGE_BINARY: {
+      std::string value = "throughput row " + std::to_string(i);
+      struct ArrowBufferView view;
+      view.data.data = value.data();
+      view.size_bytes = static_cast<int64_t>(value.size());
+      return ArrowArrayAppendBytes(array, view);
+    }
+    case NANOARROW_TYPE_DATE32:
+      return ArrowArrayAppendInt(array, i % 20000);
+    case NANOARROW_TYPE_TIMESTAMP:
+    case NANOARROW_TYPE_DURATION:
+      return ArrowArrayAppendInt(array, i * 1000000);
+    default:
+      return ENOTSUP;
+  }
+}
+
+/// Make a batch with an int64 "idx" column (0..n_rows-1) followed by one
+/// column per type, where every 10th value is null.
+ArrowErrorCode MakeThroughputBatch(const std::vector<ArrowType>& types, int64_t n_rows,
+                                   struct ArrowSchema* schema, struct ArrowArray* array,
+                                   struct ArrowError* na_error) {
+  ArrowSchemaInit(schema);
+  NANOARROW_RETURN_NOT_OK(
+      ArrowSchemaSetTypeStruct(schema, static_cast<int64_t>(types.size()) + 1));
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema->children[0], NANOARROW_TYPE_INT64));
+  NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(schema->children[0], "idx"));
+  schema->children[0]->flags &= ~ARROW_FLAG_NULLABLE;
+  for (size_t i = 0; i < types.size(); i++) {
+    struct ArrowSchema* child = schema->children[i + 1];
+    if (types[i] == NANOARROW_TYPE_TIMESTAMP || types[i] == NANOARROW_TYPE_DURATION) {
+      NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeDateTime(
+          child, types[i], NANOARROW_TIME_UNIT_MICRO, /*timezone=*/nullptr));
+    } else {
+      NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(child, types[i]));
+    }
+    std::string name = std::string("col_") + ArrowTypeString(types[i]);
+    NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(child, name.c_str()));
+  }
+
+  NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(array, schema, na_error));
+  NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(array));
+  for (int64_t row = 0; row < n_rows; row++) {
+    NANOARROW_RETURN_NOT_OK(ArrowArrayAppendInt(array->children[0], row));
+    for (size_t i = 0; i < types.size(); i++) {
+      NANOARROW_RETURN_NOT_OK(
+          AppendThroughputValue(array->children[i + 1], types[i], row));
+    }
+    NANOARROW_RETURN_NOT_OK(ArrowArrayFinishElement(array));
+  }
+  return ArrowArrayFinishBuildingDefault(array, na_error);
+}
+
+/// Report the rate of a workload on stdout and as test properties.
+void ReportThroughput(const char* workload, int64_t rows, int64_t bytes,
+                      std::chrono::steady_clock::duration elapsed) {
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  const double rows_per_second = seconds > 0 ? rows / seconds : 0;
+  const double bytes_per_second = seconds > 0 ? bytes / seconds : 0;
+  std::printf("[ THROUGHPUT ] %s: %" PRId64 " rows, %" PRId64
+              " bytes in %.3f s (%.0f rows/s, %.0f bytes/s)\n",
+              workload, rows, bytes, seconds, rows_per_second, bytes_per_second);
+  ::testing::Test::RecordProperty("rows", std::to_string(rows));
+  ::testing::Test::RecordProperty("bytes", std::to_string(bytes));
+  ::testing::Test::RecordProperty("seconds", std::to_string(seconds));
+  ::testing::Test::RecordProperty("rows_per_second", std::to_string(rows_per_second));
+  ::testing::Test::RecordProperty("bytes_per_second", std::to_string(bytes_per_second));
+}
+}  // namespace
+
+void ThroughputTest::SetUpTest() {
+  std::memset(&error, 0, sizeof(error));
+  std::memset(&database, 0, sizeof(database));
+  std::memset(&connection, 0, sizeof(connection));
+
+  ASSERT_THAT(AdbcDatabaseNew(&database, &error), IsOkStatus(&error));
+  ASSERT_THAT(quirks()->SetupDatabase(&database, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcDatabaseInit(&database, &error), IsOkStatus(&error));
+
+  ASSERT_THAT(AdbcConnectionNew(&connection, &error), IsOkStatus(&error));
+  ASSERT_THAT(AdbcConnectionInit(&connection, &database, &error), IsOkStatus(&error));
+}
+
+void ThroughputTest::TearDownTest() {
+  if (connection.private_data) {
+    EXPECT_THAT(quirks()->DropTable(&connection, kThroughputTable, &error),
+                IsOkStatus(&error));
+  }
+  EXPECT_THAT(AdbcConnectionRelease(&connection, &error), IsOkStatus(&error));
+  EXPECT_THAT(AdbcDatabaseRelease(&database, &error), IsOkStatus(&error));
+  if (error.release) {
+    error.release(&error);
+  }
+}
+
+int64_t ThroughputTest::throughput_rows() const {
+  const char* rows = std::getenv("ADBC_VALIDATION_THROUGHPUT_ROWS");
+  if (rows && rows[0] != '\0') {
+    return std::strtoll(rows, nullptr, 10);
+  }
+  return 10000;
+}
+
+std::vector<ArrowType> ThroughputTest::throughput_types() const {
+  return {
+      NANOARROW_TYPE_BOOL,   NANOARROW_TYPE_INT16,  NANOARROW_TYPE_INT32,
+      NANOARROW_TYPE_INT64,  NANOARROW_TYPE_FLOAT,  NANOARROW_TYPE_DOUBLE,
+      NANOARROW_TYPE_STRING, NANOARROW_TYPE_BINARY, NANOARROW_TYPE_DATE32,
+      NANOARROW_TYPE_TIMESTAMP,
+  };
+}
+
+void ThroughputTest::IngestThroughputTable(int64_t* bytes_ingested) {
+  ASSERT_THAT(quirks()->DropTable(&connection, kThroughputTable, &error),
+              IsOkStatus(&error));
+
+  Handle<struct ArrowSchema> schema;
+  Handle<struct ArrowArray> array;
+  struct ArrowError na_error;
+  ASSERT_THAT(MakeThroughputBatch(throughput_types(), throughput_rows(), &schema.value,
+                                  &array.value, &na_error),
+              IsOkErrno(&na_error));
+  {
+    Handle<struct ArrowArrayView> array_view;
+    ASSERT_THAT(ArrowArrayViewInitFromSchema(&array_view.value, &schema.value, &na_error),
+                IsOkErrno(&na_error));
+    ASSERT_THAT(ArrowArrayViewSetArray(&array_view.value, &array.value, &na_error),
+                IsOkErrno(&na_error));
+    *bytes_ingested = ArrayViewBytes(&array_view.value);
+  }
+
+  Handle<struct AdbcStatement> statement;
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementSetOption(&statement.value, ADBC_INGEST_OPTION_TARGET_TABLE,
+                                     kThroughputTable, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementBind(&statement.value, &array.value, &schema.value, &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error),
+              IsOkStatus(&error));
+}
+
+void ThroughputTest::TestIngest() {
+  if (!quirks()->supports_bulk_ingest(ADBC_INGEST_OPTION_MODE_CREATE)) {
+    GTEST_SKIP();
+  }
+
+  int64_t bytes = 0;
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_NO_FATAL_FAILURE(IngestThroughputTable(&bytes));
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  ReportThroughput("ingest", throughput_rows(), bytes, elapsed);
+}
+
+void ThroughputTest::TestScan() {
+  if (!quirks()->supports_bulk_ingest(ADBC_INGEST_OPTION_MODE_CREATE)) {
+    GTEST_SKIP();
+  }
+
+  int64_t bytes = 0;
+  ASSERT_NO_FATAL_FAILURE(IngestThroughputTable(&bytes));
+
+  Handle<struct AdbcStatement> statement;
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+              IsOkStatus(&error));
+  const std::string query = std::string("SELECT * FROM ") + kThroughputTable;
+  ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, query.c_str(), &error),
+              IsOkStatus(&error));
+
+  int64_t rows = 0;
+  bytes = 0;
+  const auto start = std::chrono::steady_clock::now();
+  {
+    StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          &reader.rows_affected, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    while (true) {
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+      if (!reader.array->release) break;
+      rows += reader.array->length;
+      bytes += ArrayViewBytes(&reader.array_view.value);
+    }
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_EQ(throughput_rows(), rows);
+  ReportThroughput("scan", rows, bytes, elapsed);
+}
+
+void ThroughputTest::TestPreparedPointQuery() {
+  if (!quirks()->supports_bulk_ingest(ADBC_INGEST_OPTION_MODE_CREATE) ||
+      !quirks()->supports_dynamic_parameter_binding()) {
+    GTEST_SKIP();
+  }
+
+  int64_t bytes = 0;
+  ASSERT_NO_FATAL_FAILURE(IngestThroughputTable(&bytes));
+
+  Handle<struct AdbcStatement> statement;
+  ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+              IsOkStatus(&error));
+  const std::string query = std::string("SELECT * FROM ") + kThroughputTable +
+                            " WHERE idx = " + quirks()->BindParameter(0);
+  ASSERT_THAT(AdbcStatementSetSqlQuery(&statement.value, query.c_str(), &error),
+              IsOkStatus(&error));
+  ASSERT_THAT(AdbcStatementPrepare(&statement.value, &error), IsOkStatus(&error));
+
+  const int64_t n_rows = throughput_rows();
+  const int64_t n_queries = throughput_point_queries();
+  int64_t rows = 0;
+  bytes = 0;
+  std::chrono::steady_clock::duration elapsed{0};
+  for (int64_t i = 0; i < n_queries; i++) {
+    // Build the parameters outside of the timed section
+    Handle<struct ArrowSchema> schema;
+    Handle<struct ArrowArray> params;
+    struct ArrowError na_error;
+    ASSERT_THAT(MakeSchema(&schema.value, {{"idx", NANOARROW_TYPE_INT64}}),
+                IsOkErrno());
+    ASSERT_THAT(MakeBatch<int64_t>(&schema.value, &params.value, &na_error,
+                                   {(i * 7919) % n_rows}),
+                IsOkErrno(&na_error));
+
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_THAT(AdbcStatementBind(&statement.value, &params.value, &schema.value, &error),
+                IsOkStatus(&error));
+    StreamReader reader;
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, &reader.stream.value,
+                                          &reader.rows_affected, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    int64_t matched = 0;
+    while (true) {
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+      if (!reader.array->release) break;
+      matched += reader.array->length;
+      bytes += ArrayViewBytes(&reader.array_view.value);
+    }
+    elapsed += std::chrono::steady_clock::now() - start;
+    ASSERT_EQ(1, matched) << "for idx = " << (i * 7919) % n_rows;
+    rows += matched;
+  }
+  ReportThroughput("prepared point query", rows, bytes, elapsed);
+}
+
+void ThroughputTest::TestGetObjects() {
+  if (!quirks()->supports_get_objects() ||
+      !quirks()->supports_bulk_ingest(ADBC_INGEST_OPTION_MODE_CREATE)) {
+    GTEST_SKIP();
+  }
+
+  const int64_t n_tables = throughput_tables();
+  const std::vector<ArrowType> types = throughput_types();
+  std::vector<std::string> table_names;
+  for (int64_t i = 0; i < n_tables; i++) {
+    table_names.push_back(std::string(kThroughputTable) + "_objects_" +
+                          std::to_string(i));
+  }
+
+  for (const auto& table_name : table_names) {
+    ASSERT_THAT(quirks()->DropTable(&connection, table_name, &error),
+                IsOkStatus(&error));
+    Handle<struct ArrowSchema> schema;
+    Handle<struct ArrowArray> array;
+    struct ArrowError na_error;
+    ASSERT_THAT(MakeThroughputBatch(types, 1, &schema.value, &array.value, &na_error),
+                IsOkErrno(&na_error));
+
+    Handle<struct AdbcStatement> statement;
+    ASSERT_THAT(AdbcStatementNew(&connection, &statement.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementSetOption(&statement.value, ADBC_INGEST_OPTION_TARGET_TABLE,
+                                       table_name.c_str(), &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementBind(&statement.value, &array.value, &schema.value, &error),
+                IsOkStatus(&error));
+    ASSERT_THAT(AdbcStatementExecuteQuery(&statement.value, nullptr, nullptr, &error),
+                IsOkStatus(&error));
+  }
+
+  // Count tables and columns as rows, since that is what a client sees after
+  // unpacking the nested result
+  const std::string pattern = std::string(kThroughputTable) + "_objects_%";
+  int64_t tables = 0;
+  int64_t columns = 0;
+  int64_t bytes = 0;
+  const auto start = std::chrono::steady_clock::now();
+  {
+    StreamReader reader;
+    ASSERT_THAT(AdbcConnectionGetObjects(&connection, ADBC_OBJECT_DEPTH_ALL, nullptr,
+                                         nullptr, pattern.c_str(), nullptr, nullptr,
+                                         &reader.stream.value, &error),
+                IsOkStatus(&error));
+    ASSERT_NO_FATAL_FAILURE(reader.GetSchema());
+    while (true) {
+      ASSERT_NO_FATAL_FAILURE(reader.Next());
+      if (!reader.array->release) break;
+      bytes += ArrayViewBytes(&reader.array_view.value);
+
+      GetObjectsReader get_objects(&reader.array_view.value);
+      ASSERT_NE(*get_objects, nullptr) << "could not initialize the AdbcGetObjectsData";
+      for (int i = 0; i < get_objects->n_catalogs; i++) {
+        struct AdbcGetObjectsCatalog* catalog = get_objects->catalogs[i];
+        for (int j = 0; j < catalog->n_db_schemas; j++) {
+          struct AdbcGetObjectsSchema* db_schema = catalog->catalog_db_schemas[j];
+          tables += db_schema->n_db_schema_tables;
+          for (int k = 0; k < db_schema->n_db_schema_tables; k++) {
+            columns += db_schema->db_schema_tables[k]->n_table_columns;
+          }
+        }
+      }
+    }
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  for (const auto& table_name : table_names) {
+    EXPECT_THAT(quirks()->DropTable(&connection, table_name, &error),
+                IsOkStatus(&error));
+  }
+
+  ASSERT_EQ(n_tables, tables);
+  ASSERT_EQ(n_tables * static_cast<int64_t>(types.size() + 1), columns);
+  ReportThroughput("get objects", tables + columns, bytes, elapsed);
+}
+
 #undef NOT_NULL
 #undef NULLABLE
 }  // namespace adbc_validation
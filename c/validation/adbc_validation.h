@@ -434,6 +434,53 @@ class StatementTest {
   TEST_F(FIXTURE, ErrorCompatibility) { TestErrorCompatibility(); }                     \
   TEST_F(FIXTURE, ResultInvalidation) { TestResultInvalidation(); }
 
+/// \brief Throughput workloads, reported as rows/s and bytes/s.
+///
+/// These are not benchmarks in the statistical sense: each workload runs
+/// once and reports its rate via stdout and RecordProperty (so it ends up
+/// in the --gtest_output XML). The intent is to catch order-of-magnitude
+/// regressions across drivers with the same workloads.
+class ThroughputTest {
+ public:
+  virtual const DriverQuirks* quirks() const = 0;
+
+  void SetUpTest();
+  void TearDownTest();
+
+  /// \brief Rows to ingest and scan (ADBC_VALIDATION_THROUGHPUT_ROWS overrides)
+  virtual int64_t throughput_rows() const;
+
+  /// \brief Column types to ingest, in addition to the int64 "idx" column
+  virtual std::vector<ArrowType> throughput_types() const;
+
+  /// \brief Number of executions of the prepared point query
+  virtual int64_t throughput_point_queries() const { return 200; }
+
+  /// \brief Number of tables to create for the GetObjects workload
+  virtual int64_t throughput_tables() const { return 100; }
+
+  // Test methods
+  void TestIngest();
+  void TestScan();
+  void TestPreparedPointQuery();
+  void TestGetObjects();
+
+ protected:
+  struct AdbcError error;
+  struct AdbcDatabase database;
+  struct AdbcConnection connection;
+
+  void IngestThroughputTable(int64_t* bytes_ingested);
+};
+
+#define ADBCV_TEST_THROUGHPUT(FIXTURE)                                            \
+  static_assert(std::is_base_of<adbc_validation::ThroughputTest, FIXTURE>::value, \
+                ADBCV_STRINGIFY(FIXTURE) " must inherit from ThroughputTest");    \
+  TEST_F(FIXTURE, Ingest) { TestIngest(); }                                       \
+  TEST_F(FIXTURE, Scan) { TestScan(); }                                           \
+  TEST_F(FIXTURE, PreparedPointQuery) { TestPreparedPointQuery(); }               \
+  TEST_F(FIXTURE, GetObjects) { TestGetObjects(); }
+
 }  // namespace adbc_validation
 
 #endif  // ADBC_VALIDATION_H
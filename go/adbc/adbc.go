@@ -238,6 +238,9 @@ const (
 	OptionKeyMaxProgress              = "adbc.statement.exec.max_progress"
 	OptionKeyIngestTargetTable        = "adbc.ingest.target_table"
 	OptionKeyIngestMode               = "adbc.ingest.mode"
+	OptionKeyIngestTargetCatalog      = "adbc.ingest.target_catalog"
+	OptionKeyIngestTargetDBSchema     = "adbc.ingest.target_db_schema"
+	OptionKeyIngestTemporary          = "adbc.ingest.temporary"
 	OptionKeyIsolationLevel           = "adbc.connection.transaction.isolation_level"
 	OptionKeyReadOnly                 = "adbc.connection.readonly"
 	OptionValueIngestModeCreate       = "adbc.ingest.mode.create"
@@ -0,0 +1,248 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package flightsql
+
+import (
+	"context"
+	"sync/atomic"
+
+	"github.com/apache/arrow/go/v13/arrow"
+	"github.com/apache/arrow/go/v13/arrow/array"
+	"github.com/apache/arrow/go/v13/arrow/flight"
+	"github.com/apache/arrow/go/v13/arrow/flight/flightsql"
+	"github.com/apache/arrow/go/v13/arrow/ipc"
+	"github.com/apache/arrow/go/v13/arrow/memory"
+	"google.golang.org/grpc"
+	"google.golang.org/grpc/encoding"
+	grpcproto "google.golang.org/grpc/encoding/proto"
+	"google.golang.org/grpc/metadata"
+	"google.golang.org/protobuf/encoding/protowire"
+)
+
+// streamReader is the result of a DoGet: either a *flight.Reader, or an
+// *ipc.Reader over an allocatedMessageReader.
+type streamReader interface {
+	array.RecordReader
+	Read() (arrow.Record, error)
+}
+
+// streamOptions controls how a DoGet stream is requested and read.
+type streamOptions struct {
+	// If not nil, message bodies are received into memory from this
+	// allocator (see flightDataCodec)
+	bodyAlloc memory.Allocator
+	// If not "", ask the server to compress the stream with this codec,
+	// and decompress batches in parallel (see decompressBody)
+	compression string
+	// Allocates decompressed bodies, if bodyAlloc is nil
+	alloc memory.Allocator
+}
+
+// FlightData field numbers, from Flight.proto
+const (
+	flightDataFieldHeader = 2
+	flightDataFieldBody   = 1000
+)
+
+// flightDataCodec is the gRPC codec of DoGet streams whose message bodies
+// are kept in allocator memory. gRPC hands a codec the serialized message
+// as received off the wire; where the protobuf codec would copy data_body
+// into a new slice on the Go heap, this copies it into a buffer from mem
+// instead. A body is therefore copied exactly once either way, but here
+// it never lands on the Go heap.
+//
+// Other messages (the Ticket that is sent) go through the protobuf codec.
+type flightDataCodec struct {
+	mem memory.Allocator
+}
+
+// allocatedFlightData is the part of a FlightData the IPC reader needs,
+// with the body in allocator memory.
+type allocatedFlightData struct {
+	header []byte
+	body   *memory.Buffer
+}
+
+func (flightDataCodec) Name() string {
+	// The content-subtype: the messages on the wire are plain protobuf
+	return grpcproto.Name
+}
+
+func (flightDataCodec) Marshal(v interface{}) ([]byte, error) {
+	return encoding.GetCodec(grpcproto.Name).Marshal(v)
+}
+
+func (c flightDataCodec) Unmarshal(data []byte, v interface{}) error {
+	msg, ok := v.(*allocatedFlightData)
+	if !ok {
+		return encoding.GetCodec(grpcproto.Name).Unmarshal(data, v)
+	}
+
+	for len(data) > 0 {
+		num, typ, n := protowire.ConsumeTag(data)
+		if n < 0 {
+			return protowire.ParseError(n)
+		}
+		data = data[n:]
+		if typ != protowire.BytesType || (num != flightDataFieldHeader && num != flightDataFieldBody) {
+			n = protowire.ConsumeFieldValue(num, typ, data)
+			if n < 0 {
+				return protowire.ParseError(n)
+			}
+			data = data[n:]
+			continue
+		}
+
+		value, n := protowire.ConsumeBytes(data)
+		if n < 0 {
+			return protowire.ParseError(n)
+		}
+		data = data[n:]
+		// gRPC may reuse data once this returns, so nothing may alias it
+		if num == flightDataFieldHeader {
+			msg.header = append([]byte(nil), value...)
+			continue
+		}
+		if msg.body != nil {
+			msg.body.Release()
+		}
+		msg.body = memory.NewResizableBuffer(c.mem)
+		msg.body.Resize(len(value))
+		copy(msg.body.Bytes(), value)
+	}
+	return nil
+}
+
+// allocatedMessageReader reads the IPC messages of a DoGet, receiving
+// each message body into memory from an allocator (see flightDataCodec)
+// instead of onto the Go heap, and/or decompressing the buffers of
+// compressed batches in parallel.
+//
+// The IPC reader slices record buffers out of the message body (retaining
+// it), so records read this way reference only allocator memory. With the
+// C allocator used by the driver library, batches exported through the C
+// Data Interface point straight at the received bodies: no Go memory is
+// kept alive for as long as the consumer holds them, and nothing is
+// copied to export them.
+type allocatedMessageReader struct {
+	refCount   int64
+	stream     flight.FlightService_DoGetClient
+	mem        memory.Allocator
+	copyBodies bool
+	decompress bool
+	msg        *ipc.Message
+}
+
+func (r *allocatedMessageReader) Message() (*ipc.Message, error) {
+	if r.msg != nil {
+		r.msg.Release()
+		r.msg = nil
+	}
+
+	var header []byte
+	var body *memory.Buffer
+	if r.copyBodies {
+		// The stream was opened with a flightDataCodec
+		var data allocatedFlightData
+		if err := r.stream.RecvMsg(&data); err != nil {
+			if data.body != nil {
+				data.body.Release()
+			}
+			return nil, err
+		}
+		header, body = data.header, data.body
+		if body == nil {
+			body = memory.NewResizableBuffer(r.mem)
+		}
+	} else {
+		data, err := r.stream.Recv()
+		if err != nil {
+			return nil, err
+		}
+		header, body = data.DataHeader, memory.NewBufferBytes(data.DataBody)
+	}
+	defer body.Release()
+
+	if r.decompress {
+		decompressedHeader, decompressed, err := decompressBody(header, body.Bytes(), r.mem)
+		if err != nil {
+			return nil, err
+		}
+		if decompressed != nil {
+			defer decompressed.Release()
+			header, body = decompressedHeader, decompressed
+		}
+	}
+
+	meta := memory.NewBufferBytes(header)
+	defer meta.Release()
+	r.msg = ipc.NewMessage(meta, body)
+	return r.msg, nil
+}
+
+func (r *allocatedMessageReader) Retain() {
+	atomic.AddInt64(&r.refCount, 1)
+}
+
+func (r *allocatedMessageReader) Release() {
+	if atomic.AddInt64(&r.refCount, -1) == 0 {
+		if r.msg != nil {
+			r.msg.Release()
+			r.msg = nil
+		}
+	}
+}
+
+// doGetTicket is cl.DoGet, but reading the stream as stream says.
+func doGetTicket(ctx context.Context, cl *flightsql.Client, ticket *flight.Ticket, stream streamOptions, opts ...grpc.CallOption) (streamReader, error) {
+	if stream.bodyAlloc == nil && stream.compression == "" {
+		rdr, err := cl.DoGet(ctx, ticket, opts...)
+		if err != nil {
+			return nil, err
+		}
+		return rdr, nil
+	}
+
+	if stream.compression != "" {
+		ctx = metadata.AppendToOutgoingContext(ctx, IPCCompressionHeader, stream.compression)
+	}
+	if stream.bodyAlloc != nil {
+		opts = append(opts[:len(opts):len(opts)], grpc.ForceCodec(flightDataCodec{mem: stream.bodyAlloc}))
+	}
+	data, err := cl.Client.DoGet(ctx, ticket, opts...)
+	if err != nil {
+		return nil, err
+	}
+
+	msgs := &allocatedMessageReader{
+		refCount:   1,
+		stream:     data,
+		mem:        stream.bodyAlloc,
+		copyBodies: stream.bodyAlloc != nil,
+		decompress: stream.compression != "",
+	}
+	if msgs.mem == nil {
+		msgs.mem = stream.alloc
+	}
+	rdr, err := ipc.NewReaderFromMessageReader(msgs, ipc.WithAllocator(msgs.mem))
+	if err != nil {
+		msgs.Release()
+		return nil, err
+	}
+	return rdr, nil
+}
@@ -0,0 +1,249 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package flightsql
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"io"
+
+	"github.com/apache/arrow-adbc/go/adbc"
+	"github.com/apache/arrow/go/v13/arrow"
+	"github.com/apache/arrow/go/v13/arrow/array"
+	"github.com/apache/arrow/go/v13/arrow/flight"
+	"github.com/apache/arrow/go/v13/arrow/ipc"
+	"google.golang.org/grpc"
+	"google.golang.org/grpc/metadata"
+	"google.golang.org/protobuf/encoding/protowire"
+	"google.golang.org/protobuf/proto"
+	"google.golang.org/protobuf/types/known/anypb"
+)
+
+// CommandStatementIngest is newer than the Flight SQL protocol bindings in
+// the Arrow release we build against, so the command (and the
+// DoPutUpdateResult that answers it) are encoded by hand. Field numbers and
+// enum values follow FlightSql.proto.
+const ingestCommandTypeURL = "type.googleapis.com/arrow.flight.protocol.sql.CommandStatementIngest"
+
+const (
+	// TableDefinitionOptions.TableNotExistOption
+	tableNotExistCreate = 1
+	tableNotExistFail   = 2
+	// TableDefinitionOptions.TableExistsOption
+	tableExistsFail    = 1
+	tableExistsAppend  = 2
+	tableExistsReplace = 3
+)
+
+type ingestCommand struct {
+	ifNotExist    uint64
+	ifExists      uint64
+	table         string
+	dbSchema      string
+	catalog       string
+	temporary     bool
+	transactionID []byte
+}
+
+func newIngestCommand(table, mode string) (*ingestCommand, error) {
+	cmd := &ingestCommand{table: table}
+	switch mode {
+	case adbc.OptionValueIngestModeCreate, "":
+		cmd.ifNotExist, cmd.ifExists = tableNotExistCreate, tableExistsFail
+	case adbc.OptionValueIngestModeAppend:
+		cmd.ifNotExist, cmd.ifExists = tableNotExistFail, tableExistsAppend
+	case adbc.OptionValueIngestModeReplace:
+		cmd.ifNotExist, cmd.ifExists = tableNotExistCreate, tableExistsReplace
+	case adbc.OptionValueIngestModeCreateAppend:
+		cmd.ifNotExist, cmd.ifExists = tableNotExistCreate, tableExistsAppend
+	default:
+		return nil, adbc.Error{
+			Msg:  fmt.Sprintf("[Flight SQL] Invalid ingest mode '%s'", mode),
+			Code: adbc.StatusInvalidArgument,
+		}
+	}
+	return cmd, nil
+}
+
+// descriptor returns the FlightDescriptor.Cmd for the command: a serialized
+// google.protobuf.Any wrapping the CommandStatementIngest message.
+func (c *ingestCommand) descriptor() ([]byte, error) {
+	var options []byte
+	options = protowire.AppendTag(options, 1, protowire.VarintType)
+	options = protowire.AppendVarint(options, c.ifNotExist)
+	options = protowire.AppendTag(options, 2, protowire.VarintType)
+	options = protowire.AppendVarint(options, c.ifExists)
+
+	var msg []byte
+	msg = protowire.AppendTag(msg, 1, protowire.BytesType)
+	msg = protowire.AppendBytes(msg, options)
+	msg = protowire.AppendTag(msg, 2, protowire.BytesType)
+	msg = protowire.AppendString(msg, c.table)
+	// schema and catalog are optional: leave them out to use the server's
+	// defaults
+	if c.dbSchema != "" {
+		msg = protowire.AppendTag(msg, 3, protowire.BytesType)
+		msg = protowire.AppendString(msg, c.dbSchema)
+	}
+	if c.catalog != "" {
+		msg = protowire.AppendTag(msg, 4, protowire.BytesType)
+		msg = protowire.AppendString(msg, c.catalog)
+	}
+	if c.temporary {
+		msg = protowire.AppendTag(msg, 5, protowire.VarintType)
+		msg = protowire.AppendVarint(msg, protowire.EncodeBool(true))
+	}
+	if len(c.transactionID) > 0 {
+		msg = protowire.AppendTag(msg, 6, protowire.BytesType)
+		msg = protowire.AppendBytes(msg, c.transactionID)
+	}
+
+	return proto.Marshal(&anypb.Any{TypeUrl: ingestCommandTypeURL, Value: msg})
+}
+
+// parseDoPutUpdateResult extracts record_count from a DoPutUpdateResult.
+func parseDoPutUpdateResult(data []byte) (int64, error) {
+	count := int64(0)
+	for len(data) > 0 {
+		num, typ, n := protowire.ConsumeTag(data)
+		if n < 0 {
+			return -1, protowire.ParseError(n)
+		}
+		data = data[n:]
+		if num == 1 && typ == protowire.VarintType {
+			v, n := protowire.ConsumeVarint(data)
+			if n < 0 {
+				return -1, protowire.ParseError(n)
+			}
+			count = int64(v)
+			data = data[n:]
+			continue
+		}
+		n = protowire.ConsumeFieldValue(num, typ, data)
+		if n < 0 {
+			return -1, protowire.ParseError(n)
+		}
+		data = data[n:]
+	}
+	return count, nil
+}
+
+// executeIngest streams the bound data to the server over a single DoPut
+// with a CommandStatementIngest descriptor, and returns the number of rows
+// the server reports having ingested (or -1 if it does not say).
+func (s *statement) executeIngest(ctx context.Context) (int64, error) {
+	if s.bound == nil && s.streamBind == nil {
+		return -1, adbc.Error{
+			Msg:  "[Flight SQL Statement] must call Bind before bulk ingestion",
+			Code: adbc.StatusInvalidState,
+		}
+	}
+	// The bound data is consumed by the DoPut either way, so it can only be
+	// ingested once
+	defer s.clearIngestBinding()
+
+	var rdr array.RecordReader
+	if s.bound != nil {
+		var err error
+		rdr, err = array.NewRecordReader(s.bound.Schema(), []arrow.Record{s.bound})
+		if err != nil {
+			return -1, adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL Statement] cannot ingest bound record: %s", err),
+				Code: adbc.StatusInternal,
+			}
+		}
+		defer rdr.Release()
+	} else {
+		rdr = s.streamBind
+	}
+
+	cmd, err := newIngestCommand(s.targetTable, s.ingestMode)
+	if err != nil {
+		return -1, err
+	}
+	cmd.dbSchema, cmd.catalog, cmd.temporary = s.targetDBSchema, s.targetCatalog, s.temporary
+	if s.cnxn.txn != nil {
+		cmd.transactionID = s.cnxn.txn.ID()
+	}
+	desc, err := cmd.descriptor()
+	if err != nil {
+		return -1, adbc.Error{
+			Msg:  fmt.Sprintf("[Flight SQL Statement] cannot serialize ingest command: %s", err),
+			Code: adbc.StatusInternal,
+		}
+	}
+
+	ctx, cancel := context.WithCancel(metadata.NewOutgoingContext(ctx, s.hdrs))
+	defer cancel()
+	var header, trailer metadata.MD
+	stream, err := s.cnxn.cl.Client.DoPut(ctx, grpc.Header(&header), grpc.Trailer(&trailer), s.timeouts)
+	if err != nil {
+		return -1, adbcFromFlightStatusWithDetails(err, header, trailer, "ExecuteIngest")
+	}
+
+	wrOpts := append([]ipc.Option{ipc.WithSchema(rdr.Schema()), ipc.WithAllocator(s.alloc)}, ipcWriteOptions(s.cnxn.db.compression)...)
+	wr := flight.NewRecordWriter(stream, wrOpts...)
+	wr.SetFlightDescriptor(&flight.FlightDescriptor{Type: flight.DescriptorCMD, Cmd: desc})
+
+	// If the server fails the call, Write only sees io.EOF; the actual
+	// status is reported by Recv below, so stop writing and go get it.
+	var writeErr error
+	for rdr.Next() {
+		if writeErr = wr.Write(rdr.Record()); writeErr != nil {
+			break
+		}
+	}
+	if writeErr == nil {
+		if err := rdr.Err(); err != nil {
+			// Cancel the call so the server does not commit a partial load
+			cancel()
+			return -1, adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL Statement] failed to read bound data: %s", err),
+				Code: adbc.StatusIO,
+			}
+		}
+		writeErr = wr.Close()
+	}
+	if err := stream.CloseSend(); err != nil && writeErr == nil {
+		writeErr = err
+	}
+
+	n := int64(-1)
+	for {
+		result, err := stream.Recv()
+		if errors.Is(err, io.EOF) {
+			break
+		} else if err != nil {
+			return -1, adbcFromFlightStatusWithDetails(err, header, trailer, "ExecuteIngest")
+		}
+		if len(result.GetAppMetadata()) > 0 {
+			if n, err = parseDoPutUpdateResult(result.GetAppMetadata()); err != nil {
+				return -1, adbc.Error{
+					Msg:  fmt.Sprintf("[Flight SQL Statement] invalid DoPutUpdateResult: %s", err),
+					Code: adbc.StatusInternal,
+				}
+			}
+		}
+	}
+
+	if writeErr != nil && !errors.Is(writeErr, io.EOF) {
+		return -1, adbcFromFlightStatusWithDetails(writeErr, header, trailer, "ExecuteIngest")
+	}
+	return n, nil
+}
@@ -23,21 +23,28 @@ package main
 
 import (
 	"context"
+	"errors"
 	"flag"
 	"fmt"
+	"io"
 	"log"
 	"net"
 	"os"
+	"runtime"
 	"strconv"
 	"strings"
+	"sync"
 
 	"github.com/apache/arrow/go/v13/arrow"
 	"github.com/apache/arrow/go/v13/arrow/array"
 	"github.com/apache/arrow/go/v13/arrow/flight"
 	"github.com/apache/arrow/go/v13/arrow/flight/flightsql"
+	"github.com/apache/arrow/go/v13/arrow/ipc"
 	"github.com/apache/arrow/go/v13/arrow/memory"
 	"google.golang.org/grpc/codes"
+	"google.golang.org/grpc/metadata"
 	"google.golang.org/grpc/status"
+	"google.golang.org/protobuf/encoding/protowire"
 	"google.golang.org/protobuf/proto"
 	"google.golang.org/protobuf/types/known/anypb"
 	"google.golang.org/protobuf/types/known/wrapperspb"
@@ -218,10 +225,300 @@ func (srv *ExampleServer) DoPutPreparedStatementUpdate(context.Context, flightsq
 	return 0, status.Error(codes.Unimplemented, "DoPutPreparedStatementUpdate not implemented")
 }
 
+// Bulk ingestion (CommandStatementIngest) is newer than the Flight SQL
+// bindings of this Arrow release, so IngestServer intercepts DoPut calls
+// carrying that command before they reach the Flight SQL dispatcher, and
+// decodes the command by hand.
+const ingestCommandTypeURL = "type.googleapis.com/arrow.flight.protocol.sql.CommandStatementIngest"
+
+type ingestCommand struct {
+	ifNotExist uint64
+	ifExists   uint64
+	table      string
+	schema     string
+	catalog    string
+	temporary  bool
+}
+
+// qualifiedName is the key of the command's table in IngestServer.tables.
+func (cmd ingestCommand) qualifiedName() string {
+	name := cmd.catalog + "." + cmd.schema + "." + cmd.table
+	if cmd.temporary {
+		name = "temp:" + name
+	}
+	return name
+}
+
+func parseIngestCommand(data []byte) (cmd ingestCommand, err error) {
+	for len(data) > 0 {
+		num, typ, n := protowire.ConsumeTag(data)
+		if n < 0 {
+			return cmd, protowire.ParseError(n)
+		}
+		data = data[n:]
+		switch {
+		case num == 1 && typ == protowire.BytesType:
+			var options []byte
+			if options, n = protowire.ConsumeBytes(data); n < 0 {
+				return cmd, protowire.ParseError(n)
+			}
+			for len(options) > 0 {
+				optNum, optTyp, m := protowire.ConsumeTag(options)
+				if m < 0 || optTyp != protowire.VarintType {
+					return cmd, fmt.Errorf("invalid TableDefinitionOptions")
+				}
+				options = options[m:]
+				value, m := protowire.ConsumeVarint(options)
+				if m < 0 {
+					return cmd, protowire.ParseError(m)
+				}
+				options = options[m:]
+				if optNum == 1 {
+					cmd.ifNotExist = value
+				} else if optNum == 2 {
+					cmd.ifExists = value
+				}
+			}
+		case num == 2 && typ == protowire.BytesType:
+			if cmd.table, n = protowire.ConsumeString(data); n < 0 {
+				return cmd, protowire.ParseError(n)
+			}
+		case num == 3 && typ == protowire.BytesType:
+			if cmd.schema, n = protowire.ConsumeString(data); n < 0 {
+				return cmd, protowire.ParseError(n)
+			}
+		case num == 4 && typ == protowire.BytesType:
+			if cmd.catalog, n = protowire.ConsumeString(data); n < 0 {
+				return cmd, protowire.ParseError(n)
+			}
+		case num == 5 && typ == protowire.VarintType:
+			var value uint64
+			if value, n = protowire.ConsumeVarint(data); n < 0 {
+				return cmd, protowire.ParseError(n)
+			}
+			cmd.temporary = protowire.DecodeBool(value)
+		default:
+			if n = protowire.ConsumeFieldValue(num, typ, data); n < 0 {
+				return cmd, protowire.ParseError(n)
+			}
+		}
+		data = data[n:]
+	}
+	return
+}
+
+// putStream replays the message that was read to pick the DoPut handler.
+type putStream struct {
+	flight.FlightService_DoPutServer
+	first *flight.FlightData
+}
+
+func (s *putStream) Recv() (*flight.FlightData, error) {
+	if s.first != nil {
+		data := s.first
+		s.first = nil
+		return data, nil
+	}
+	return s.FlightService_DoPutServer.Recv()
+}
+
+// IngestServer accepts bulk ingestion into in-memory tables. Only the row
+// count and schema of each table are kept, so that ingestion throughput can
+// be measured without the server's memory growing.
+type IngestServer struct {
+	flight.FlightServer
+
+	mu     sync.Mutex
+	tables map[string]*ingestTable
+}
+
+type ingestTable struct {
+	schema *arrow.Schema
+	rows   int64
+}
+
+func (srv *IngestServer) DoPut(stream flight.FlightService_DoPutServer) error {
+	first, err := stream.Recv()
+	if err != nil {
+		return err
+	}
+
+	var cmd anypb.Any
+	desc := first.GetFlightDescriptor()
+	if desc == nil || proto.Unmarshal(desc.GetCmd(), &cmd) != nil || cmd.GetTypeUrl() != ingestCommandTypeURL {
+		return srv.FlightServer.DoPut(&putStream{FlightService_DoPutServer: stream, first: first})
+	}
+
+	ingest, err := parseIngestCommand(cmd.GetValue())
+	if err != nil {
+		return status.Errorf(codes.InvalidArgument, "invalid CommandStatementIngest: %s", err)
+	}
+	switch ingest.table {
+	case "error_do_put":
+		return status.Error(codes.Unknown, "expected error (DoPut)")
+	case "error_do_put_detail":
+		detail1 := wrapperspb.String("detail1")
+		detail2 := wrapperspb.String("detail2")
+		return StatusWithDetail(codes.Unknown, "expected error (DoPut)", detail1, detail2)
+	case "check_target":
+		// Lets clients check that the target options are sent
+		if ingest.schema != "schema" || ingest.catalog != "catalog" || !ingest.temporary {
+			return status.Errorf(codes.InvalidArgument,
+				"expected schema 'schema', catalog 'catalog', temporary true; got '%s', '%s', %t",
+				ingest.schema, ingest.catalog, ingest.temporary)
+		}
+	}
+
+	rdr, err := flight.NewRecordReader(&putStream{FlightService_DoPutServer: stream, first: first})
+	if err != nil {
+		return status.Errorf(codes.InvalidArgument, "could not read ingested data: %s", err)
+	}
+	defer rdr.Release()
+
+	var rows int64
+	for rdr.Next() {
+		rows += rdr.Record().NumRows()
+	}
+	if err := rdr.Err(); err != nil && !errors.Is(err, io.EOF) {
+		return status.Errorf(codes.InvalidArgument, "could not read ingested data: %s", err)
+	}
+
+	if err := srv.store(ingest, rdr.Schema(), rows); err != nil {
+		return err
+	}
+
+	// DoPutUpdateResult { int64 record_count = 1; }
+	var result []byte
+	result = protowire.AppendTag(result, 1, protowire.VarintType)
+	result = protowire.AppendVarint(result, uint64(rows))
+	return stream.Send(&flight.PutResult{AppMetadata: result})
+}
+
+func (srv *IngestServer) store(cmd ingestCommand, schema *arrow.Schema, rows int64) error {
+	const (
+		tableNotExistCreate = 1
+		tableExistsAppend   = 2
+		tableExistsReplace  = 3
+	)
+
+	srv.mu.Lock()
+	defer srv.mu.Unlock()
+	table, ok := srv.tables[cmd.qualifiedName()]
+	switch {
+	case !ok && cmd.ifNotExist != tableNotExistCreate:
+		return status.Errorf(codes.NotFound, "table %s does not exist", cmd.table)
+	case !ok || cmd.ifExists == tableExistsReplace:
+		srv.tables[cmd.qualifiedName()] = &ingestTable{schema: schema, rows: rows}
+	case cmd.ifExists == tableExistsAppend:
+		if !table.schema.Equal(schema) {
+			return status.Errorf(codes.InvalidArgument, "schema does not match table %s", cmd.table)
+		}
+		table.rows += rows
+	default:
+		return status.Errorf(codes.AlreadyExists, "table %s already exists", cmd.table)
+	}
+	return nil
+}
+
+// The call header with which the driver asks for compressed results
+// (flightsql.IPCCompressionHeader).
+const ipcCompressionHeader = "x-adbc-ipc-compression"
+
+// CompressingServer writes the results of DoGet as compressed IPC
+// streams, with the codec requested by the client or else its default
+// codec, so that compression can be benchmarked locally.
+type CompressingServer struct {
+	flight.FlightServer
+
+	codec string
+}
+
+func ipcCompressionOption(codec string) (ipc.Option, bool) {
+	switch codec {
+	case "lz4_frame":
+		return ipc.WithLZ4(), true
+	case "zstd":
+		return ipc.WithZstd(), true
+	}
+	return nil, false
+}
+
+// getStream captures the stream written by the wrapped DoGet.
+type getStream struct {
+	flight.FlightService_DoGetServer
+	ch   chan *flight.FlightData
+	done chan struct{}
+}
+
+func (s *getStream) Send(data *flight.FlightData) error {
+	select {
+	case s.ch <- data:
+		return nil
+	case <-s.done:
+		return io.EOF
+	}
+}
+
+func (s *getStream) Recv() (*flight.FlightData, error) {
+	data, ok := <-s.ch
+	if !ok {
+		return nil, io.EOF
+	}
+	return data, nil
+}
+
+func (srv *CompressingServer) DoGet(tkt *flight.Ticket, stream flight.FlightService_DoGetServer) error {
+	codec := srv.codec
+	if md, ok := metadata.FromIncomingContext(stream.Context()); ok {
+		if values := md.Get(ipcCompressionHeader); len(values) > 0 {
+			codec = values[0]
+		}
+	}
+	compression, ok := ipcCompressionOption(codec)
+	if !ok {
+		return srv.FlightServer.DoGet(tkt, stream)
+	}
+
+	// Decode the wrapped DoGet's stream, and write it out again compressed
+	get := &getStream{FlightService_DoGetServer: stream, ch: make(chan *flight.FlightData), done: make(chan struct{})}
+	errs := make(chan error, 1)
+	go func() {
+		defer close(get.ch)
+		errs <- srv.FlightServer.DoGet(tkt, get)
+	}()
+	stop := func() error {
+		close(get.done)
+		return <-errs
+	}
+
+	rdr, err := flight.NewRecordReader(get)
+	if err != nil {
+		if getErr := stop(); getErr != nil {
+			return getErr
+		}
+		return err
+	}
+	defer rdr.Release()
+
+	wr := flight.NewRecordWriter(stream, ipc.WithSchema(rdr.Schema()), compression, ipc.WithCompressConcurrency(runtime.GOMAXPROCS(0)))
+	defer wr.Close()
+	for rdr.Next() {
+		if err := wr.Write(rdr.Record()); err != nil {
+			stop()
+			return err
+		}
+	}
+	if err := stop(); err != nil {
+		return err
+	}
+	return rdr.Err()
+}
+
 func main() {
 	var (
-		host = flag.String("host", "localhost", "hostname to bind to")
-		port = flag.Int("port", 0, "port to bind to")
+		host        = flag.String("host", "localhost", "hostname to bind to")
+		port        = flag.Int("port", 0, "port to bind to")
+		compression = flag.String("compression", "", "compress results with this codec (lz4_frame or zstd) unless the client asks otherwise")
 	)
 
 	flag.Parse()
@@ -230,7 +527,13 @@ func main() {
 	srv.Alloc = memory.DefaultAllocator
 
 	server := flight.NewServerWithMiddleware(nil)
-	server.RegisterFlightService(flightsql.NewFlightServer(srv))
+	server.RegisterFlightService(&CompressingServer{
+		FlightServer: &IngestServer{
+			FlightServer: flightsql.NewFlightServer(srv),
+			tables:       make(map[string]*ingestTable),
+		},
+		codec: *compression,
+	})
 	if err := server.Init(net.JoinHostPort(*host, strconv.Itoa(*port))); err != nil {
 		log.Fatal(err)
 	}
@@ -20,12 +20,16 @@
 package flightsql_test
 
 import (
+	"bytes"
 	"context"
+	"encoding/json"
 	"errors"
 	"fmt"
 	"net/textproto"
 	"os"
 	"strings"
+	"sync"
+	"sync/atomic"
 	"testing"
 	"time"
 
@@ -36,6 +40,7 @@ import (
 	"github.com/apache/arrow/go/v13/arrow/flight"
 	"github.com/apache/arrow/go/v13/arrow/flight/flightsql"
 	"github.com/apache/arrow/go/v13/arrow/flight/flightsql/schema_ref"
+	"github.com/apache/arrow/go/v13/arrow/ipc"
 	"github.com/apache/arrow/go/v13/arrow/memory"
 	"github.com/golang/protobuf/ptypes/wrappers"
 	"github.com/stretchr/testify/suite"
@@ -43,7 +48,9 @@ import (
 	"google.golang.org/grpc"
 	"google.golang.org/grpc/codes"
 	"google.golang.org/grpc/metadata"
+	"google.golang.org/grpc/peer"
 	"google.golang.org/grpc/status"
+	"google.golang.org/protobuf/encoding/protowire"
 	"google.golang.org/protobuf/proto"
 	"google.golang.org/protobuf/types/known/anypb"
 	"google.golang.org/protobuf/types/known/wrapperspb"
@@ -60,8 +67,14 @@ type ServerBasedTests struct {
 }
 
 func (suite *ServerBasedTests) DoSetupSuite(srv flightsql.Server, srvMiddleware []flight.ServerMiddleware, dbArgs map[string]string) {
+	suite.DoSetupSuiteWithService(flightsql.NewFlightServer(srv), srvMiddleware, dbArgs)
+}
+
+// DoSetupSuiteWithService is DoSetupSuite for servers that need to handle
+// Flight RPCs themselves rather than only Flight SQL commands.
+func (suite *ServerBasedTests) DoSetupSuiteWithService(svc flight.FlightServer, srvMiddleware []flight.ServerMiddleware, dbArgs map[string]string) {
 	suite.s = flight.NewServerWithMiddleware(srvMiddleware)
-	suite.s.RegisterFlightService(flightsql.NewFlightServer(srv))
+	suite.s.RegisterFlightService(svc)
 	suite.Require().NoError(suite.s.Init("localhost:0"))
 	suite.s.SetShutdownOnSignals(os.Interrupt, os.Kill)
 	go func() {
@@ -124,6 +137,22 @@ func TestMultiTable(t *testing.T) {
 	suite.Run(t, &MultiTableTests{})
 }
 
+func TestIngest(t *testing.T) {
+	suite.Run(t, &IngestTests{})
+}
+
+func TestResultCache(t *testing.T) {
+	suite.Run(t, &ResultCacheTests{})
+}
+
+func TestIPCCompression(t *testing.T) {
+	suite.Run(t, &IPCCompressionTests{})
+}
+
+func TestReadPartition(t *testing.T) {
+	suite.Run(t, &ReadPartitionTests{})
+}
+
 // ---- AuthN Tests --------------------
 
 type AuthnTestServer struct {
@@ -697,6 +726,8 @@ func (ts *TimeoutTests) TestDontTimeout() {
 }
 
 // ---- Cookie Tests --------------------
+const cookieTestChannels = 3
+
 type CookieTestServer struct {
 	flightsql.BaseServer
 
@@ -722,6 +753,12 @@ func (server *CookieTestServer) GetFlightInfoStatement(ctx context.Context, cmd
 		TotalRecords: -1,
 		TotalBytes:   -1,
 	}
+	// One endpoint per result channel, so that each channel checks the cookies
+	if cmd.GetQuery() == "channels" {
+		for i := 1; i < cookieTestChannels; i++ {
+			info.Endpoint = append(info.Endpoint, &flight.FlightEndpoint{Ticket: &flight.Ticket{Ticket: tkt}})
+		}
+	}
 
 	return info, nil
 }
@@ -811,6 +848,35 @@ func (suite *CookieTests) TestCookieUsage() {
 	defer reader.Release()
 }
 
+func (suite *CookieTests) TestCookieResultChannels() {
+	db := suite.db.(adbc.PostInitOptions)
+	suite.Require().NoError(db.SetOption(driver.OptionResultChannels, fmt.Sprint(cookieTestChannels)))
+	defer func() {
+		suite.Require().NoError(db.SetOption(driver.OptionResultChannels, "1"))
+	}()
+
+	cnxn, err := suite.db.Open(context.Background())
+	suite.Require().NoError(err)
+	defer cnxn.Close()
+
+	stmt, err := cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+
+	// The extra channels must send the cookies set on the connection's client
+	suite.Require().NoError(stmt.SetSqlQuery("channels"))
+	reader, _, err := stmt.ExecuteQuery(context.Background())
+	suite.Require().NoError(err)
+	defer reader.Release()
+
+	rows := int64(0)
+	for reader.Next() {
+		rows += reader.Record().NumRows()
+	}
+	suite.Require().NoError(reader.Err())
+	suite.Equal(int64(cookieTestChannels), rows)
+}
+
 // ---- Data Type Tests --------------------
 type DataTypeTestServer struct {
 	flightsql.BaseServer
@@ -996,3 +1062,851 @@ func (suite *MultiTableTests) TestGetTableSchema() {
 	expectedSchema := arrow.NewSchema([]arrow.Field{{Name: "b", Type: arrow.PrimitiveTypes.Int32, Nullable: true}}, nil)
 	suite.Equal(expectedSchema, actualSchema)
 }
+
+// ---- Bulk Ingest Tests --------------------
+
+type putStream struct {
+	flight.FlightService_DoPutServer
+	first *flight.FlightData
+}
+
+func (s *putStream) Recv() (*flight.FlightData, error) {
+	if s.first != nil {
+		data := s.first
+		s.first = nil
+		return data, nil
+	}
+	return s.FlightService_DoPutServer.Recv()
+}
+
+// IngestTestServer handles DoPut with CommandStatementIngest, recording the
+// command's fields (TableDefinitionOptions, table, schema, catalog, and
+// temporary).
+type IngestTestServer struct {
+	flight.FlightServer
+
+	table     string
+	options   []uint64
+	schema    string
+	catalog   string
+	temporary bool
+}
+
+func (srv *IngestTestServer) DoPut(stream flight.FlightService_DoPutServer) error {
+	first, err := stream.Recv()
+	if err != nil {
+		return err
+	}
+	var cmd anypb.Any
+	if err := proto.Unmarshal(first.GetFlightDescriptor().GetCmd(), &cmd); err != nil {
+		return err
+	}
+	if cmd.GetTypeUrl() != "type.googleapis.com/arrow.flight.protocol.sql.CommandStatementIngest" {
+		return status.Errorf(codes.Unimplemented, "unexpected command %s", cmd.GetTypeUrl())
+	}
+
+	srv.table, srv.options = "", nil
+	srv.schema, srv.catalog, srv.temporary = "", "", false
+	data := cmd.GetValue()
+	for len(data) > 0 {
+		num, typ, n := protowire.ConsumeTag(data)
+		data = data[n:]
+		if num == 1 {
+			options, n := protowire.ConsumeBytes(data)
+			for len(options) > 0 {
+				_, _, m := protowire.ConsumeTag(options)
+				options = options[m:]
+				value, m := protowire.ConsumeVarint(options)
+				options = options[m:]
+				srv.options = append(srv.options, value)
+			}
+			data = data[n:]
+		} else if num == 2 {
+			table, n := protowire.ConsumeString(data)
+			srv.table = table
+			data = data[n:]
+		} else if num == 3 || num == 4 {
+			value, n := protowire.ConsumeString(data)
+			if num == 3 {
+				srv.schema = value
+			} else {
+				srv.catalog = value
+			}
+			data = data[n:]
+		} else if num == 5 {
+			value, n := protowire.ConsumeVarint(data)
+			srv.temporary = protowire.DecodeBool(value)
+			data = data[n:]
+		} else {
+			data = data[protowire.ConsumeFieldValue(num, typ, data):]
+		}
+	}
+
+	if srv.table == "error" {
+		detail := wrapperspb.Int32Value{Value: 42}
+		st, err := status.New(codes.AlreadyExists, "table exists").WithDetails(&detail)
+		if err != nil {
+			return err
+		}
+		return st.Err()
+	}
+
+	rdr, err := flight.NewRecordReader(&putStream{FlightService_DoPutServer: stream, first: first})
+	if err != nil {
+		return err
+	}
+	defer rdr.Release()
+	rows := uint64(0)
+	for rdr.Next() {
+		rows += uint64(rdr.Record().NumRows())
+	}
+
+	var result []byte
+	result = protowire.AppendTag(result, 1, protowire.VarintType)
+	result = protowire.AppendVarint(result, rows)
+	return stream.Send(&flight.PutResult{AppMetadata: result})
+}
+
+type IngestTests struct {
+	ServerBasedTests
+
+	srv *IngestTestServer
+}
+
+func (suite *IngestTests) SetupSuite() {
+	base := &flightsql.BaseServer{}
+	base.Alloc = memory.DefaultAllocator
+	suite.srv = &IngestTestServer{FlightServer: flightsql.NewFlightServer(base)}
+	suite.DoSetupSuiteWithService(suite.srv, nil, nil)
+}
+
+func (suite *IngestTests) makeRecord(values string) arrow.Record {
+	schema := arrow.NewSchema([]arrow.Field{{Name: "ints", Type: arrow.PrimitiveTypes.Int64, Nullable: true}}, nil)
+	rec, _, err := array.RecordFromJSON(memory.DefaultAllocator, schema, strings.NewReader(values))
+	suite.Require().NoError(err)
+	return rec
+}
+
+func (suite *IngestTests) TestBind() {
+	stmt, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+
+	suite.Require().NoError(stmt.SetOption(adbc.OptionKeyIngestTargetTable, "tbl"))
+	suite.Require().NoError(stmt.SetOption(adbc.OptionKeyIngestMode, adbc.OptionValueIngestModeAppend))
+	rec := suite.makeRecord(`[{"ints": 1}, {"ints": null}, {"ints": 3}]`)
+	defer rec.Release()
+	suite.Require().NoError(stmt.Bind(context.Background(), rec))
+
+	n, err := stmt.ExecuteUpdate(context.Background())
+	suite.Require().NoError(err)
+	suite.Equal(int64(3), n)
+	suite.Equal("tbl", suite.srv.table)
+	// TABLE_NOT_EXIST_OPTION_FAIL, TABLE_EXISTS_OPTION_APPEND
+	suite.Equal([]uint64{2, 2}, suite.srv.options)
+	// Unset, so left to the server
+	suite.Equal("", suite.srv.schema)
+	suite.Equal("", suite.srv.catalog)
+	suite.False(suite.srv.temporary)
+
+	// The bound data was released after being sent
+	_, err = stmt.ExecuteUpdate(context.Background())
+	var adbcErr adbc.Error
+	suite.ErrorAs(err, &adbcErr)
+	suite.Equal(adbc.StatusInvalidState, adbcErr.Code)
+}
+
+func (suite *IngestTests) TestBindStream() {
+	stmt, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+
+	suite.Require().NoError(stmt.SetOption(adbc.OptionKeyIngestTargetTable, "tbl"))
+	rec1 := suite.makeRecord(`[{"ints": 1}, {"ints": 2}]`)
+	defer rec1.Release()
+	rec2 := suite.makeRecord(`[{"ints": 3}, {"ints": 4}, {"ints": 5}]`)
+	defer rec2.Release()
+	rdr, err := array.NewRecordReader(rec1.Schema(), []arrow.Record{rec1, rec2})
+	suite.Require().NoError(err)
+	defer rdr.Release()
+	suite.Require().NoError(stmt.BindStream(context.Background(), rdr))
+
+	n, err := stmt.ExecuteUpdate(context.Background())
+	suite.Require().NoError(err)
+	suite.Equal(int64(5), n)
+	// The default mode is create: TABLE_NOT_EXIST_OPTION_CREATE, TABLE_EXISTS_OPTION_FAIL
+	suite.Equal([]uint64{1, 1}, suite.srv.options)
+}
+
+func (suite *IngestTests) TestTarget() {
+	stmt, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+
+	suite.Require().NoError(stmt.SetOption(adbc.OptionKeyIngestTargetTable, "tbl"))
+	suite.Require().NoError(stmt.SetOption(adbc.OptionKeyIngestTargetDBSchema, "sch"))
+	suite.Require().NoError(stmt.SetOption(adbc.OptionKeyIngestTargetCatalog, "cat"))
+	suite.Require().NoError(stmt.SetOption(adbc.OptionKeyIngestTemporary, adbc.OptionValueEnabled))
+	suite.Error(stmt.SetOption(adbc.OptionKeyIngestTemporary, "maybe"))
+
+	getter := stmt.(adbc.GetSetOptions)
+	for key, expected := range map[string]string{
+		adbc.OptionKeyIngestTargetDBSchema: "sch",
+		adbc.OptionKeyIngestTargetCatalog:  "cat",
+		adbc.OptionKeyIngestTemporary:      adbc.OptionValueEnabled,
+	} {
+		val, err := getter.GetOption(key)
+		suite.Require().NoError(err)
+		suite.Equal(expected, val, key)
+	}
+
+	rec := suite.makeRecord(`[{"ints": 1}]`)
+	defer rec.Release()
+	suite.Require().NoError(stmt.Bind(context.Background(), rec))
+	_, err = stmt.ExecuteUpdate(context.Background())
+	suite.Require().NoError(err)
+	suite.Equal("tbl", suite.srv.table)
+	suite.Equal("sch", suite.srv.schema)
+	suite.Equal("cat", suite.srv.catalog)
+	suite.True(suite.srv.temporary)
+}
+
+func (suite *IngestTests) TestErrors() {
+	stmt, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+
+	suite.Require().NoError(stmt.SetOption(adbc.OptionKeyIngestTargetTable, "error"))
+	_, err = stmt.ExecuteUpdate(context.Background())
+	var adbcErr adbc.Error
+	suite.ErrorAs(err, &adbcErr)
+	suite.Equal(adbc.StatusInvalidState, adbcErr.Code)
+
+	suite.Error(stmt.SetOption(adbc.OptionKeyIngestMode, "adbc.ingest.mode.upsert"))
+
+	rec := suite.makeRecord(`[{"ints": 1}]`)
+	defer rec.Release()
+	suite.Require().NoError(stmt.Bind(context.Background(), rec))
+	_, err = stmt.ExecuteUpdate(context.Background())
+	suite.ErrorAs(err, &adbcErr)
+	suite.Equal(adbc.StatusAlreadyExists, adbcErr.Code)
+	suite.Contains(adbcErr.Msg, "table exists")
+	suite.Equal(1, len(adbcErr.Details))
+}
+
+// ---- Result Cache Tests --------------------
+
+// ResultCacheTestServer answers every query with the number of times
+// GetFlightInfo has been called so far.
+type ResultCacheTestServer struct {
+	flightsql.BaseServer
+
+	infoCalls int64
+}
+
+func (srv *ResultCacheTestServer) GetFlightInfoStatement(ctx context.Context, cmd flightsql.StatementQuery, desc *flight.FlightDescriptor) (*flight.FlightInfo, error) {
+	calls := atomic.AddInt64(&srv.infoCalls, 1)
+	tkt, _ := flightsql.CreateStatementQueryTicket([]byte(fmt.Sprint(calls)))
+	return &flight.FlightInfo{
+		FlightDescriptor: desc,
+		Endpoint:         []*flight.FlightEndpoint{{Ticket: &flight.Ticket{Ticket: tkt}}},
+		TotalRecords:     -1,
+		TotalBytes:       -1,
+	}, nil
+}
+
+func (srv *ResultCacheTestServer) DoGetStatement(ctx context.Context, tkt flightsql.StatementQueryTicket) (*arrow.Schema, <-chan flight.StreamChunk, error) {
+	schema := arrow.NewSchema([]arrow.Field{{Name: "calls", Type: arrow.PrimitiveTypes.Int64}}, nil)
+	rec, _, err := array.RecordFromJSON(memory.DefaultAllocator, schema, strings.NewReader(`[{"calls": `+string(tkt.GetStatementHandle())+`}]`))
+	if err != nil {
+		return nil, nil, err
+	}
+
+	ch := make(chan flight.StreamChunk, 1)
+	ch <- flight.StreamChunk{Data: rec}
+	close(ch)
+	return schema, ch, nil
+}
+
+func (srv *ResultCacheTestServer) DoPutCommandStatementUpdate(ctx context.Context, cmd flightsql.StatementUpdate) (int64, error) {
+	return 1, nil
+}
+
+type ResultCacheTests struct {
+	ServerBasedTests
+
+	srv *ResultCacheTestServer
+}
+
+func (suite *ResultCacheTests) SetupSuite() {
+	suite.srv = &ResultCacheTestServer{}
+	suite.srv.Alloc = memory.DefaultAllocator
+	suite.DoSetupSuite(suite.srv, nil, map[string]string{
+		driver.OptionResultCacheMaxBytes: "1048576",
+	})
+}
+
+// query returns the value the server answered query with.
+func (suite *ResultCacheTests) query(query string, options map[string]string) int64 {
+	stmt, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+	for k, v := range options {
+		suite.Require().NoError(stmt.SetOption(k, v))
+	}
+
+	suite.Require().NoError(stmt.SetSqlQuery(query))
+	rdr, _, err := stmt.ExecuteQuery(context.Background())
+	suite.Require().NoError(err)
+	defer rdr.Release()
+
+	suite.Require().True(rdr.Next())
+	calls := rdr.Record().Column(0).(*array.Int64).Value(0)
+	suite.False(rdr.Next())
+	suite.Require().NoError(rdr.Err())
+	return calls
+}
+
+func (suite *ResultCacheTests) TestCached() {
+	first := suite.query("SELECT 1", nil)
+	// Leading and trailing whitespace doesn't matter
+	suite.Equal(first, suite.query("  SELECT 1\n", nil))
+	suite.NotEqual(first, suite.query("SELECT ' 1'", nil))
+	suite.Equal(first, suite.query("SELECT 1", nil))
+
+	bypass := map[string]string{driver.OptionStatementResultCacheBypass: adbc.OptionValueEnabled}
+	suite.NotEqual(first, suite.query("SELECT 1", bypass))
+	// Call headers may change the result
+	headers := map[string]string{driver.OptionRPCCallHeaderPrefix + "x-user": "someone"}
+	suite.NotEqual(first, suite.query("SELECT 1", headers))
+}
+
+func (suite *ResultCacheTests) TestDistinctKeys() {
+	// Queries that differ only in whitespace may still differ in meaning
+	for _, queries := range [][2]string{
+		// The newline ends the comment
+		{"SELECT a -- c\nFROM t", "SELECT a -- c FROM t"},
+		// A backslash-escaped quote doesn't end the string (e.g. MySQL)
+		{`SELECT 'a\'  b'`, `SELECT 'a\' b'`},
+		// An apostrophe in a comment doesn't start a string
+		{"SELECT 1 /* it's */, '  x'", "SELECT 1 /* it's */, ' x'"},
+		{"SELECT 1 -- it's\n, '  x'", "SELECT 1 -- it's\n, ' x'"},
+		{"SELECT $$a  b$$", "SELECT $$a b$$"},
+		{"SELECT\n1", "SELECT 1"},
+	} {
+		first := suite.query(queries[0], nil)
+		suite.Equal(first, suite.query(queries[0], nil), queries[0])
+		suite.NotEqual(first, suite.query(queries[1], nil), queries[1])
+	}
+}
+
+func (suite *ResultCacheTests) TestReadQueriesOnly() {
+	for _, query := range []string{
+		"select 5",
+		"/* comment */ (SELECT 6)",
+		"-- comment\nWITH t AS (SELECT 7) SELECT * FROM t",
+		"VALUES (8)",
+	} {
+		first := suite.query(query, nil)
+		suite.Equal(first, suite.query(query, nil), query)
+	}
+
+	for _, query := range []string{
+		"SHOW TABLES",
+		"INSERT INTO t VALUES (1) RETURNING *",
+		"SELECTED",
+	} {
+		first := suite.query(query, nil)
+		suite.NotEqual(first, suite.query(query, nil), query)
+	}
+}
+
+func (suite *ResultCacheTests) TestInvalidation() {
+	first := suite.query("SELECT 9", nil)
+	suite.Equal(first, suite.query("SELECT 9", nil))
+
+	// Queries that may change data empty the cache
+	suite.query("DELETE FROM t RETURNING *", nil)
+	second := suite.query("SELECT 9", nil)
+	suite.NotEqual(first, second)
+	suite.Equal(second, suite.query("SELECT 9", nil))
+
+	// As do updates
+	stmt, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+	suite.Require().NoError(stmt.SetSqlQuery("UPDATE t SET x = 1"))
+	_, err = stmt.ExecuteUpdate(context.Background())
+	suite.Require().NoError(err)
+	suite.NotEqual(second, suite.query("SELECT 9", nil))
+
+	// A result read across an invalidation is not cached
+	reading, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer reading.Close()
+	suite.Require().NoError(reading.SetSqlQuery("SELECT 10"))
+	rdr, _, err := reading.ExecuteQuery(context.Background())
+	suite.Require().NoError(err)
+	_, err = stmt.ExecuteUpdate(context.Background())
+	suite.Require().NoError(err)
+	for rdr.Next() {
+	}
+	suite.Require().NoError(rdr.Err())
+	rdr.Release()
+	calls := atomic.LoadInt64(&suite.srv.infoCalls)
+	suite.Equal(calls+1, suite.query("SELECT 10", nil))
+}
+
+func (suite *ResultCacheTests) TestPartialRead() {
+	stmt, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+	suite.Require().NoError(stmt.SetSqlQuery("SELECT 2"))
+	rdr, _, err := stmt.ExecuteQuery(context.Background())
+	suite.Require().NoError(err)
+	// Released before reaching the end, so not cached
+	rdr.Release()
+
+	calls := atomic.LoadInt64(&suite.srv.infoCalls)
+	suite.Equal(calls+1, suite.query("SELECT 2", nil))
+}
+
+func (suite *ResultCacheTests) TestExpiry() {
+	db := suite.db.(adbc.PostInitOptions)
+	suite.Require().NoError(db.SetOption(driver.OptionResultCacheTTL, "0.05"))
+	defer func() {
+		suite.Require().NoError(db.SetOption(driver.OptionResultCacheTTL, "60"))
+	}()
+
+	first := suite.query("SELECT 3", nil)
+	suite.Equal(first, suite.query("SELECT 3", nil))
+	time.Sleep(100 * time.Millisecond)
+	suite.NotEqual(first, suite.query("SELECT 3", nil))
+}
+
+func (suite *ResultCacheTests) TestSpill() {
+	dir := suite.T().TempDir()
+	db := suite.db.(adbc.PostInitOptions)
+	suite.Require().NoError(db.SetOption(driver.OptionResultCacheSpillDirectory, dir))
+	defer func() {
+		suite.Require().NoError(db.SetOption(driver.OptionResultCacheSpillDirectory, ""))
+	}()
+
+	first := suite.query("SELECT 4", nil)
+	files, err := os.ReadDir(dir)
+	suite.Require().NoError(err)
+	suite.Len(files, 1)
+	suite.Equal(first, suite.query("SELECT 4", nil))
+
+	suite.Error(db.SetOption(driver.OptionResultCacheSpillDirectory, dir+"/nonexistent"))
+}
+
+// ---- IPC Compression Tests --------------------
+
+const compressionTestRows = 100000
+
+// IPCCompressionQueryServer plans every query as a single endpoint.
+type IPCCompressionQueryServer struct {
+	flightsql.BaseServer
+}
+
+func (srv *IPCCompressionQueryServer) GetFlightInfoStatement(ctx context.Context, cmd flightsql.StatementQuery, desc *flight.FlightDescriptor) (*flight.FlightInfo, error) {
+	tkt, _ := flightsql.CreateStatementQueryTicket([]byte(cmd.GetQuery()))
+	return &flight.FlightInfo{
+		FlightDescriptor: desc,
+		Endpoint:         []*flight.FlightEndpoint{{Ticket: &flight.Ticket{Ticket: tkt}}},
+		TotalRecords:     -1,
+		TotalBytes:       -1,
+	}, nil
+}
+
+// IPCCompressionTestServer answers every DoGet with a compressible batch,
+// compressed with the codec the client asks for, and records the size of
+// the message bodies it receives on DoPut.
+type IPCCompressionTestServer struct {
+	flight.FlightServer
+
+	mu        sync.Mutex
+	requested string
+	putBytes  int64
+}
+
+func (srv *IPCCompressionTestServer) lastRequested() string {
+	srv.mu.Lock()
+	defer srv.mu.Unlock()
+	return srv.requested
+}
+
+func (srv *IPCCompressionTestServer) lastPutBytes() int64 {
+	srv.mu.Lock()
+	defer srv.mu.Unlock()
+	return srv.putBytes
+}
+
+func compressionTestRecord() arrow.Record {
+	schema := arrow.NewSchema([]arrow.Field{
+		{Name: "a", Type: arrow.PrimitiveTypes.Int64, Nullable: true},
+		{Name: "b", Type: arrow.PrimitiveTypes.Int64, Nullable: true},
+		{Name: "c", Type: arrow.PrimitiveTypes.Int64, Nullable: true},
+	}, nil)
+	bldr := array.NewRecordBuilder(memory.DefaultAllocator, schema)
+	defer bldr.Release()
+	for i := 0; i < compressionTestRows; i++ {
+		bldr.Field(0).(*array.Int64Builder).Append(int64(i % 10))
+		bldr.Field(1).(*array.Int64Builder).Append(int64(i % 100))
+		if i%7 == 0 {
+			bldr.Field(2).AppendNull()
+		} else {
+			bldr.Field(2).(*array.Int64Builder).Append(int64(i))
+		}
+	}
+	return bldr.NewRecord()
+}
+
+func (srv *IPCCompressionTestServer) DoGet(tkt *flight.Ticket, stream flight.FlightService_DoGetServer) error {
+	requested := ""
+	if md, ok := metadata.FromIncomingContext(stream.Context()); ok {
+		if values := md.Get(driver.IPCCompressionHeader); len(values) > 0 {
+			requested = values[0]
+		}
+	}
+	srv.mu.Lock()
+	srv.requested = requested
+	srv.mu.Unlock()
+
+	var opts []ipc.Option
+	switch requested {
+	case driver.OptionValueIPCCompressionLZ4Frame:
+		opts = append(opts, ipc.WithLZ4())
+	case driver.OptionValueIPCCompressionZstd:
+		opts = append(opts, ipc.WithZstd())
+	}
+
+	rec := compressionTestRecord()
+	defer rec.Release()
+	wr := flight.NewRecordWriter(stream, append(opts, ipc.WithSchema(rec.Schema()))...)
+	defer wr.Close()
+	return wr.Write(rec)
+}
+
+func (srv *IPCCompressionTestServer) DoPut(stream flight.FlightService_DoPutServer) error {
+	counter := &countingPutStream{FlightService_DoPutServer: stream}
+	rdr, err := flight.NewRecordReader(counter)
+	if err != nil {
+		return err
+	}
+	defer rdr.Release()
+	rows := int64(0)
+	for rdr.Next() {
+		rows += rdr.Record().NumRows()
+	}
+	if err := rdr.Err(); err != nil {
+		return err
+	}
+
+	srv.mu.Lock()
+	srv.putBytes = counter.bytes
+	srv.mu.Unlock()
+	var result []byte
+	result = protowire.AppendTag(result, 1, protowire.VarintType)
+	result = protowire.AppendVarint(result, uint64(rows))
+	return stream.Send(&flight.PutResult{AppMetadata: result})
+}
+
+// countingPutStream adds up the sizes of the message bodies received.
+type countingPutStream struct {
+	flight.FlightService_DoPutServer
+	bytes int64
+}
+
+func (s *countingPutStream) Recv() (*flight.FlightData, error) {
+	data, err := s.FlightService_DoPutServer.Recv()
+	if err == nil {
+		s.bytes += int64(len(data.DataBody))
+	}
+	return data, err
+}
+
+type IPCCompressionTests struct {
+	ServerBasedTests
+
+	srv *IPCCompressionTestServer
+}
+
+func (suite *IPCCompressionTests) SetupSuite() {
+	base := &IPCCompressionQueryServer{}
+	base.Alloc = memory.DefaultAllocator
+	suite.srv = &IPCCompressionTestServer{FlightServer: flightsql.NewFlightServer(base)}
+	suite.DoSetupSuiteWithService(suite.srv, nil, nil)
+}
+
+func (suite *IPCCompressionTests) SetupTest() {
+	suite.ServerBasedTests.SetupTest()
+	suite.setOption(driver.OptionIPCCompression, driver.OptionValueIPCCompressionNone)
+	suite.setOption(driver.OptionAllocateMessageBodies, adbc.OptionValueDisabled)
+}
+
+func (suite *IPCCompressionTests) setOption(key, value string) {
+	suite.Require().NoError(suite.db.(adbc.PostInitOptions).SetOption(key, value))
+}
+
+// fetch runs a query and checks that the server's batch arrived intact.
+func (suite *IPCCompressionTests) fetch() {
+	stmt, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+	suite.Require().NoError(stmt.SetSqlQuery("SELECT * FROM compressible"))
+	rdr, _, err := stmt.ExecuteQuery(context.Background())
+	suite.Require().NoError(err)
+	defer rdr.Release()
+
+	expected := compressionTestRecord()
+	defer expected.Release()
+	suite.Require().True(rdr.Next())
+	suite.Truef(array.RecordEqual(expected, rdr.Record()), "expected: %s\ngot: %s", expected, rdr.Record())
+	suite.False(rdr.Next())
+	suite.Require().NoError(rdr.Err())
+}
+
+func (suite *IPCCompressionTests) TestDoGet() {
+	suite.fetch()
+	suite.Equal("", suite.srv.lastRequested())
+
+	for _, codec := range []string{driver.OptionValueIPCCompressionLZ4Frame, driver.OptionValueIPCCompressionZstd} {
+		suite.setOption(driver.OptionIPCCompression, codec)
+		suite.fetch()
+		suite.Equal(codec, suite.srv.lastRequested())
+
+		suite.setOption(driver.OptionAllocateMessageBodies, adbc.OptionValueEnabled)
+		suite.fetch()
+		suite.setOption(driver.OptionAllocateMessageBodies, adbc.OptionValueDisabled)
+	}
+}
+
+func (suite *IPCCompressionTests) ingest() {
+	stmt, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+	suite.Require().NoError(stmt.SetOption(adbc.OptionKeyIngestTargetTable, "tbl"))
+	rec := compressionTestRecord()
+	defer rec.Release()
+	suite.Require().NoError(stmt.Bind(context.Background(), rec))
+
+	n, err := stmt.ExecuteUpdate(context.Background())
+	suite.Require().NoError(err)
+	suite.Equal(int64(compressionTestRows), n)
+}
+
+func (suite *IPCCompressionTests) TestDoPut() {
+	suite.ingest()
+	uncompressed := suite.srv.lastPutBytes()
+	// Three columns of int64, plus a validity bitmap
+	suite.GreaterOrEqual(uncompressed, int64(3*8*compressionTestRows))
+
+	for _, codec := range []string{driver.OptionValueIPCCompressionLZ4Frame, driver.OptionValueIPCCompressionZstd} {
+		suite.setOption(driver.OptionIPCCompression, codec)
+		suite.ingest()
+		suite.Less(suite.srv.lastPutBytes(), uncompressed/2, codec)
+	}
+}
+
+func (suite *IPCCompressionTests) TestInvalid() {
+	db := suite.db.(adbc.PostInitOptions)
+	suite.Error(db.SetOption(driver.OptionIPCCompression, "snappy"))
+	val, err := suite.db.(adbc.GetSetOptions).GetOption(driver.OptionIPCCompression)
+	suite.Require().NoError(err)
+	suite.Equal(driver.OptionValueIPCCompressionNone, val)
+}
+
+// ---- Partition Tests --------------------
+
+const partitionTestEndpoints = 4
+
+// PartitionTestServer plans every query as several endpoints, each
+// returning its index, and records which connections the DoGets arrive on.
+type PartitionTestServer struct {
+	flightsql.BaseServer
+
+	mu    sync.Mutex
+	peers map[string]bool
+}
+
+func (srv *PartitionTestServer) GetFlightInfoStatement(ctx context.Context, cmd flightsql.StatementQuery, desc *flight.FlightDescriptor) (*flight.FlightInfo, error) {
+	info := &flight.FlightInfo{
+		FlightDescriptor: desc,
+		TotalRecords:     -1,
+		TotalBytes:       -1,
+	}
+	for i := 0; i < partitionTestEndpoints; i++ {
+		tkt, _ := flightsql.CreateStatementQueryTicket([]byte(fmt.Sprint(i)))
+		info.Endpoint = append(info.Endpoint, &flight.FlightEndpoint{Ticket: &flight.Ticket{Ticket: tkt}})
+	}
+	return info, nil
+}
+
+func (srv *PartitionTestServer) DoGetStatement(ctx context.Context, tkt flightsql.StatementQueryTicket) (*arrow.Schema, <-chan flight.StreamChunk, error) {
+	if p, ok := peer.FromContext(ctx); ok {
+		srv.mu.Lock()
+		srv.peers[p.Addr.String()] = true
+		srv.mu.Unlock()
+	}
+
+	schema := arrow.NewSchema([]arrow.Field{{Name: "endpoint", Type: arrow.PrimitiveTypes.Int64}}, nil)
+	rec, _, err := array.RecordFromJSON(memory.DefaultAllocator, schema, strings.NewReader(`[{"endpoint": `+string(tkt.GetStatementHandle())+`}]`))
+	if err != nil {
+		return nil, nil, err
+	}
+
+	ch := make(chan flight.StreamChunk, 1)
+	ch <- flight.StreamChunk{Data: rec}
+	close(ch)
+	return schema, ch, nil
+}
+
+func (srv *PartitionTestServer) resetPeers() {
+	srv.mu.Lock()
+	defer srv.mu.Unlock()
+	srv.peers = make(map[string]bool)
+}
+
+func (srv *PartitionTestServer) numPeers() int {
+	srv.mu.Lock()
+	defer srv.mu.Unlock()
+	return len(srv.peers)
+}
+
+type ReadPartitionTests struct {
+	ServerBasedTests
+
+	srv *PartitionTestServer
+}
+
+func (suite *ReadPartitionTests) SetupSuite() {
+	suite.srv = &PartitionTestServer{peers: make(map[string]bool)}
+	suite.srv.Alloc = memory.DefaultAllocator
+	suite.DoSetupSuite(suite.srv, nil, nil)
+}
+
+func (suite *ReadPartitionTests) partitions() adbc.Partitions {
+	stmt, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+	suite.Require().NoError(stmt.SetSqlQuery("SELECT endpoint"))
+	_, partitions, _, err := stmt.ExecutePartitions(context.Background())
+	suite.Require().NoError(err)
+	suite.Require().Equal(uint64(partitionTestEndpoints), partitions.NumPartitions)
+	return partitions
+}
+
+// read returns the values read from a (possibly merged) partition.
+func (suite *ReadPartitionTests) read(cnxn adbc.Connection, partition []byte) []int64 {
+	rdr, err := cnxn.ReadPartition(context.Background(), partition)
+	suite.Require().NoError(err)
+	defer rdr.Release()
+
+	values := []int64{}
+	for rdr.Next() {
+		values = append(values, rdr.Record().Column(0).(*array.Int64).Int64Values()...)
+	}
+	suite.Require().NoError(rdr.Err())
+	return values
+}
+
+func (suite *ReadPartitionTests) TestReadOne() {
+	partitions := suite.partitions()
+	for i, partition := range partitions.PartitionIDs {
+		suite.Equal([]int64{int64(i)}, suite.read(suite.cnxn, partition))
+	}
+}
+
+func (suite *ReadPartitionTests) TestReadMerged() {
+	partitions := suite.partitions()
+	// Concatenated partitions are read as one
+	merged := bytes.Join(partitions.PartitionIDs[1:], nil)
+	suite.Equal([]int64{1, 2, 3}, suite.read(suite.cnxn, merged))
+
+	// MergePartitions produces the same partition, in the given order
+	helper, err := driver.MergePartitions(partitions.PartitionIDs[3], partitions.PartitionIDs[0])
+	suite.Require().NoError(err)
+	suite.Equal([]int64{3, 0}, suite.read(suite.cnxn, helper))
+
+	_, err = suite.cnxn.ReadPartition(context.Background(), []byte{})
+	var adbcErr adbc.Error
+	suite.ErrorAs(err, &adbcErr)
+	suite.Equal(adbc.StatusInvalidArgument, adbcErr.Code)
+
+	otherSchema, err := proto.Marshal(&flight.FlightInfo{
+		Schema:   []byte("other"),
+		Endpoint: []*flight.FlightEndpoint{{Ticket: &flight.Ticket{Ticket: []byte("x")}}},
+	})
+	suite.Require().NoError(err)
+	for _, invalid := range [][][]byte{
+		nil,
+		{partitions.PartitionIDs[0], {}},
+		{partitions.PartitionIDs[0], []byte("\xff")},
+		{partitions.PartitionIDs[0], otherSchema},
+	} {
+		_, err = driver.MergePartitions(invalid...)
+		suite.ErrorAs(err, &adbcErr)
+		suite.Equal(adbc.StatusInvalidArgument, adbcErr.Code)
+	}
+}
+
+func (suite *ReadPartitionTests) TestResultChannels() {
+	db := suite.db.(adbc.PostInitOptions)
+	suite.Require().NoError(db.SetOption(driver.OptionResultChannels, "3"))
+	defer func() {
+		suite.Require().NoError(db.SetOption(driver.OptionResultChannels, "0"))
+	}()
+	suite.Error(db.SetOption(driver.OptionResultChannels, "-1"))
+
+	cnxn, err := suite.db.Open(context.Background())
+	suite.Require().NoError(err)
+	defer cnxn.Close()
+
+	stmt, err := cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+	suite.Require().NoError(stmt.SetSqlQuery("SELECT endpoint"))
+	_, partitions, _, err := stmt.ExecutePartitions(context.Background())
+	suite.Require().NoError(err)
+
+	// Four endpoints are spread over the three channels
+	suite.srv.resetPeers()
+	suite.Equal([]int64{0, 1, 2, 3}, suite.read(cnxn, bytes.Join(partitions.PartitionIDs, nil)))
+	suite.Equal(3, suite.srv.numPeers())
+}
+
+func (suite *ReadPartitionTests) TestResultStats() {
+	stmt, err := suite.cnxn.NewStatement()
+	suite.Require().NoError(err)
+	defer stmt.Close()
+
+	getStats := func() []map[string]interface{} {
+		val, err := stmt.(adbc.GetSetOptions).GetOption(driver.OptionStatementResultStats)
+		suite.Require().NoError(err)
+		var stats []map[string]interface{}
+		suite.Require().NoError(json.Unmarshal([]byte(val), &stats))
+		return stats
+	}
+	suite.Empty(getStats())
+
+	suite.Require().NoError(stmt.SetSqlQuery("SELECT endpoint"))
+	rdr, _, err := stmt.ExecuteQuery(context.Background())
+	suite.Require().NoError(err)
+	for rdr.Next() {
+	}
+	suite.Require().NoError(rdr.Err())
+	rdr.Release()
+
+	stats := getStats()
+	suite.Require().Len(stats, partitionTestEndpoints)
+	for i, endpoint := range stats {
+		suite.Equal(float64(i), endpoint["endpoint"])
+		suite.Equal(float64(1), endpoint["batches"])
+		suite.Equal(float64(1), endpoint["rows"])
+		suite.Greater(endpoint["bytes"], float64(0))
+		suite.Greater(endpoint["seconds"], float64(0))
+		suite.NotContains(endpoint, "error")
+	}
+}
@@ -24,6 +24,7 @@ import (
 	"io"
 	"math"
 	"strings"
+	"sync"
 
 	"github.com/apache/arrow-adbc/go/adbc"
 	"github.com/apache/arrow-adbc/go/adbc/driver/internal"
@@ -50,6 +51,14 @@ type cnxn struct {
 	timeouts    timeoutOption
 	txn         *flightsql.Txn
 	supportInfo support
+
+	// Extra clients for fetching results (see resultChannels)
+	numChannels int
+	channelsMu  sync.Mutex
+	channels    []*flightsql.Client
+	// The cookie middleware of cl, shared with the extra clients so that
+	// they present the same session to the server (nil if disabled)
+	cookies *flight.ClientMiddleware
 }
 
 var adbcToFlightSQLInfo = map[adbc.InfoCode]flightsql.SqlInfo{
@@ -58,9 +67,46 @@ var adbcToFlightSQLInfo = map[adbc.InfoCode]flightsql.SqlInfo{
 	adbc.InfoVendorArrowVersion: flightsql.SqlInfoFlightSqlServerArrowVersion,
 }
 
-func doGet(ctx context.Context, cl *flightsql.Client, endpoint *flight.FlightEndpoint, clientCache gcache.Cache, opts ...grpc.CallOption) (rdr *flight.Reader, err error) {
+// readerOptions are used for metadata results: the default queue size,
+// with the database's limits.
+func (c *cnxn) readerOptions() recordReaderOptions {
+	return recordReaderOptions{
+		queueSize:  5,
+		queueBytes: c.db.queueBytes,
+		maxStreams: c.db.maxStreams,
+		logger:     c.db.Logger,
+		stream:     c.db.streamOptions(),
+	}
+}
+
+// resultChannels returns the clients that endpoints without a location
+// are fetched over, or nil to use only the connection's client. The
+// extra clients asked for with OptionResultChannels are dialed on first
+// use. Each client has its own HTTP/2 connection, so concurrent DoGets
+// are not all limited by the flow control of a single connection. They
+// share the connection's cookie jar, so cookies set on any of them (such
+// as a session) are sent on all of them.
+func (c *cnxn) resultChannels(ctx context.Context) ([]*flightsql.Client, error) {
+	if c.numChannels <= 1 {
+		return nil, nil
+	}
+
+	c.channelsMu.Lock()
+	defer c.channelsMu.Unlock()
+	for len(c.channels) < c.numChannels-1 {
+		cl, err := getFlightClient(ctx, c.db.uri.String(), c.db, c.cookies)
+		if err != nil {
+			return nil, err
+		}
+		c.channels = append(c.channels, cl)
+	}
+	return append([]*flightsql.Client{c.cl}, c.channels...), nil
+}
+
+// doGet fetches an endpoint; see doGetTicket for stream.
+func doGet(ctx context.Context, cl *flightsql.Client, endpoint *flight.FlightEndpoint, clientCache gcache.Cache, stream streamOptions, opts ...grpc.CallOption) (rdr streamReader, err error) {
 	if len(endpoint.Location) == 0 {
-		return cl.DoGet(ctx, endpoint.Ticket, opts...)
+		return doGetTicket(ctx, cl, endpoint.Ticket, stream, opts...)
 	}
 
 	var (
@@ -74,7 +120,7 @@ func doGet(ctx context.Context, cl *flightsql.Client, endpoint *flight.FlightEnd
 		}
 
 		conn := cc.(*flightsql.Client)
-		rdr, err = conn.DoGet(ctx, endpoint.Ticket, opts...)
+		rdr, err = doGetTicket(ctx, conn, endpoint.Ticket, stream, opts...)
 		if err != nil {
 			continue
 		}
@@ -215,6 +261,8 @@ func (c *cnxn) SetOption(key, value string) error {
 		ctx := metadata.NewOutgoingContext(context.Background(), c.hdrs)
 		var err error
 		if c.txn != nil {
+			// Committed changes may make cached results stale
+			defer c.db.results.invalidate()
 			if err = c.txn.Commit(ctx, c.timeouts); err != nil {
 				return adbc.Error{
 					Msg:  "[Flight SQL] failed to update autocommit: " + err.Error(),
@@ -353,7 +401,7 @@ func (c *cnxn) GetInfo(ctx context.Context, infoCodes []adbc.InfoCode) (array.Re
 	if err == nil {
 		for i, endpoint := range info.Endpoint {
 			var header, trailer metadata.MD
-			rdr, err := doGet(ctx, c.cl, endpoint, c.clientCache, grpc.Header(&header), grpc.Trailer(&trailer), c.timeouts)
+			rdr, err := doGet(ctx, c.cl, endpoint, c.clientCache, c.db.streamOptions(), grpc.Header(&header), grpc.Trailer(&trailer), c.timeouts)
 			if err != nil {
 				return nil, adbcFromFlightStatusWithDetails(err, header, trailer, "GetInfo(DoGet): endpoint %d: %s", i, endpoint.Location)
 			}
@@ -530,8 +578,7 @@ func (c *cnxn) GetObjects(ctx context.Context, depth adbc.ObjectDepth, catalog *
 
 // Helper function to read and validate a metadata stream
 func (c *cnxn) readInfo(ctx context.Context, expectedSchema *arrow.Schema, info *flight.FlightInfo, opts ...grpc.CallOption) (array.RecordReader, error) {
-	// use a default queueSize for the reader
-	rdr, err := newRecordReader(ctx, c.db.Alloc, c.cl, info, c.clientCache, 5, opts...)
+	rdr, err := newRecordReader(ctx, c.db.Alloc, c.cl, info, c.clientCache, c.readerOptions(), opts...)
 	if err != nil {
 		return nil, adbcFromFlightStatus(err, "DoGet")
 	}
@@ -685,7 +732,7 @@ func (c *cnxn) GetTableSchema(ctx context.Context, catalog *string, dbSchema *st
 
 	header = metadata.MD{}
 	trailer = metadata.MD{}
-	rdr, err := doGet(ctx, c.cl, info.Endpoint[0], c.clientCache, c.timeouts, grpc.Header(&header), grpc.Trailer(&trailer))
+	rdr, err := doGet(ctx, c.cl, info.Endpoint[0], c.clientCache, c.db.streamOptions(), c.timeouts, grpc.Header(&header), grpc.Trailer(&trailer))
 	if err != nil {
 		return nil, adbcFromFlightStatusWithDetails(err, header, trailer, "GetTableSchema(DoGet)")
 	}
@@ -755,7 +802,7 @@ func (c *cnxn) GetTableTypes(ctx context.Context) (array.RecordReader, error) {
 		return nil, adbcFromFlightStatusWithDetails(err, header, trailer, "GetTableTypes")
 	}
 
-	return newRecordReader(ctx, c.db.Alloc, c.cl, info, c.clientCache, 5)
+	return newRecordReader(ctx, c.db.Alloc, c.cl, info, c.clientCache, c.readerOptions())
 }
 
 // Commit commits any pending transactions on this connection, it should
@@ -776,6 +823,9 @@ func (c *cnxn) Commit(ctx context.Context) error {
 		return errNoTransactionSupport
 	}
 
+	// Committed changes may make cached results stale
+	defer c.db.results.invalidate()
+
 	ctx = metadata.NewOutgoingContext(ctx, c.hdrs)
 	var header, trailer metadata.MD
 	err := c.txn.Commit(ctx, c.timeouts, grpc.Header(&header), grpc.Trailer(&trailer))
@@ -833,6 +883,8 @@ func (c *cnxn) NewStatement() (adbc.Statement, error) {
 		clientCache: c.clientCache,
 		hdrs:        c.hdrs.Copy(),
 		queueSize:   5,
+		queueBytes:  c.db.queueBytes,
+		maxStreams:  c.db.maxStreams,
 		timeouts:    c.timeouts,
 		cnxn:        c,
 	}, nil
@@ -913,6 +965,13 @@ func (c *cnxn) Close() error {
 
 	err := c.cl.Close()
 	c.cl = nil
+	c.channelsMu.Lock()
+	for _, cl := range c.channels {
+		cl.Close()
+	}
+	c.channels = nil
+	c.channelsMu.Unlock()
+	c.db.results.closeConnection()
 	return adbcFromFlightStatus(err, "Close")
 }
 
@@ -920,6 +979,17 @@ func (c *cnxn) Close() error {
 // results can then be read independently using the returned RecordReader.
 //
 // A partition can be retrieved by using ExecutePartitions on a statement.
+//
+// Partitions are serialized FlightInfo messages, each with one endpoint.
+// ReadPartition also accepts several partitions of the same result set
+// concatenated together (see MergePartitions): protobuf parses
+// concatenated messages as one, appending repeated fields, so the
+// FlightInfo has the endpoints of all of them in order, while its other
+// fields (schema, descriptor, totals) are those of the last partition.
+// The endpoints are fetched concurrently, as ExecuteQuery does (subject
+// to the database's result options), and returned as a single stream.
+// This gives C and Python callers a distributed scan without managing
+// threads themselves.
 func (c *cnxn) ReadPartition(ctx context.Context, serializedPartition []byte) (rdr array.RecordReader, err error) {
 	var info flight.FlightInfo
 	if err := proto.Unmarshal(serializedPartition, &info); err != nil {
@@ -929,22 +999,71 @@ func (c *cnxn) ReadPartition(ctx context.Context, serializedPartition []byte) (r
 		}
 	}
 
-	// The driver only ever returns one endpoint.
-	if len(info.Endpoint) != 1 {
+	// The driver only ever returns one endpoint per partition.
+	if len(info.Endpoint) == 0 {
 		return nil, adbc.Error{
-			Msg:  fmt.Sprintf("Invalid partition: expected 1 endpoint, got %d", len(info.Endpoint)),
+			Msg:  "Invalid partition: expected at least 1 endpoint, got 0",
 			Code: adbc.StatusInvalidArgument,
 		}
 	}
 
 	ctx = metadata.NewOutgoingContext(ctx, c.hdrs)
-	rdr, err = doGet(ctx, c.cl, info.Endpoint[0], c.clientCache, c.timeouts)
+	if len(info.Endpoint) > 1 {
+		options := c.readerOptions()
+		if options.channels, err = c.resultChannels(ctx); err != nil {
+			return nil, err
+		}
+		return newRecordReader(ctx, c.db.Alloc, c.cl, &info, c.clientCache, options, c.timeouts)
+	}
+
+	rdr, err = doGet(ctx, c.cl, info.Endpoint[0], c.clientCache, c.db.streamOptions(), c.timeouts)
 	if err != nil {
 		return nil, adbcFromFlightStatus(err, "ReadPartition(DoGet)")
 	}
 	return rdr, nil
 }
 
+// MergePartitions combines partitions of one result set, as returned by
+// ExecutePartitions, into a single partition that ReadPartition reads as
+// one stream of all of their endpoints, in the order given. It checks
+// that each partition is a FlightInfo and that they share a schema, so
+// that the merged partition is well-formed; the result is the
+// concatenation of the partitions.
+func MergePartitions(partitions ...[]byte) ([]byte, error) {
+	if len(partitions) == 0 {
+		return nil, adbc.Error{
+			Msg:  "[Flight SQL] MergePartitions: no partitions given",
+			Code: adbc.StatusInvalidArgument,
+		}
+	}
+
+	var schema []byte
+	for i, partition := range partitions {
+		var info flight.FlightInfo
+		if err := proto.Unmarshal(partition, &info); err != nil {
+			return nil, adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL] MergePartitions: invalid partition %d: %s", i, err),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+		if len(info.Endpoint) == 0 {
+			return nil, adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL] MergePartitions: partition %d has no endpoints", i),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+		if i == 0 {
+			schema = info.Schema
+		} else if !bytes.Equal(schema, info.Schema) {
+			return nil, adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL] MergePartitions: partition %d has a different schema than partition 0", i),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+	}
+	return bytes.Join(partitions, nil), nil
+}
+
 var (
 	_ adbc.PostInitOptions = (*cnxn)(nil)
 )
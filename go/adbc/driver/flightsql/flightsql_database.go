@@ -22,7 +22,9 @@ import (
 	"crypto/tls"
 	"crypto/x509"
 	"fmt"
+	"math"
 	"net/url"
+	"os"
 	"strconv"
 	"strings"
 	"sync"
@@ -72,6 +74,48 @@ type databaseImpl struct {
 	dialOpts      dbDialOpts
 	enableCookies bool
 	options       map[string]string
+
+	// Defaults for the result sets of statements on this database
+	maxStreams int
+	queueBytes int64
+	channels   int
+
+	allocateBodies bool
+	compression    string
+	results        *resultCache
+}
+
+// streamOptions returns how DoGet streams of this database are read.
+func (d *databaseImpl) streamOptions() streamOptions {
+	opts := streamOptions{alloc: d.Alloc, compression: d.compression}
+	if d.allocateBodies {
+		opts.bodyAlloc = d.Alloc
+	}
+	return opts
+}
+
+func (d *databaseImpl) setAllocateBodies(value string) error {
+	switch value {
+	case adbc.OptionValueEnabled:
+		d.allocateBodies = true
+	case adbc.OptionValueDisabled:
+		d.allocateBodies = false
+	default:
+		return d.ErrorHelper.Errorf(adbc.StatusInvalidArgument, "[Flight SQL] Invalid value for database option '%s': '%s'", OptionAllocateMessageBodies, value)
+	}
+	return nil
+}
+
+func (d *databaseImpl) setCompression(value string) error {
+	switch value {
+	case OptionValueIPCCompressionNone:
+		d.compression = ""
+	case OptionValueIPCCompressionLZ4Frame, OptionValueIPCCompressionZstd:
+		d.compression = value
+	default:
+		return d.ErrorHelper.Errorf(adbc.StatusInvalidArgument, "[Flight SQL] Invalid value for database option '%s': '%s'", OptionIPCCompression, value)
+	}
+	return nil
 }
 
 func (d *databaseImpl) SetOptions(cnOptions map[string]string) error {
@@ -238,6 +282,38 @@ func (d *databaseImpl) SetOptions(cnOptions map[string]string) error {
 		delete(cnOptions, OptionCookieMiddleware)
 	}
 
+	if val, ok := cnOptions[OptionAllocateMessageBodies]; ok {
+		if err := d.setAllocateBodies(val); err != nil {
+			return err
+		}
+		delete(cnOptions, OptionAllocateMessageBodies)
+	}
+
+	if val, ok := cnOptions[OptionIPCCompression]; ok {
+		if err := d.setCompression(val); err != nil {
+			return err
+		}
+		delete(cnOptions, OptionIPCCompression)
+	}
+
+	for _, key := range []string{OptionResultCacheMaxBytes, OptionResultCacheTTL, OptionResultCacheSpillDirectory} {
+		if val, ok := cnOptions[key]; ok {
+			if err := d.setResultCacheOption(key, val); err != nil {
+				return err
+			}
+			delete(cnOptions, key)
+		}
+	}
+
+	for _, key := range []string{OptionStatementMaxConcurrentStreams, OptionStatementQueueBytes, OptionResultChannels} {
+		if val, ok := cnOptions[key]; ok {
+			if err := d.setResultLimitString(key, val); err != nil {
+				return err
+			}
+			delete(cnOptions, key)
+		}
+	}
+
 	for key, val := range cnOptions {
 		if strings.HasPrefix(key, OptionRPCCallHeaderPrefix) {
 			d.hdrs.Append(strings.TrimPrefix(key, OptionRPCCallHeaderPrefix), val)
@@ -249,6 +325,56 @@ func (d *databaseImpl) SetOptions(cnOptions map[string]string) error {
 	return nil
 }
 
+// setResultLimitString sets the default maximum number of concurrent
+// DoGets or byte budget for result sets.
+func (d *databaseImpl) setResultLimitString(key, value string) error {
+	limit, err := strconv.ParseInt(value, 10, 64)
+	if err != nil {
+		return d.ErrorHelper.Errorf(adbc.StatusInvalidArgument, "[Flight SQL] Invalid value for database option '%s': '%s' is not an integer", key, value)
+	}
+	return d.setResultLimit(key, limit)
+}
+
+func (d *databaseImpl) setResultLimit(key string, value int64) error {
+	if value < 0 {
+		return d.ErrorHelper.Errorf(adbc.StatusInvalidArgument, "[Flight SQL] Invalid value for database option '%s': '%d' is negative", key, value)
+	}
+	switch key {
+	case OptionStatementMaxConcurrentStreams:
+		d.maxStreams = int(value)
+	case OptionResultChannels:
+		d.channels = int(value)
+	default:
+		d.queueBytes = value
+	}
+	return nil
+}
+
+func (d *databaseImpl) setResultCacheOption(key, value string) error {
+	switch key {
+	case OptionResultCacheMaxBytes:
+		maxBytes, err := strconv.ParseInt(value, 10, 64)
+		if err != nil || maxBytes < 0 {
+			return d.ErrorHelper.Errorf(adbc.StatusInvalidArgument, "[Flight SQL] Invalid value for database option '%s': '%s' is not a non-negative integer", key, value)
+		}
+		d.results.setMaxBytes(maxBytes)
+	case OptionResultCacheTTL:
+		seconds, err := strconv.ParseFloat(value, 64)
+		if err != nil || math.IsNaN(seconds) || math.IsInf(seconds, 0) || seconds <= 0 {
+			return d.ErrorHelper.Errorf(adbc.StatusInvalidArgument, "[Flight SQL] Invalid value for database option '%s': '%s' is not a positive number", key, value)
+		}
+		d.results.setTTL(time.Duration(seconds * float64(time.Second)))
+	case OptionResultCacheSpillDirectory:
+		if value != "" {
+			if info, err := os.Stat(value); err != nil || !info.IsDir() {
+				return d.ErrorHelper.Errorf(adbc.StatusInvalidArgument, "[Flight SQL] Invalid value for database option '%s': '%s' is not a directory", key, value)
+			}
+		}
+		d.results.setSpillDir(value)
+	}
+	return nil
+}
+
 func (d *databaseImpl) GetOption(key string) (string, error) {
 	switch key {
 	case OptionTimeoutFetch:
@@ -257,6 +383,31 @@ func (d *databaseImpl) GetOption(key string) (string, error) {
 		return d.timeout.queryTimeout.String(), nil
 	case OptionTimeoutUpdate:
 		return d.timeout.updateTimeout.String(), nil
+	case OptionStatementMaxConcurrentStreams:
+		return strconv.Itoa(d.maxStreams), nil
+	case OptionStatementQueueBytes:
+		return strconv.FormatInt(d.queueBytes, 10), nil
+	case OptionResultChannels:
+		return strconv.Itoa(d.channels), nil
+	case OptionAllocateMessageBodies:
+		if d.allocateBodies {
+			return adbc.OptionValueEnabled, nil
+		}
+		return adbc.OptionValueDisabled, nil
+	case OptionIPCCompression:
+		if d.compression == "" {
+			return OptionValueIPCCompressionNone, nil
+		}
+		return d.compression, nil
+	case OptionResultCacheMaxBytes:
+		maxBytes, _, _ := d.results.settings()
+		return strconv.FormatInt(maxBytes, 10), nil
+	case OptionResultCacheTTL:
+		_, ttl, _ := d.results.settings()
+		return strconv.FormatFloat(ttl.Seconds(), 'f', -1, 64), nil
+	case OptionResultCacheSpillDirectory:
+		_, _, spillDir := d.results.settings()
+		return spillDir, nil
 	}
 	if val, ok := d.options[key]; ok {
 		return val, nil
@@ -276,6 +427,15 @@ func (d *databaseImpl) GetOptionInt(key string) (int64, error) {
 			return 0, err
 		}
 		return int64(val), nil
+	case OptionStatementMaxConcurrentStreams:
+		return int64(d.maxStreams), nil
+	case OptionStatementQueueBytes:
+		return d.queueBytes, nil
+	case OptionResultChannels:
+		return int64(d.channels), nil
+	case OptionResultCacheMaxBytes:
+		maxBytes, _, _ := d.results.settings()
+		return maxBytes, nil
 	}
 
 	return d.DatabaseImplBase.GetOptionInt(key)
@@ -289,6 +449,9 @@ func (d *databaseImpl) GetOptionDouble(key string) (float64, error) {
 		return d.timeout.queryTimeout.Seconds(), nil
 	case OptionTimeoutUpdate:
 		return d.timeout.updateTimeout.Seconds(), nil
+	case OptionResultCacheTTL:
+		_, ttl, _ := d.results.settings()
+		return ttl.Seconds(), nil
 	}
 
 	return d.DatabaseImplBase.GetOptionDouble(key)
@@ -299,6 +462,14 @@ func (d *databaseImpl) SetOption(key, value string) error {
 	switch key {
 	case OptionTimeoutFetch, OptionTimeoutQuery, OptionTimeoutUpdate:
 		return d.timeout.setTimeoutString(key, value)
+	case OptionStatementMaxConcurrentStreams, OptionStatementQueueBytes, OptionResultChannels:
+		return d.setResultLimitString(key, value)
+	case OptionAllocateMessageBodies:
+		return d.setAllocateBodies(value)
+	case OptionIPCCompression:
+		return d.setCompression(value)
+	case OptionResultCacheMaxBytes, OptionResultCacheTTL, OptionResultCacheSpillDirectory:
+		return d.setResultCacheOption(key, value)
 	}
 	if strings.HasPrefix(key, OptionRPCCallHeaderPrefix) {
 		d.hdrs.Set(strings.TrimPrefix(key, OptionRPCCallHeaderPrefix), value)
@@ -314,6 +485,10 @@ func (d *databaseImpl) SetOptionInt(key string, value int64) error {
 		fallthrough
 	case OptionTimeoutUpdate:
 		return d.timeout.setTimeout(key, float64(value))
+	case OptionStatementMaxConcurrentStreams, OptionStatementQueueBytes, OptionResultChannels:
+		return d.setResultLimit(key, value)
+	case OptionResultCacheMaxBytes, OptionResultCacheTTL:
+		return d.setResultCacheOption(key, strconv.FormatInt(value, 10))
 	}
 
 	return d.DatabaseImplBase.SetOptionInt(key, value)
@@ -327,12 +502,17 @@ func (d *databaseImpl) SetOptionDouble(key string, value float64) error {
 		fallthrough
 	case OptionTimeoutUpdate:
 		return d.timeout.setTimeout(key, value)
+	case OptionResultCacheTTL:
+		return d.setResultCacheOption(key, strconv.FormatFloat(value, 'f', -1, 64))
 	}
 
 	return d.DatabaseImplBase.SetOptionDouble(key, value)
 }
 
-func getFlightClient(ctx context.Context, loc string, d *databaseImpl) (*flightsql.Client, error) {
+// getFlightClient dials loc. If cookies are enabled, the client keeps
+// them in the given cookie middleware, so that clients sharing it share
+// one jar, or in a jar of its own if cookies is nil.
+func getFlightClient(ctx context.Context, loc string, d *databaseImpl, cookies *flight.ClientMiddleware) (*flightsql.Client, error) {
 	authMiddle := &bearerAuthMiddleware{hdrs: d.hdrs.Copy()}
 	middleware := []flight.ClientMiddleware{
 		{
@@ -347,7 +527,10 @@ func getFlightClient(ctx context.Context, loc string, d *databaseImpl) (*flights
 	}
 
 	if d.enableCookies {
-		middleware = append(middleware, flight.NewClientCookieMiddleware())
+		if cookies == nil {
+			cookies = d.newCookieMiddleware()
+		}
+		middleware = append(middleware, *cookies)
 	}
 
 	uri, err := url.Parse(loc)
@@ -391,12 +574,23 @@ func getFlightClient(ctx context.Context, loc string, d *databaseImpl) (*flights
 	return cl, nil
 }
 
+// newCookieMiddleware returns a cookie middleware with an empty jar, or
+// nil if cookies are disabled.
+func (d *databaseImpl) newCookieMiddleware() *flight.ClientMiddleware {
+	if !d.enableCookies {
+		return nil
+	}
+	cookies := flight.NewClientCookieMiddleware()
+	return &cookies
+}
+
 type support struct {
 	transactions bool
 }
 
 func (impl *databaseImpl) Open(ctx context.Context) (adbc.Connection, error) {
-	cl, err := getFlightClient(ctx, impl.uri.String(), impl)
+	cookies := impl.newCookieMiddleware()
+	cl, err := getFlightClient(ctx, impl.uri.String(), impl, cookies)
 	if err != nil {
 		return nil, err
 	}
@@ -409,7 +603,7 @@ func (impl *databaseImpl) Open(ctx context.Context) (adbc.Connection, error) {
 				return nil, adbc.Error{Msg: fmt.Sprintf("Location must be a string, got %#v", uri), Code: adbc.StatusInternal}
 			}
 
-			cl, err := getFlightClient(context.Background(), uri, impl)
+			cl, err := getFlightClient(context.Background(), uri, impl, nil)
 			if err != nil {
 				return nil, err
 			}
@@ -430,7 +624,7 @@ func (impl *databaseImpl) Open(ctx context.Context) (adbc.Connection, error) {
 		const int32code = 3
 
 		for _, endpoint := range info.Endpoint {
-			rdr, err := doGet(ctx, cl, endpoint, cache, impl.timeout)
+			rdr, err := doGet(ctx, cl, endpoint, cache, impl.streamOptions(), impl.timeout)
 			if err != nil {
 				continue
 			}
@@ -464,9 +658,11 @@ func (impl *databaseImpl) Open(ctx context.Context) (adbc.Connection, error) {
 		}
 	}
 
+	impl.results.openConnection()
 	return &cnxn{cl: cl, db: impl, clientCache: cache,
 		hdrs: make(metadata.MD), timeouts: impl.timeout,
-		supportInfo: cnxnSupport}, nil
+		supportInfo: cnxnSupport, numChannels: impl.channels,
+		cookies: cookies}, nil
 }
 
 type bearerAuthMiddleware struct {
@@ -58,7 +58,34 @@ const (
 	OptionTimeoutUpdate       = "adbc.flight.sql.rpc.timeout_seconds.update"
 	OptionRPCCallHeaderPrefix = "adbc.flight.sql.rpc.call_header."
 	OptionCookieMiddleware    = "adbc.flight.sql.rpc.with_cookie_middleware"
-	infoDriverName            = "ADBC Flight SQL Driver - Go"
+	// Receive the body of each message of a DoGet into memory from the
+	// driver's allocator ("true" or "false", the default). The C driver
+	// library allocates with malloc, so this keeps result data off the Go
+	// heap.
+	OptionAllocateMessageBodies = "adbc.flight.sql.rpc.allocate_message_bodies"
+	// Compress the IPC streams of bulk ingestion, and ask the server to
+	// compress the IPC streams of results (see IPCCompressionHeader), with
+	// one of the OptionValueIPCCompression codecs
+	OptionIPCCompression = "adbc.flight.sql.rpc.ipc_compression"
+	// Fetch result endpoints that have no location over this many gRPC
+	// channels (each with its own connection) to the server, instead of
+	// only the connection's own. Applies to connections opened afterwards.
+	OptionResultChannels = "adbc.flight.sql.rpc.result_channels"
+	// Cache query results of up to this many bytes in total (0, the
+	// default, disables the cache)
+	OptionResultCacheMaxBytes = "adbc.flight.sql.result_cache.max_bytes"
+	// How long cached results are used for, in floating-point seconds
+	OptionResultCacheTTL = "adbc.flight.sql.result_cache.ttl_seconds"
+	// Keep cached results as files in this directory instead of in memory
+	OptionResultCacheSpillDirectory = "adbc.flight.sql.result_cache.spill_directory"
+
+	infoDriverName = "ADBC Flight SQL Driver - Go"
+)
+
+const (
+	OptionValueIPCCompressionNone     = "none"
+	OptionValueIPCCompressionLZ4Frame = "lz4_frame"
+	OptionValueIPCCompressionZstd     = "zstd"
 )
 
 var (
@@ -128,6 +155,7 @@ func (d *driverImpl) NewDatabase(opts map[string]string) (adbc.Database, error)
 		DatabaseImplBase: driverbase.NewDatabaseImplBase(&d.DriverImplBase),
 		hdrs:             make(metadata.MD),
 	}
+	db.results = newResultCache(db.Alloc)
 
 	var err error
 	if db.uri, err = url.Parse(uri); err != nil {
@@ -19,6 +19,7 @@ package flightsql
 
 import (
 	"context"
+	"encoding/json"
 	"fmt"
 	"strconv"
 	"strings"
@@ -37,6 +38,26 @@ import (
 
 const (
 	OptionStatementQueueSize = "adbc.rpc.result_queue_size"
+	// Return batches from whichever endpoint produces one first, rather
+	// than endpoint by endpoint ("true" or "false", the default)
+	OptionStatementUnorderedResults = "adbc.rpc.result_unordered"
+	// Bound the batches buffered across all endpoints by their total size
+	// in bytes; with unordered results, this replaces
+	// adbc.rpc.result_queue_size (0, the default, disables the limit).
+	// May also be set on the database as the default for its statements.
+	OptionStatementQueueBytes = "adbc.rpc.result_queue_bytes"
+	// The maximum number of endpoints fetched at once (0, the default,
+	// fetches all of them at once). May also be set on the database.
+	OptionStatementMaxConcurrentStreams = "adbc.rpc.result_max_concurrent_streams"
+	// Neither use nor fill the database's result cache when executing this
+	// statement ("true" or "false", the default)
+	OptionStatementResultCacheBypass = "adbc.flight.sql.result_cache.bypass"
+	// Read-only: a JSON array with the statistics of each endpoint of the
+	// last result set of this statement (batches, rows, bytes, seconds,
+	// bytes_per_second, stream_wait_seconds, queue_wait_seconds, and
+	// error). Complete once the result set has been read to the end;
+	// empty for cached results and results without endpoints.
+	OptionStatementResultStats = "adbc.rpc.result_stats"
 	// Explicitly set substrait version for Flight SQL
 	// substrait *does* include the version in the serialized plan
 	// so this is not entirely necessary depending on the version
@@ -132,6 +153,62 @@ type statement struct {
 	prepared  *flightsql.PreparedStatement
 	queueSize int
 	timeouts  timeoutOption
+
+	unordered  bool
+	queueBytes int64
+	maxStreams int
+
+	// For the result cache: the hash of the bound parameters, and whether
+	// they were bound as a stream (which cannot be hashed up front)
+	bypassCache    bool
+	paramHash      []byte
+	unhashedParams bool
+
+	// The reader of the last result set, for OptionStatementResultStats
+	lastResult *reader
+
+	// Bulk ingestion state (the bound data is sent on execute)
+	targetTable    string
+	targetDBSchema string
+	targetCatalog  string
+	temporary      bool
+	ingestMode     string
+	bound          arrow.Record
+	streamBind     array.RecordReader
+}
+
+func (s *statement) clearIngestBinding() {
+	if s.bound != nil {
+		s.bound.Release()
+		s.bound = nil
+	} else if s.streamBind != nil {
+		s.streamBind.Release()
+		s.streamBind = nil
+	}
+}
+
+func (s *statement) readerOptions() recordReaderOptions {
+	return recordReaderOptions{
+		queueSize:  s.queueSize,
+		unordered:  s.unordered,
+		queueBytes: s.queueBytes,
+		maxStreams: s.maxStreams,
+		logger:     s.cnxn.db.Logger,
+		stream:     s.cnxn.db.streamOptions(),
+	}
+}
+
+// resultCacheKey returns the key of this statement's result in the
+// database's result cache, or "" if the result must not be cached.
+func (s *statement) resultCacheKey() string {
+	// Within a transaction, results may depend on uncommitted changes
+	if s.bypassCache || s.cnxn.txn != nil || s.unhashedParams || !s.cnxn.db.results.enabled() {
+		return ""
+	}
+	if !isReadQuery(s.query.sqlQuery) {
+		return ""
+	}
+	return resultCacheKey(s.query.sqlQuery, s.prepared != nil, s.paramHash, s.hdrs)
 }
 
 func (s *statement) closePreparedStatement() error {
@@ -149,6 +226,7 @@ func (s *statement) Close() (err error) {
 		err = s.closePreparedStatement()
 		s.prepared = nil
 	}
+	s.clearIngestBinding()
 
 	if s.cnxn == nil {
 		return adbc.Error{
@@ -173,6 +251,49 @@ func (s *statement) GetOption(key string) (string, error) {
 		return s.timeouts.queryTimeout.String(), nil
 	case OptionTimeoutUpdate:
 		return s.timeouts.updateTimeout.String(), nil
+	case OptionStatementUnorderedResults:
+		if s.unordered {
+			return adbc.OptionValueEnabled, nil
+		}
+		return adbc.OptionValueDisabled, nil
+	case OptionStatementQueueBytes:
+		return strconv.FormatInt(s.queueBytes, 10), nil
+	case OptionStatementMaxConcurrentStreams:
+		return strconv.Itoa(s.maxStreams), nil
+	case OptionStatementResultCacheBypass:
+		if s.bypassCache {
+			return adbc.OptionValueEnabled, nil
+		}
+		return adbc.OptionValueDisabled, nil
+	case OptionStatementResultStats:
+		stats := []endpointSummary{}
+		if s.lastResult != nil {
+			stats = s.lastResult.resultStats()
+		}
+		encoded, err := json.Marshal(stats)
+		if err != nil {
+			return "", adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL] Could not encode result statistics: %s", err),
+				Code: adbc.StatusInternal,
+			}
+		}
+		return string(encoded), nil
+	case adbc.OptionKeyIngestTargetTable:
+		return s.targetTable, nil
+	case adbc.OptionKeyIngestTargetDBSchema:
+		return s.targetDBSchema, nil
+	case adbc.OptionKeyIngestTargetCatalog:
+		return s.targetCatalog, nil
+	case adbc.OptionKeyIngestTemporary:
+		if s.temporary {
+			return adbc.OptionValueEnabled, nil
+		}
+		return adbc.OptionValueDisabled, nil
+	case adbc.OptionKeyIngestMode:
+		if s.ingestMode == "" {
+			return adbc.OptionValueIngestModeCreate, nil
+		}
+		return s.ingestMode, nil
 	}
 
 	if strings.HasPrefix(key, OptionRPCCallHeaderPrefix) {
@@ -206,6 +327,12 @@ func (s *statement) GetOptionInt(key string) (int64, error) {
 			return 0, err
 		}
 		return int64(val), nil
+	case OptionStatementQueueSize:
+		return int64(s.queueSize), nil
+	case OptionStatementQueueBytes:
+		return s.queueBytes, nil
+	case OptionStatementMaxConcurrentStreams:
+		return int64(s.maxStreams), nil
 	}
 
 	return 0, adbc.Error{
@@ -258,8 +385,77 @@ func (s *statement) SetOption(key string, val string) error {
 			}
 		}
 		return s.SetOptionInt(key, int64(size))
+	case OptionStatementUnorderedResults:
+		switch val {
+		case adbc.OptionValueEnabled:
+			s.unordered = true
+		case adbc.OptionValueDisabled:
+			s.unordered = false
+		default:
+			return adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL] Invalid value for statement option '%s': '%s'", key, val),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+	case OptionStatementResultCacheBypass:
+		switch val {
+		case adbc.OptionValueEnabled:
+			s.bypassCache = true
+		case adbc.OptionValueDisabled:
+			s.bypassCache = false
+		default:
+			return adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL] Invalid value for statement option '%s': '%s'", key, val),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+	case OptionStatementQueueBytes, OptionStatementMaxConcurrentStreams:
+		size, err := strconv.ParseInt(val, 10, 64)
+		if err != nil {
+			return adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL] Invalid value for statement option '%s': '%s' is not an integer", key, val),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+		return s.SetOptionInt(key, size)
 	case OptionStatementSubstraitVersion:
 		s.query.substraitVersion = val
+	case adbc.OptionKeyIngestTargetTable:
+		if s.prepared != nil {
+			if err := s.closePreparedStatement(); err != nil {
+				return err
+			}
+			s.prepared = nil
+		}
+		s.query.setSqlQuery("")
+		s.targetTable = val
+	case adbc.OptionKeyIngestTargetDBSchema:
+		s.targetDBSchema = val
+	case adbc.OptionKeyIngestTargetCatalog:
+		s.targetCatalog = val
+	case adbc.OptionKeyIngestTemporary:
+		switch val {
+		case adbc.OptionValueEnabled:
+			s.temporary = true
+		case adbc.OptionValueDisabled:
+			s.temporary = false
+		default:
+			return adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL] Invalid value for statement option '%s': '%s'", key, val),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+	case adbc.OptionKeyIngestMode:
+		switch val {
+		case adbc.OptionValueIngestModeCreate, adbc.OptionValueIngestModeAppend,
+			adbc.OptionValueIngestModeReplace, adbc.OptionValueIngestModeCreateAppend:
+			s.ingestMode = val
+		default:
+			return adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL] Invalid value for statement option '%s': '%s'", key, val),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
 	default:
 		return adbc.Error{
 			Msg:  "[Flight SQL] Unknown statement option '" + key + "'",
@@ -287,6 +483,24 @@ func (s *statement) SetOptionInt(key string, value int64) error {
 		}
 		s.queueSize = int(value)
 		return nil
+	case OptionStatementQueueBytes:
+		if value < 0 {
+			return adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL] Invalid value for statement option '%s': '%d' is negative", key, value),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+		s.queueBytes = value
+		return nil
+	case OptionStatementMaxConcurrentStreams:
+		if value < 0 {
+			return adbc.Error{
+				Msg:  fmt.Sprintf("[Flight SQL] Invalid value for statement option '%s': '%d' is negative", key, value),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+		s.maxStreams = int(value)
+		return nil
 	}
 	return s.SetOptionDouble(key, float64(value))
 }
@@ -320,6 +534,7 @@ func (s *statement) SetSqlQuery(query string) error {
 	}
 
 	s.query.setSqlQuery(query)
+	s.targetTable = ""
 	return nil
 }
 
@@ -329,6 +544,27 @@ func (s *statement) SetSqlQuery(query string) error {
 //
 // This invalidates any prior result sets on this statement.
 func (s *statement) ExecuteQuery(ctx context.Context) (rdr array.RecordReader, nrec int64, err error) {
+	s.lastResult = nil
+	if s.targetTable != "" {
+		defer s.cnxn.db.results.invalidate()
+		nrec, err = s.executeIngest(ctx)
+		return nil, nrec, err
+	}
+
+	// Substrait plans, and SQL other than queries that read data, may
+	// change data, so cached results may be stale afterwards
+	if !isReadQuery(s.query.sqlQuery) {
+		defer s.cnxn.db.results.invalidate()
+	}
+
+	cacheKey := s.resultCacheKey()
+	generation := s.cnxn.db.results.currentGeneration()
+	if cacheKey != "" {
+		if cached, rows, ok := s.cnxn.db.results.get(cacheKey); ok {
+			return cached, rows, nil
+		}
+	}
+
 	ctx = metadata.NewOutgoingContext(ctx, s.hdrs)
 	var info *flight.FlightInfo
 	var header, trailer metadata.MD
@@ -344,13 +580,30 @@ func (s *statement) ExecuteQuery(ctx context.Context) (rdr array.RecordReader, n
 	}
 
 	nrec = info.TotalRecords
-	rdr, err = newRecordReader(ctx, s.alloc, s.cnxn.cl, info, s.clientCache, s.queueSize, s.timeouts)
+	options := s.readerOptions()
+	if options.channels, err = s.cnxn.resultChannels(ctx); err != nil {
+		return nil, -1, err
+	}
+	rdr, err = newRecordReader(ctx, s.alloc, s.cnxn.cl, info, s.clientCache, options, s.timeouts)
+	if r, ok := rdr.(*reader); ok {
+		s.lastResult = r
+	}
+	if err == nil && cacheKey != "" {
+		rdr = newCachingReader(rdr, s.cnxn.db.results, cacheKey, generation)
+	}
 	return
 }
 
 // ExecuteUpdate executes a statement that does not generate a result
 // set. It returns the number of rows affected if known, otherwise -1.
 func (s *statement) ExecuteUpdate(ctx context.Context) (n int64, err error) {
+	// Whatever the statement changed, cached results may be stale now
+	defer s.cnxn.db.results.invalidate()
+
+	if s.targetTable != "" {
+		return s.executeIngest(ctx)
+	}
+
 	ctx = metadata.NewOutgoingContext(ctx, s.hdrs)
 	var header, trailer metadata.MD
 	opts := append([]grpc.CallOption{}, grpc.Header(&header), grpc.Trailer(&trailer), s.timeouts)
@@ -377,6 +630,8 @@ func (s *statement) Prepare(ctx context.Context) error {
 		return adbcFromFlightStatusWithDetails(err, header, trailer, "Prepare")
 	}
 	s.prepared = prep
+	s.paramHash = nil
+	s.unhashedParams = false
 	return nil
 }
 
@@ -398,6 +653,7 @@ func (s *statement) SetSubstraitPlan(plan []byte) error {
 	}
 
 	s.query.setSubstraitPlan(plan)
+	s.targetTable = ""
 	return nil
 }
 
@@ -408,7 +664,14 @@ func (s *statement) SetSubstraitPlan(plan []byte) error {
 // but it may not do this until the statement is closed or another
 // record is bound.
 func (s *statement) Bind(_ context.Context, values arrow.Record) error {
-	// TODO: handle bulk insert situation
+	if s.targetTable != "" {
+		s.clearIngestBinding()
+		s.bound = values
+		if s.bound != nil {
+			s.bound.Retain()
+		}
+		return nil
+	}
 
 	if s.prepared == nil {
 		return adbc.Error{
@@ -416,6 +679,16 @@ func (s *statement) Bind(_ context.Context, values arrow.Record) error {
 			Code: adbc.StatusInvalidState}
 	}
 
+	s.paramHash = nil
+	s.unhashedParams = false
+	if values != nil {
+		if hash, err := hashParameters(values); err == nil {
+			s.paramHash = hash
+		} else {
+			s.unhashedParams = true
+		}
+	}
+
 	// calls retain
 	s.prepared.SetParameters(values)
 	return nil
@@ -427,12 +700,24 @@ func (s *statement) Bind(_ context.Context, values arrow.Record) error {
 // The driver will call Release on the record reader, but may not do this
 // until Close is called.
 func (s *statement) BindStream(_ context.Context, stream array.RecordReader) error {
+	if s.targetTable != "" {
+		s.clearIngestBinding()
+		s.streamBind = stream
+		if s.streamBind != nil {
+			s.streamBind.Retain()
+		}
+		return nil
+	}
+
 	if s.prepared == nil {
 		return adbc.Error{
 			Msg:  "[Flight SQL Statement] must call Prepare before calling Bind",
 			Code: adbc.StatusInvalidState}
 	}
 
+	s.paramHash = nil
+	s.unhashedParams = stream != nil
+
 	// calls retain
 	s.prepared.SetRecordReader(stream)
 	return nil
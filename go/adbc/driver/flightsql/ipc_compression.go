@@ -0,0 +1,280 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package flightsql
+
+import (
+	"bytes"
+	"encoding/binary"
+	"fmt"
+	"io"
+	"runtime"
+	"sync"
+
+	"github.com/apache/arrow/go/v13/arrow/ipc"
+	"github.com/apache/arrow/go/v13/arrow/memory"
+	flatbuffers "github.com/google/flatbuffers/go"
+	"github.com/klauspost/compress/zstd"
+	"github.com/pierrec/lz4/v4"
+	"golang.org/x/sync/errgroup"
+)
+
+// IPCCompressionHeader is the call header with which DoGet asks for
+// compressed results when OptionIPCCompression is set. Flight has no way
+// to negotiate compression (the server picks the options of the streams
+// it writes), so this is specific to this driver: servers that do not
+// know it send uncompressed streams, which are read as usual.
+const IPCCompressionHeader = "x-adbc-ipc-compression"
+
+// ipcWriteOptions returns the IPC writer options that compress with codec
+// (an OptionValueIPCCompression value, or "" for none).
+func ipcWriteOptions(codec string) []ipc.Option {
+	switch codec {
+	case OptionValueIPCCompressionLZ4Frame:
+		return []ipc.Option{ipc.WithLZ4(), ipc.WithCompressConcurrency(runtime.GOMAXPROCS(0))}
+	case OptionValueIPCCompressionZstd:
+		return []ipc.Option{ipc.WithZstd(), ipc.WithCompressConcurrency(runtime.GOMAXPROCS(0))}
+	}
+	return nil
+}
+
+// Positions of the fields used below in the vtables of the IPC metadata
+// tables (4 + 2 * the field's index in Message.fbs), and enum values.
+const (
+	fbMessageHeaderType      = 6
+	fbMessageHeader          = 8
+	fbMessageBodyLength      = 10
+	fbDictionaryBatchData    = 6
+	fbRecordBatchBuffers     = 8
+	fbRecordBatchCompression = 10
+	fbBodyCompressionCodec   = 4
+
+	fbHeaderDictionaryBatch = 2
+	fbHeaderRecordBatch     = 3
+	fbCodecLZ4Frame         = 0
+	fbCodecZstd             = 1
+
+	// sizeof(struct Buffer { offset: long; length: long; })
+	fbBufferSize = 16
+)
+
+// Batches smaller than this are decompressed on the reading goroutine.
+const parallelDecompressionBytes = 256 * 1024
+
+var (
+	zstdDecoderOnce sync.Once
+	zstdDecoder     *zstd.Decoder
+	zstdDecoderErr  error
+)
+
+// sharedZstdDecoder returns a decoder for DecodeAll, which may be called
+// concurrently.
+func sharedZstdDecoder() (*zstd.Decoder, error) {
+	zstdDecoderOnce.Do(func() {
+		zstdDecoder, zstdDecoderErr = zstd.NewReader(nil, zstd.WithDecoderConcurrency(0))
+	})
+	return zstdDecoder, zstdDecoderErr
+}
+
+// compressedBuffer is a buffer of a compressed batch, and where it goes
+// in the decompressed body.
+type compressedBuffer struct {
+	// The position of the buffer's Buffer struct in the metadata
+	pos flatbuffers.UOffsetT
+	// The compressed data, or the data itself if it was left uncompressed
+	src        []byte
+	compressed bool
+	offset     int64
+	size       int64
+}
+
+func (b *compressedBuffer) decompress(codec byte, dst []byte) error {
+	if !b.compressed {
+		copy(dst, b.src)
+		return nil
+	}
+
+	switch codec {
+	case fbCodecLZ4Frame:
+		if _, err := io.ReadFull(lz4.NewReader(bytes.NewReader(b.src)), dst); err != nil {
+			return fmt.Errorf("LZ4 frame: %w", err)
+		}
+	case fbCodecZstd:
+		dec, err := sharedZstdDecoder()
+		if err != nil {
+			return err
+		}
+		out, err := dec.DecodeAll(b.src, dst[:0])
+		if err != nil {
+			return fmt.Errorf("ZSTD: %w", err)
+		}
+		if len(out) != len(dst) {
+			return fmt.Errorf("ZSTD: expected %d bytes, got %d", len(dst), len(out))
+		}
+	default:
+		return fmt.Errorf("unknown compression codec %d", codec)
+	}
+	return nil
+}
+
+// decompressBody decompresses the buffers of a compressed record batch or
+// dictionary batch message in parallel. It returns the uncompressed body
+// and new metadata describing it, or nil if the message is not a
+// compressed batch. meta itself is not modified.
+//
+// The IPC reader of this Arrow release decompresses the buffers of a
+// batch one after the other, on the goroutine reading the stream, so a
+// wide batch decompresses at the speed of a single core. Instead, each
+// buffer is decompressed on its own goroutine directly into its place in
+// a new body. The offsets and lengths of the buffers in the metadata are
+// fixed-size structs, so they can be updated in a copy of the metadata.
+// The batch's compression field is dropped by giving the batch a new
+// vtable without it, appended to the copy: writers share identical
+// vtables between tables, so the old one may not be edited. The IPC
+// reader then reads the message as an uncompressed batch.
+func decompressBody(meta, body []byte, mem memory.Allocator) (outMeta []byte, out *memory.Buffer, err error) {
+	// Malformed metadata makes the flatbuffers accessors panic
+	defer func() {
+		if r := recover(); r != nil {
+			if out != nil {
+				out.Release()
+			}
+			outMeta, out, err = nil, nil, fmt.Errorf("invalid IPC message metadata: %v", r)
+		}
+	}()
+
+	if len(meta) < flatbuffers.SizeUOffsetT {
+		return nil, nil, nil
+	}
+	msg := flatbuffers.Table{Bytes: meta, Pos: flatbuffers.GetUOffsetT(meta)}
+	typeField := flatbuffers.UOffsetT(msg.Offset(fbMessageHeaderType))
+	headerField := flatbuffers.UOffsetT(msg.Offset(fbMessageHeader))
+	if typeField == 0 || headerField == 0 {
+		return nil, nil, nil
+	}
+
+	batch := flatbuffers.Table{Bytes: meta, Pos: msg.Indirect(headerField + msg.Pos)}
+	switch msg.GetByte(typeField + msg.Pos) {
+	case fbHeaderRecordBatch:
+	case fbHeaderDictionaryBatch:
+		dataField := flatbuffers.UOffsetT(batch.Offset(fbDictionaryBatchData))
+		if dataField == 0 {
+			return nil, nil, nil
+		}
+		batch.Pos = batch.Indirect(dataField + batch.Pos)
+	default:
+		return nil, nil, nil
+	}
+
+	compressionField := flatbuffers.UOffsetT(batch.Offset(fbRecordBatchCompression))
+	if compressionField == 0 {
+		return nil, nil, nil
+	}
+	compression := flatbuffers.Table{Bytes: meta, Pos: batch.Indirect(compressionField + batch.Pos)}
+	codec := byte(fbCodecLZ4Frame)
+	if codecField := flatbuffers.UOffsetT(compression.Offset(fbBodyCompressionCodec)); codecField != 0 {
+		codec = compression.GetByte(codecField + compression.Pos)
+	}
+
+	var buffers []compressedBuffer
+	var total int64
+	if buffersField := flatbuffers.UOffsetT(batch.Offset(fbRecordBatchBuffers)); buffersField != 0 {
+		start := batch.Vector(buffersField)
+		buffers = make([]compressedBuffer, batch.VectorLen(buffersField))
+		for i := range buffers {
+			buf := &buffers[i]
+			buf.pos = start + flatbuffers.UOffsetT(i*fbBufferSize)
+			offset := batch.GetInt64(buf.pos)
+			length := batch.GetInt64(buf.pos + 8)
+			buf.offset = total
+			if length == 0 {
+				continue
+			}
+			if offset < 0 || length < 8 || offset+length > int64(len(body)) {
+				return nil, nil, fmt.Errorf("buffer %d (offset %d, length %d) is outside of the message body (length %d)", i, offset, length, len(body))
+			}
+
+			// Each buffer is prefixed by its uncompressed length, or -1
+			// if it was left uncompressed
+			raw := body[offset : offset+length]
+			buf.src = raw[8:]
+			buf.size = int64(binary.LittleEndian.Uint64(raw))
+			buf.compressed = buf.size != -1
+			if !buf.compressed {
+				buf.size = int64(len(buf.src))
+			} else if buf.size < 0 {
+				return nil, nil, fmt.Errorf("buffer %d has invalid uncompressed length %d", i, buf.size)
+			}
+			// Keep buffers 8-byte aligned, as the IPC writer does
+			total += (buf.size + 7) &^ 7
+		}
+	}
+
+	out = memory.NewResizableBuffer(mem)
+	out.Resize(int(total))
+	dst := out.Bytes()
+
+	decompress := func(buf *compressedBuffer) error {
+		target := dst[buf.offset : buf.offset+buf.size]
+		// Zero the padding, since the allocator may not have
+		end := buf.offset + ((buf.size + 7) &^ 7)
+		for i := buf.offset + buf.size; i < end; i++ {
+			dst[i] = 0
+		}
+		return buf.decompress(codec, target)
+	}
+	if total < parallelDecompressionBytes {
+		for i := range buffers {
+			if err = decompress(&buffers[i]); err != nil {
+				break
+			}
+		}
+	} else {
+		var g errgroup.Group
+		g.SetLimit(runtime.GOMAXPROCS(0))
+		for i := range buffers {
+			buf := &buffers[i]
+			if buf.size == 0 {
+				continue
+			}
+			g.Go(func() error { return decompress(buf) })
+		}
+		err = g.Wait()
+	}
+	if err != nil {
+		out.Release()
+		return nil, nil, err
+	}
+
+	vtable := flatbuffers.UOffsetT(flatbuffers.SOffsetT(batch.Pos) - batch.GetSOffsetT(batch.Pos))
+	vtableSize := flatbuffers.UOffsetT(flatbuffers.GetVOffsetT(meta[vtable:]))
+	// vtables are 2-byte aligned
+	newVtable := (flatbuffers.UOffsetT(len(meta)) + 1) &^ 1
+	outMeta = make([]byte, newVtable+vtableSize)
+	copy(outMeta, meta)
+	copy(outMeta[newVtable:], meta[vtable:vtable+vtableSize])
+	flatbuffers.WriteVOffsetT(outMeta[newVtable+fbRecordBatchCompression:], 0)
+	flatbuffers.WriteSOffsetT(outMeta[batch.Pos:], flatbuffers.SOffsetT(batch.Pos)-flatbuffers.SOffsetT(newVtable))
+
+	for i := range buffers {
+		flatbuffers.WriteInt64(outMeta[buffers[i].pos:], buffers[i].offset)
+		flatbuffers.WriteInt64(outMeta[buffers[i].pos+8:], buffers[i].size)
+	}
+	msg.Bytes = outMeta
+	msg.MutateInt64Slot(fbMessageBodyLength, total)
+	return outMeta, out, nil
+}
@@ -0,0 +1,180 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package flightsql
+
+import (
+	"encoding/binary"
+	"encoding/hex"
+	"fmt"
+	"io"
+	"testing"
+
+	"github.com/apache/arrow/go/v13/arrow/array"
+	"github.com/apache/arrow/go/v13/arrow/ipc"
+	"github.com/apache/arrow/go/v13/arrow/memory"
+	flatbuffers "github.com/google/flatbuffers/go"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+// IPC streams written by the C++ writer (pyarrow 26.0.0) with each codec:
+//
+//	ints = pa.array([None if i == 3 else i * 1000 for i in range(16)], pa.int64())
+//	strs = pa.array(["s%d" % i for i in range(16)])
+//	batch = pa.record_batch([ints, strs], names=["ints", "strs"])
+//	options = pa.ipc.IpcWriteOptions(compression=codec)
+//	with pa.ipc.new_stream(sink, batch.schema, options=options) as writer:
+//	    writer.write_batch(batch)
+var cppCompressedStreams = map[string]string{
+	OptionValueIPCCompressionLZ4Frame: "ffffffffb00000001000000000000a000c000600050008000a000000000104000c000000080008000000040008000000" +
+		"04000000020000004400000004000000d4ffffff00000105100000001c00000004000000000000000400000073747273" +
+		"000000000400040004000000100014000800060007000c00000010001000000000000102100000002000000004000000" +
+		"0000000004000000696e74730000000008000c000800070008000000000000014000000000000000ffffffffd8000000" +
+		"14000000000000000c0018000600050008000c000c000000000304001c0000002801000000000000000000000c001c00" +
+		"1000040008000c000c000000780000001c00000014000000100000000000000000000000040004000400000005000000" +
+		"000000000000000019000000000000002000000000000000680000000000000088000000000000000000000000000000" +
+		"88000000000000005b00000000000000e8000000000000003d0000000000000000000000020000001000000000000000" +
+		"010000000000000010000000000000000000000000000000020000000000000004224d1860408202000080f7ff000000" +
+		"0000000000000000800000000000000004224d18604082510000001300010022e803090022d007080004020022a00f0a" +
+		"002288130800227017080022581b080022401f08002228230800221027080022f82a080022e02e080022c832080022b0" +
+		"36080080983a00000000000000000000440000000000000004224d186040824400008000000000020000000400000006" +
+		"000000080000000a0000000c0000000e000000100000001200000014000000170000001a0000001d0000002000000023" +
+		"00000026000000000000000000000000260000000000000004224d186040822600008073307331733273337334733573" +
+		"3673377338733973313073313173313273313373313473313500000000000000ffffffff00000000",
+	OptionValueIPCCompressionZstd: "ffffffffb00000001000000000000a000c000600050008000a000000000104000c000000080008000000040008000000" +
+		"04000000020000004400000004000000d4ffffff00000105100000001c00000004000000000000000400000073747273" +
+		"000000000400040004000000100014000800060007000c00000010001000000000000102100000002000000004000000" +
+		"0000000004000000696e74730000000008000c000800070008000000000000014000000000000000ffffffffe0000000" +
+		"14000000000000000c0018000600050008000c000c000000000304001c000000e000000000000000000000000c001e00" +
+		"1000040008000c000c000000800000002400000018000000100000000000000000000000000006000800070006000000" +
+		"000000010500000000000000000000001300000000000000180000000000000058000000000000007000000000000000" +
+		"000000000000000070000000000000003100000000000000a80000000000000037000000000000000000000002000000" +
+		"1000000000000000010000000000000010000000000000000000000000000000020000000000000028b52ffd20021100" +
+		"00f7ff0000000000800000000000000028b52ffd20803d020014030000e80300d00700a00f00881300701700581b0040" +
+		"1f00282300102700f82a00e02e00c83200b03600983a0000000000000e1000326eb421e3461b326eb421e31a37ee18b0" +
+		"440000000000000028b52ffd20440501004204070a403d076ecbe56e1d5d0a7f776f675f574f473f372f271f170f071f" +
+		"0000000000000000260000000000000028b52ffd20263101007330733173327333733473357336733773387339733130" +
+		"73313173313273313373313473313500ffffffff00000000",
+}
+
+// splitIPCStream splits an IPC stream into the metadata and body of each
+// message.
+func splitIPCStream(t *testing.T, stream []byte) (metas, bodies [][]byte) {
+	for {
+		require.GreaterOrEqual(t, len(stream), 8)
+		require.Equal(t, uint32(0xFFFFFFFF), binary.LittleEndian.Uint32(stream))
+		length := int(binary.LittleEndian.Uint32(stream[4:]))
+		stream = stream[8:]
+		if length == 0 {
+			return
+		}
+		meta := stream[:length]
+		msg := flatbuffers.Table{Bytes: meta, Pos: flatbuffers.GetUOffsetT(meta)}
+		bodyLength := int(msg.GetInt64Slot(fbMessageBodyLength, 0))
+		metas = append(metas, meta)
+		bodies = append(bodies, stream[length:length+bodyLength])
+		stream = stream[length+bodyLength:]
+	}
+}
+
+type sliceMessageReader struct {
+	msgs []*ipc.Message
+}
+
+func (r *sliceMessageReader) Message() (*ipc.Message, error) {
+	if len(r.msgs) == 0 {
+		return nil, io.EOF
+	}
+	msg := r.msgs[0]
+	r.msgs = r.msgs[1:]
+	return msg, nil
+}
+
+func (r *sliceMessageReader) Retain()  {}
+func (r *sliceMessageReader) Release() {}
+
+func TestDecompressBodyCppWriter(t *testing.T) {
+	for codec, stream := range cppCompressedStreams {
+		t.Run(codec, func(t *testing.T) {
+			mem := memory.NewCheckedAllocator(memory.DefaultAllocator)
+			defer mem.AssertSize(t, 0)
+
+			data, err := hex.DecodeString(stream)
+			require.NoError(t, err)
+			metas, bodies := splitIPCStream(t, data)
+			require.Len(t, metas, 2)
+
+			var msgs []*ipc.Message
+			defer func() {
+				for _, msg := range msgs {
+					msg.Release()
+				}
+			}()
+			for i := range metas {
+				original := append([]byte(nil), metas[i]...)
+				meta, body, err := decompressBody(metas[i], bodies[i], mem)
+				require.NoError(t, err)
+				// The metadata is rewritten in a copy: writers share vtables
+				// between tables, so the original must not be touched
+				assert.Equal(t, original, metas[i])
+
+				if i == 0 {
+					// The schema
+					require.Nil(t, body)
+					msgs = append(msgs, ipc.NewMessage(memory.NewBufferBytes(metas[i]), memory.NewBufferBytes(bodies[i])))
+					continue
+				}
+				require.NotNil(t, body)
+				msgs = append(msgs, ipc.NewMessage(memory.NewBufferBytes(meta), body))
+				body.Release()
+			}
+
+			rdr, err := ipc.NewReaderFromMessageReader(&sliceMessageReader{msgs: msgs}, ipc.WithAllocator(mem))
+			require.NoError(t, err)
+			defer rdr.Release()
+			require.True(t, rdr.Next())
+			rec := rdr.Record()
+			require.EqualValues(t, 16, rec.NumRows())
+			ints := rec.Column(0).(*array.Int64)
+			strs := rec.Column(1).(*array.String)
+			for i := 0; i < 16; i++ {
+				if i == 3 {
+					assert.True(t, ints.IsNull(i))
+				} else {
+					assert.Equal(t, int64(i*1000), ints.Value(i))
+				}
+				assert.Equal(t, fmt.Sprintf("s%d", i), strs.Value(i))
+			}
+			require.False(t, rdr.Next())
+			require.NoError(t, rdr.Err())
+		})
+	}
+}
+
+func TestDecompressBodyInvalid(t *testing.T) {
+	data, err := hex.DecodeString(cppCompressedStreams[OptionValueIPCCompressionZstd])
+	require.NoError(t, err)
+	metas, bodies := splitIPCStream(t, data)
+
+	// A body too short for its buffers
+	_, _, err = decompressBody(metas[1], bodies[1][:16], memory.DefaultAllocator)
+	assert.Error(t, err)
+	// Truncated metadata
+	_, _, err = decompressBody(metas[1][:24], bodies[1], memory.DefaultAllocator)
+	assert.Error(t, err)
+}
@@ -20,7 +20,10 @@ package flightsql
 import (
 	"context"
 	"fmt"
+	"sort"
+	"sync"
 	"sync/atomic"
+	"time"
 
 	"github.com/apache/arrow-adbc/go/adbc"
 	"github.com/apache/arrow-adbc/go/adbc/utils"
@@ -30,7 +33,9 @@ import (
 	"github.com/apache/arrow/go/v13/arrow/flight/flightsql"
 	"github.com/apache/arrow/go/v13/arrow/memory"
 	"github.com/bluele/gcache"
+	"golang.org/x/exp/slog"
 	"golang.org/x/sync/errgroup"
+	"golang.org/x/sync/semaphore"
 	"google.golang.org/grpc"
 	"google.golang.org/grpc/metadata"
 )
@@ -43,12 +48,230 @@ type reader struct {
 	rec        arrow.Record
 	err        error
 
+	// If not nil, the bytes of batches fetched but not yet released by Next
+	budget *byteBudget
+	// For ordered reads, the index of the channel being consumed (read
+	// atomically by the endpoints, which are exempt from the budget while
+	// they are the one being consumed)
+	consuming int64
+	ordered   bool
+	logger    *slog.Logger
+
+	// Statistics of the endpoints that have finished
+	statsMu sync.Mutex
+	stats   []endpointSummary
+
 	cancelFn context.CancelFunc
 }
 
+// recordReaderOptions controls how newRecordReader consumes endpoints.
+type recordReaderOptions struct {
+	// The number of batches buffered per endpoint (or in total, for
+	// unordered reads without a byte limit)
+	queueSize int
+	// Return batches from whichever endpoint produces one first, instead
+	// of returning all batches of each endpoint in turn
+	unordered bool
+	// If positive, bound the total size in bytes of the batches buffered
+	// across all endpoints (for unordered reads, instead of by queueSize)
+	queueBytes int64
+	// If positive, the maximum number of endpoints fetched at once
+	maxStreams int
+	// If not nil, statistics for each endpoint are logged at debug level
+	// once the endpoint is finished
+	logger *slog.Logger
+	// How each endpoint's DoGet stream is requested and read
+	stream streamOptions
+	// If not empty, endpoints without a location are fetched over these
+	// clients in turn, instead of all over the reader's client
+	channels []*flightsql.Client
+}
+
+// client returns the client to fetch endpoint endpointIndex over, if it
+// has no location.
+func (o *recordReaderOptions) client(cl *flightsql.Client, endpointIndex int) *flightsql.Client {
+	if len(o.channels) == 0 {
+		return cl
+	}
+	return o.channels[endpointIndex%len(o.channels)]
+}
+
+// byteBudget bounds the total size of the batches held by a reader.
+//
+// A sync.Cond rather than a semaphore.Weighted, since whether a waiter is
+// exempt from the limit changes as the consumer moves between endpoints.
+type byteBudget struct {
+	mu     sync.Mutex
+	cond   *sync.Cond
+	limit  int64
+	used   int64
+	closed bool
+}
+
+func newByteBudget(limit int64) *byteBudget {
+	b := &byteBudget{limit: limit}
+	b.cond = sync.NewCond(&b.mu)
+	return b
+}
+
+// acquire blocks until size bytes fit in the budget, or until exempt
+// returns true. A batch larger than the whole limit is admitted once
+// nothing else is held. Returns false if the budget was closed.
+func (b *byteBudget) acquire(size int64, exempt func() bool) bool {
+	b.mu.Lock()
+	defer b.mu.Unlock()
+	for !b.closed && b.used > 0 && b.used+size > b.limit && !exempt() {
+		b.cond.Wait()
+	}
+	if b.closed {
+		return false
+	}
+	b.used += size
+	return true
+}
+
+func (b *byteBudget) release(size int64) {
+	b.mu.Lock()
+	b.used -= size
+	b.mu.Unlock()
+	b.cond.Broadcast()
+}
+
+// wake makes waiters re-check whether they are exempt.
+func (b *byteBudget) wake() {
+	b.mu.Lock()
+	defer b.mu.Unlock()
+	b.cond.Broadcast()
+}
+
+// close fails all current and future calls to acquire.
+func (b *byteBudget) close() {
+	b.mu.Lock()
+	b.closed = true
+	b.mu.Unlock()
+	b.cond.Broadcast()
+}
+
+// recordSize approximates the memory held by a record by summing the sizes
+// of its buffers.
+func recordSize(rec arrow.Record) int64 {
+	var size int64
+	var addData func(data arrow.ArrayData)
+	addData = func(data arrow.ArrayData) {
+		for _, buf := range data.Buffers() {
+			if buf != nil {
+				size += int64(buf.Len())
+			}
+		}
+		for _, child := range data.Children() {
+			addData(child)
+		}
+	}
+	for _, col := range rec.Columns() {
+		addData(col.Data())
+	}
+	return size
+}
+
+// endpointStats are collected while an endpoint is read.
+type endpointStats struct {
+	index   int
+	start   time.Time
+	batches int64
+	rows    int64
+	bytes   int64
+	// Time spent waiting for one of the maxStreams slots before starting
+	streamWait time.Duration
+	// Time spent waiting for the consumer (the byte budget or the queue)
+	queueWait time.Duration
+}
+
+// endpointSummary is the statistics of a finished endpoint, as reported
+// through OptionStatementResultStats.
+type endpointSummary struct {
+	Endpoint int   `json:"endpoint"`
+	Batches  int64 `json:"batches"`
+	Rows     int64 `json:"rows"`
+	Bytes    int64 `json:"bytes"`
+	// Wall-clock time from starting the DoGet to the end of the stream
+	Seconds float64 `json:"seconds"`
+	// Throughput excluding the time the consumer kept the endpoint waiting
+	BytesPerSecond    float64 `json:"bytes_per_second"`
+	StreamWaitSeconds float64 `json:"stream_wait_seconds"`
+	QueueWaitSeconds  float64 `json:"queue_wait_seconds"`
+	Error             string  `json:"error,omitempty"`
+}
+
+// drain sends the batches of one endpoint to ch, within the byte budget.
+func (r *reader) drain(ctx context.Context, rdr streamReader, ch chan<- arrow.Record, stats *endpointStats) {
+	exempt := func() bool {
+		return r.ordered && atomic.LoadInt64(&r.consuming) == int64(stats.index)
+	}
+	for rdr.Next() && ctx.Err() == nil {
+		rec := rdr.Record()
+		size := recordSize(rec)
+		waitStart := time.Now()
+		if r.budget != nil && !r.budget.acquire(size, exempt) {
+			break
+		}
+		rec.Retain()
+		ch <- rec
+		stats.queueWait += time.Since(waitStart)
+		stats.batches++
+		stats.rows += rec.NumRows()
+		stats.bytes += size
+	}
+}
+
+// finish records the statistics of an endpoint once it is done, and logs
+// them if a logger was given.
+func (r *reader) finish(ctx context.Context, stats *endpointStats, err error) {
+	elapsed := time.Since(stats.start)
+	busy := elapsed - stats.queueWait
+	summary := endpointSummary{
+		Endpoint:          stats.index,
+		Batches:           stats.batches,
+		Rows:              stats.rows,
+		Bytes:             stats.bytes,
+		Seconds:           elapsed.Seconds(),
+		StreamWaitSeconds: stats.streamWait.Seconds(),
+		QueueWaitSeconds:  stats.queueWait.Seconds(),
+	}
+	if busy > 0 {
+		summary.BytesPerSecond = float64(stats.bytes) / busy.Seconds()
+	}
+	if err != nil {
+		summary.Error = err.Error()
+	}
+
+	r.statsMu.Lock()
+	r.stats = append(r.stats, summary)
+	r.statsMu.Unlock()
+
+	if r.logger == nil {
+		return
+	}
+	r.logger.DebugContext(ctx, "DoGet endpoint finished", "endpoint", stats.index,
+		"batches", stats.batches, "rows", stats.rows, "bytes", stats.bytes,
+		"duration", elapsed, "bytes_per_second", summary.BytesPerSecond,
+		"stream_wait", stats.streamWait, "queue_wait", stats.queueWait, "err", err)
+}
+
+// resultStats returns the statistics of the endpoints finished so far,
+// ordered by endpoint. Once Next has returned false, all endpoints that
+// were started are included.
+func (r *reader) resultStats() []endpointSummary {
+	r.statsMu.Lock()
+	defer r.statsMu.Unlock()
+	result := make([]endpointSummary, len(r.stats))
+	copy(result, r.stats)
+	sort.Slice(result, func(i, j int) bool { return result[i].Endpoint < result[j].Endpoint })
+	return result
+}
+
 // kicks off a goroutine for each endpoint and returns a reader which
 // gathers all of the records as they come in.
-func newRecordReader(ctx context.Context, alloc memory.Allocator, cl *flightsql.Client, info *flight.FlightInfo, clCache gcache.Cache, bufferSize int, opts ...grpc.CallOption) (rdr array.RecordReader, err error) {
+func newRecordReader(ctx context.Context, alloc memory.Allocator, cl *flightsql.Client, info *flight.FlightInfo, clCache gcache.Cache, options recordReaderOptions, opts ...grpc.CallOption) (rdr array.RecordReader, err error) {
 	endpoints := info.Endpoint
 	var header, trailer metadata.MD
 	opts = append(append([]grpc.CallOption{}, opts...), grpc.Header(&header), grpc.Trailer(&trailer))
@@ -70,19 +293,66 @@ func newRecordReader(ctx context.Context, alloc memory.Allocator, cl *flightsql.
 		return array.NewRecordReader(schema, []arrow.Record{})
 	}
 
-	ch := make(chan arrow.Record, bufferSize)
-	group, ctx := errgroup.WithContext(ctx)
-	ctx, cancelFn := context.WithCancel(ctx)
+	created := time.Now()
 	// We may mutate endpoints below
 	numEndpoints := len(endpoints)
+	unordered := options.unordered && numEndpoints > 1
+	bufferSize := options.queueSize
+	var budget *byteBudget
+	if options.queueBytes > 0 {
+		if unordered {
+			// The budget does the bounding; don't also hold batches in the channel
+			bufferSize = 0
+		}
+		budget = newByteBudget(options.queueBytes)
+	}
+	var streams *semaphore.Weighted
+	if options.maxStreams > 0 && options.maxStreams < numEndpoints {
+		streams = semaphore.NewWeighted(int64(options.maxStreams))
+	}
+
+	group, ctx := errgroup.WithContext(ctx)
+	ctx, cancelFn := context.WithCancel(ctx)
+
+	// Channels are all made up front, since with a stream limit endpoints
+	// start after this function returns. In unordered mode every endpoint
+	// sends to the one channel, which is closed once all of them are done
+	var chs []chan arrow.Record
+	if unordered {
+		chs = []chan arrow.Record{make(chan arrow.Record, bufferSize)}
+	} else {
+		chs = make([]chan arrow.Record, numEndpoints)
+		for i := range chs {
+			chs[i] = make(chan arrow.Record, bufferSize)
+		}
+	}
+	lastChannelIndex := len(chs) - 1
+	endpointChannel := func(endpointIndex int) chan arrow.Record {
+		if unordered {
+			return chs[0]
+		}
+		return chs[endpointIndex]
+	}
 
 	defer func() {
 		if err != nil {
-			close(ch)
+			for _, ch := range chs {
+				close(ch)
+			}
 			cancelFn()
 		}
 	}()
 
+	reader := &reader{
+		refCount: 1,
+		chs:      chs,
+		err:      nil,
+		budget:   budget,
+		ordered:  !unordered,
+		logger:   options.logger,
+		cancelFn: cancelFn,
+	}
+
 	if info.Schema != nil {
 		schema, err = flight.DeserializeSchema(info.Schema, alloc)
 		if err != nil {
@@ -91,24 +361,32 @@ func newRecordReader(ctx context.Context, alloc memory.Allocator, cl *flightsql.
 				Code: adbc.StatusInvalidState}
 		}
 	} else {
+		if streams != nil {
+			// Cannot block, nothing else holds a slot yet
+			if err = streams.Acquire(ctx, 1); err != nil {
+				return nil, checkContext(err, ctx)
+			}
+		}
 		firstEndpoint := endpoints[0]
-		rdr, err := doGet(ctx, cl, firstEndpoint, clCache, opts...)
+		stats := &endpointStats{index: 0, start: time.Now()}
+		rdr, err := doGet(ctx, options.client(cl, 0), firstEndpoint, clCache, options.stream, opts...)
 		if err != nil {
 			return nil, adbcFromFlightStatusWithDetails(err, header, trailer, "DoGet: endpoint 0: remote: %s", firstEndpoint.Location)
 		}
 		schema = rdr.Schema()
 		group.Go(func() error {
+			if streams != nil {
+				defer streams.Release(1)
+			}
 			defer rdr.Release()
-			if numEndpoints > 1 {
-				defer close(ch)
+			if !unordered && lastChannelIndex != 0 {
+				defer close(chs[0])
 			}
 
-			for rdr.Next() && ctx.Err() == nil {
-				rec := rdr.Record()
-				rec.Retain()
-				ch <- rec
-			}
-			if err := checkContext(rdr.Err(), ctx); err != nil {
+			reader.drain(ctx, rdr, chs[0], stats)
+			err := checkContext(rdr.Err(), ctx)
+			reader.finish(ctx, stats, err)
+			if err != nil {
 				return adbcFromFlightStatusWithDetails(err, header, trailer, "DoGet: endpoint 0: remote: %s", firstEndpoint.Location)
 			}
 			return nil
@@ -116,31 +394,26 @@ func newRecordReader(ctx context.Context, alloc memory.Allocator, cl *flightsql.
 
 		endpoints = endpoints[1:]
 	}
+	reader.schema = schema
 
-	chs := make([]chan arrow.Record, numEndpoints)
-	chs[0] = ch
-	reader := &reader{
-		refCount: 1,
-		chs:      chs,
-		err:      nil,
-		cancelFn: cancelFn,
-		schema:   schema,
-	}
-
-	lastChannelIndex := len(chs) - 1
+	// Endpoint i (of the remaining endpoints) is endpoint i + offset
+	offset := numEndpoints - len(endpoints)
 
 	referenceSchema := utils.RemoveSchemaMetadata(schema)
-	for i, ep := range endpoints {
-		endpoint := ep
-		endpointIndex := i
-		chs[endpointIndex] = make(chan arrow.Record, bufferSize)
+	start := func(endpointIndex int, endpoint *flight.FlightEndpoint) {
+		epCh := endpointChannel(endpointIndex)
+		stats := &endpointStats{index: endpointIndex, start: time.Now()}
+		stats.streamWait = stats.start.Sub(created)
 		group.Go(func() error {
+			if streams != nil {
+				defer streams.Release(1)
+			}
 			// Close channels (except the last) so that Next can move on to the next channel properly
-			if endpointIndex != lastChannelIndex {
-				defer close(chs[endpointIndex])
+			if !unordered && endpointIndex != lastChannelIndex {
+				defer close(epCh)
 			}
 
-			rdr, err := doGet(ctx, cl, endpoint, clCache, opts...)
+			rdr, err := doGet(ctx, options.client(cl, endpointIndex), endpoint, clCache, options.stream, opts...)
 			if err != nil {
 				return adbcFromFlightStatusWithDetails(err, header, trailer, "DoGet: endpoint %d: %s", endpointIndex, endpoint.Location)
 			}
@@ -151,19 +424,51 @@ func newRecordReader(ctx context.Context, alloc memory.Allocator, cl *flightsql.
 				return fmt.Errorf("endpoint %d returned inconsistent schema: expected %s but got %s", endpointIndex, referenceSchema.String(), streamSchema.String())
 			}
 
-			for rdr.Next() && ctx.Err() == nil {
-				rec := rdr.Record()
-				rec.Retain()
-				chs[endpointIndex] <- rec
+			reader.drain(ctx, rdr, epCh, stats)
+			err = checkContext(rdr.Err(), ctx)
+			reader.finish(ctx, stats, err)
+			if err != nil {
+				return adbcFromFlightStatusWithDetails(err, header, trailer, "DoGet: endpoint %d: %s", endpointIndex, endpoint.Location)
 			}
+			return nil
+		})
+	}
 
-			if err := checkContext(rdr.Err(), ctx); err != nil {
-				return adbcFromFlightStatusWithDetails(err, header, trailer, "DoGet: endpoint %d: %s", endpointIndex, endpoint.Location)
+	if streams == nil {
+		for i, ep := range endpoints {
+			start(i+offset, ep)
+		}
+	} else {
+		// Start endpoints in order as slots free up. Since slots are taken
+		// in endpoint order, the endpoint being consumed always holds one
+		// (or is next in line for one), so ordered reads cannot stall.
+		group.Go(func() error {
+			for i, ep := range endpoints {
+				if err := streams.Acquire(ctx, 1); err != nil {
+					// Let Next move past the endpoints that never started
+					if !unordered {
+						for j := i + offset; j < lastChannelIndex; j++ {
+							close(chs[j])
+						}
+					}
+					return checkContext(nil, ctx)
+				}
+				start(i+offset, ep)
 			}
 			return nil
 		})
 	}
 
+	if budget != nil {
+		go func() {
+			// Unblock endpoints waiting on the budget once the reader is
+			// released or has failed (the context is also cancelled once
+			// all endpoints are done)
+			<-ctx.Done()
+			budget.close()
+		}()
+	}
+
 	go func() {
 		reader.err = group.Wait()
 		// Don't close the last channel until after the group is finished, so that
@@ -181,7 +486,7 @@ func (r *reader) Retain() {
 func (r *reader) Release() {
 	if atomic.AddInt64(&r.refCount, -1) == 0 {
 		if r.rec != nil {
-			r.rec.Release()
+			r.releaseRecord()
 		}
 		r.cancelFn()
 		for _, ch := range r.chs {
@@ -196,10 +501,17 @@ func (r *reader) Err() error {
 	return r.err
 }
 
+func (r *reader) releaseRecord() {
+	if r.budget != nil {
+		r.budget.release(recordSize(r.rec))
+	}
+	r.rec.Release()
+	r.rec = nil
+}
+
 func (r *reader) Next() bool {
 	if r.rec != nil {
-		r.rec.Release()
-		r.rec = nil
+		r.releaseRecord()
 	}
 
 	if r.curChIndex >= len(r.chs) {
@@ -212,6 +524,10 @@ func (r *reader) Next() bool {
 			break
 		}
 		r.curChIndex++
+		atomic.StoreInt64(&r.consuming, int64(r.curChIndex))
+		if r.budget != nil {
+			r.budget.wake()
+		}
 	}
 	return r.rec != nil
 }
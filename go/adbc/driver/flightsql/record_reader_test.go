@@ -18,9 +18,12 @@
 package flightsql
 
 import (
+	"bytes"
 	"context"
+	"encoding/json"
 	"fmt"
 	"net/url"
+	"sync"
 	"testing"
 
 	"github.com/apache/arrow-adbc/go/adbc"
@@ -32,6 +35,7 @@ import (
 	"github.com/apache/arrow/go/v13/arrow/memory"
 	"github.com/bluele/gcache"
 	"github.com/stretchr/testify/suite"
+	"golang.org/x/exp/slog"
 	"google.golang.org/grpc"
 	"google.golang.org/grpc/credentials/insecure"
 )
@@ -47,6 +51,12 @@ type testFlightService struct {
 	flight.BaseFlightServer
 	alloc        memory.Allocator
 	failureCount int
+	// If not nil, DoGet of endpoint 0 waits for this to be closed
+	stall chan struct{}
+
+	mu sync.Mutex
+	// The number of DoGets in progress, and the most seen at once
+	active, maxActive int
 }
 
 func (f *testFlightService) DoGet(request *flight.Ticket, stream flight.FlightService_DoGetServer) error {
@@ -56,6 +66,22 @@ func (f *testFlightService) DoGet(request *flight.Ticket, stream flight.FlightSe
 		return fmt.Errorf("Failed request")
 	}
 
+	f.mu.Lock()
+	f.active++
+	if f.active > f.maxActive {
+		f.maxActive = f.active
+	}
+	f.mu.Unlock()
+	defer func() {
+		f.mu.Lock()
+		f.active--
+		f.mu.Unlock()
+	}()
+
+	if request.Ticket[0] == 0 && f.stall != nil {
+		<-f.stall
+	}
+
 	schema := orderingSchema()
 	wr := flight.NewRecordWriter(stream, ipc.WithSchema(schema))
 	defer wr.Close()
@@ -157,7 +183,7 @@ func (suite *RecordReaderTests) TestFallbackFailedConnection() {
 		},
 	}
 
-	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, 3)
+	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, recordReaderOptions{queueSize: 3})
 	suite.NoError(err)
 	defer reader.Release()
 
@@ -187,7 +213,7 @@ func (suite *RecordReaderTests) TestFallbackFailedDoGet() {
 		},
 	}
 
-	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, 3)
+	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, recordReaderOptions{queueSize: 3})
 	suite.NoError(err)
 	defer reader.Release()
 
@@ -201,7 +227,7 @@ func (suite *RecordReaderTests) TestFallbackFailedDoGet() {
 
 	// Not enough retries
 	suite.service.failureCount = 4
-	reader, err = newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, 3)
+	reader, err = newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, recordReaderOptions{queueSize: 3})
 	suite.NoError(err)
 	defer reader.Release()
 	suite.False(reader.Next())
@@ -220,7 +246,7 @@ func (suite *RecordReaderTests) TestFallbackFailed() {
 		},
 	}
 
-	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, 3)
+	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, recordReaderOptions{queueSize: 3})
 	suite.NoError(err)
 	defer reader.Release()
 
@@ -233,7 +259,7 @@ func (suite *RecordReaderTests) TestNoEndpoints() {
 		Schema: flight.SerializeSchema(orderingSchema(), suite.alloc),
 	}
 
-	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, 3)
+	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, recordReaderOptions{queueSize: 3})
 	suite.NoError(err)
 	defer reader.Release()
 
@@ -245,7 +271,7 @@ func (suite *RecordReaderTests) TestNoEndpoints() {
 func (suite *RecordReaderTests) TestNoEndpointsNoSchema() {
 	info := flight.FlightInfo{}
 
-	_, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, 3)
+	_, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, recordReaderOptions{queueSize: 3})
 	suite.ErrorContains(err, "Server returned FlightInfo with no schema and no endpoints, cannot read stream")
 }
 
@@ -254,7 +280,7 @@ func (suite *RecordReaderTests) TestNoEndpointsInvalidSchema() {
 		Schema: []byte("f"),
 	}
 
-	_, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, 3)
+	_, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, recordReaderOptions{queueSize: 3})
 	suite.ErrorContains(err, "Server returned FlightInfo with invalid schema and no endpoints, cannot read stream")
 }
 
@@ -269,7 +295,7 @@ func (suite *RecordReaderTests) TestNoSchema() {
 		},
 	}
 
-	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, 3)
+	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, recordReaderOptions{queueSize: 3})
 	suite.NoError(err)
 	defer reader.Release()
 
@@ -302,7 +328,7 @@ func (suite *RecordReaderTests) TestSchemaEndpointMismatch() {
 		},
 	}
 
-	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, 3)
+	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, recordReaderOptions{queueSize: 3})
 	suite.NoError(err)
 	defer reader.Release()
 
@@ -336,7 +362,7 @@ func (suite *RecordReaderTests) TestOrdering() {
 		},
 	}
 
-	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, 3)
+	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, &info, suite.clCache, recordReaderOptions{queueSize: 3})
 	suite.NoError(err)
 	defer reader.Release()
 
@@ -362,6 +388,225 @@ func (suite *RecordReaderTests) TestOrdering() {
 	suite.NoError(reader.Err())
 }
 
+func (suite *RecordReaderTests) orderingInfo(numEndpoints int) *flight.FlightInfo {
+	location := "grpc://" + suite.server.Addr().String()
+	info := &flight.FlightInfo{Schema: flight.SerializeSchema(orderingSchema(), suite.alloc)}
+	for i := 0; i < numEndpoints; i++ {
+		info.Endpoint = append(info.Endpoint, &flight.FlightEndpoint{
+			Ticket:   &flight.Ticket{Ticket: []byte{byte(i)}},
+			Location: []*flight.Location{{Uri: location}},
+		})
+	}
+	return info
+}
+
+func (suite *RecordReaderTests) TestUnordered() {
+	for _, queueBytes := range []int64{0, 1} {
+		suite.Run(fmt.Sprintf("queueBytes=%d", queueBytes), func() {
+			// Endpoint 0 produces nothing until the other endpoints are drained
+			suite.service.stall = make(chan struct{})
+			defer func() {
+				suite.service.stall = nil
+			}()
+
+			options := recordReaderOptions{queueSize: 3, unordered: true, queueBytes: queueBytes}
+			reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, suite.orderingInfo(4), suite.clCache, options)
+			suite.NoError(err)
+			defer reader.Release()
+
+			nextBatch := make(map[int8]int8)
+			for i := 0; i < 16; i++ {
+				if i == 12 {
+					close(suite.service.stall)
+				}
+				suite.True(reader.Next())
+				rec := reader.Record()
+				epIdx := rec.Column(0).(*array.Int8).Value(0)
+				if i < 12 {
+					suite.NotEqual(int8(0), epIdx)
+				}
+				// Each endpoint's batches are still in order
+				suite.Equal(nextBatch[epIdx], rec.Column(1).(*array.Int8).Value(0))
+				nextBatch[epIdx]++
+			}
+			suite.False(reader.Next())
+			suite.NoError(reader.Err())
+		})
+	}
+}
+
+func (suite *RecordReaderTests) TestUnorderedReleaseEarly() {
+	options := recordReaderOptions{queueSize: 3, unordered: true, queueBytes: 1}
+	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, suite.orderingInfo(4), suite.clCache, options)
+	suite.NoError(err)
+	suite.True(reader.Next())
+	// Must not deadlock with producers waiting for space in the queue
+	reader.Release()
+}
+
+func (suite *RecordReaderTests) TestMaxStreams() {
+	for _, options := range []recordReaderOptions{
+		{queueSize: 3, maxStreams: 2},
+		{queueSize: 3, maxStreams: 2, queueBytes: 1},
+		{queueSize: 3, maxStreams: 2, unordered: true},
+		{queueSize: 3, maxStreams: 2, unordered: true, queueBytes: 1},
+	} {
+		suite.Run(fmt.Sprintf("%+v", options), func() {
+			suite.service.mu.Lock()
+			suite.service.maxActive = 0
+			suite.service.mu.Unlock()
+
+			reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, suite.orderingInfo(6), suite.clCache, options)
+			suite.NoError(err)
+			defer reader.Release()
+
+			nextBatch := make(map[int8]int8)
+			lastEndpoint := int8(0)
+			for i := 0; i < 24; i++ {
+				suite.True(reader.Next())
+				rec := reader.Record()
+				epIdx := rec.Column(0).(*array.Int8).Value(0)
+				if !options.unordered {
+					suite.GreaterOrEqual(epIdx, lastEndpoint)
+					lastEndpoint = epIdx
+				}
+				suite.Equal(nextBatch[epIdx], rec.Column(1).(*array.Int8).Value(0))
+				nextBatch[epIdx]++
+			}
+			suite.False(reader.Next())
+			suite.NoError(reader.Err())
+
+			suite.service.mu.Lock()
+			defer suite.service.mu.Unlock()
+			suite.LessOrEqual(suite.service.maxActive, 2)
+		})
+	}
+}
+
+func (suite *RecordReaderTests) TestMaxStreamsReleaseEarly() {
+	options := recordReaderOptions{queueSize: 1, maxStreams: 1, queueBytes: 1}
+	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, suite.orderingInfo(4), suite.clCache, options)
+	suite.NoError(err)
+	suite.True(reader.Next())
+	// Must not deadlock with endpoints that were never started
+	reader.Release()
+}
+
+func (suite *RecordReaderTests) TestEndpointStats() {
+	var buf bytes.Buffer
+	var mu sync.Mutex
+	logger := slog.New(slog.NewJSONHandler(&lockedWriter{w: &buf, mu: &mu}, &slog.HandlerOptions{Level: slog.LevelDebug}))
+
+	options := recordReaderOptions{queueSize: 3, logger: logger}
+	rdr, err := newRecordReader(context.Background(), suite.alloc, suite.cl, suite.orderingInfo(3), suite.clCache, options)
+	suite.NoError(err)
+	for rdr.Next() {
+	}
+	suite.NoError(rdr.Err())
+	rdr.Release()
+
+	// The same statistics are kept for OptionStatementResultStats
+	summaries := rdr.(*reader).resultStats()
+	suite.Require().Len(summaries, 3)
+	for i, summary := range summaries {
+		suite.Equal(i, summary.Endpoint)
+		suite.Equal(int64(4), summary.Batches)
+		suite.Equal(int64(4), summary.Rows)
+		suite.Greater(summary.Bytes, int64(0))
+		suite.Greater(summary.BytesPerSecond, float64(0))
+		suite.Empty(summary.Error)
+	}
+
+	mu.Lock()
+	defer mu.Unlock()
+	seen := make(map[int]bool)
+	decoder := json.NewDecoder(&buf)
+	for decoder.More() {
+		var entry struct {
+			Msg      string `json:"msg"`
+			Endpoint int    `json:"endpoint"`
+			Batches  int64  `json:"batches"`
+			Rows     int64  `json:"rows"`
+			Bytes    int64  `json:"bytes"`
+		}
+		suite.Require().NoError(decoder.Decode(&entry))
+		suite.Equal("DoGet endpoint finished", entry.Msg)
+		suite.Equal(int64(4), entry.Batches)
+		suite.Equal(int64(4), entry.Rows)
+		suite.Greater(entry.Bytes, int64(0))
+		seen[entry.Endpoint] = true
+	}
+	suite.Equal(map[int]bool{0: true, 1: true, 2: true}, seen)
+}
+
+func (suite *RecordReaderTests) TestAllocatedBodies() {
+	bodies := memory.NewCheckedAllocator(memory.DefaultAllocator)
+	defer bodies.AssertSize(suite.T(), 0)
+
+	options := recordReaderOptions{queueSize: 3, stream: streamOptions{bodyAlloc: bodies}}
+	reader, err := newRecordReader(context.Background(), suite.alloc, suite.cl, suite.orderingInfo(2), suite.clCache, options)
+	suite.NoError(err)
+
+	for epIdx := int8(0); epIdx < 2; epIdx++ {
+		for batchIdx := int8(0); batchIdx < 4; batchIdx++ {
+			suite.True(reader.Next())
+			rec := reader.Record()
+			suite.Equal(epIdx, rec.Column(0).(*array.Int8).Value(0))
+			suite.Equal(batchIdx, rec.Column(1).(*array.Int8).Value(0))
+			// The batch lives in the body copied into the allocator
+			suite.Greater(bodies.CurrentAlloc(), 0)
+		}
+	}
+	suite.False(reader.Next())
+	suite.NoError(reader.Err())
+	reader.Release()
+}
+
+func (suite *RecordReaderTests) TestFlightDataCodec() {
+	mem := memory.NewCheckedAllocator(memory.DefaultAllocator)
+	defer mem.AssertSize(suite.T(), 0)
+
+	codec := flightDataCodec{mem: mem}
+	wire, err := codec.Marshal(&flight.FlightData{
+		FlightDescriptor: &flight.FlightDescriptor{Type: flight.DescriptorCMD, Cmd: []byte("cmd")},
+		DataHeader:       []byte("header"),
+		AppMetadata:      []byte("metadata"),
+		DataBody:         []byte("body"),
+	})
+	suite.Require().NoError(err)
+
+	var data allocatedFlightData
+	suite.Require().NoError(codec.Unmarshal(wire, &data))
+	// gRPC may reuse the buffer of the received message
+	for i := range wire {
+		wire[i] = 0
+	}
+	suite.Equal([]byte("header"), data.header)
+	suite.Equal([]byte("body"), data.body.Bytes())
+	suite.Greater(mem.CurrentAlloc(), 0)
+	data.body.Release()
+
+	suite.Error(codec.Unmarshal([]byte{0xff}, &allocatedFlightData{}))
+
+	// Anything else is plain protobuf
+	wire, err = codec.Marshal(&flight.Ticket{Ticket: []byte("ticket")})
+	suite.Require().NoError(err)
+	var ticket flight.Ticket
+	suite.Require().NoError(codec.Unmarshal(wire, &ticket))
+	suite.Equal([]byte("ticket"), ticket.GetTicket())
+}
+
+type lockedWriter struct {
+	w  *bytes.Buffer
+	mu *sync.Mutex
+}
+
+func (l *lockedWriter) Write(p []byte) (int, error) {
+	l.mu.Lock()
+	defer l.mu.Unlock()
+	return l.w.Write(p)
+}
+
 func TestRecordReader(t *testing.T) {
 	suite.Run(t, &RecordReaderTests{})
 }
@@ -0,0 +1,475 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package flightsql
+
+import (
+	"container/list"
+	"crypto/sha256"
+	"os"
+	"sort"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+	"unicode"
+
+	"github.com/apache/arrow/go/v13/arrow"
+	"github.com/apache/arrow/go/v13/arrow/array"
+	"github.com/apache/arrow/go/v13/arrow/ipc"
+	"github.com/apache/arrow/go/v13/arrow/memory"
+	"google.golang.org/grpc/metadata"
+)
+
+const defaultResultCacheTTL = time.Minute
+
+// resultCache keeps the results of recently executed queries, so that
+// repeating a query does not repeat its GetFlightInfo and DoGets.
+//
+// Only SQL queries that read data (see isReadQuery) are cached. Anything
+// else the driver executes through the database (updates, other queries,
+// bulk ingestion, commits) may change data, and since the driver cannot
+// tell which results that affects, it empties the cache.
+//
+// It is shared by all connections of a database, and bounded by the total
+// size of the cached batches (a gcache.Cache, as used for clients, can
+// only be bounded by its number of entries). Entries are kept in memory,
+// or written as IPC streams to spillDir if set. The cache is emptied when
+// the last connection of the database is closed, since Go databases are
+// never explicitly released.
+type resultCache struct {
+	mu          sync.Mutex
+	maxBytes    int64
+	ttl         time.Duration
+	spillDir    string
+	alloc       memory.Allocator
+	connections int
+
+	// Incremented whenever the cache is emptied because data may have
+	// changed, so that results read from before then are not kept
+	generation uint64
+
+	used    int64
+	entries map[string]*list.Element
+	// Of *cachedResult, most recently used at the front
+	lru *list.List
+}
+
+type cachedResult struct {
+	key    string
+	schema *arrow.Schema
+	// Either the batches themselves, or the file they were spilled to
+	records []arrow.Record
+	path    string
+	rows    int64
+	size    int64
+	expires time.Time
+}
+
+func newResultCache(alloc memory.Allocator) *resultCache {
+	return &resultCache{
+		ttl:     defaultResultCacheTTL,
+		alloc:   alloc,
+		entries: make(map[string]*list.Element),
+		lru:     list.New(),
+	}
+}
+
+func (c *resultCache) enabled() bool {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.maxBytes > 0
+}
+
+func (c *resultCache) limit() int64 {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.maxBytes
+}
+
+func (c *resultCache) setMaxBytes(maxBytes int64) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	c.maxBytes = maxBytes
+	c.evictLocked(0)
+}
+
+func (c *resultCache) setTTL(ttl time.Duration) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	c.ttl = ttl
+}
+
+func (c *resultCache) setSpillDir(dir string) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	c.spillDir = dir
+}
+
+func (c *resultCache) settings() (maxBytes int64, ttl time.Duration, spillDir string) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.maxBytes, c.ttl, c.spillDir
+}
+
+// openConnection and closeConnection track the connections using the
+// cache; closing the last one empties it.
+func (c *resultCache) openConnection() {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	c.connections++
+}
+
+func (c *resultCache) closeConnection() {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	c.connections--
+	if c.connections == 0 {
+		c.clearLocked()
+	}
+}
+
+// invalidate empties the cache after data may have changed.
+func (c *resultCache) invalidate() {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	c.generation++
+	c.clearLocked()
+}
+
+// currentGeneration is to be passed to put by a reader of a result that
+// starts now.
+func (c *resultCache) currentGeneration() uint64 {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	return c.generation
+}
+
+func (c *resultCache) clearLocked() {
+	for c.lru.Len() > 0 {
+		c.removeLocked(c.lru.Back())
+	}
+}
+
+func (c *resultCache) removeLocked(elem *list.Element) {
+	entry := c.lru.Remove(elem).(*cachedResult)
+	delete(c.entries, entry.key)
+	c.used -= entry.size
+	entry.discard()
+}
+
+func (e *cachedResult) discard() {
+	for _, rec := range e.records {
+		rec.Release()
+	}
+	e.records = nil
+	if e.path != "" {
+		// Readers that already opened the file keep reading it (except on
+		// Windows, where this fails and the file is left behind)
+		_ = os.Remove(e.path)
+	}
+}
+
+// evictLocked removes expired entries, then the least recently used
+// entries until size more bytes fit.
+func (c *resultCache) evictLocked(size int64) {
+	now := time.Now()
+	for elem := c.lru.Back(); elem != nil; {
+		prev := elem.Prev()
+		if now.After(elem.Value.(*cachedResult).expires) {
+			c.removeLocked(elem)
+		}
+		elem = prev
+	}
+	for c.lru.Len() > 0 && c.used+size > c.maxBytes {
+		c.removeLocked(c.lru.Back())
+	}
+}
+
+// get returns a reader over the cached result for key, and its number of
+// rows, if there is one.
+func (c *resultCache) get(key string) (array.RecordReader, int64, bool) {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	elem, ok := c.entries[key]
+	if !ok {
+		return nil, -1, false
+	}
+	entry := elem.Value.(*cachedResult)
+	if time.Now().After(entry.expires) {
+		c.removeLocked(elem)
+		return nil, -1, false
+	}
+
+	if entry.path == "" {
+		rdr, err := array.NewRecordReader(entry.schema, entry.records)
+		if err != nil {
+			return nil, -1, false
+		}
+		c.lru.MoveToFront(elem)
+		return rdr, entry.rows, true
+	}
+
+	f, err := os.Open(entry.path)
+	if err != nil {
+		c.removeLocked(elem)
+		return nil, -1, false
+	}
+	rdr, err := ipc.NewReader(f, ipc.WithAllocator(c.alloc), ipc.WithSchema(entry.schema))
+	if err != nil {
+		f.Close()
+		c.removeLocked(elem)
+		return nil, -1, false
+	}
+	c.lru.MoveToFront(elem)
+	return &spilledReader{Reader: rdr, file: f, refCount: 1}, entry.rows, true
+}
+
+// put caches a result, taking ownership of the records. The result is
+// dropped if the cache was invalidated since generation.
+func (c *resultCache) put(key string, generation uint64, schema *arrow.Schema, records []arrow.Record, rows, size int64) {
+	entry := &cachedResult{key: key, schema: schema, records: records, rows: rows, size: size}
+	c.mu.Lock()
+	maxBytes, spillDir, stale := c.maxBytes, c.spillDir, generation != c.generation
+	c.mu.Unlock()
+	if stale || size > maxBytes {
+		entry.discard()
+		return
+	}
+
+	if spillDir != "" {
+		// If spilling fails, keep the result in memory
+		if path, err := spill(spillDir, schema, records, c.alloc); err == nil {
+			for _, rec := range records {
+				rec.Release()
+			}
+			entry.records = nil
+			entry.path = path
+		}
+	}
+
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	if generation != c.generation || size > c.maxBytes {
+		entry.discard()
+		return
+	}
+	if elem, ok := c.entries[key]; ok {
+		c.removeLocked(elem)
+	}
+	c.evictLocked(size)
+	entry.expires = time.Now().Add(c.ttl)
+	c.entries[key] = c.lru.PushFront(entry)
+	c.used += size
+}
+
+// spill writes records to a new IPC stream file in dir.
+func spill(dir string, schema *arrow.Schema, records []arrow.Record, alloc memory.Allocator) (string, error) {
+	f, err := os.CreateTemp(dir, "adbc-flightsql-*.arrows")
+	if err != nil {
+		return "", err
+	}
+	wr := ipc.NewWriter(f, ipc.WithSchema(schema), ipc.WithAllocator(alloc))
+	for _, rec := range records {
+		if err = wr.Write(rec); err != nil {
+			break
+		}
+	}
+	if closeErr := wr.Close(); err == nil {
+		err = closeErr
+	}
+	if closeErr := f.Close(); err == nil {
+		err = closeErr
+	}
+	if err != nil {
+		_ = os.Remove(f.Name())
+		return "", err
+	}
+	return f.Name(), nil
+}
+
+// spilledReader reads a spilled result and closes the file when released.
+type spilledReader struct {
+	*ipc.Reader
+	file     *os.File
+	refCount int64
+}
+
+func (r *spilledReader) Retain() {
+	atomic.AddInt64(&r.refCount, 1)
+}
+
+func (r *spilledReader) Release() {
+	if atomic.AddInt64(&r.refCount, -1) == 0 {
+		r.Reader.Release()
+		r.file.Close()
+	}
+}
+
+// cachingReader passes a result through while keeping its batches, and
+// caches them once the result has been read to the end without error.
+// Results that turn out to be larger than the whole cache are not kept.
+type cachingReader struct {
+	array.RecordReader
+	refCount   int64
+	cache      *resultCache
+	key        string
+	generation uint64
+
+	records []arrow.Record
+	rows    int64
+	size    int64
+	done    bool
+}
+
+// newCachingReader caches the result read from rdr, unless the cache is
+// invalidated after generation (taken before the query was executed).
+func newCachingReader(rdr array.RecordReader, cache *resultCache, key string, generation uint64) *cachingReader {
+	return &cachingReader{RecordReader: rdr, refCount: 1, cache: cache, key: key, generation: generation}
+}
+
+func (r *cachingReader) abandon() {
+	for _, rec := range r.records {
+		rec.Release()
+	}
+	r.records = nil
+	r.done = true
+}
+
+func (r *cachingReader) Next() bool {
+	if !r.RecordReader.Next() {
+		if !r.done {
+			if r.RecordReader.Err() != nil {
+				r.abandon()
+			} else {
+				r.cache.put(r.key, r.generation, r.Schema(), r.records, r.rows, r.size)
+				r.records = nil
+				r.done = true
+			}
+		}
+		return false
+	}
+
+	if !r.done {
+		rec := r.RecordReader.Record()
+		r.size += recordSize(rec)
+		if r.size > r.cache.limit() {
+			r.abandon()
+		} else {
+			rec.Retain()
+			r.records = append(r.records, rec)
+			r.rows += rec.NumRows()
+		}
+	}
+	return true
+}
+
+func (r *cachingReader) Retain() {
+	atomic.AddInt64(&r.refCount, 1)
+}
+
+func (r *cachingReader) Release() {
+	if atomic.AddInt64(&r.refCount, -1) == 0 {
+		r.abandon()
+		r.RecordReader.Release()
+	}
+}
+
+// readQueryKeywords are the first keywords of the queries that are
+// cached. The driver cannot see what a query does beyond its text, so it
+// assumes these only read data; a query that modifies data this way (with
+// a data-modifying WITH clause, or a function with side effects) should
+// bypass the cache.
+var readQueryKeywords = []string{"SELECT", "WITH", "VALUES", "TABLE"}
+
+// isReadQuery reports whether a SQL query is one that is cached: its
+// first keyword, after any comments and opening parentheses, is one of
+// readQueryKeywords.
+func isReadQuery(query string) bool {
+	for {
+		query = strings.TrimLeftFunc(query, func(ch rune) bool { return unicode.IsSpace(ch) || ch == '(' })
+		if strings.HasPrefix(query, "--") {
+			end := strings.IndexByte(query, '\n')
+			if end < 0 {
+				return false
+			}
+			query = query[end+1:]
+		} else if strings.HasPrefix(query, "/*") {
+			end := strings.Index(query, "*/")
+			if end < 0 {
+				return false
+			}
+			query = query[end+2:]
+		} else {
+			break
+		}
+	}
+
+	end := strings.IndexFunc(query, func(ch rune) bool { return !unicode.IsLetter(ch) })
+	if end < 0 {
+		end = len(query)
+	}
+	for _, keyword := range readQueryKeywords {
+		if strings.EqualFold(query[:end], keyword) {
+			return true
+		}
+	}
+	return false
+}
+
+// resultCacheKey hashes everything that determines the result of a
+// query: the query, the bound parameters (hashed on Bind), and the call
+// headers (which may e.g. authenticate a different user). The query is
+// only trimmed: whitespace elsewhere may be significant (in literals,
+// or ending a comment), and the driver does not parse SQL dialects.
+func resultCacheKey(query string, prepared bool, params []byte, hdrs metadata.MD) string {
+	h := sha256.New()
+	h.Write([]byte(strings.TrimSpace(query)))
+	h.Write([]byte{0})
+	if prepared {
+		h.Write([]byte("prepared\x00"))
+		h.Write(params)
+	}
+
+	keys := make([]string, 0, len(hdrs))
+	for k := range hdrs {
+		keys = append(keys, k)
+	}
+	sort.Strings(keys)
+	for _, k := range keys {
+		for _, v := range hdrs[k] {
+			h.Write([]byte(k))
+			h.Write([]byte{0})
+			h.Write([]byte(v))
+			h.Write([]byte{0})
+		}
+	}
+	return string(h.Sum(nil))
+}
+
+// hashParameters hashes bound parameters by their IPC serialization.
+func hashParameters(values arrow.Record) ([]byte, error) {
+	h := sha256.New()
+	wr := ipc.NewWriter(h, ipc.WithSchema(values.Schema()))
+	if err := wr.Write(values); err != nil {
+		return nil, err
+	}
+	if err := wr.Close(); err != nil {
+		return nil, err
+	}
+	return h.Sum(nil), nil
+}
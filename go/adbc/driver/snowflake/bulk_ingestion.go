@@ -0,0 +1,318 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package snowflake
+
+import (
+	"context"
+	"database/sql/driver"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"runtime"
+	"strconv"
+	"strings"
+	"sync/atomic"
+
+	"github.com/apache/arrow-adbc/go/adbc"
+	"github.com/apache/arrow/go/v13/arrow"
+	"github.com/apache/arrow/go/v13/arrow/array"
+	"github.com/apache/arrow/go/v13/arrow/memory"
+	"github.com/apache/arrow/go/v13/parquet"
+	"github.com/apache/arrow/go/v13/parquet/compress"
+	"github.com/apache/arrow/go/v13/parquet/pqarrow"
+	"golang.org/x/sync/errgroup"
+)
+
+const (
+	defaultIngestUploadConcurrency = 8
+	defaultIngestTargetFileSize    = 10 * 1024 * 1024
+	// PUT accepts PARALLEL between 1 and 99
+	maxIngestUploadConcurrency = 99
+)
+
+// ingestOptions controls bulk ingestion through staged Parquet files.
+type ingestOptions struct {
+	method            string
+	writerConcurrency int
+	uploadConcurrency int
+	targetFileSize    int64
+}
+
+func defaultIngestOptions() ingestOptions {
+	return ingestOptions{
+		method:            OptionValueIngestMethodInsert,
+		writerConcurrency: runtime.NumCPU(),
+		uploadConcurrency: defaultIngestUploadConcurrency,
+		targetFileSize:    defaultIngestTargetFileSize,
+	}
+}
+
+// tableStage returns the stage of a table: @%table, or @db.schema.%table
+// for a qualified name.
+func tableStage(table string) string {
+	if i := strings.LastIndex(table, "."); i >= 0 {
+		return "@" + table[:i+1] + "%" + table[i+1:]
+	}
+	return "@%" + table
+}
+
+// executeIngestCopy loads the bound data by writing it into Parquet files
+// in a temporary directory, uploading them with a single PUT, and loading
+// them with COPY INTO. Unlike binding batches to INSERTs, which converts
+// every value into a Go value for the REST API, this keeps the data in
+// Arrow until it is encoded as Parquet, and lets Snowflake load the files
+// in parallel.
+func (st *statement) executeIngestCopy(ctx context.Context) (int64, error) {
+	if _, err := st.initIngest(ctx); err != nil {
+		return -1, err
+	}
+
+	var rdr array.RecordReader
+	if st.bound != nil {
+		var err error
+		rdr, err = array.NewRecordReader(st.bound.Schema(), []arrow.Record{st.bound})
+		if err != nil {
+			return -1, errToAdbcErr(adbc.StatusInternal, err)
+		}
+		defer rdr.Release()
+	} else {
+		rdr = st.streamBind
+	}
+
+	dir, err := os.MkdirTemp("", "adbc-snowflake-ingest-")
+	if err != nil {
+		return -1, errToAdbcErr(adbc.StatusIO, err)
+	}
+	defer os.RemoveAll(dir)
+
+	files, err := writeParquetFiles(ctx, rdr, dir, st.ingest, st.alloc)
+	if err != nil {
+		return -1, errToAdbcErr(adbc.StatusIO, err)
+	}
+	if files == 0 {
+		return 0, nil
+	}
+
+	// Upload into a directory of its own, so that concurrent loads into
+	// the same table do not pick up each other's files
+	stage := tableStage(st.targetTable) + "/" + filepath.Base(dir) + "/"
+	putQuery := fmt.Sprintf("PUT 'file://%s/*.parquet' %s PARALLEL=%d AUTO_COMPRESS=FALSE SOURCE_COMPRESSION=NONE",
+		filepath.ToSlash(dir), stage, st.ingest.uploadConcurrency)
+	if _, err := st.cnxn.cn.ExecContext(ctx, putQuery, nil); err != nil {
+		st.removeStaged(ctx, stage)
+		return -1, errToAdbcErr(adbc.StatusIO, err)
+	}
+
+	copyQuery := fmt.Sprintf("COPY INTO %s FROM %s FILE_FORMAT=(TYPE=PARQUET) MATCH_BY_COLUMN_NAME=CASE_INSENSITIVE PURGE=TRUE",
+		st.targetTable, stage)
+	rows, err := st.cnxn.cn.QueryContext(ctx, copyQuery, nil)
+	if err != nil {
+		st.removeStaged(ctx, stage)
+		return -1, errToAdbcErr(adbc.StatusInternal, err)
+	}
+	n, err := sumRowsLoaded(rows)
+	if err != nil {
+		return -1, errToAdbcErr(adbc.StatusInternal, err)
+	}
+	return n, nil
+}
+
+// removeStaged makes a best effort to remove uploaded files that were
+// not loaded (and so not purged by COPY INTO).
+func (st *statement) removeStaged(ctx context.Context, stage string) {
+	_, _ = st.cnxn.cn.ExecContext(ctx, "REMOVE "+stage, nil)
+}
+
+// sumRowsLoaded adds up the rows_loaded column of the result of COPY
+// INTO, which has a row per file.
+func sumRowsLoaded(rows driver.Rows) (int64, error) {
+	defer rows.Close()
+
+	cols := rows.Columns()
+	col := -1
+	for i, name := range cols {
+		if strings.EqualFold(name, "rows_loaded") {
+			col = i
+		}
+	}
+
+	dest := make([]driver.Value, len(cols))
+	var n int64
+	for {
+		if err := rows.Next(dest); errors.Is(err, io.EOF) {
+			break
+		} else if err != nil {
+			return -1, err
+		}
+		if col < 0 {
+			// No files were loaded
+			continue
+		}
+
+		switch v := dest[col].(type) {
+		case int64:
+			n += v
+		case string:
+			loaded, err := strconv.ParseInt(v, 10, 64)
+			if err != nil {
+				return -1, fmt.Errorf("invalid rows_loaded '%s': %w", v, err)
+			}
+			n += loaded
+		case nil:
+		default:
+			return -1, fmt.Errorf("invalid rows_loaded %v (%T)", v, v)
+		}
+	}
+	return n, nil
+}
+
+// writeParquetFiles writes the records of rdr into numbered Parquet files
+// in dir, with opts.writerConcurrency files being written at once, and
+// returns the number of files written.
+func writeParquetFiles(ctx context.Context, rdr array.RecordReader, dir string, opts ingestOptions, alloc memory.Allocator) (int, error) {
+	g, ctx := errgroup.WithContext(ctx)
+	records := make(chan arrow.Record, opts.writerConcurrency)
+	var files int64
+
+	g.Go(func() error {
+		defer close(records)
+		for rdr.Next() {
+			rec := rdr.Record()
+			rec.Retain()
+			select {
+			case records <- rec:
+			case <-ctx.Done():
+				rec.Release()
+				return ctx.Err()
+			}
+		}
+		return rdr.Err()
+	})
+
+	props := parquet.NewWriterProperties(
+		parquet.WithAllocator(alloc),
+		parquet.WithCompression(compress.Codecs.Snappy),
+		parquet.WithDictionaryDefault(false))
+	arrowProps := pqarrow.NewArrowWriterProperties(pqarrow.WithAllocator(alloc))
+	for i := 0; i < opts.writerConcurrency; i++ {
+		g.Go(func() error {
+			w := &parquetFileWriter{
+				schema:     rdr.Schema(),
+				props:      props,
+				arrowProps: arrowProps,
+				targetSize: opts.targetFileSize,
+				create: func() (*os.File, error) {
+					n := atomic.AddInt64(&files, 1)
+					return os.Create(filepath.Join(dir, fmt.Sprintf("%d.parquet", n)))
+				},
+			}
+			for rec := range records {
+				err := w.write(rec)
+				rec.Release()
+				if err != nil {
+					w.abort()
+					return err
+				}
+			}
+			return w.close()
+		})
+	}
+
+	err := g.Wait()
+	// Release anything left behind by writers that failed
+	for rec := range records {
+		rec.Release()
+	}
+	return int(atomic.LoadInt64(&files)), err
+}
+
+// parquetFileWriter writes records into a series of Parquet files, moving
+// on to the next once the current one reaches the target size.
+type parquetFileWriter struct {
+	schema     *arrow.Schema
+	props      *parquet.WriterProperties
+	arrowProps pqarrow.ArrowWriterProperties
+	targetSize int64
+	create     func() (*os.File, error)
+
+	file    *os.File
+	counter *countingWriter
+	writer  *pqarrow.FileWriter
+}
+
+type countingWriter struct {
+	w io.Writer
+	n int64
+}
+
+func (c *countingWriter) Write(p []byte) (int, error) {
+	n, err := c.w.Write(p)
+	c.n += int64(n)
+	return n, err
+}
+
+func (w *parquetFileWriter) write(rec arrow.Record) error {
+	if w.writer == nil {
+		f, err := w.create()
+		if err != nil {
+			return err
+		}
+		w.file = f
+		// Not the file itself, so that closing the Parquet writer does
+		// not close the file out from under us
+		w.counter = &countingWriter{w: f}
+		if w.writer, err = pqarrow.NewFileWriter(w.schema, w.counter, w.props, w.arrowProps); err != nil {
+			w.abort()
+			return err
+		}
+	}
+
+	if err := w.writer.Write(rec); err != nil {
+		return err
+	}
+	if w.counter.n >= w.targetSize {
+		return w.close()
+	}
+	return nil
+}
+
+func (w *parquetFileWriter) close() error {
+	if w.file == nil {
+		return nil
+	}
+	var err error
+	if w.writer != nil {
+		err = w.writer.Close()
+	}
+	if closeErr := w.file.Close(); err == nil {
+		err = closeErr
+	}
+	w.file, w.counter, w.writer = nil, nil, nil
+	return err
+}
+
+// abort closes the current file after an error (the whole directory is
+// discarded).
+func (w *parquetFileWriter) abort() {
+	if w.file != nil {
+		w.file.Close()
+	}
+	w.file, w.counter, w.writer = nil, nil, nil
+}
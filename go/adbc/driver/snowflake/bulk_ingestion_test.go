@@ -0,0 +1,239 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package snowflake
+
+import (
+	"context"
+	"database/sql/driver"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"regexp"
+	"strconv"
+	"strings"
+	"testing"
+
+	"github.com/apache/arrow-adbc/go/adbc"
+	"github.com/apache/arrow/go/v13/arrow"
+	"github.com/apache/arrow/go/v13/arrow/array"
+	"github.com/apache/arrow/go/v13/arrow/memory"
+	"github.com/apache/arrow/go/v13/parquet/file"
+	"github.com/stretchr/testify/require"
+)
+
+var putPattern = regexp.MustCompile(`^PUT 'file://(.+)/\*\.parquet' (\S+) PARALLEL=(\d+) `)
+
+// stagingConn stands in for Snowflake: it records the statements it is
+// sent, and on PUT, reads back the Parquet files being uploaded, so that
+// COPY INTO can report the rows they hold.
+type stagingConn struct {
+	snowflakeConn
+
+	statements []string
+	// The number of rows in each uploaded file
+	fileRows []int64
+	failCopy bool
+}
+
+func (c *stagingConn) ExecContext(_ context.Context, query string, _ []driver.NamedValue) (driver.Result, error) {
+	c.statements = append(c.statements, query)
+	if m := putPattern.FindStringSubmatch(query); m != nil {
+		paths, err := filepath.Glob(filepath.Join(filepath.FromSlash(m[1]), "*.parquet"))
+		if err != nil {
+			return nil, err
+		}
+		for _, path := range paths {
+			rdr, err := file.OpenParquetFile(path, false)
+			if err != nil {
+				return nil, err
+			}
+			c.fileRows = append(c.fileRows, rdr.NumRows())
+			rdr.Close()
+		}
+	}
+	return driver.RowsAffected(0), nil
+}
+
+func (c *stagingConn) QueryContext(_ context.Context, query string, _ []driver.NamedValue) (driver.Rows, error) {
+	c.statements = append(c.statements, query)
+	if c.failCopy {
+		return nil, errors.New("COPY failed")
+	}
+	rows := &copyRows{}
+	for i, n := range c.fileRows {
+		rows.values = append(rows.values, []driver.Value{fmt.Sprintf("%d.parquet", i+1), "LOADED", strconv.FormatInt(n, 10)})
+	}
+	return rows, nil
+}
+
+type copyRows struct {
+	values [][]driver.Value
+}
+
+func (r *copyRows) Columns() []string { return []string{"file", "status", "rows_loaded"} }
+func (r *copyRows) Close() error      { return nil }
+func (r *copyRows) Next(dest []driver.Value) error {
+	if len(r.values) == 0 {
+		return io.EOF
+	}
+	copy(dest, r.values[0])
+	r.values = r.values[1:]
+	return nil
+}
+
+func bindIngestRecords(t *testing.T, st *statement, mem memory.Allocator, batches, rowsPerBatch int) {
+	schema := arrow.NewSchema([]arrow.Field{
+		{Name: "id", Type: arrow.PrimitiveTypes.Int64},
+		{Name: "name", Type: arrow.BinaryTypes.String, Nullable: true},
+	}, nil)
+
+	bldr := array.NewRecordBuilder(mem, schema)
+	defer bldr.Release()
+	recs := make([]arrow.Record, batches)
+	for i := range recs {
+		for j := 0; j < rowsPerBatch; j++ {
+			id := int64(i*rowsPerBatch + j)
+			bldr.Field(0).(*array.Int64Builder).Append(id)
+			bldr.Field(1).(*array.StringBuilder).Append(strings.Repeat("x", int(id%64)))
+		}
+		recs[i] = bldr.NewRecord()
+		defer recs[i].Release()
+	}
+
+	rdr, err := array.NewRecordReader(schema, recs)
+	require.NoError(t, err)
+	defer rdr.Release()
+	require.NoError(t, st.BindStream(context.Background(), rdr))
+}
+
+func newStagingStatement(t *testing.T, mem memory.Allocator, cn *stagingConn) *statement {
+	st := &statement{
+		alloc:               mem,
+		cnxn:                &cnxn{cn: cn},
+		queueSize:           defaultStatementQueueSize,
+		prefetchConcurrency: defaultPrefetchConcurrency,
+		ingest:              defaultIngestOptions(),
+	}
+	require.NoError(t, st.SetOption(adbc.OptionKeyIngestTargetTable, "db.schema.tbl"))
+	require.NoError(t, st.SetOption(OptionStatementIngestMethod, OptionValueIngestMethodCopy))
+	return st
+}
+
+func TestIngestCopy(t *testing.T) {
+	mem := memory.NewCheckedAllocator(memory.DefaultAllocator)
+	defer mem.AssertSize(t, 0)
+
+	cn := &stagingConn{}
+	st := newStagingStatement(t, mem, cn)
+	require.NoError(t, st.SetOptionInt(OptionStatementIngestWriterConcurrency, 3))
+	require.NoError(t, st.SetOptionInt(OptionStatementIngestUploadConcurrency, 4))
+	// Small enough that every batch finishes a file
+	require.NoError(t, st.SetOptionInt(OptionStatementIngestTargetFileSize, 1))
+
+	bindIngestRecords(t, st, mem, 10, 100)
+	n, err := st.ExecuteUpdate(context.Background())
+	require.NoError(t, err)
+	require.EqualValues(t, 1000, n)
+	require.NoError(t, st.Close())
+
+	require.Len(t, cn.statements, 3)
+	require.True(t, strings.HasPrefix(cn.statements[0], "CREATE TABLE db.schema.tbl ("), cn.statements[0])
+
+	m := putPattern.FindStringSubmatch(cn.statements[1])
+	require.NotNil(t, m, cn.statements[1])
+	require.Equal(t, "@db.schema.%tbl/"+filepath.Base(m[1])+"/", m[2])
+	require.Equal(t, "4", m[3])
+	require.Contains(t, cn.statements[1], "AUTO_COMPRESS=FALSE")
+	require.Equal(t, fmt.Sprintf("COPY INTO db.schema.tbl FROM %s FILE_FORMAT=(TYPE=PARQUET) MATCH_BY_COLUMN_NAME=CASE_INSENSITIVE PURGE=TRUE", m[2]),
+		cn.statements[2])
+
+	require.Len(t, cn.fileRows, 10)
+	for _, rows := range cn.fileRows {
+		require.EqualValues(t, 100, rows)
+	}
+
+	_, err = os.Stat(filepath.FromSlash(m[1]))
+	require.True(t, os.IsNotExist(err), "temporary directory was not removed")
+}
+
+func TestIngestCopyTargetFileSize(t *testing.T) {
+	mem := memory.NewCheckedAllocator(memory.DefaultAllocator)
+	defer mem.AssertSize(t, 0)
+
+	cn := &stagingConn{}
+	st := newStagingStatement(t, mem, cn)
+	require.NoError(t, st.SetOption(OptionStatementIngestWriterConcurrency, "1"))
+	require.NoError(t, st.SetOption(adbc.OptionKeyIngestMode, adbc.OptionValueIngestModeAppend))
+
+	bindIngestRecords(t, st, mem, 10, 100)
+	n, err := st.ExecuteUpdate(context.Background())
+	require.NoError(t, err)
+	require.EqualValues(t, 1000, n)
+	require.NoError(t, st.Close())
+
+	// No CREATE TABLE when appending, and everything fits in one file
+	require.Len(t, cn.statements, 2)
+	require.Equal(t, []int64{1000}, cn.fileRows)
+}
+
+func TestIngestCopyFailure(t *testing.T) {
+	mem := memory.NewCheckedAllocator(memory.DefaultAllocator)
+	defer mem.AssertSize(t, 0)
+
+	cn := &stagingConn{failCopy: true}
+	st := newStagingStatement(t, mem, cn)
+
+	bindIngestRecords(t, st, mem, 2, 10)
+	_, err := st.ExecuteUpdate(context.Background())
+	require.Error(t, err)
+	require.NoError(t, st.Close())
+
+	// The uploaded files are removed from the stage
+	require.Len(t, cn.statements, 4)
+	m := putPattern.FindStringSubmatch(cn.statements[1])
+	require.NotNil(t, m, cn.statements[1])
+	require.Equal(t, "REMOVE "+m[2], cn.statements[3])
+}
+
+func TestIngestCopyOptions(t *testing.T) {
+	st := newStagingStatement(t, memory.DefaultAllocator, &stagingConn{})
+
+	method, err := st.GetOption(OptionStatementIngestMethod)
+	require.NoError(t, err)
+	require.Equal(t, OptionValueIngestMethodCopy, method)
+
+	var adbcErr adbc.Error
+	err = st.SetOption(OptionStatementIngestMethod, "bulk")
+	require.ErrorAs(t, err, &adbcErr)
+	require.Equal(t, adbc.StatusInvalidArgument, adbcErr.Code)
+
+	err = st.SetOptionInt(OptionStatementIngestUploadConcurrency, 100)
+	require.ErrorAs(t, err, &adbcErr)
+	require.Equal(t, adbc.StatusInvalidArgument, adbcErr.Code)
+
+	err = st.SetOption(OptionStatementIngestTargetFileSize, "big")
+	require.ErrorAs(t, err, &adbcErr)
+	require.Equal(t, adbc.StatusInvalidArgument, adbcErr.Code)
+
+	require.NoError(t, st.SetOption(OptionStatementIngestTargetFileSize, "1048576"))
+	size, err := st.GetOptionInt(OptionStatementIngestTargetFileSize)
+	require.NoError(t, err)
+	require.EqualValues(t, 1048576, size)
+}
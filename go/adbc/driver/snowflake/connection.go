@@ -961,6 +961,7 @@ func (c *cnxn) NewStatement() (adbc.Statement, error) {
 		cnxn:                c,
 		queueSize:           defaultStatementQueueSize,
 		prefetchConcurrency: defaultPrefetchConcurrency,
+		ingest:              defaultIngestOptions(),
 	}, nil
 }
 
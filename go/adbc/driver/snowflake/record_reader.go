@@ -20,6 +20,7 @@ package snowflake
 import (
 	"context"
 	"encoding/hex"
+	"fmt"
 	"math"
 	"strconv"
 	"strings"
@@ -289,124 +290,315 @@ func rowTypesToArrowSchema(ctx context.Context, ld gosnowflake.ArrowStreamLoader
 	return arrow.NewSchema(fields, nil), nil
 }
 
-func extractTimestamp(src *string) (sec, nsec int64, err error) {
-	s, ms, hasFraction := strings.Cut(*src, ".")
+// extractTimestamp parses a number of seconds with an optional fraction
+// of up to 9 digits, as Snowflake formats times and timestamps in JSON
+// results.
+func extractTimestamp(src string) (sec, nsec int64, err error) {
+	s, frac, hasFraction := strings.Cut(src, ".")
 	sec, err = strconv.ParseInt(s, 10, 64)
-	if err != nil {
+	if err != nil || !hasFraction {
 		return
 	}
 
-	if !hasFraction {
-		return
+	if len(frac) > 9 {
+		return 0, 0, fmt.Errorf("invalid timestamp '%s': more than 9 fractional digits", src)
+	}
+	for i := 0; i < 9; i++ {
+		nsec *= 10
+		if i < len(frac) {
+			c := frac[i]
+			if c < '0' || c > '9' {
+				return 0, 0, fmt.Errorf("invalid timestamp '%s'", src)
+			}
+			nsec += int64(c - '0')
+		}
 	}
-
-	nsec, err = strconv.ParseInt(ms+strings.Repeat("0", 9-len(ms)), 10, 64)
 	return
 }
 
-func jsonDataToArrow(ctx context.Context, bldr *array.RecordBuilder, ld gosnowflake.ArrowStreamLoader) (arrow.Record, error) {
-	rawData := ld.JSONData()
-	fieldBuilders := bldr.Fields()
-	for _, rec := range rawData {
-		for i, col := range rec {
-			field := fieldBuilders[i]
+// The number of rows of a JSON result converted into each record. Records
+// are converted concurrently.
+const jsonBatchRows = 16 * 1024
+
+// jsonColumnParser appends column col of rows to bldr, which has been
+// reserved for len(rows) values.
+type jsonColumnParser func(bldr array.Builder, rows [][]*string, col int) error
+
+type unsafeAppender[T any] interface {
+	UnsafeAppend(T)
+	UnsafeAppendBoolToBitmap(bool)
+}
+
+func parseJSONColumn[T any](b unsafeAppender[T], rows [][]*string, col int, parse func(string) (T, error)) error {
+	for _, row := range rows {
+		v := row[col]
+		if v == nil {
+			b.UnsafeAppendBoolToBitmap(false)
+			continue
+		}
+
+		val, err := parse(*v)
+		if err != nil {
+			return err
+		}
+		b.UnsafeAppend(val)
+	}
+	return nil
+}
+
+func parseInt64(s string) (int64, error) { return strconv.ParseInt(s, 10, 64) }
+
+func parseFloat64(s string) (float64, error) { return strconv.ParseFloat(s, 64) }
+
+// parseDate32 parses a number of days since the epoch, as Snowflake
+// formats dates, or else a date formatted as YYYY-MM-DD.
+func parseDate32(s string) (arrow.Date32, error) {
+	days, err := strconv.ParseInt(s, 10, 32)
+	if err == nil {
+		return arrow.Date32(days), nil
+	}
+	tm, err := time.Parse("2006-01-02", s)
+	if err != nil {
+		return 0, err
+	}
+	return arrow.Date32FromTime(tm), nil
+}
+
+func parseTime64(s string) (arrow.Time64, error) {
+	sec, nsec, err := extractTimestamp(s)
+	return arrow.Time64(sec*1e9 + nsec), err
+}
+
+// parseTimestamp parses TIMESTAMP_NTZ and TIMESTAMP_LTZ values. Arrow
+// timestamps are relative to the epoch in UTC whatever their time zone,
+// so the session's time zone does not change the value.
+func parseTimestamp(s string) (arrow.Timestamp, error) {
+	sec, nsec, err := extractTimestamp(s)
+	return arrow.Timestamp(sec*1e9 + nsec), err
+}
+
+// parseTimestampTZ parses TIMESTAMP_TZ values, which are the epoch time
+// in UTC and the time zone's offset (in minutes, plus 1440), separated by
+// a space. Values are converted to UTC, so the offset is only validated.
+func parseTimestampTZ(s string) (arrow.Timestamp, error) {
+	epoch, offset, ok := strings.Cut(s, " ")
+	if !ok || strings.Contains(offset, " ") {
+		return 0, adbc.Error{
+			Msg:        "invalid TIMESTAMP_TZ data. value doesn't consist of two numeric values separated by a space: " + s,
+			SqlState:   [5]byte{'2', '2', '0', '0', '7'},
+			VendorCode: 268000,
+			Code:       adbc.StatusInvalidData,
+		}
+	}
+
+	sec, nsec, err := extractTimestamp(epoch)
+	if err != nil {
+		return 0, err
+	}
+	if _, err := strconv.ParseInt(offset, 10, 64); err != nil {
+		return 0, adbc.Error{
+			Msg:        "invalid TIMESTAMP_TZ data. offset value is not an integer: " + offset,
+			SqlState:   [5]byte{'2', '2', '0', '0', '7'},
+			VendorCode: 268000,
+			Code:       adbc.StatusInvalidData,
+		}
+	}
+	return arrow.Timestamp(sec*1e9 + nsec), nil
+}
+
+func parseJSONString(bldr array.Builder, rows [][]*string, col int) error {
+	b := bldr.(*array.StringBuilder)
+	size := 0
+	for _, row := range rows {
+		if v := row[col]; v != nil {
+			size += len(*v)
+		}
+	}
+	b.ReserveData(size)
 
-			if col == nil {
-				field.AppendNull()
-				continue
+	for _, row := range rows {
+		if v := row[col]; v != nil {
+			b.Append(*v)
+		} else {
+			b.AppendNull()
+		}
+	}
+	return nil
+}
+
+func parseJSONBinary(bldr array.Builder, rows [][]*string, col int) error {
+	b := bldr.(*array.BinaryBuilder)
+	size := 0
+	for _, row := range rows {
+		if v := row[col]; v != nil {
+			size += hex.DecodedLen(len(*v))
+		}
+	}
+	b.ReserveData(size)
+
+	var src []byte
+	// dst is never nil, since Append(nil) appends a null
+	dst := make([]byte, 0, 64)
+	for _, row := range rows {
+		v := row[col]
+		if v == nil {
+			b.AppendNull()
+			continue
+		}
+
+		src = append(src[:0], *v...)
+		if n := hex.DecodedLen(len(src)); cap(dst) < n {
+			dst = make([]byte, n)
+		}
+		n, err := hex.Decode(dst[:cap(dst)], src)
+		if err != nil {
+			return adbc.Error{
+				Msg:        err.Error(),
+				VendorCode: 268002,
+				SqlState:   [5]byte{'2', '2', '0', '0', '3'},
+				Code:       adbc.StatusInvalidData,
 			}
+		}
+		b.Append(dst[:n])
+	}
+	return nil
+}
 
-			switch fb := field.(type) {
-			case *array.Time64Builder:
-				sec, nsec, err := extractTimestamp(col)
-				if err != nil {
-					return nil, err
-				}
+func parseJSONFromString(bldr array.Builder, rows [][]*string, col int) error {
+	for _, row := range rows {
+		if v := row[col]; v != nil {
+			if err := bldr.AppendValueFromString(*v); err != nil {
+				return err
+			}
+		} else {
+			bldr.AppendNull()
+		}
+	}
+	return nil
+}
 
-				fb.Append(arrow.Time64(sec*1e9 + nsec))
-			case *array.TimestampBuilder:
-				tz, err := fb.Type().(*arrow.TimestampType).GetZone()
-				if err != nil {
-					return nil, err
-				}
+// getJSONParsers picks the parser of each column of a schema from
+// rowTypesToArrowSchema once, rather than switching on the type of every
+// value.
+func getJSONParsers(sc *arrow.Schema) []jsonColumnParser {
+	parsers := make([]jsonColumnParser, len(sc.Fields()))
+	for i, f := range sc.Fields() {
+		switch f.Type.ID() {
+		case arrow.INT64:
+			parsers[i] = func(b array.Builder, rows [][]*string, col int) error {
+				return parseJSONColumn[int64](b.(*array.Int64Builder), rows, col, parseInt64)
+			}
+		case arrow.FLOAT64:
+			parsers[i] = func(b array.Builder, rows [][]*string, col int) error {
+				return parseJSONColumn[float64](b.(*array.Float64Builder), rows, col, parseFloat64)
+			}
+		case arrow.DATE32:
+			parsers[i] = func(b array.Builder, rows [][]*string, col int) error {
+				return parseJSONColumn[arrow.Date32](b.(*array.Date32Builder), rows, col, parseDate32)
+			}
+		case arrow.TIME64:
+			parsers[i] = func(b array.Builder, rows [][]*string, col int) error {
+				return parseJSONColumn[arrow.Time64](b.(*array.Time64Builder), rows, col, parseTime64)
+			}
+		case arrow.TIMESTAMP:
+			parse := parseTimestamp
+			if snowflakeType, _ := f.Metadata.GetValue("SNOWFLAKE_TYPE"); snowflakeType == "timestamp_tz" {
+				parse = parseTimestampTZ
+			}
+			parsers[i] = func(b array.Builder, rows [][]*string, col int) error {
+				return parseJSONColumn[arrow.Timestamp](b.(*array.TimestampBuilder), rows, col, parse)
+			}
+		case arrow.BINARY:
+			parsers[i] = parseJSONBinary
+		case arrow.STRING:
+			parsers[i] = parseJSONString
+		default:
+			parsers[i] = parseJSONFromString
+		}
+	}
+	return parsers
+}
 
-				if tz != time.UTC {
-					sec, nsec, err := extractTimestamp(col)
-					if err != nil {
-						return nil, err
-					}
+// jsonDataToArrow converts rows of a JSON result into a record, a column
+// at a time.
+func jsonDataToArrow(bldr *array.RecordBuilder, parsers []jsonColumnParser, rows [][]*string) (arrow.Record, error) {
+	for i, fb := range bldr.Fields() {
+		fb.Reserve(len(rows))
+		if err := parsers[i](fb, rows, i); err != nil {
+			return nil, err
+		}
+	}
+	return bldr.NewRecord(), nil
+}
 
-					val := time.Unix(sec, nsec).In(tz)
-					ts, err := arrow.TimestampFromTime(val, arrow.Nanosecond)
-					if err != nil {
-						return nil, err
-					}
-					fb.Append(ts)
-					break
-				}
+// newJSONRecordReader reads a result that Snowflake returned as JSON
+// rather than Arrow, with the schema from rowTypesToArrowSchema. The rows are split into batches of jsonBatchRows,
+// which are converted concurrently (up to prefetchConcurrency at a time)
+// and returned in order through the same channels as Arrow results.
+func newJSONRecordReader(ctx context.Context, alloc memory.Allocator, schema *arrow.Schema, rows [][]*string, prefetchConcurrency int) (array.RecordReader, error) {
+	parsers := getJSONParsers(schema)
+	if len(rows) <= jsonBatchRows {
+		bldr := array.NewRecordBuilder(alloc, schema)
+		defer bldr.Release()
+
+		rec, err := jsonDataToArrow(bldr, parsers, rows)
+		if err != nil {
+			return nil, err
+		}
+		defer rec.Release()
 
-				snowflakeType, _ := bldr.Schema().Field(i).Metadata.GetValue("SNOWFLAKE_TYPE")
-				if snowflakeType == "timestamp_ntz" {
-					sec, nsec, err := extractTimestamp(col)
-					if err != nil {
-						return nil, err
-					}
+		return array.NewRecordReader(schema, []arrow.Record{rec})
+	}
 
-					fb.Append(arrow.Timestamp(sec*1e9 + nsec))
-					break
-				}
+	ctx, cancelFn := context.WithCancel(ctx)
+	group, ctx := errgroup.WithContext(ctx)
+	group.SetLimit(prefetchConcurrency)
 
-				// "timestamp_tz" should be value + offset separated by space
-				tm := strings.Split(*col, " ")
-				if len(tm) != 2 {
-					return nil, adbc.Error{
-						Msg:        "invalid TIMESTAMP_TZ data. value doesn't consist of two numeric values separated by a space: " + *col,
-						SqlState:   [5]byte{'2', '2', '0', '0', '7'},
-						VendorCode: 268000,
-						Code:       adbc.StatusInvalidData,
-					}
-				}
+	// each channel receives a single record, so sends never block
+	chs := make([]chan arrow.Record, (len(rows)+jsonBatchRows-1)/jsonBatchRows)
+	for i := range chs {
+		chs[i] = make(chan arrow.Record, 1)
+	}
+	rdr := &reader{
+		refCount: 1,
+		chs:      chs,
+		cancelFn: cancelFn,
+		schema:   schema,
+	}
 
-				sec, nsec, err := extractTimestamp(&tm[0])
-				if err != nil {
-					return nil, err
+	lastChannelIndex := len(chs) - 1
+	go func() {
+		for i := range chs {
+			batchIdx, batch := i, rows[i*jsonBatchRows:]
+			if len(batch) > jsonBatchRows {
+				batch = batch[:jsonBatchRows]
+			}
+			group.Go(func() error {
+				// close channels (except the last) so that Next can move on to the next channel properly
+				if batchIdx != lastChannelIndex {
+					defer close(chs[batchIdx])
 				}
-				offset, err := strconv.ParseInt(tm[1], 10, 64)
-				if err != nil {
-					return nil, adbc.Error{
-						Msg:        "invalid TIMESTAMP_TZ data. offset value is not an integer: " + tm[1],
-						SqlState:   [5]byte{'2', '2', '0', '0', '7'},
-						VendorCode: 268000,
-						Code:       adbc.StatusInvalidData,
-					}
+				if ctx.Err() != nil {
+					return ctx.Err()
 				}
 
-				loc := gosnowflake.Location(int(offset) - 1440)
-				tt := time.Unix(sec, nsec).In(loc)
-				ts, err := arrow.TimestampFromTime(tt, arrow.Nanosecond)
-				if err != nil {
-					return nil, err
-				}
-				fb.Append(ts)
-			case *array.BinaryBuilder:
-				b, err := hex.DecodeString(*col)
+				bldr := array.NewRecordBuilder(alloc, schema)
+				defer bldr.Release()
+				rec, err := jsonDataToArrow(bldr, parsers, batch)
 				if err != nil {
-					return nil, adbc.Error{
-						Msg:        err.Error(),
-						VendorCode: 268002,
-						SqlState:   [5]byte{'2', '2', '0', '0', '3'},
-						Code:       adbc.StatusInvalidData,
-					}
-				}
-				fb.Append(b)
-			default:
-				if err := fb.AppendValueFromString(*col); err != nil {
-					return nil, err
+					return err
 				}
-			}
+				chs[batchIdx] <- rec
+				return nil
+			})
 		}
-	}
-	return bldr.NewRecord(), nil
+
+		// all batches have been started, so Wait cannot return early
+		rdr.err = group.Wait()
+		close(chs[lastChannelIndex])
+	}()
+
+	return rdr, nil
 }
 
 type reader struct {
@@ -436,17 +628,7 @@ func newRecordReader(ctx context.Context, alloc memory.Allocator, ld gosnowflake
 					Code: adbc.StatusInternal,
 				}
 			}
-
-			bldr := array.NewRecordBuilder(alloc, schema)
-			defer bldr.Release()
-
-			rec, err := jsonDataToArrow(ctx, bldr, ld)
-			if err != nil {
-				return nil, err
-			}
-			defer rec.Release()
-
-			return array.NewRecordReader(schema, []arrow.Record{rec})
+			return newJSONRecordReader(ctx, alloc, schema, ld.JSONData(), prefetchConcurrency)
 		}
 		schema := arrow.NewSchema([]arrow.Field{}, nil)
 		reader, err := array.NewRecordReader(schema, []arrow.Record{})
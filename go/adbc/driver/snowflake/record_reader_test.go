@@ -0,0 +1,199 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package snowflake
+
+import (
+	"context"
+	"strconv"
+	"testing"
+	"time"
+
+	"github.com/apache/arrow-adbc/go/adbc"
+	"github.com/apache/arrow/go/v13/arrow"
+	"github.com/apache/arrow/go/v13/arrow/array"
+	"github.com/apache/arrow/go/v13/arrow/memory"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+// jsonTestSchema is what rowTypesToArrowSchema returns for these types
+func jsonTestSchema() *arrow.Schema {
+	field := func(name, sfType string, dt arrow.DataType) arrow.Field {
+		return arrow.Field{
+			Name:     name,
+			Type:     dt,
+			Nullable: true,
+			Metadata: arrow.MetadataFrom(map[string]string{"SNOWFLAKE_TYPE": sfType}),
+		}
+	}
+	return arrow.NewSchema([]arrow.Field{
+		field("FIXED", "fixed", arrow.PrimitiveTypes.Int64),
+		field("REAL", "real", arrow.PrimitiveTypes.Float64),
+		field("DATE", "date", arrow.PrimitiveTypes.Date32),
+		field("TIME", "time", arrow.FixedWidthTypes.Time64ns),
+		field("NTZ", "timestamp_ntz", arrow.FixedWidthTypes.Timestamp_ns),
+		field("LTZ", "timestamp_ltz", &arrow.TimestampType{Unit: arrow.Nanosecond, TimeZone: "UTC"}),
+		field("TZ", "timestamp_tz", arrow.FixedWidthTypes.Timestamp_ns),
+		field("BINARY", "binary", arrow.BinaryTypes.Binary),
+		field("TEXT", "text", arrow.BinaryTypes.String),
+	}, nil)
+}
+
+func strs(vals ...string) []*string {
+	out := make([]*string, len(vals))
+	for i := range vals {
+		if vals[i] != "" {
+			out[i] = &vals[i]
+		}
+	}
+	return out
+}
+
+func TestJSONDataToArrow(t *testing.T) {
+	mem := memory.NewCheckedAllocator(memory.DefaultAllocator)
+	defer mem.AssertSize(t, 0)
+
+	schema := jsonTestSchema()
+	rows := [][]*string{
+		strs("42", "1.5", "19000", "3723.5", "1600000000.000000001", "1600000000.25", "1600000000.5 1500", "cafe", "hello"),
+		strs("", "", "", "", "", "", "", "", ""),
+	}
+
+	bldr := array.NewRecordBuilder(mem, schema)
+	defer bldr.Release()
+	rec, err := jsonDataToArrow(bldr, getJSONParsers(schema), rows)
+	require.NoError(t, err)
+	defer rec.Release()
+
+	require.EqualValues(t, 2, rec.NumRows())
+	for i, col := range rec.Columns() {
+		assert.True(t, col.IsNull(1), "column %d", i)
+	}
+	assert.Equal(t, int64(42), rec.Column(0).(*array.Int64).Value(0))
+	assert.Equal(t, 1.5, rec.Column(1).(*array.Float64).Value(0))
+	assert.Equal(t, arrow.Date32(19000), rec.Column(2).(*array.Date32).Value(0))
+	assert.Equal(t, arrow.Time64(3723500000000), rec.Column(3).(*array.Time64).Value(0))
+	assert.Equal(t, arrow.Timestamp(1600000000000000001), rec.Column(4).(*array.Timestamp).Value(0))
+	assert.Equal(t, arrow.Timestamp(1600000000250000000), rec.Column(5).(*array.Timestamp).Value(0))
+	assert.Equal(t, arrow.Timestamp(1600000000500000000), rec.Column(6).(*array.Timestamp).Value(0))
+	assert.Equal(t, []byte{0xca, 0xfe}, rec.Column(7).(*array.Binary).Value(0))
+	assert.Equal(t, "hello", rec.Column(8).(*array.String).Value(0))
+}
+
+func TestJSONDataToArrowInvalid(t *testing.T) {
+	schema := arrow.NewSchema([]arrow.Field{
+		{Name: "TZ", Type: arrow.FixedWidthTypes.Timestamp_ns,
+			Metadata: arrow.MetadataFrom(map[string]string{"SNOWFLAKE_TYPE": "timestamp_tz"})},
+		{Name: "BINARY", Type: arrow.BinaryTypes.Binary},
+	}, nil)
+	parsers := getJSONParsers(schema)
+
+	for _, row := range [][]*string{
+		strs("1600000000", "00"),
+		strs("1600000000 1440", "xyz"),
+	} {
+		bldr := array.NewRecordBuilder(memory.DefaultAllocator, schema)
+		_, err := jsonDataToArrow(bldr, parsers, [][]*string{row})
+		bldr.Release()
+
+		var adbcErr adbc.Error
+		require.ErrorAs(t, err, &adbcErr)
+		assert.Equal(t, adbc.StatusInvalidData, adbcErr.Code)
+	}
+}
+
+func TestExtractTimestamp(t *testing.T) {
+	for _, tc := range []struct {
+		src       string
+		sec, nsec int64
+	}{
+		{"0", 0, 0},
+		{"12", 12, 0},
+		{"12.5", 12, 500000000},
+		{"12.000000001", 12, 1},
+		{"-86400.000000000", -86400, 0},
+	} {
+		sec, nsec, err := extractTimestamp(tc.src)
+		require.NoError(t, err, tc.src)
+		assert.Equal(t, tc.sec, sec, tc.src)
+		assert.Equal(t, tc.nsec, nsec, tc.src)
+	}
+
+	for _, src := range []string{"", "a", "1.a", "1.0000000001"} {
+		_, _, err := extractTimestamp(src)
+		assert.Error(t, err, src)
+	}
+}
+
+func TestJSONRecordReaderBatches(t *testing.T) {
+	mem := memory.NewCheckedAllocator(memory.DefaultAllocator)
+	defer mem.AssertSize(t, 0)
+
+	schema := arrow.NewSchema([]arrow.Field{
+		{Name: "ID", Type: arrow.PrimitiveTypes.Int64, Nullable: true},
+		{Name: "TS", Type: arrow.FixedWidthTypes.Timestamp_ns, Nullable: true,
+			Metadata: arrow.MetadataFrom(map[string]string{"SNOWFLAKE_TYPE": "timestamp_ntz"})},
+	}, nil)
+
+	const numRows = 3*jsonBatchRows + 10
+	rows := make([][]*string, numRows)
+	for i := range rows {
+		rows[i] = strs(strconv.Itoa(i), strconv.Itoa(i)+".5")
+	}
+
+	rdr, err := newJSONRecordReader(context.Background(), mem, schema, rows, 2)
+	require.NoError(t, err)
+	defer rdr.Release()
+
+	// batches are returned in order, whatever order they were converted in
+	next := int64(0)
+	for rdr.Next() {
+		rec := rdr.Record()
+		ids := rec.Column(0).(*array.Int64)
+		ts := rec.Column(1).(*array.Timestamp)
+		for i := 0; i < ids.Len(); i++ {
+			require.Equal(t, next, ids.Value(i))
+			require.Equal(t, arrow.Timestamp(next*int64(time.Second)+5e8), ts.Value(i))
+			next++
+		}
+	}
+	require.NoError(t, rdr.Err())
+	require.EqualValues(t, numRows, next)
+}
+
+func TestJSONRecordReaderError(t *testing.T) {
+	mem := memory.NewCheckedAllocator(memory.DefaultAllocator)
+	defer mem.AssertSize(t, 0)
+
+	schema := arrow.NewSchema([]arrow.Field{
+		{Name: "ID", Type: arrow.PrimitiveTypes.Int64, Nullable: true},
+	}, nil)
+	rows := make([][]*string, 2*jsonBatchRows)
+	for i := range rows {
+		rows[i] = strs("1")
+	}
+	rows[len(rows)-1] = strs("one")
+
+	rdr, err := newJSONRecordReader(context.Background(), mem, schema, rows, 2)
+	require.NoError(t, err)
+	defer rdr.Release()
+
+	for rdr.Next() {
+	}
+	require.Error(t, rdr.Err())
+}
@@ -35,6 +35,22 @@ import (
 const (
 	OptionStatementQueueSize           = "adbc.rpc.result_queue_size"
 	OptionStatementPrefetchConcurrency = "adbc.snowflake.rpc.prefetch_concurrency"
+	// How bulk ingestion loads data: by binding each batch to an INSERT
+	// (OptionValueIngestMethodInsert, the default), or by writing Parquet
+	// files, uploading them to the table's stage with PUT, and loading them
+	// with COPY INTO (OptionValueIngestMethodCopy)
+	OptionStatementIngestMethod = "adbc.snowflake.statement.ingest_method"
+	// The number of Parquet files written at once by the copy method
+	OptionStatementIngestWriterConcurrency = "adbc.snowflake.statement.ingest_writer_concurrency"
+	// The number of files uploaded at once by the copy method (the
+	// PARALLEL option of PUT)
+	OptionStatementIngestUploadConcurrency = "adbc.snowflake.statement.ingest_upload_concurrency"
+	// The size in bytes after which the copy method finishes a Parquet
+	// file and starts the next
+	OptionStatementIngestTargetFileSize = "adbc.snowflake.statement.ingest_target_file_size"
+
+	OptionValueIngestMethodInsert = "insert"
+	OptionValueIngestMethodCopy   = "copy"
 )
 
 type statement struct {
@@ -46,6 +62,7 @@ type statement struct {
 	query       string
 	targetTable string
 	ingestMode  string
+	ingest      ingestOptions
 
 	bound      arrow.Record
 	streamBind array.RecordReader
@@ -74,6 +91,10 @@ func (st *statement) Close() error {
 }
 
 func (st *statement) GetOption(key string) (string, error) {
+	switch key {
+	case OptionStatementIngestMethod:
+		return st.ingest.method, nil
+	}
 	return "", adbc.Error{
 		Msg:  fmt.Sprintf("[Snowflake] Unknown statement option '%s'", key),
 		Code: adbc.StatusNotFound,
@@ -89,6 +110,14 @@ func (st *statement) GetOptionInt(key string) (int64, error) {
 	switch key {
 	case OptionStatementQueueSize:
 		return int64(st.queueSize), nil
+	case OptionStatementPrefetchConcurrency:
+		return int64(st.prefetchConcurrency), nil
+	case OptionStatementIngestWriterConcurrency:
+		return int64(st.ingest.writerConcurrency), nil
+	case OptionStatementIngestUploadConcurrency:
+		return int64(st.ingest.uploadConcurrency), nil
+	case OptionStatementIngestTargetFileSize:
+		return st.ingest.targetFileSize, nil
 	}
 	return 0, adbc.Error{
 		Msg:  fmt.Sprintf("[Snowflake] Unknown statement option '%s'", key),
@@ -142,6 +171,26 @@ func (st *statement) SetOption(key string, val string) error {
 			}
 		}
 		return st.SetOptionInt(key, int64(concurrency))
+	case OptionStatementIngestMethod:
+		switch val {
+		case OptionValueIngestMethodInsert, OptionValueIngestMethodCopy:
+			st.ingest.method = val
+		default:
+			return adbc.Error{
+				Msg:  fmt.Sprintf("invalid statement option %s=%s", key, val),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+	case OptionStatementIngestWriterConcurrency, OptionStatementIngestUploadConcurrency,
+		OptionStatementIngestTargetFileSize:
+		v, err := strconv.ParseInt(val, 10, 64)
+		if err != nil {
+			return adbc.Error{
+				Msg:  fmt.Sprintf("could not parse '%s' as int for option '%s'", val, key),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+		return st.SetOptionInt(key, v)
 	default:
 		return adbc.Error{
 			Msg:  fmt.Sprintf("[Snowflake] Unknown statement option '%s'", key),
@@ -178,6 +227,28 @@ func (st *statement) SetOptionInt(key string, value int64) error {
 		}
 		st.prefetchConcurrency = int(value)
 		return nil
+	case OptionStatementIngestWriterConcurrency, OptionStatementIngestTargetFileSize:
+		if value <= 0 {
+			return adbc.Error{
+				Msg:  fmt.Sprintf("invalid value ('%d') for option '%s', must be > 0", value, key),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+		if key == OptionStatementIngestWriterConcurrency {
+			st.ingest.writerConcurrency = int(value)
+		} else {
+			st.ingest.targetFileSize = value
+		}
+		return nil
+	case OptionStatementIngestUploadConcurrency:
+		if value <= 0 || value > maxIngestUploadConcurrency {
+			return adbc.Error{
+				Msg:  fmt.Sprintf("invalid value ('%d') for option '%s', must be between 1 and %d", value, key, maxIngestUploadConcurrency),
+				Code: adbc.StatusInvalidArgument,
+			}
+		}
+		st.ingest.uploadConcurrency = int(value)
+		return nil
 	}
 	return adbc.Error{
 		Msg:  fmt.Sprintf("[Snowflake] Unknown statement option '%s'", key),
@@ -442,6 +513,17 @@ func getQueryArg(arr arrow.Array) interface{} {
 	}
 }
 
+// releaseBound releases the data bound for ingestion, once it is consumed.
+func (st *statement) releaseBound() {
+	if st.bound != nil {
+		st.bound.Release()
+		st.bound = nil
+	} else if st.streamBind != nil {
+		st.streamBind.Release()
+		st.streamBind = nil
+	}
+}
+
 func (st *statement) executeIngest(ctx context.Context) (int64, error) {
 	if st.streamBind == nil && st.bound == nil {
 		return -1, adbc.Error{
@@ -450,18 +532,21 @@ func (st *statement) executeIngest(ctx context.Context) (int64, error) {
 		}
 	}
 
+	if st.ingest.method == OptionValueIngestMethodCopy {
+		defer st.releaseBound()
+		return st.executeIngestCopy(ctx)
+	}
+
 	insertQuery, err := st.initIngest(ctx)
 	if err != nil {
 		return -1, err
 	}
 
-	// if the ingestion is large enough it might make more sense to
-	// write this out to a temporary file / stage / etc. and use
-	// the snowflake bulk loader that way.
-	//
-	// on the other hand, according to the documentation,
+	// according to the documentation,
 	// https://pkg.go.dev/github.com/snowflakedb/gosnowflake#hdr-Batch_Inserts_and_Binding_Parameters
-	// snowflake's internal driver work should already be doing this.
+	// large array binds are already uploaded to a stage by gosnowflake,
+	// but each value is still converted to a Go value first: for large
+	// ingests, OptionValueIngestMethodCopy avoids that.
 
 	var n int64
 	exec := func(rec arrow.Record, args []driver.NamedValue) error {
@@ -482,19 +567,12 @@ func (st *statement) executeIngest(ctx context.Context) (int64, error) {
 		return nil
 	}
 
+	defer st.releaseBound()
 	if st.bound != nil {
-		defer func() {
-			st.bound.Release()
-			st.bound = nil
-		}()
 		args := make([]driver.NamedValue, len(st.bound.Schema().Fields()))
 		return n, exec(st.bound, args)
 	}
 
-	defer func() {
-		st.streamBind.Release()
-		st.streamBind = nil
-	}()
 	args := make([]driver.NamedValue, len(st.streamBind.Schema().Fields()))
 	for st.streamBind.Next() {
 		rec := st.streamBind.Record()
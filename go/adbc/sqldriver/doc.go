@@ -27,6 +27,11 @@
 //
 //	sql.Register("drivername", sqldriver.Driver{adbcdriver})
 //
+// Reading results through database/sql converts every value into a
+// driver.Value. To avoid that, QueryRecords reads the results of a query
+// as the Arrow records they are made of (see RecordRows), and a Scanner
+// fills slices of structs from those records a column at a time.
+//
 // Additionally, the sqldriver/flightsql package simplifies registration
 // of the FlightSQL ADBC driver implementation, so that only a single
 // import statement is needed. See the example in that package.
@@ -550,12 +550,30 @@ func (s *stmt) QueryContext(ctx context.Context, args []driver.NamedValue) (driv
 	return &rows{rdr: rdr, rowsAffected: affected, stmt: s}, nil
 }
 
+// RecordRows is implemented by the driver.Rows of this package, to read
+// results as the Arrow records they are made of, rather than boxing every
+// value into a driver.Value as Next does. Since database/sql does not
+// expose the rows of a driver, use QueryRecords to reach them.
+type RecordRows interface {
+	driver.Rows
+
+	// Schema returns the schema of the records.
+	Schema() *arrow.Schema
+	// NextRecord returns the next record of the results, or io.EOF once
+	// there are no more. If Next has returned rows of a record, it
+	// returns the rest of that record. The record is only valid until
+	// the next call to NextRecord, Next or Close, unless retained.
+	NextRecord() (arrow.Record, error)
+}
+
 type rows struct {
 	rdr          array.RecordReader
 	curRow       int64
 	curRecord    arrow.Record
 	rowsAffected int64
 	stmt         *stmt
+	// the rest of a partially read record, returned by NextRecord
+	sliced arrow.Record
 }
 
 func (r *rows) Columns() (out []string) {
@@ -570,6 +588,10 @@ func (r *rows) Close() error {
 	if r.curRecord != nil {
 		r.curRecord = nil
 	}
+	if r.sliced != nil {
+		r.sliced.Release()
+		r.sliced = nil
+	}
 
 	r.rdr.Release()
 	r.rdr = nil
@@ -659,6 +681,94 @@ func (r *rows) Next(dest []driver.Value) error {
 	return nil
 }
 
+func (r *rows) Schema() *arrow.Schema {
+	return r.rdr.Schema()
+}
+
+func (r *rows) NextRecord() (arrow.Record, error) {
+	if r.sliced != nil {
+		r.sliced.Release()
+		r.sliced = nil
+	}
+
+	if r.curRecord != nil && r.curRow < r.curRecord.NumRows() {
+		r.sliced = r.curRecord.NewSlice(r.curRow, r.curRecord.NumRows())
+		r.curRow = r.curRecord.NumRows()
+		return r.sliced, nil
+	}
+
+	for {
+		if !r.rdr.Next() {
+			r.curRecord = nil
+			if err := r.rdr.Err(); err != nil {
+				return nil, err
+			}
+			return nil, io.EOF
+		}
+		if rec := r.rdr.Record(); rec.NumRows() > 0 {
+			// mark the record as read, so that Next moves on
+			r.curRecord, r.curRow = rec, rec.NumRows()
+			return rec, nil
+		}
+	}
+}
+
+// QueryRecords runs a query on a connection of this driver and calls fn
+// with its results, which can then be read as Arrow records. The results
+// are closed once fn returns. As with database/sql, args are converted
+// with driver.DefaultParameterConverter unless they are driver.Valuers.
+//
+//	err := sqldriver.QueryRecords(ctx, conn, func(rows sqldriver.RecordRows) error {
+//		for {
+//			rec, err := rows.NextRecord()
+//			if err == io.EOF {
+//				return nil
+//			} else if err != nil {
+//				return err
+//			}
+//			// ...
+//		}
+//	}, "SELECT * FROM table WHERE id > ?", 10)
+func QueryRecords(ctx context.Context, c *sql.Conn, fn func(RecordRows) error, query string, args ...any) error {
+	namedValues := make([]driver.NamedValue, len(args))
+	for i, arg := range args {
+		var (
+			v   driver.Value
+			err error
+		)
+		if valuer, ok := arg.(driver.Valuer); ok {
+			v, err = valuer.Value()
+		} else {
+			v, err = driver.DefaultParameterConverter.ConvertValue(arg)
+		}
+		if err != nil {
+			return &adbc.Error{
+				Code: adbc.StatusInvalidArgument,
+				Msg:  "invalid argument " + strconv.Itoa(i+1) + ": " + err.Error(),
+			}
+		}
+		// nb: Ordinal is 1-based
+		namedValues[i] = driver.NamedValue{Ordinal: i + 1, Value: v}
+	}
+
+	return c.Raw(func(driverConn any) error {
+		cn, ok := driverConn.(*conn)
+		if !ok {
+			return &adbc.Error{
+				Code: adbc.StatusInvalidArgument,
+				Msg:  "QueryRecords requires a connection of the sqldriver package",
+			}
+		}
+
+		rs, err := cn.QueryContext(ctx, query, namedValues)
+		if err != nil {
+			return err
+		}
+		defer rs.Close()
+		return fn(rs.(*rows))
+	})
+}
+
 func (r *rows) ColumnTypeDatabaseTypeName(index int) string {
 	return r.rdr.Schema().Field(index).Type.String()
 }
@@ -0,0 +1,372 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package sqldriver
+
+import (
+	"errors"
+	"fmt"
+	"io"
+	"time"
+
+	"github.com/apache/arrow-adbc/go/adbc"
+	"github.com/apache/arrow/go/v13/arrow"
+	"github.com/apache/arrow/go/v13/arrow/array"
+)
+
+// FieldType is the set of Go types that a column can be scanned into.
+//
+// Integer and floating point columns can be scanned into a field of the
+// same type, or a wider one of the same kind (int64 for any signed
+// integers, uint64 for any unsigned integers, float64 for float32).
+// Strings and binary data are copied out of the record, so the values
+// outlive it. Dates, times and timestamps are scanned into time.Time.
+type FieldType interface {
+	bool | int8 | int16 | int32 | int64 | uint8 | uint16 | uint32 | uint64 |
+		float32 | float64 | string | []byte | time.Time
+}
+
+// Column binds a column of a record to a field of T, for a Scanner.
+type Column[T any] struct {
+	name   string
+	goType string
+	// scan fills in the field of each element of dst from arr, which has
+	// len(dst) values, returning false if arr's type is not supported
+	scan func(arr arrow.Array, dst []T) bool
+}
+
+// Field binds the column name to the field of T returned by field. Null
+// values are scanned as the zero value: bind Valid to the same column to
+// tell them apart.
+//
+//	sqldriver.Field("id", func(r *Row) *int64 { return &r.ID })
+func Field[T any, V FieldType](name string, field func(*T) *V) Column[T] {
+	c := Column[T]{name: name, goType: fmt.Sprintf("%T", *new(V))}
+	switch f := any(field).(type) {
+	case func(*T) *bool:
+		c.scan = scanBool(f)
+	case func(*T) *int8:
+		c.scan = scanAs[T, int8, int8](f)
+	case func(*T) *int16:
+		c.scan = scanAs[T, int16, int16](f)
+	case func(*T) *int32:
+		c.scan = scanAs[T, int32, int32](f)
+	case func(*T) *int64:
+		c.scan = anyOf(scanAs[T, int64, int64](f), scanAs[T, int64, int32](f),
+			scanAs[T, int64, int16](f), scanAs[T, int64, int8](f))
+	case func(*T) *uint8:
+		c.scan = scanAs[T, uint8, uint8](f)
+	case func(*T) *uint16:
+		c.scan = scanAs[T, uint16, uint16](f)
+	case func(*T) *uint32:
+		c.scan = scanAs[T, uint32, uint32](f)
+	case func(*T) *uint64:
+		c.scan = anyOf(scanAs[T, uint64, uint64](f), scanAs[T, uint64, uint32](f),
+			scanAs[T, uint64, uint16](f), scanAs[T, uint64, uint8](f))
+	case func(*T) *float32:
+		c.scan = scanAs[T, float32, float32](f)
+	case func(*T) *float64:
+		c.scan = anyOf(scanAs[T, float64, float64](f), scanAs[T, float64, float32](f))
+	case func(*T) *string:
+		c.scan = scanString(f)
+	case func(*T) *[]byte:
+		c.scan = scanBinary(f)
+	case func(*T) *time.Time:
+		c.scan = scanTime(f)
+	}
+	return c
+}
+
+// Valid binds the column name to a field of T that is set to whether the
+// column is non-null.
+func Valid[T any](name string, field func(*T) *bool) Column[T] {
+	return Column[T]{name: name, goType: "bool", scan: func(arr arrow.Array, dst []T) bool {
+		if arr.NullN() == 0 {
+			for i := range dst {
+				*field(&dst[i]) = true
+			}
+			return true
+		}
+		for i := range dst {
+			*field(&dst[i]) = arr.IsValid(i)
+		}
+		return true
+	}}
+}
+
+// Scanner fills slices of T from Arrow records a column at a time, with
+// a loop per column and Go type rather than a conversion per value, and
+// without reflection.
+//
+//	type Row struct {
+//		ID   int64
+//		Name string
+//	}
+//
+//	scanner := sqldriver.NewScanner(
+//		sqldriver.Field("id", func(r *Row) *int64 { return &r.ID }),
+//		sqldriver.Field("name", func(r *Row) *string { return &r.Name }))
+//	var result []Row
+//	err := sqldriver.QueryRecords(ctx, conn, func(rows sqldriver.RecordRows) (err error) {
+//		result, err = scanner.ScanAll(result, rows)
+//		return err
+//	}, "SELECT id, name FROM table")
+type Scanner[T any] struct {
+	columns []Column[T]
+}
+
+// NewScanner returns a Scanner filling in the given columns. Columns of
+// records that are not bound are ignored, and fields that are not bound
+// are left as the zero value.
+func NewScanner[T any](columns ...Column[T]) *Scanner[T] {
+	return &Scanner[T]{columns: columns}
+}
+
+// Append appends an element to dst for each row of rec, and returns the
+// extended slice.
+func (s *Scanner[T]) Append(dst []T, rec arrow.Record) ([]T, error) {
+	start, n := len(dst), int(rec.NumRows())
+	if cap(dst)-start < n {
+		grown := make([]T, start, start+n)
+		copy(grown, dst)
+		dst = grown
+	}
+	dst = dst[:start+n]
+	rows := dst[start:]
+	var zero T
+	for i := range rows {
+		rows[i] = zero
+	}
+
+	schema := rec.Schema()
+	for _, c := range s.columns {
+		indices := schema.FieldIndices(c.name)
+		if len(indices) == 0 {
+			return dst[:start], &adbc.Error{
+				Code: adbc.StatusInvalidArgument,
+				Msg:  "column '" + c.name + "' not found in results",
+			}
+		}
+
+		arr := rec.Column(indices[0])
+		if c.scan == nil || !c.scan(arr, rows) {
+			return dst[:start], &adbc.Error{
+				Code: adbc.StatusInvalidArgument,
+				Msg:  "cannot scan column '" + c.name + "' of type " + arr.DataType().String() + " into " + c.goType,
+			}
+		}
+	}
+	return dst, nil
+}
+
+// ScanAll appends an element to dst for each of the remaining rows, and
+// returns the extended slice.
+func (s *Scanner[T]) ScanAll(dst []T, rows RecordRows) ([]T, error) {
+	for {
+		rec, err := rows.NextRecord()
+		if errors.Is(err, io.EOF) {
+			return dst, nil
+		} else if err != nil {
+			return dst, err
+		}
+
+		if dst, err = s.Append(dst, rec); err != nil {
+			return dst, err
+		}
+	}
+}
+
+type numeric interface {
+	int8 | int16 | int32 | int64 | uint8 | uint16 | uint32 | uint64 | float32 | float64
+}
+
+// numericValues returns the values of arr if it is an array of A.
+func numericValues[A numeric](arr arrow.Array) ([]A, bool) {
+	var values any
+	switch arr := arr.(type) {
+	case *array.Int8:
+		values = arr.Int8Values()
+	case *array.Int16:
+		values = arr.Int16Values()
+	case *array.Int32:
+		values = arr.Int32Values()
+	case *array.Int64:
+		values = arr.Int64Values()
+	case *array.Uint8:
+		values = arr.Uint8Values()
+	case *array.Uint16:
+		values = arr.Uint16Values()
+	case *array.Uint32:
+		values = arr.Uint32Values()
+	case *array.Uint64:
+		values = arr.Uint64Values()
+	case *array.Float32:
+		values = arr.Float32Values()
+	case *array.Float64:
+		values = arr.Float64Values()
+	}
+	v, ok := values.([]A)
+	return v, ok
+}
+
+// scanAs scans arrays of A into fields of type V.
+func scanAs[T any, V, A numeric](field func(*T) *V) func(arrow.Array, []T) bool {
+	return func(arr arrow.Array, dst []T) bool {
+		values, ok := numericValues[A](arr)
+		if !ok {
+			return false
+		}
+		for i, v := range values {
+			*field(&dst[i]) = V(v)
+		}
+		if arr.NullN() > 0 {
+			for i := range dst {
+				if arr.IsNull(i) {
+					*field(&dst[i]) = 0
+				}
+			}
+		}
+		return true
+	}
+}
+
+// anyOf tries each of scans in turn, until one supports the array.
+func anyOf[T any](scans ...func(arrow.Array, []T) bool) func(arrow.Array, []T) bool {
+	return func(arr arrow.Array, dst []T) bool {
+		for _, scan := range scans {
+			if scan(arr, dst) {
+				return true
+			}
+		}
+		return false
+	}
+}
+
+func scanBool[T any](field func(*T) *bool) func(arrow.Array, []T) bool {
+	return func(arr arrow.Array, dst []T) bool {
+		a, ok := arr.(*array.Boolean)
+		if !ok {
+			return false
+		}
+		for i := range dst {
+			*field(&dst[i]) = a.Value(i) && a.IsValid(i)
+		}
+		return true
+	}
+}
+
+// copyStrings sets the fields of dst to slices of data, which holds the
+// values of an array with the given offsets, or "" for nulls.
+func copyStrings[T any, O int32 | int64](arr arrow.Array, dst []T, field func(*T) *string, data string, offsets []O) {
+	if len(dst) == 0 {
+		return
+	}
+	base := offsets[0]
+	for i := range dst {
+		if arr.IsNull(i) {
+			*field(&dst[i]) = ""
+			continue
+		}
+		*field(&dst[i]) = data[int(offsets[i]-base):int(offsets[i+1]-base)]
+	}
+}
+
+func scanString[T any](field func(*T) *string) func(arrow.Array, []T) bool {
+	return func(arr arrow.Array, dst []T) bool {
+		// copy the data of the whole array at once, rather than value by
+		// value (String.Value does not copy, so its result would not
+		// outlive the record)
+		switch a := arr.(type) {
+		case *array.String:
+			copyStrings(arr, dst, field, string(a.ValueBytes()), a.ValueOffsets())
+		case *array.LargeString:
+			copyStrings(arr, dst, field, string(a.ValueBytes()), a.ValueOffsets())
+		default:
+			return false
+		}
+		return true
+	}
+}
+
+// copyBinary sets the fields of dst to slices of data, which holds the
+// values of an array with the given offsets, or nil for nulls.
+func copyBinary[T any, O int32 | int64](arr arrow.Array, dst []T, field func(*T) *[]byte, data []byte, offsets []O) {
+	if len(dst) == 0 {
+		return
+	}
+	base := offsets[0]
+	for i := range dst {
+		if arr.IsNull(i) {
+			*field(&dst[i]) = nil
+			continue
+		}
+		// cap the slices, so appending to one does not overwrite the next
+		end := int(offsets[i+1] - base)
+		*field(&dst[i]) = data[int(offsets[i]-base):end:end]
+	}
+}
+
+func scanBinary[T any](field func(*T) *[]byte) func(arrow.Array, []T) bool {
+	return func(arr arrow.Array, dst []T) bool {
+		switch a := arr.(type) {
+		case *array.Binary:
+			copyBinary(arr, dst, field, append([]byte{}, a.ValueBytes()...), a.ValueOffsets())
+		case *array.LargeBinary:
+			copyBinary(arr, dst, field, append([]byte{}, a.ValueBytes()...), a.ValueOffsets())
+		default:
+			return false
+		}
+		return true
+	}
+}
+
+func scanTime[T any](field func(*T) *time.Time) func(arrow.Array, []T) bool {
+	return func(arr arrow.Array, dst []T) bool {
+		var toTime func(i int) time.Time
+		switch a := arr.(type) {
+		case *array.Timestamp:
+			unit := a.DataType().(*arrow.TimestampType).Unit
+			values := a.TimestampValues()
+			toTime = func(i int) time.Time { return values[i].ToTime(unit) }
+		case *array.Date32:
+			values := a.Date32Values()
+			toTime = func(i int) time.Time { return values[i].ToTime() }
+		case *array.Date64:
+			values := a.Date64Values()
+			toTime = func(i int) time.Time { return values[i].ToTime() }
+		case *array.Time32:
+			unit := a.DataType().(*arrow.Time32Type).Unit
+			values := a.Time32Values()
+			toTime = func(i int) time.Time { return values[i].ToTime(unit) }
+		case *array.Time64:
+			unit := a.DataType().(*arrow.Time64Type).Unit
+			values := a.Time64Values()
+			toTime = func(i int) time.Time { return values[i].ToTime(unit) }
+		default:
+			return false
+		}
+
+		for i := range dst {
+			if arr.IsNull(i) {
+				*field(&dst[i]) = time.Time{}
+				continue
+			}
+			*field(&dst[i]) = toTime(i)
+		}
+		return true
+	}
+}
@@ -0,0 +1,189 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+package sqldriver
+
+import (
+	"database/sql/driver"
+	"io"
+	"testing"
+	"time"
+
+	"github.com/apache/arrow-adbc/go/adbc"
+	"github.com/apache/arrow/go/v13/arrow"
+	"github.com/apache/arrow/go/v13/arrow/array"
+	"github.com/apache/arrow/go/v13/arrow/memory"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+type scanRow struct {
+	ID        int64
+	Small     int16
+	Score     float64
+	Name      string
+	NameValid bool
+	Data      []byte
+	When      time.Time
+	Flag      bool
+}
+
+var scanTestSchema = arrow.NewSchema([]arrow.Field{
+	{Name: "id", Type: arrow.PrimitiveTypes.Int32},
+	{Name: "small", Type: arrow.PrimitiveTypes.Int16},
+	{Name: "score", Type: arrow.PrimitiveTypes.Float32, Nullable: true},
+	{Name: "name", Type: arrow.BinaryTypes.String, Nullable: true},
+	{Name: "data", Type: arrow.BinaryTypes.Binary, Nullable: true},
+	{Name: "when", Type: arrow.FixedWidthTypes.Timestamp_s},
+	{Name: "flag", Type: arrow.FixedWidthTypes.Boolean},
+	{Name: "unused", Type: arrow.PrimitiveTypes.Int64},
+}, nil)
+
+func buildScanRecord(t *testing.T, mem memory.Allocator, ids ...int32) arrow.Record {
+	bldr := array.NewRecordBuilder(mem, scanTestSchema)
+	defer bldr.Release()
+
+	for _, id := range ids {
+		bldr.Field(0).(*array.Int32Builder).Append(id)
+		bldr.Field(1).(*array.Int16Builder).Append(int16(-id))
+		bldr.Field(5).(*array.TimestampBuilder).Append(arrow.Timestamp(id))
+		bldr.Field(6).(*array.BooleanBuilder).Append(id%2 == 0)
+		bldr.Field(7).(*array.Int64Builder).Append(0)
+		if id%3 == 0 {
+			bldr.Field(2).AppendNull()
+			bldr.Field(3).AppendNull()
+			bldr.Field(4).AppendNull()
+			continue
+		}
+		bldr.Field(2).(*array.Float32Builder).Append(float32(id) / 2)
+		bldr.Field(3).(*array.StringBuilder).Append(string(rune('a' + id)))
+		bldr.Field(4).(*array.BinaryBuilder).Append([]byte{byte(id), byte(id)})
+	}
+	return bldr.NewRecord()
+}
+
+func newScanRowScanner() *Scanner[scanRow] {
+	return NewScanner(
+		Field("id", func(r *scanRow) *int64 { return &r.ID }),
+		Field("small", func(r *scanRow) *int16 { return &r.Small }),
+		Field("score", func(r *scanRow) *float64 { return &r.Score }),
+		Field("name", func(r *scanRow) *string { return &r.Name }),
+		Valid("name", func(r *scanRow) *bool { return &r.NameValid }),
+		Field("data", func(r *scanRow) *[]byte { return &r.Data }),
+		Field("when", func(r *scanRow) *time.Time { return &r.When }),
+		Field("flag", func(r *scanRow) *bool { return &r.Flag }),
+	)
+}
+
+func expectedScanRow(id int32) scanRow {
+	row := scanRow{
+		ID:    int64(id),
+		Small: int16(-id),
+		When:  time.Unix(int64(id), 0).UTC(),
+		Flag:  id%2 == 0,
+	}
+	if id%3 != 0 {
+		row.Score = float64(id) / 2
+		row.Name = string(rune('a' + id))
+		row.NameValid = true
+		row.Data = []byte{byte(id), byte(id)}
+	}
+	return row
+}
+
+func TestScannerAppend(t *testing.T) {
+	mem := memory.NewCheckedAllocator(memory.DefaultAllocator)
+	defer mem.AssertSize(t, 0)
+
+	rec := buildScanRecord(t, mem, 1, 2, 3, 4)
+	scanner := newScanRowScanner()
+	got, err := scanner.Append([]scanRow{expectedScanRow(0)}, rec)
+	// values must outlive the record
+	rec.Release()
+	require.NoError(t, err)
+
+	want := []scanRow{expectedScanRow(0)}
+	for _, id := range []int32{1, 2, 3, 4} {
+		want = append(want, expectedScanRow(id))
+	}
+	assert.Equal(t, want, got)
+
+	// appending to a value must not overwrite the next
+	got[1].Data = append(got[1].Data, 0xff)
+	assert.Equal(t, []byte{2, 2}, got[2].Data)
+}
+
+func TestScannerErrors(t *testing.T) {
+	mem := memory.NewCheckedAllocator(memory.DefaultAllocator)
+	defer mem.AssertSize(t, 0)
+
+	rec := buildScanRecord(t, mem, 1)
+	defer rec.Release()
+
+	for _, scanner := range []*Scanner[scanRow]{
+		NewScanner(Field("missing", func(r *scanRow) *int64 { return &r.ID })),
+		// narrowing is not supported
+		NewScanner(Field("score", func(r *scanRow) *int16 { return &r.Small })),
+		NewScanner(Field("name", func(r *scanRow) *int64 { return &r.ID })),
+	} {
+		dst := []scanRow{expectedScanRow(0)}
+		got, err := scanner.Append(dst, rec)
+		var adbcErr *adbc.Error
+		require.ErrorAs(t, err, &adbcErr)
+		assert.Equal(t, adbc.StatusInvalidArgument, adbcErr.Code)
+		assert.Len(t, got, 1)
+	}
+}
+
+func TestRowsNextRecord(t *testing.T) {
+	mem := memory.NewCheckedAllocator(memory.DefaultAllocator)
+	defer mem.AssertSize(t, 0)
+
+	recs := []arrow.Record{
+		buildScanRecord(t, mem, 1, 2, 3),
+		buildScanRecord(t, mem),
+		buildScanRecord(t, mem, 4, 5),
+	}
+	rdr, err := array.NewRecordReader(scanTestSchema, recs)
+	require.NoError(t, err)
+	for _, rec := range recs {
+		rec.Release()
+	}
+
+	r := &rows{rdr: rdr}
+	var _ RecordRows = r
+	assert.Same(t, scanTestSchema, r.Schema())
+
+	// read a row, then the rest of its record, then the rest of the rows
+	dest := make([]driver.Value, len(scanTestSchema.Fields()))
+	require.NoError(t, r.Next(dest))
+	assert.Equal(t, int32(1), dest[0])
+
+	rec, err := r.NextRecord()
+	require.NoError(t, err)
+	assert.EqualValues(t, 2, rec.NumRows())
+	assert.Equal(t, []int32{2, 3}, rec.Column(0).(*array.Int32).Int32Values())
+
+	got, err := newScanRowScanner().ScanAll(nil, r)
+	require.NoError(t, err)
+	assert.Equal(t, []scanRow{expectedScanRow(4), expectedScanRow(5)}, got)
+
+	_, err = r.NextRecord()
+	assert.ErrorIs(t, err, io.EOF)
+	assert.ErrorIs(t, r.Next(dest), io.EOF)
+	require.NoError(t, r.Close())
+}
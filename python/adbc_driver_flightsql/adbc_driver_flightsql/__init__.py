@@ -36,14 +36,39 @@ __all__ = [
 class DatabaseOptions(enum.Enum):
     """Database options specific to the Flight SQL driver."""
 
+    #: Copy result message bodies into malloc()-allocated memory as they
+    #: are received, keeping result data off the Go heap.
+    ALLOCATE_MESSAGE_BODIES = "adbc.flight.sql.rpc.allocate_message_bodies"
     #: The authorization header to use for requests.
     AUTHORIZATION_HEADER = "adbc.flight.sql.authorization_header"
     #: Server name in authentication handshake
     AUTHORITY = "adbc.flight.sql.client_option.authority"
+    #: Compress ingested data, and ask the server to compress results,
+    #: with this codec ("lz4_frame", "zstd", or "none", the default).
+    IPC_COMPRESSION = "adbc.flight.sql.rpc.ipc_compression"
     #: Enable mTLS and use these PEM-encoded certificates.
     MTLS_CERT_CHAIN = "adbc.flight.sql.client_option.mtls_cert_chain"
     #: Enable mTLS and use this PEM-encoded private key.
     MTLS_PRIVATE_KEY = "adbc.flight.sql.client_option.mtls_private_key"
+    #: Cache query results of up to this many bytes in total. Defaults to
+    #: 0 (disabled).
+    RESULT_CACHE_MAX_BYTES = "adbc.flight.sql.result_cache.max_bytes"
+    #: Keep cached results as files in this directory instead of in
+    #: memory.
+    RESULT_CACHE_SPILL_DIRECTORY = "adbc.flight.sql.result_cache.spill_directory"
+    #: How long cached results are used for (in floating-point seconds).
+    #: Defaults to 60.
+    RESULT_CACHE_TTL = "adbc.flight.sql.result_cache.ttl_seconds"
+    #: The number of gRPC channels each connection fetches results over.
+    #: Defaults to 1.
+    RESULT_CHANNELS = "adbc.flight.sql.rpc.result_channels"
+    #: The default maximum number of partitions of a result set fetched
+    #: at once. Defaults to 0 (no limit).
+    RESULT_MAX_CONCURRENT_STREAMS = "adbc.rpc.result_max_concurrent_streams"
+    #: The default bound on the total size (in bytes) of the batches
+    #: queued across all partitions of a result set. Defaults to 0 (no
+    #: limit).
+    RESULT_QUEUE_BYTES = "adbc.rpc.result_queue_bytes"
     #: Add an arbitrary header to all outgoing requests.
     #:
     #: This option should prefix the name of the header to add
@@ -108,6 +133,18 @@ class StatementOptions(enum.Enum):
     #:
     #: This controls how much we read ahead on result sets.
     QUEUE_SIZE = "adbc.rpc.result_queue_size"
+    #: Return batches from whichever partition produces one first,
+    #: instead of partition by partition. Defaults to false.
+    UNORDERED_RESULTS = "adbc.rpc.result_unordered"
+    #: Bound the total size (in bytes) of the batches queued across all
+    #: partitions. Defaults to 0 (no byte limit; with unordered results,
+    #: QUEUE_SIZE batches are queued in total).
+    QUEUE_BYTES = DatabaseOptions.RESULT_QUEUE_BYTES.value
+    #: The maximum number of partitions fetched at once. Defaults to 0
+    #: (no limit).
+    MAX_CONCURRENT_STREAMS = DatabaseOptions.RESULT_MAX_CONCURRENT_STREAMS.value
+    #: Neither use nor fill the result cache for this statement.
+    RESULT_CACHE_BYPASS = "adbc.flight.sql.result_cache.bypass"
     #: Add an arbitrary header to all outgoing requests.
     #:
     #: This option should prefix the name of the header to add
@@ -19,6 +19,7 @@ import re
 
 import google.protobuf.any_pb2 as any_pb2
 import google.protobuf.wrappers_pb2 as wrappers_pb2
+import pyarrow
 import pytest
 
 
@@ -149,3 +150,26 @@ def test_query_error_getflightinfo(test_dbapi):
             ),
         ):
             cur.adbc_execute_partitions("error_get_flight_info")
+
+
+def test_ingest_target(test_dbapi):
+    # The test server checks the target options it receives for this table
+    data = pyarrow.table({"ints": [1, 2]})
+    with test_dbapi.cursor() as cur:
+        with pytest.raises(
+            Exception,
+            match=re.escape("INVALID_ARGUMENT: [FlightSQL] expected schema"),
+        ):
+            cur.adbc_ingest("check_target", data)
+
+        assert (
+            cur.adbc_ingest(
+                "check_target",
+                data,
+                mode="replace",
+                catalog_name="catalog",
+                db_schema_name="schema",
+                temporary=True,
+            )
+            == 2
+        )
@@ -95,6 +95,19 @@ class StatementOptions(enum.Enum):
     #: Number of concurrent streams being prefetched for a result set.
     #: Defaults to 10.
     PREFETCH_CONCURRENCY = "adbc.snowflake.rpc.prefetch_concurrency"
+    #: How bulk ingestion loads data: "insert" (the default) or "copy",
+    #: which writes Parquet files, uploads them to the table's stage, and
+    #: loads them with COPY INTO.
+    INGEST_METHOD = "adbc.snowflake.statement.ingest_method"
+    #: The number of Parquet files written at once by the "copy" method.
+    #: Defaults to the number of CPUs.
+    INGEST_WRITER_CONCURRENCY = "adbc.snowflake.statement.ingest_writer_concurrency"
+    #: The number of files uploaded at once by the "copy" method.
+    #: Defaults to 8.
+    INGEST_UPLOAD_CONCURRENCY = "adbc.snowflake.statement.ingest_upload_concurrency"
+    #: The size in bytes after which the "copy" method starts a new file.
+    #: Defaults to 10 MiB.
+    INGEST_TARGET_FILE_SIZE = "adbc.snowflake.statement.ingest_target_file_size"
 
 
 def connect(